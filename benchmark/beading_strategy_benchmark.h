@@ -0,0 +1,80 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BEADING_STRATEGY_BENCHMARK_H
+#define CURAENGINE_BEADING_STRATEGY_BENCHMARK_H
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "BeadingStrategy/BeadingStrategyFactory.h"
+
+namespace cura
+{
+class BeadingStrategyTestFixture : public benchmark::Fixture
+{
+public:
+    std::vector<coord_t> thicknesses;
+    bool flattened{ false };
+    static constexpr coord_t max_bead_count = 6;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        flattened = state.range(0) == 1;
+
+        // The thicknesses at the nodes of the skeleton of typical parts: many nodes along parallel walls of a few designed thicknesses, thin
+        // features in between and the thicker centres of larger regions.
+        std::mt19937_64 random{ 42 };
+        const std::vector<coord_t> designed_thicknesses{ MM2INT(0.8), MM2INT(1.2), MM2INT(1.6), MM2INT(2.0), MM2INT(3.0) };
+        std::uniform_int_distribution<size_t> designed(0, designed_thicknesses.size() - 1);
+        std::uniform_int_distribution<coord_t> thin(MM2INT(0.1), MM2INT(0.8));
+        std::uniform_int_distribution<coord_t> thick(MM2INT(0.8), MM2INT(6.0));
+        std::uniform_int_distribution<int> kind(0, 9);
+        for (size_t node_idx = 0; node_idx < 20000; node_idx++)
+        {
+            const int node_kind = kind(random);
+            thicknesses.push_back(node_kind < 5 ? designed_thicknesses[designed(random)] : node_kind < 7 ? thin(random) : thick(random));
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        thicknesses.clear();
+    }
+
+    BeadingStrategyPtr makeStrategy() const
+    {
+        const auto factory = flattened ? &BeadingStrategyFactory::makeStrategy : &BeadingStrategyFactory::makeStrategyStack;
+        return factory(MM2INT(0.4), MM2INT(0.4), MM2INT(0.4), std::numbers::pi / 18.0, true, MM2INT(0.34), MM2INT(0.1), 0.5_r, 0.5_r, max_bead_count, 0, 2, 0.5_r);
+    }
+};
+
+// The argument selects the stack of strategies (0) or the flattened strategy (1).
+BENCHMARK_DEFINE_F(BeadingStrategyTestFixture, compute)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        // A new strategy per pass, like the walls of each part on each layer get.
+        const BeadingStrategyPtr strategy = makeStrategy();
+        coord_t total = 0;
+        for (const coord_t thickness : thicknesses)
+        {
+            // Like the skeletal trapezoidation, compute both beadings around the optimal bead count to interpolate between them.
+            const coord_t bead_count = strategy->getOptimalBeadCount(thickness);
+            for (const coord_t computed_bead_count : { bead_count, std::min(bead_count + 1, max_bead_count + 1) })
+            {
+                const BeadingStrategy::Beading beading = strategy->compute(thickness, computed_bead_count);
+                total += beading.toolpath_locations.empty() ? 0 : beading.toolpath_locations.back();
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK_REGISTER_F(BeadingStrategyTestFixture, compute)->Arg(0)->Arg(1);
+
+} // namespace cura
+#endif // CURAENGINE_BEADING_STRATEGY_BENCHMARK_H
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_GEOMETRY_KERNELS_BENCHMARK_H
+#define CURAENGINE_GEOMETRY_KERNELS_BENCHMARK_H
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "geometry/PointsKernels.h"
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "utils/AABB.h"
+
+namespace cura
+{
+class GeometryKernelsTestFixture : public benchmark::Fixture
+{
+public:
+    Shape shape;
+    std::vector<Point2LL> query_points;
+    kernels::InstructionSet instruction_set{ kernels::InstructionSet::SCALAR };
+
+    void SetUp(::benchmark::State& state)
+    {
+        instruction_set = static_cast<kernels::InstructionSet>(state.range(0));
+        if (! kernels::isSupported(instruction_set))
+        {
+            state.SkipWithError("Instruction set not supported by this CPU.");
+            return;
+        }
+
+        auto wkt_file = std::filesystem::path(__FILE__).parent_path().append("holes.wkt");
+        std::ifstream file{ wkt_file };
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        shape = Shape::fromWkt(buffer.str());
+
+        const AABB aabb(shape);
+        constexpr coord_t grid_size = 20;
+        for (coord_t x = 0; x < grid_size; x++)
+        {
+            for (coord_t y = 0; y < grid_size; y++)
+            {
+                query_points.emplace_back(aabb.min_.X + (aabb.max_.X - aabb.min_.X) * x / grid_size, aabb.min_.Y + (aabb.max_.Y - aabb.min_.Y) * y / grid_size);
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        shape.clear();
+        query_points.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, area)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        double total = 0;
+        for (const Polygon& polygon : shape)
+        {
+            total += kernels::area(polygon.getPoints(), instruction_set);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, area)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, length)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        coord_t total = 0;
+        for (const Polygon& polygon : shape)
+        {
+            total += kernels::length(polygon.getPoints(), true, instruction_set);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, length)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, bounds)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        AABB aabb;
+        for (const Polygon& polygon : shape)
+        {
+            kernels::bounds(polygon.getPoints(), aabb.min_, aabb.max_, instruction_set);
+        }
+        benchmark::DoNotOptimize(aabb);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, bounds)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, pointInPolygon)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        int inside = 0;
+        for (const Point2LL& point : query_points)
+        {
+            for (const Polygon& polygon : shape)
+            {
+                inside += kernels::pointInPolygon(point, polygon.getPoints(), instruction_set);
+            }
+        }
+        benchmark::DoNotOptimize(inside);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, pointInPolygon)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, pointInPolygonSoA)(benchmark::State& st)
+{
+    std::vector<kernels::PointsSoAView> views;
+    for (const Polygon& polygon : shape)
+    {
+        views.emplace_back(polygon.getPoints());
+    }
+    for (auto _ : st)
+    {
+        int inside = 0;
+        for (const Point2LL& point : query_points)
+        {
+            for (const kernels::PointsSoAView& view : views)
+            {
+                inside += kernels::pointInPolygon(point, view.xs(), view.ys(), instruction_set);
+            }
+        }
+        benchmark::DoNotOptimize(inside);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, pointInPolygonSoA)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(GeometryKernelsTestFixture, closestOnPolygon)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        size_t total = 0;
+        for (const Point2LL& point : query_points)
+        {
+            for (const Polygon& polygon : shape)
+            {
+                if (! polygon.empty())
+                {
+                    total += kernels::closestOnPolygon(point, polygon.getPoints(), instruction_set).second;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK_REGISTER_F(GeometryKernelsTestFixture, closestOnPolygon)->Arg(0)->Arg(1);
+
+} // namespace cura
+#endif // CURAENGINE_GEOMETRY_KERNELS_BENCHMARK_H
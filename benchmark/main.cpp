@@ -4,6 +4,11 @@
 #include "infill_benchmark.h"
 #include "wall_benchmark.h"
 #include "simplify_benchmark.h"
+#include "geometry_kernels_benchmark.h"
+#include "slicer_benchmark.h"
+#include "material_splitter_benchmark.h"
+#include "path_order_benchmark.h"
+#include "beading_strategy_benchmark.h"
 #include <benchmark/benchmark.h>
 
 // Run the benchmark
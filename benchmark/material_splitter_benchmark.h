@@ -0,0 +1,143 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_MATERIAL_SPLITTER_BENCHMARK_H
+#define CURAENGINE_MATERIAL_SPLITTER_BENCHMARK_H
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "MeshGroup.h"
+#include "MeshMaterialSplitter.h"
+#include "Slice.h"
+#include "TextureDataMapping.h"
+#include "communication/CommandLine.h"
+#include "mesh.h"
+
+namespace cura
+{
+
+/*!
+ * A cube of 20mm, of which each side is textured with stripes painted alternately for extruder 0 and extruder 1.
+ *
+ * The argument of the benchmark is the paint resolution, in microns.
+ */
+class MaterialSplitterTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr coord_t cube_size = MM2INT(20);
+    static constexpr size_t quads_per_side = 16;
+    static constexpr size_t texture_size = 64;
+    static constexpr size_t stripe_width = 8; //!< In pixels
+
+    std::unique_ptr<Mesh> mesh;
+    MeshGroup mesh_group;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().communication_ = std::make_shared<CommandLine>();
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+
+        Scene& scene = Application::getInstance().current_slice_->scene;
+        scene.settings.add("multi_material_paint_resolution", std::to_string(INT2MM(state.range(0))));
+        scene.settings.add("multi_material_paint_deepness", "2");
+        scene.settings.add("layer_height_0", "0.2");
+        scene.settings.add("layer_height", "0.1");
+        scene.settings.add("layer_0_z_overlap", "0.0");
+        scene.settings.add("raft_airgap", "0.0");
+        scene.settings.add("raft_base_thickness", "0.2");
+        scene.settings.add("raft_interface_thickness", "0.2");
+        scene.settings.add("raft_interface_layers", "1");
+        scene.settings.add("raft_surface_thickness", "0.2");
+        scene.settings.add("raft_surface_layers", "1");
+        scene.settings.add("raft_surface_extruder_nr", "0");
+        scene.settings.add("magic_mesh_surface_mode", "normal");
+        scene.settings.add("meshfix_extensive_stitching", "false");
+        scene.settings.add("meshfix_keep_open_polygons", "false");
+        scene.settings.add("minimum_polygon_circumference", "1");
+        scene.settings.add("meshfix_maximum_resolution", "0.04");
+        scene.settings.add("meshfix_maximum_deviation", "0.02");
+        scene.settings.add("meshfix_maximum_extrusion_area_deviation", "2000");
+        scene.settings.add("wall_transition_angle", "10");
+        scene.settings.add("support_mesh", "false");
+        scene.settings.add("anti_overhang_mesh", "false");
+        scene.settings.add("cutting_mesh", "false");
+        scene.settings.add("infill_mesh", "false");
+        scene.settings.add("adhesion_type", "none");
+        scene.settings.add("slicing_tolerance", "middle");
+        scene.extruders.clear();
+        scene.extruders.emplace_back(0, &scene.settings);
+        scene.extruders.emplace_back(1, &scene.settings);
+
+        std::vector<uint8_t> pixels(texture_size * texture_size);
+        for (size_t y = 0; y < texture_size; y++)
+        {
+            for (size_t x = 0; x < texture_size; x++)
+            {
+                pixels[y * texture_size + x] = static_cast<uint8_t>((x / stripe_width) % 2);
+            }
+        }
+
+        mesh = std::make_unique<Mesh>(scene.settings);
+        mesh->texture_ = std::make_shared<Image>(texture_size, texture_size, 1, std::move(pixels));
+        mesh->texture_data_mapping_ = std::make_shared<TextureDataMapping>();
+        mesh->texture_data_mapping_->emplace("extruder", TextureBitField{ 0, 7 });
+
+        // Each side of the cube is a grid of quads, with the UV coordinates spanning the whole texture.
+        const auto add_side = [this](const Point3LL& origin, const Point3LL& u_axis, const Point3LL& v_axis)
+        {
+            const auto corner = [&](const size_t u, const size_t v)
+            {
+                return origin + u_axis * static_cast<coord_t>(u) / static_cast<coord_t>(quads_per_side) + v_axis * static_cast<coord_t>(v) / static_cast<coord_t>(quads_per_side);
+            };
+            const auto uv = [](const size_t u, const size_t v)
+            {
+                return std::make_optional(Point2F(static_cast<float>(u) / quads_per_side, static_cast<float>(v) / quads_per_side));
+            };
+            for (size_t u = 0; u < quads_per_side; u++)
+            {
+                for (size_t v = 0; v < quads_per_side; v++)
+                {
+                    mesh->addFace(corner(u, v), corner(u + 1, v), corner(u + 1, v + 1), uv(u, v), uv(u + 1, v), uv(u + 1, v + 1));
+                    mesh->addFace(corner(u, v), corner(u + 1, v + 1), corner(u, v + 1), uv(u, v), uv(u + 1, v + 1), uv(u, v + 1));
+                }
+            }
+        };
+        const Point3LL x_axis(cube_size, 0, 0);
+        const Point3LL y_axis(0, cube_size, 0);
+        const Point3LL z_axis(0, 0, cube_size);
+        add_side(Point3LL(0, 0, 0), y_axis, x_axis); // Bottom
+        add_side(z_axis, x_axis, y_axis); // Top
+        add_side(Point3LL(0, 0, 0), x_axis, z_axis); // Front
+        add_side(y_axis, z_axis, x_axis); // Back
+        add_side(Point3LL(0, 0, 0), z_axis, y_axis); // Left
+        add_side(x_axis, y_axis, z_axis); // Right
+        mesh->finish();
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        mesh_group.meshes.clear();
+        mesh.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(MaterialSplitterTestFixture, make_modifier_meshes)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        MeshMaterialSplitter::makeMaterialModifierMeshes(*mesh, &mesh_group);
+        benchmark::DoNotOptimize(mesh_group.meshes);
+        mesh_group.meshes.clear();
+    }
+}
+
+BENCHMARK_REGISTER_F(MaterialSplitterTestFixture, make_modifier_meshes)->Arg(400)->Arg(200)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+
+#endif // CURAENGINE_MATERIAL_SPLITTER_BENCHMARK_H
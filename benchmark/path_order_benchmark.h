@@ -0,0 +1,76 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_PATH_ORDER_BENCHMARK_H
+#define CURAENGINE_PATH_ORDER_BENCHMARK_H
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "PathOrderMonotonic.h"
+#include "geometry/OpenLinesSet.h"
+#include "geometry/OpenPolyline.h"
+#include "infill.h"
+#include "settings/Settings.h"
+
+namespace cura
+{
+class MonotonicSkinTestFixture : public benchmark::Fixture
+{
+public:
+    Settings settings{};
+    OpenLinesSet skin_lines;
+    AngleRadians monotonic_direction{ 0. };
+
+    coord_t SKIN_LINE_WIDTH = 400;
+    coord_t MAX_ADJACENT_DISTANCE = SKIN_LINE_WIDTH * 1.1;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        auto wkt_file = std::filesystem::path(__FILE__).parent_path().append("holes.wkt");
+        std::ifstream file{ wkt_file };
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const auto shape = Shape::fromWkt(buffer.str());
+
+        settings.add("fill_outline_gaps", "false");
+        settings.add("meshfix_maximum_deviation", "0.1");
+        settings.add("meshfix_maximum_extrusion_area_deviation", "0.01");
+        settings.add("meshfix_maximum_resolution", "0.01");
+
+        // Lines skin, as it is generated for the top/bottom skin of a part with many holes.
+        const AngleDegrees fill_angle = static_cast<double>(state.range(0));
+        monotonic_direction = AngleRadians(fill_angle);
+        Infill infill(EFillMethod::LINES, false, false, shape, SKIN_LINE_WIDTH, SKIN_LINE_WIDTH, 0, 1, fill_angle, 100, 0, 10, 5);
+
+        std::vector<VariableWidthLines> result_paths;
+        Shape result_polygons;
+        infill.generate(result_paths, result_polygons, skin_lines, settings, 0, SectionType::SKIN, nullptr, nullptr);
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+};
+
+BENCHMARK_DEFINE_F(MonotonicSkinTestFixture, PathOrderMonotonic_optimize)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        PathOrderMonotonic<const OpenPolyline*> order(monotonic_direction, MAX_ADJACENT_DISTANCE, Point2LL(0, 0));
+        for (const OpenPolyline& line : skin_lines)
+        {
+            order.addPolyline(&line);
+        }
+        order.optimize();
+        benchmark::DoNotOptimize(order.paths_);
+    }
+}
+
+BENCHMARK_REGISTER_F(MonotonicSkinTestFixture, PathOrderMonotonic_optimize)->Arg(0)->Arg(45)->Arg(90)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+#endif // CURAENGINE_PATH_ORDER_BENCHMARK_H
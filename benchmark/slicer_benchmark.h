@@ -0,0 +1,150 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_SLICER_BENCHMARK_H
+#define CURAENGINE_SLICER_BENCHMARK_H
+
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Application.h"
+#include "MeshGroup.h"
+#include "Slice.h"
+#include "mesh.h"
+#include "slicer.h"
+
+namespace cura
+{
+
+/*!
+ * A build plate crowded with small parts: a grid of 200 cylinders of about 8mm diameter and 20mm high.
+ *
+ * The argument of the benchmark is the number of different cylinders on the plate, the others are translated copies of those.
+ */
+class SlicerTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr size_t part_count = 200;
+    static constexpr size_t parts_per_row = 20;
+    static constexpr size_t cylinder_sides = 64;
+    static constexpr coord_t part_radius = MM2INT(4);
+    static constexpr coord_t part_height = MM2INT(20);
+    static constexpr coord_t part_spacing = MM2INT(10);
+
+    MeshGroup mesh_group;
+    coord_t layer_thickness = MM2INT(0.1);
+    coord_t initial_layer_thickness = MM2INT(0.2);
+    size_t layer_count = 0;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+
+        Scene& scene = Application::getInstance().current_slice_->scene;
+        scene.settings.add("layer_height_0", "0.2");
+        scene.settings.add("layer_height", "0.1");
+        scene.settings.add("layer_0_z_overlap", "0.0");
+        scene.settings.add("raft_airgap", "0.0");
+        scene.settings.add("raft_base_thickness", "0.2");
+        scene.settings.add("raft_interface_thickness", "0.2");
+        scene.settings.add("raft_interface_layers", "1");
+        scene.settings.add("raft_surface_thickness", "0.2");
+        scene.settings.add("raft_surface_layers", "1");
+        scene.settings.add("raft_surface_extruder_nr", "0");
+        scene.settings.add("magic_mesh_surface_mode", "normal");
+        scene.settings.add("meshfix_extensive_stitching", "false");
+        scene.settings.add("meshfix_keep_open_polygons", "false");
+        scene.settings.add("minimum_polygon_circumference", "1");
+        scene.settings.add("meshfix_maximum_resolution", "0.04");
+        scene.settings.add("meshfix_maximum_deviation", "0.02");
+        scene.settings.add("meshfix_maximum_extrusion_area_deviation", "2000");
+        scene.settings.add("wall_transition_angle", "10");
+        scene.settings.add("xy_offset", "0");
+        scene.settings.add("xy_offset_layer_0", "0");
+        scene.settings.add("hole_xy_offset", "0");
+        scene.settings.add("hole_xy_offset_max_diameter", "0");
+        scene.settings.add("support_mesh", "false");
+        scene.settings.add("anti_overhang_mesh", "false");
+        scene.settings.add("cutting_mesh", "false");
+        scene.settings.add("infill_mesh", "false");
+        scene.settings.add("adhesion_type", "none");
+        scene.settings.add("slicing_tolerance", "middle");
+
+        const size_t distinct_part_count = static_cast<size_t>(state.range(0));
+        std::vector<Mesh>& meshes = mesh_group.meshes;
+        meshes.clear();
+        meshes.reserve(part_count);
+        for (size_t part_idx = 0; part_idx < part_count; part_idx++)
+        {
+            const coord_t center_x = static_cast<coord_t>(part_idx % parts_per_row) * part_spacing;
+            const coord_t center_y = static_cast<coord_t>(part_idx / parts_per_row) * part_spacing;
+            const coord_t radius = part_radius + static_cast<coord_t>(part_idx % distinct_part_count) * MM2INT(0.01);
+            Mesh& mesh = meshes.emplace_back(scene.settings);
+            std::vector<Point3LL> bottom;
+            std::vector<Point3LL> top;
+            for (size_t side_idx = 0; side_idx < cylinder_sides; side_idx++)
+            {
+                const double angle = 2.0 * std::numbers::pi * static_cast<double>(side_idx) / static_cast<double>(cylinder_sides);
+                const coord_t x = center_x + std::llround(std::cos(angle) * radius);
+                const coord_t y = center_y + std::llround(std::sin(angle) * radius);
+                bottom.emplace_back(x, y, 0);
+                top.emplace_back(x, y, part_height);
+            }
+            const Point3LL bottom_center(center_x, center_y, 0);
+            const Point3LL top_center(center_x, center_y, part_height);
+            for (size_t side_idx = 0; side_idx < cylinder_sides; side_idx++)
+            {
+                const size_t next_idx = (side_idx + 1) % cylinder_sides;
+                mesh.addFace(bottom_center, bottom[next_idx], bottom[side_idx]);
+                mesh.addFace(top_center, top[side_idx], top[next_idx]);
+                mesh.addFace(bottom[side_idx], bottom[next_idx], top[next_idx]);
+                mesh.addFace(bottom[side_idx], top[next_idx], top[side_idx]);
+            }
+            mesh.finish();
+        }
+        layer_count = static_cast<size_t>((part_height - initial_layer_thickness) / layer_thickness + 1);
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+        mesh_group.meshes.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(SlicerTestFixture, slice_plate_per_mesh)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        for (Mesh& mesh : mesh_group.meshes)
+        {
+            Slicer slicer(&mesh, layer_thickness, layer_count, false, nullptr, SlicingTolerance::MIDDLE, initial_layer_thickness);
+            benchmark::DoNotOptimize(slicer.layers);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(SlicerTestFixture, slice_plate_per_mesh)->Arg(1)->Arg(200)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(SlicerTestFixture, slice_plate_batched)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        std::vector<Slicer*> slicers = Slicer::sliceMeshes(mesh_group, layer_thickness, layer_count, false, nullptr, initial_layer_thickness);
+        benchmark::DoNotOptimize(slicers);
+        for (Slicer* slicer : slicers)
+        {
+            delete slicer;
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(SlicerTestFixture, slice_plate_batched)->Arg(1)->Arg(200)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+
+#endif // CURAENGINE_SLICER_BENCHMARK_H
@@ -5,19 +5,23 @@
 #define CURAENGINE_WALL_BENCHMARK_H
 
 #include <benchmark/benchmark.h>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <numbers>
 #include <string>
 
 #include <range/v3/view/join.hpp>
 #include <spdlog/spdlog.h>
 
 #include "InsetOrderOptimizer.h"
+#include "WallToolPaths.h"
 #include "WallsComputation.h"
 #include "geometry/Polygon.h"
 #include "settings/Settings.h"
 #include "sliceDataStorage.h"
+#include "utils/CompressedGeometry.h"
 
 namespace cura
 {
@@ -153,6 +157,85 @@ public:
     }
 };
 
+class MechanicalPartWallTestFixture : public benchmark::Fixture
+{
+public:
+    Settings settings{};
+    Shape plate;
+    size_t wall_count{ 0 };
+    bool offset_fast_path{ true };
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        // A cross-section of a typical mechanical part: a plate with rounded corners, bolt holes and a slot, thick enough everywhere for a
+        // few walls.
+        plate.clear();
+        const auto add_arc = [](Polygon& polygon, const Point2LL& center, const coord_t radius, const double start_angle, const double end_angle)
+        {
+            constexpr size_t segment_count = 32;
+            for (size_t segment_idx = 0; segment_idx <= segment_count; segment_idx++)
+            {
+                const double angle = start_angle + (end_angle - start_angle) * static_cast<double>(segment_idx) / segment_count;
+                polygon.emplace_back(center.X + static_cast<coord_t>(radius * std::cos(angle)), center.Y + static_cast<coord_t>(radius * std::sin(angle)));
+            }
+        };
+        constexpr double quarter = std::numbers::pi / 2;
+        Polygon& outline = plate.newLine();
+        add_arc(outline, Point2LL(MM2INT(5), MM2INT(5)), MM2INT(5), 2 * quarter, 3 * quarter);
+        add_arc(outline, Point2LL(MM2INT(75), MM2INT(5)), MM2INT(5), 3 * quarter, 4 * quarter);
+        add_arc(outline, Point2LL(MM2INT(75), MM2INT(45)), MM2INT(5), 0, quarter);
+        add_arc(outline, Point2LL(MM2INT(5), MM2INT(45)), MM2INT(5), quarter, 2 * quarter);
+        for (const Point2LL& center : { Point2LL(MM2INT(8), MM2INT(8)), Point2LL(MM2INT(72), MM2INT(8)), Point2LL(MM2INT(72), MM2INT(42)), Point2LL(MM2INT(8), MM2INT(42)) })
+        {
+            Polygon& hole = plate.newLine();
+            add_arc(hole, center, MM2INT(1.6), 4 * quarter, 0);
+        }
+        Polygon& slot = plate.newLine();
+        add_arc(slot, Point2LL(MM2INT(50), MM2INT(25)), MM2INT(4), quarter, -quarter);
+        add_arc(slot, Point2LL(MM2INT(30), MM2INT(25)), MM2INT(4), -quarter, -3 * quarter);
+
+        settings.add("alternate_extra_perimeter", "false");
+        settings.add("fill_outline_gaps", "false");
+        settings.add("initial_layer_line_width_factor", "100");
+        settings.add("magic_spiralize", "false");
+        settings.add("meshfix_maximum_deviation", "0.025");
+        settings.add("meshfix_maximum_extrusion_area_deviation", "50");
+        settings.add("meshfix_maximum_resolution", "0.5");
+        settings.add("meshfix_fluid_motion_enabled", "false");
+        settings.add("min_wall_line_width", "0.34");
+        settings.add("min_bead_width", "0.34");
+        settings.add("min_feature_size", "0.1");
+        settings.add("wall_0_extruder_nr", "0");
+        settings.add("wall_0_inset", "0");
+        settings.add("wall_line_width_0", "0.4");
+        settings.add("wall_line_width_x", "0.4");
+        settings.add("min_even_wall_line_width", "0.34");
+        settings.add("min_odd_wall_line_width", "0.34");
+        settings.add("wall_transition_angle", "10");
+        settings.add("wall_transition_filter_distance", "100");
+        settings.add("wall_transition_filter_deviation", "0.1");
+        settings.add("wall_transition_length", "0.4");
+        settings.add("wall_x_extruder_nr", "0");
+        settings.add("wall_distribution_count", "1");
+        wall_count = static_cast<size_t>(state.range(0));
+        offset_fast_path = state.range(1) == 1;
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+
+    /*!
+     * Generate the walls of the plate, with or without generating them as offsets outside of the thin regions.
+     */
+    std::vector<VariableWidthLines> generateWalls() const
+    {
+        WallToolPaths wall_tool_paths(plate, MM2INT(0.4), MM2INT(0.4), wall_count, 0, settings, 100, SectionType::WALL);
+        wall_tool_paths.offset_fast_path_ = offset_fast_path;
+        return wall_tool_paths.generate();
+    }
+};
+
 BENCHMARK_DEFINE_F(WallTestFixture, generateWalls)(benchmark::State& st)
 {
     for (auto _ : st)
@@ -237,5 +320,49 @@ BENCHMARK_DEFINE_F(HolesWallTestFixture, InsetOrderOptimizer_getInsetOrder)(benc
 
 BENCHMARK_REGISTER_F(HolesWallTestFixture, InsetOrderOptimizer_getInsetOrder)->Arg(3)->Arg(15)->Arg(9999)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(HolesWallTestFixture, SliceLayerPart_compressDecompress)(benchmark::State& st)
+{
+    walls_computation.generateWalls(&layer, SectionType::WALL);
+    SliceLayerPart& part = layer.parts.back();
+    size_t uncompressed_bytes = 0;
+    for (const ExtrusionLine& line : part.wall_toolpaths | ranges::views::join)
+    {
+        uncompressed_bytes += sizeof(ExtrusionLine) + line.junctions_.size() * sizeof(ExtrusionJunction);
+    }
+    for (const Shape* shape : { &part.inner_area, &part.print_outline })
+    {
+        for (const Polygon& polygon : *shape)
+        {
+            uncompressed_bytes += sizeof(Polygon) + polygon.size() * sizeof(Point2LL);
+        }
+    }
+    const size_t compressed_bytes
+        = CompressedToolPaths(part.wall_toolpaths).byteSize() + CompressedShape(part.inner_area).byteSize() + CompressedShape(part.print_outline).byteSize();
+
+    for (auto _ : st)
+    {
+        st.PauseTiming();
+        SliceLayerPart uncompressed_part = part; // Once compressed, a part keeps its compressed data, so compress a fresh copy every time.
+        st.ResumeTiming();
+        uncompressed_part.compress();
+        uncompressed_part.decompress();
+    }
+    st.counters["uncompressed_bytes"] = static_cast<double>(uncompressed_bytes);
+    st.counters["compressed_bytes"] = static_cast<double>(compressed_bytes);
+}
+
+BENCHMARK_REGISTER_F(HolesWallTestFixture, SliceLayerPart_compressDecompress)->Arg(3)->Arg(15)->Unit(benchmark::kMillisecond);
+
+// The second argument disables (0) or enables (1) the walls generated as offsets outside of the thin regions.
+BENCHMARK_DEFINE_F(MechanicalPartWallTestFixture, generateWalls)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        benchmark::DoNotOptimize(generateWalls());
+    }
+}
+
+BENCHMARK_REGISTER_F(MechanicalPartWallTestFixture, generateWalls)->ArgsProduct({ { 2, 3, 4 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
 } // namespace cura
 #endif // CURAENGINE_WALL_BENCHMARK_H
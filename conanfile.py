@@ -78,6 +78,8 @@ class CuraEngineLEConan(ConanFile):
              os.path.join(self.export_sources_folder, "benchmark"))
         copy(self, "*", os.path.join(self.recipe_folder, "stress_benchmark"),
              os.path.join(self.export_sources_folder, "stress_benchmark"))
+        copy(self, "*", os.path.join(self.recipe_folder, "pipeline_benchmark"),
+             os.path.join(self.export_sources_folder, "pipeline_benchmark"))
         copy(self, "*", os.path.join(self.recipe_folder, "tests"), os.path.join(self.export_sources_folder, "tests"))
 
     def config_options(self):
@@ -177,6 +179,7 @@ class CuraEngineLEConan(ConanFile):
             if self.options.enable_benchmarks:
                 folder_dists.append("benchmark")
                 folder_dists.append("stress_benchmark")
+                folder_dists.append("pipeline_benchmark")
 
             for dist_folder in folder_dists:
                 dist_path = os.path.join(self.build_folder, dist_folder)
@@ -126,6 +126,15 @@ protected:
      */
     void slice();
 
+    /*!
+     * \brief Slice all jobs of a manifest file, one after another in the same
+     * process.
+     *
+     * Each job writes its g-code to its own output file. The thread pool and
+     * the parsed definition files are kept between the jobs.
+     */
+    void batch();
+
 private:
     /*
      * \brief The number of arguments that the application was called with.
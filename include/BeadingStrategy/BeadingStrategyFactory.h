@@ -15,6 +15,10 @@ namespace cura
 class BeadingStrategyFactory
 {
 public:
+    /*!
+     * Make the beading strategy for walls: a \ref FlattenedBeadingStrategy, which gives the same results as the stack of strategies made
+     * by \ref makeStrategyStack.
+     */
     static BeadingStrategyPtr makeStrategy(
         const coord_t preferred_bead_width_outer = MM2INT(0.5),
         const coord_t preferred_bead_width_inner = MM2INT(0.5),
@@ -29,6 +33,25 @@ public:
         const coord_t outer_wall_offset = 0,
         const int inward_distributed_center_wall_count = 2,
         const Ratio minimum_variable_line_ratio = 0.5);
+
+    /*!
+     * Make the beading strategy for walls as a stack of meta-strategies around a \ref DistributedBeadingStrategy, each of which adjusts
+     * the results of the strategy it wraps.
+     */
+    static BeadingStrategyPtr makeStrategyStack(
+        const coord_t preferred_bead_width_outer = MM2INT(0.5),
+        const coord_t preferred_bead_width_inner = MM2INT(0.5),
+        const coord_t preferred_transition_length = MM2INT(0.4),
+        const double transitioning_angle = std::numbers::pi / 4.0,
+        const bool print_thin_walls = false,
+        const coord_t min_bead_width = 0,
+        const coord_t min_feature_size = 0,
+        const Ratio wall_split_middle_threshold = 0.5_r,
+        const Ratio wall_add_middle_threshold = 0.5_r,
+        const coord_t max_bead_count = 0,
+        const coord_t outer_wall_offset = 0,
+        const int inward_distributed_center_wall_count = 2,
+        const Ratio minimum_variable_line_ratio = 0.5);
 };
 
 } // namespace cura
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef FLATTENED_BEADING_STRATEGY_H
+#define FLATTENED_BEADING_STRATEGY_H
+
+#include <unordered_map>
+
+#include "../settings/types/Ratio.h"
+#include "BeadingStrategy.h"
+
+namespace cura
+{
+
+/*!
+ * The stack of beading strategies that \ref BeadingStrategyFactory::makeStrategyStack makes, evaluated as a single strategy.
+ *
+ * This gives exactly the same results as a \ref DistributedBeadingStrategy, wrapped in a \ref RedistributeBeadingStrategy, optionally a
+ * \ref WideningBeadingStrategy and an \ref OuterWallInsetBeadingStrategy, and finally a \ref LimitedBeadingStrategy. Each of those steps
+ * is a plain function call here, instead of a virtual call to the next strategy in the stack.
+ *
+ * The skeletal trapezoidation computes the beading of every node of the skeleton, and many nodes of a part have the same thickness.
+ * The beadings are therefore memoized by the strategy itself. A strategy is made per call to \ref WallToolPaths::generate, so the
+ * memo only lives as long as the walls of a single part are generated.
+ */
+class FlattenedBeadingStrategy final : public BeadingStrategy
+{
+public:
+    /*!
+     * See \ref BeadingStrategyFactory::makeStrategy for the meaning of the parameters.
+     */
+    FlattenedBeadingStrategy(
+        const coord_t preferred_bead_width_outer,
+        const coord_t preferred_bead_width_inner,
+        const coord_t preferred_transition_length,
+        const double transitioning_angle,
+        const bool print_thin_walls,
+        const coord_t min_bead_width,
+        const coord_t min_feature_size,
+        const Ratio wall_split_middle_threshold,
+        const Ratio wall_add_middle_threshold,
+        const coord_t max_bead_count,
+        const coord_t outer_wall_offset,
+        const int inward_distributed_center_wall_count,
+        const Ratio minimum_variable_line_ratio);
+
+    ~FlattenedBeadingStrategy() override = default;
+
+    Beading compute(coord_t thickness, coord_t bead_count) const override;
+    coord_t getOptimalThickness(coord_t bead_count) const override;
+    coord_t getTransitionThickness(coord_t lower_bead_count) const override;
+    coord_t getOptimalBeadCount(coord_t thickness) const override;
+    coord_t getTransitioningLength(coord_t lower_bead_count) const override;
+    double getTransitionAnchorPos(coord_t lower_bead_count) const override;
+
+private:
+    struct BeadingKey
+    {
+        coord_t thickness;
+        coord_t bead_count;
+
+        bool operator==(const BeadingKey& other) const = default;
+    };
+
+    struct BeadingKeyHash
+    {
+        size_t operator()(const BeadingKey& key) const
+        {
+            return std::hash<coord_t>()(key.thickness) ^ (std::hash<coord_t>()(key.bead_count) << 20);
+        }
+    };
+
+    /*!
+     * The beading of the whole stack, without memoization: the \ref LimitedBeadingStrategy step.
+     */
+    Beading computeLimited(coord_t thickness, coord_t bead_count) const;
+
+    /*!
+     * The steps of \ref OuterWallInsetBeadingStrategy, if there is an outer wall offset. Otherwise the widening steps below it.
+     */
+    Beading computeInset(coord_t thickness, coord_t bead_count) const;
+    double getTransitionAnchorPosInset(coord_t lower_bead_count) const;
+
+    /*!
+     * The steps of \ref WideningBeadingStrategy, if thin walls are printed. Otherwise the redistribution steps below it.
+     */
+    Beading computeWidened(coord_t thickness, coord_t bead_count) const;
+    coord_t getTransitionThicknessWidened(coord_t lower_bead_count) const;
+    coord_t getOptimalBeadCountWidened(coord_t thickness) const;
+
+    /*!
+     * The steps of \ref RedistributeBeadingStrategy.
+     */
+    Beading computeRedistributed(coord_t thickness, coord_t bead_count) const;
+    coord_t getOptimalThicknessRedistributed(coord_t bead_count) const;
+    coord_t getTransitionThicknessRedistributed(coord_t lower_bead_count) const;
+    coord_t getOptimalBeadCountRedistributed(coord_t thickness) const;
+
+    /*!
+     * The steps of \ref DistributedBeadingStrategy, the bottom of the stack.
+     */
+    Beading computeDistributed(coord_t thickness, coord_t bead_count) const;
+    coord_t getOptimalThicknessDistributed(coord_t bead_count) const;
+    coord_t getTransitionThicknessDistributed(coord_t lower_bead_count) const;
+    coord_t getOptimalBeadCountDistributed(coord_t thickness) const;
+    double getTransitionAnchorPosDistributed(coord_t lower_bead_count) const;
+
+    coord_t optimal_width_outer_;
+    Ratio minimum_variable_line_ratio_;
+    bool print_thin_walls_;
+    coord_t min_input_width_;
+    coord_t min_output_width_;
+    coord_t outer_wall_offset_;
+    coord_t max_bead_count_;
+    double one_over_distribution_radius_squared_; // (1 / distribution_radius)^2
+    mutable std::unordered_map<BeadingKey, Beading, BeadingKeyHash> memoized_beadings_;
+};
+
+} // namespace cura
+#endif // FLATTENED_BEADING_STRATEGY_H
@@ -4,7 +4,7 @@
 #ifndef GCODE_WRITER_H
 #define GCODE_WRITER_H
 
-#include <fstream>
+#include <memory>
 #include <optional>
 
 #include "ExtruderUse.h"
@@ -58,11 +58,6 @@ private:
      */
     GCodeExport gcode;
 
-    /*!
-     * The gcode file to write to when using CuraEngine as command line tool.
-     */
-    std::ofstream output_file;
-
     //!< For each layer, the extruders to be used in that layer in the order in which they are going to be used
     LayerVector<std::vector<ExtruderUse>> extruder_order_per_layer;
 
@@ -102,13 +97,13 @@ public:
     bool setTargetFile(const char* filename);
 
     /*!
-     * Set the target to write gcode to: an output stream.
+     * Set the target to write gcode to: a sink that is read by the front-end.
      *
      * Used when CuraEngine is NOT used as command line tool.
      *
-     * \param stream The stream to write gcode to.
+     * \param sink The sink to write gcode to.
      */
-    void setTargetStream(std::ostream* stream);
+    void setTargetSink(std::shared_ptr<GCodeSink> sink);
 
     /*!
      * Wether or not the extruder is actually used in the print, regardless of enablement.
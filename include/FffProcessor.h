@@ -4,6 +4,8 @@
 #ifndef FFF_PROCESSOR_H
 #define FFF_PROCESSOR_H
 
+#include <memory>
+
 #include "FffGcodeWriter.h"
 #include "FffPolygonGenerator.h"
 #include "utils/NoCopy.h"
@@ -35,7 +37,7 @@ public:
     /*!
      * The gcode writer, which generates paths in layer plans in a buffer, which converts these paths into gcode commands.
      */
-    FffGcodeWriter gcode_writer;
+    std::unique_ptr<FffGcodeWriter> gcode_writer = std::make_unique<FffGcodeWriter>();
 
     /*!
      * The polygon generator, which slices the models and generates all polygons to be printed and areas to be filled.
@@ -57,13 +59,13 @@ public:
     bool setTargetFile(const char* filename);
 
     /*!
-     * Set the target to write gcode to: an output stream.
+     * Set the target to write gcode to: a sink that is read by the front-end.
      *
      * Used when CuraEngine is NOT used as command line tool.
      *
-     * \param stream The stream to write gcode to.
+     * \param sink The sink to write gcode to.
      */
-    void setTargetStream(std::ostream* stream);
+    void setTargetSink(std::shared_ptr<GCodeSink> sink);
 
     /*!
      * Wether or not the extruder is actually used in the print, regardless of enablement.
@@ -94,6 +96,15 @@ public:
      * Add the end gcode and set all temperatures to zero.
      */
     void finalize();
+
+    /*!
+     * Start over with a new g-code writer, so that nothing of a previous slice carries over into the next one: the layers on which the
+     * extruders are primed, the bounding box and the used extruders in the header, the fans, the height of the previously printed objects
+     * and the rest of the state of the g-code export.
+     *
+     * The g-code is written to stdout again, until another target is set. The previous target is closed once nothing refers to it.
+     */
+    void reset();
 };
 
 } // namespace cura
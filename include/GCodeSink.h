@@ -0,0 +1,209 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GCODE_SINK_H
+#define GCODE_SINK_H
+
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "settings/types/Duration.h"
+#include "settings/types/LayerIndex.h"
+#include "utils/NoCopy.h"
+#include "utils/string.h" // MMtoStream, PrecisionedDouble
+#include "utils/types/generic.h"
+
+namespace cura
+{
+
+/*!
+ * Destination of the g-code written by GCodeExport.
+ *
+ * The g-code is formatted directly into a growable byte buffer, with hand-rolled number formatting that doesn't depend on the
+ * locale of a std::ostream. Once the buffer holds at least a chunk of g-code, it is handed to the implementation, which may either
+ * write it out or take ownership of it.
+ *
+ * Numbers are written as they would be written to a std::ostream in std::fixed mode, so the output stays byte-identical to that of
+ * a stream.
+ */
+class GCodeSink : NoCopy
+{
+public:
+    virtual ~GCodeSink() = default;
+
+    GCodeSink& operator<<(const std::string_view text)
+    {
+        buffer_.append(text);
+        return commit();
+    }
+
+    GCodeSink& operator<<(const char character)
+    {
+        buffer_.push_back(character);
+        return commit();
+    }
+
+    template<utils::integral T>
+    GCodeSink& operator<<(const T value)
+    {
+        char digits[24];
+        const char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        buffer_.append(digits, static_cast<size_t>(end - digits));
+        return commit();
+    }
+
+    /*!
+     * Write a floating point number with 6 decimals, like a stream in std::fixed mode would do.
+     */
+    template<utils::floating_point T>
+    GCodeSink& operator<<(const T value)
+    {
+        fmt::format_to(std::back_inserter(buffer_), "{:.6f}", value);
+        return commit();
+    }
+
+    GCodeSink& operator<<(const LayerIndex layer_nr)
+    {
+        return *this << layer_nr.value;
+    }
+
+    GCodeSink& operator<<(const Duration duration)
+    {
+        return *this << duration.value_;
+    }
+
+    GCodeSink& operator<<(const MMtoStream coord)
+    {
+        char digits[24];
+        const char* end = writeInt2mm(coord.value, digits);
+        buffer_.append(digits, static_cast<size_t>(end - digits));
+        return commit();
+    }
+
+    GCodeSink& operator<<(const PrecisionedDouble number)
+    {
+        char digits[400];
+        const char* end = writeDoubleToBuffer(number.precision, number.value, digits);
+        buffer_.append(digits, static_cast<size_t>(end - digits));
+        return commit();
+    }
+
+    /*!
+     * Hand all the g-code written so far to the implementation.
+     */
+    virtual void flush();
+
+protected:
+    /*!
+     * \param chunk_size The amount of buffered g-code (in bytes) from which it is handed to the implementation. With a chunk size of
+     * zero, every write is passed through directly.
+     */
+    explicit GCodeSink(const size_t chunk_size);
+
+    /*!
+     * Write out or take over a chunk of g-code.
+     *
+     * The buffer is cleared afterwards. Implementations that take ownership of the g-code can swap the buffer out, in which case a
+     * new one is allocated.
+     * \param gcode The buffered g-code.
+     */
+    virtual void consume(std::string& gcode) = 0;
+
+private:
+    GCodeSink& commit()
+    {
+        if (buffer_.size() >= chunk_size_)
+        {
+            drain();
+        }
+        return *this;
+    }
+
+    /*!
+     * Hand the buffered g-code to the implementation, and get a new buffer ready.
+     */
+    void drain();
+
+    void reserveBuffer();
+
+    size_t chunk_size_;
+    std::string buffer_;
+};
+
+/*!
+ * Sink passing all g-code through to a std::ostream, which does its own buffering.
+ */
+class StreamGCodeSink : public GCodeSink
+{
+public:
+    explicit StreamGCodeSink(std::ostream* stream);
+
+    ~StreamGCodeSink() override;
+
+    void flush() override;
+
+protected:
+    void consume(std::string& gcode) override;
+
+private:
+    std::ostream* stream_;
+};
+
+/*!
+ * Sink writing the g-code to a file in large chunks, without any buffering of the C library in between, so that every chunk is a
+ * single write to the file.
+ */
+class FileGCodeSink : public GCodeSink
+{
+public:
+    static constexpr size_t chunk_size = 1024 * 1024;
+
+    explicit FileGCodeSink(const std::filesystem::path& path);
+
+    ~FileGCodeSink() override;
+
+    /*!
+     * Whether the file could be opened for writing.
+     */
+    bool isOpen() const;
+
+protected:
+    void consume(std::string& gcode) override;
+
+private:
+    std::FILE* file_;
+    bool write_failed_{ false }; //!< To only report the first failed write.
+};
+
+/*!
+ * Sink keeping the g-code in memory until it is taken, e.g. to be moved into a message to the front-end without copying it.
+ */
+class BufferGCodeSink : public GCodeSink
+{
+public:
+    BufferGCodeSink();
+
+    ~BufferGCodeSink() override = default;
+
+    /*!
+     * Take ownership of all the g-code written since the last time this was called.
+     */
+    std::string take();
+
+protected:
+    void consume(std::string& gcode) override;
+
+private:
+    std::string taken_;
+};
+
+} // namespace cura
+
+#endif // GCODE_SINK_H
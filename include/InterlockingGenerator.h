@@ -5,11 +5,11 @@
 #define INTERLOCKING_GENERATOR_H
 
 #include <cassert>
-#include <unordered_set>
 #include <vector>
 
 #include "geometry/PointMatrix.h"
 #include "geometry/Polygon.h"
+#include "utils/VoxelBitGrid.h"
 #include "utils/VoxelUtils.h"
 
 namespace cura
@@ -114,16 +114,25 @@ protected:
      * Expand the meshes into each other where they need it, namely when a thin strip of material needs to be attached.
      * \param has_all_meshes Only do this special handling if there's actually microstructure nearby that needs to be adhered to.
      */
-    void handleThinAreas(const std::unordered_set<GridPoint3>& has_all_meshes) const;
+    void handleThinAreas(const VoxelBitGrid& has_all_meshes) const;
+
+    /*!
+     * Create a voxel grid which is large enough to hold all the (dilated) shell voxels of both models.
+     *
+     * \param layer_regions The rotated regions occupied by both models, as computed by computeUnionedVolumeRegions.
+     * \return An empty grid.
+     */
+    VoxelBitGrid createEmptyGrid(const std::vector<Shape>& layer_regions) const;
 
     /*!
      * Compute the voxels overlapping with the shell of both models.
      * This includes the walls, but also top/bottom skin.
      *
      * \param kernel The dilation kernel to give the returned voxel shell more thickness
+     * \param empty_grid An empty grid covering both models, see createEmptyGrid.
      * \return The shell voxels for mesh a and those for mesh b
      */
-    std::vector<std::unordered_set<GridPoint3>> getShellVoxels(const DilationKernel& kernel) const;
+    std::vector<VoxelBitGrid> getShellVoxels(const DilationKernel& kernel, const VoxelBitGrid& empty_grid) const;
 
     /*!
      * Compute the voxels overlapping with the shell of some layers.
@@ -131,9 +140,9 @@ protected:
      *
      * \param layers The layer outlines for which to compute the shell voxels
      * \param kernel The dilation kernel to give the returned voxel shell more thickness
-     * \param[out] cells The output cells which elong to the shell
+     * \param[out] cells The output cells which belong to the shell. Layers are processed in parallel.
      */
-    void addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, std::unordered_set<GridPoint3>& cells) const;
+    void addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, VoxelBitGrid& cells) const;
 
     /*!
      * Compute the regions occupied by both models.
@@ -155,7 +164,7 @@ protected:
      * \param cells The cells where we want to apply the interlocking structure.
      * \param layer_regions The total volume of the two meshes combined (and small gaps closed)
      */
-    void applyMicrostructureToOutlines(const std::unordered_set<GridPoint3>& cells, const std::vector<Shape>& layer_regions) const;
+    void applyMicrostructureToOutlines(const VoxelBitGrid& cells, const std::vector<Shape>& layer_regions) const;
 
     static const coord_t ignored_gap_ = 100u; //!< Distance between models to be considered next to each other so that an interlocking structure will be generated there
 
@@ -13,6 +13,7 @@
 #include "geometry/LinesSet.h"
 #include "geometry/OpenLinesSet.h"
 #include "geometry/Polygon.h"
+#include "geometry/ShapeEdgeIndex.h"
 #include "pathPlanning/GCodePath.h"
 #include "pathPlanning/NozzleTempInsert.h"
 #include "pathPlanning/TimeMaterialEstimates.h"
@@ -25,8 +26,10 @@
 #include <gtest/gtest_prod.h> //Friend tests, so that they can inspect the privates.
 #endif
 
+#include <deque>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -68,6 +71,23 @@ public:
         Ratio speed_ratio;
     };
 
+    /*!
+     * The regions of the layer below that support the walls of a part of this layer, see \ref getSupportedRegions.
+     */
+    struct SupportedRegions
+    {
+        std::vector<const Shape*> sources; //!< The outlines and support areas of the layer below that the regions are made of
+        coord_t half_outer_wall_width;
+        Shape outlines_below; //!< The sources, without the parts that are narrower than the outer wall as they will not be printed
+        Shape fully_supported_region; //!< The outlines below, shrunk by half the outer wall width
+        std::map<coord_t, Shape> expanded_regions; //!< The fully supported region expanded by each of the distances requested so far
+
+        /*!
+         * Make sure that the fully supported region is expanded by each of the distances, computing all missing ones in one go.
+         */
+        void expand(const std::vector<coord_t>& distances);
+    };
+
     const PathConfigStorage configs_storage_; //!< The line configs for this layer for each feature type
     const coord_t z_;
     coord_t final_travel_z_;
@@ -152,12 +172,17 @@ private:
     Comb* comb_;
     coord_t comb_move_inside_distance_; //!< Whenever using the minimum boundary for combing it tries to move the coordinates inside by this distance after calculating the combing.
     Shape bridge_wall_mask_; //!< The regions of a layer part that are not supported, used for bridging
+    ShapeEdgeIndex bridge_wall_mask_index_; //!< The edges of bridge_wall_mask_, to test each wall segment against it without visiting all edges
     std::vector<OverhangMask> overhang_masks_; //!< The regions of a layer part where the walls overhang, calculated for multiple overhang angles. The latter is the most
                                                //!< overhanging. For a visual explanation of the result, see doc/gradual_overhang_speed.svg
+    std::vector<ShapeEdgeIndex> overhang_mask_indices_; //!< The edges of the supported region of each of the overhang_masks_
     Shape seam_overhang_mask_; //!< The regions of a layer part where the walls overhang, specifically as defined for the seam
 
     Shape roofing_mask_; //!< The regions of a layer part where the walls are exposed to the air above
+    ShapeEdgeIndex roofing_mask_index_; //!< The edges of roofing_mask_
     Shape flooring_mask_; //!< The regions of a layer part where the walls are exposed to the air below
+    ShapeEdgeIndex flooring_mask_index_; //!< The edges of flooring_mask_
+    std::deque<SupportedRegions> supported_regions_; //!< The regions supported by the layer below, for each selection of areas below that parts rest on
 
     bool currently_overhanging_{ false }; //!< Indicates whether the last extrusion move was overhanging
     coord_t current_overhang_length_{ 0 }; //!< When doing consecutive overhanging moves, this is the current accumulated overhanging length
@@ -338,6 +363,15 @@ public:
      */
     void setBridgeWallMask(const Shape& polys);
 
+    /*!
+     * Get the regions supported by some of the outlines and support areas of the layer below. They are computed only once for all parts of
+     * this layer that rest on the same areas.
+     *
+     * \param sources The areas of the layer below that the part rests on, always collected in the same order.
+     * \param half_outer_wall_width Half the line width of the outer wall of the part.
+     */
+    SupportedRegions& getSupportedRegions(std::vector<const Shape*> sources, const coord_t half_outer_wall_width);
+
     /*!
      * Set overhang_masks.
      *
@@ -4,6 +4,9 @@
 #ifndef MESH_GROUP_H
 #define MESH_GROUP_H
 
+#include <optional>
+#include <vector>
+
 #include "mesh.h"
 #include "utils/NoCopy.h"
 
@@ -21,6 +24,15 @@ class Matrix4x3D;
 class MeshGroup
 {
 public:
+    /*!
+     * A mesh which is a copy of another mesh in the group, only translated horizontally.
+     */
+    struct MeshCopy
+    {
+        size_t original_idx; //!< The index of the mesh this is a copy of, which is not a copy itself.
+        Point2LL offset; //!< The translation from the original mesh to the copy.
+    };
+
     MeshGroup() = default;
 
     ~MeshGroup() = default;
@@ -51,6 +63,16 @@ public:
      * shrinkage while sticking to the build plate.
      */
     void scaleFromBottom(const Ratio factor_xy, const Ratio factor_z);
+
+    /*!
+     * Find the meshes that have the same vertices, faces and settings as an
+     * earlier mesh in the group, and only differ by a horizontal translation.
+     *
+     * Such copies slice to the translated slices of their original. Textured
+     * meshes are never considered copies.
+     * \return For each mesh, the original it is a copy of, if any.
+     */
+    std::vector<std::optional<MeshCopy>> findTranslatedCopies() const;
 };
 
 /*!
@@ -4,9 +4,11 @@
 #ifndef PATHORDERMONOTONIC_H
 #define PATHORDERMONOTONIC_H
 
+#include <algorithm>
 #include <cmath> //For std::sin() and std::cos().
-#include <unordered_map> //To track monotonic sequences.
-#include <unordered_set> //To track starting points of monotonic sequences.
+#include <deque>
+#include <limits>
+#include <vector> //To track monotonic sequences.
 
 #include "PathOrder.h"
 #include "path_ordering.h"
@@ -126,83 +128,115 @@ public:
         // reasons, the ``connections`` map will sometimes link the end of one segment to the start of the next segment. This link should be ignored.
         const Point2LL perpendicular = turn90CCW(monotonic_vector_); // To project on to detect adjacent lines.
 
-        std::unordered_set<Path*> connected_lines; // Lines that are reachable from one of the starting lines through its connections.
-        std::unordered_set<Path*> starting_lines; // Starting points of a linearly connected segment.
-        std::unordered_map<Path*, Path*> connections; // For each polyline, which polyline it overlaps with, closest in the projected order.
+        // From here on, the polylines are identified by their index in the sorted polylines vector.
+        std::vector<size_t> polyline_indices(this->paths_.size(), no_line_); // For each path, where it is in the polylines vector.
+        for (size_t polyline_idx = 0; polyline_idx < polylines.size(); polyline_idx++)
+        {
+            polyline_indices[static_cast<size_t>(polylines[polyline_idx] - this->paths_.data())] = polyline_idx;
+        }
+        const auto index_of = [this, &polyline_indices](const Path* path)
+        {
+            return polyline_indices[static_cast<size_t>(path - this->paths_.data())];
+        };
 
-        for (auto polyline_it = polylines.begin(); polyline_it != polylines.end(); polyline_it++)
+        std::vector<bool> connected_lines(polylines.size(), false); // Lines that are reachable from one of the starting lines through its connections.
+        std::vector<bool> starting_lines(polylines.size(), false); // Starting points of a linearly connected segment.
+        std::vector<size_t> connections(polylines.size(), no_line_); // For each polyline, which polyline it overlaps with, closest in the projected order.
+        std::vector<bool> in_polystring(polylines.size(), false); // Lines in the string of polylines that is currently being connected.
+
+        for (size_t polyline_idx = 0; polyline_idx < polylines.size(); polyline_idx++)
         {
-            if (connections.contains(*polyline_it)) // Already connected this one through a polyline.
+            if (connections[polyline_idx] != no_line_) // Already connected this one through a polyline.
             {
                 continue;
             }
             // First find out if this polyline is part of a string of polylines.
-            std::deque<Path*> polystring = findPolylineString(*polyline_it, line_bucket_grid, monotonic_vector_);
+            const std::deque<Path*> polystring_paths = findPolylineString(polylines[polyline_idx], line_bucket_grid, monotonic_vector_);
 
             // If we're part of a string of polylines, connect up the whole string and mark all of them as being connected.
-            if (polystring.size() > 1)
+            if (polystring_paths.size() > 1)
             {
-                starting_lines.insert(polystring[0]);
+                std::vector<size_t> polystring;
+                polystring.reserve(polystring_paths.size());
+                for (const Path* path : polystring_paths)
+                {
+                    polystring.push_back(index_of(path));
+                    in_polystring[polystring.back()] = true;
+                }
+
+                starting_lines[polystring[0]] = true;
                 for (size_t i = 0; i < polystring.size() - 1; ++i) // Iterate over every pair of adjacent polylines in the string (so skip the last one)!
                 {
                     connections[polystring[i]] = polystring[i + 1];
-                    connected_lines.insert(polystring[i + 1]);
+                    connected_lines[polystring[i + 1]] = true;
 
                     // Even though we chain polylines, we still want to find lines that they overlap with.
                     // The strings of polylines may still have weird shapes which interweave with other strings of polylines or loose lines.
                     // So when a polyline string comes into contact with other lines, we still want to guarantee their order.
                     // So here we will look for which lines they come into contact with, and thus mark those as possible starting points, so that they function as a new junction.
-                    const std::vector<Path*> overlapping_lines = getOverlappingLines(std::find(polylines.begin(), polylines.end(), polystring[i]), perpendicular, polylines);
-                    for (Path* overlapping_line : overlapping_lines)
+                    const std::vector<Path*> overlapping_lines = getOverlappingLines(polylines.begin() + static_cast<std::ptrdiff_t>(polystring[i]), perpendicular, polylines);
+                    for (const Path* overlapping_line : overlapping_lines)
                     {
-                        if (std::find(polystring.begin(), polystring.end(), overlapping_line)
-                            == polystring.end()) // Mark all overlapping lines not part of the string as possible starting points.
+                        const size_t overlapping_idx = index_of(overlapping_line);
+                        if (! in_polystring[overlapping_idx]) // Mark all overlapping lines not part of the string as possible starting points.
                         {
-                            starting_lines.insert(overlapping_line);
-                            starting_lines.insert(polystring[i + 1]); // Also be able to re-start from this point in the string.
+                            starting_lines[overlapping_idx] = true;
+                            starting_lines[polystring[i + 1]] = true; // Also be able to re-start from this point in the string.
                         }
                     }
                 }
+
+                for (const size_t string_idx : polystring)
+                {
+                    in_polystring[string_idx] = false;
+                }
             }
             else // Not a string of polylines, but simply adjacent line segments.
             {
-                if (! connected_lines.contains(*polyline_it)) // Nothing connects to this line yet.
+                if (! connected_lines[polyline_idx]) // Nothing connects to this line yet.
                 {
-                    starting_lines.insert(*polyline_it); // This is a starting point then.
+                    starting_lines[polyline_idx] = true; // This is a starting point then.
                 }
-                const std::vector<Path*> overlapping_lines = getOverlappingLines(polyline_it, perpendicular, polylines);
+                const std::vector<Path*> overlapping_lines = getOverlappingLines(polylines.begin() + static_cast<std::ptrdiff_t>(polyline_idx), perpendicular, polylines);
                 if (overlapping_lines.size() == 1) // If we're not a string of polylines, but adjacent to only one other polyline, create a sequence of polylines.
                 {
-                    connections[*polyline_it] = overlapping_lines[0];
-                    if (connected_lines.contains(overlapping_lines[0])) // This line was already connected to.
+                    const size_t overlapping_idx = index_of(overlapping_lines[0]);
+                    connections[polyline_idx] = overlapping_idx;
+                    if (connected_lines[overlapping_idx]) // This line was already connected to.
                     {
-                        starting_lines.insert(overlapping_lines[0]); // Multiple lines connect to it, so we must be able to start there.
+                        starting_lines[overlapping_idx] = true; // Multiple lines connect to it, so we must be able to start there.
                     }
                     else
                     {
-                        connected_lines.insert(overlapping_lines[0]);
+                        connected_lines[overlapping_idx] = true;
                     }
                 }
                 else // Either 0 (the for loop terminates immediately) or multiple overlapping lines. For multiple lines we need to mark all of them a starting position.
                 {
-                    for (Path* overlapping_line : overlapping_lines)
+                    for (const Path* overlapping_line : overlapping_lines)
                     {
-                        starting_lines.insert(overlapping_line);
+                        starting_lines[index_of(overlapping_line)] = true;
                     }
                 }
             }
         }
 
         // Order the starting points of each segments monotonically. This is the order in which to print each segment.
-        std::vector<Path*> starting_lines_monotonic;
-        starting_lines_monotonic.resize(starting_lines.size());
-        std::partial_sort_copy(
-            starting_lines.begin(),
-            starting_lines.end(),
+        std::vector<size_t> starting_lines_monotonic;
+        for (size_t polyline_idx = 0; polyline_idx < polylines.size(); polyline_idx++)
+        {
+            if (starting_lines[polyline_idx])
+            {
+                starting_lines_monotonic.push_back(polyline_idx);
+            }
+        }
+        std::stable_sort(
             starting_lines_monotonic.begin(),
             starting_lines_monotonic.end(),
-            [this](Path* a, Path* b)
+            [this, &polylines](const size_t a_idx, const size_t b_idx)
             {
+                const Path* a = polylines[a_idx];
+                const Path* b = polylines[b_idx];
                 const coord_t a_start_projection = dot(a->converted_->front(), monotonic_vector_);
                 const coord_t a_end_projection = dot(a->converted_->back(), monotonic_vector_);
                 const coord_t a_projection_min = std::min(a_start_projection, a_end_projection); // The projection of a path is the endpoint furthest back of the two endpoints.
@@ -220,26 +254,21 @@ public:
 
         // Now that we have the segments of overlapping lines, and know in which order to print the segments, print segments in monotonic order.
         Point2LL current_pos = this->start_point_;
-        for (Path* line : starting_lines_monotonic)
+        std::vector<size_t> checked_connections(polylines.size(), no_line_); // For each line, the starting line of the sequence in which its connection was iterated over
+        for (const size_t starting_line : starting_lines_monotonic)
         {
-            optimizeClosestStartPoint(*line, current_pos);
-            reordered.push_back(*line); // Plan the start of the sequence to be printed next!
-            auto connection = connections.find(line);
-
-            std::unordered_map<Path*, Path*> checked_connections; // Which connections have already been iterated over
-            auto checked_connection = checked_connections.find(line);
+            size_t line = starting_line;
+            optimizeClosestStartPoint(*polylines[line], current_pos);
+            reordered.push_back(*polylines[line]); // Plan the start of the sequence to be printed next!
 
-            while (connection != connections.end() // Stop if the sequence ends
-                   && starting_lines.find(connection->second) == starting_lines.end() // or if we hit another starting point.
-                   && (checked_connection == checked_connections.end()
-                       || checked_connection->second != connection->second)) // or if we have already checked the connection (to avoid falling into a cyclical connection)
+            while (connections[line] != no_line_ // Stop if the sequence ends
+                   && ! starting_lines[connections[line]] // or if we hit another starting point.
+                   && checked_connections[line] != starting_line) // or if we have already checked the connection (to avoid falling into a cyclical connection)
             {
-                checked_connections.insert({ connection->first, connection->second });
-                line = connection->second;
-                optimizeClosestStartPoint(*line, current_pos);
-                reordered.push_back(*line); // Plan this line in, to be printed next!
-                connection = connections.find(line);
-                checked_connection = checked_connections.find(line);
+                checked_connections[line] = starting_line;
+                line = connections[line];
+                optimizeClosestStartPoint(*polylines[line], current_pos);
+                reordered.push_back(*polylines[line]); // Plan this line in, to be printed next!
             }
         }
 
@@ -491,6 +520,11 @@ protected:
      */
     constexpr static coord_t monotonic_vector_resolution_ = 1000;
 
+    /*!
+     * Placeholder for the index of a polyline, when there is no polyline.
+     */
+    constexpr static size_t no_line_ = std::numeric_limits<size_t>::max();
+
 private:
     /*!
      * Predicate to check if a nearby path is okay for polylines to connect
@@ -4,11 +4,13 @@
 #ifndef SKIRT_BRIM_H
 #define SKIRT_BRIM_H
 
+#include <optional>
 #include <variant>
 
 #include "ExtruderTrain.h"
 #include "settings/EnumSettings.h"
 #include "sliceDataStorage.h"
+#include "utils/AABB.h"
 #include "utils/Coord_t.h"
 
 namespace cura
@@ -83,6 +85,21 @@ private:
         coord_t gap_; //!< The gap between the part and the first brim/skirt line
     };
 
+    /*!
+     * A group of parts on the first layer whose brims can't reach the brims of any other parts, with the state of generating their
+     * primary brim. Clusters are generated independently of each other.
+     */
+    struct Cluster
+    {
+        AABB reach; //!< The area that the brims of these parts can cover
+        std::vector<Outline> starting_outlines; //!< Per extruder, the starting outlines of these parts
+        std::vector<Shape> allowed_areas_per_extruder; //!< Per extruder, the allowed areas within the reach
+        Shape previously_covered_area; //!< The area within the reach that was covered before the primary brim, by models or otherwise
+        std::vector<std::vector<MixedLinesSet>> skirt_brim; //!< Per extruder and per inset, the brim lines of these parts
+        Shape covered_area; //!< The area covered by the brim lines of these parts, not yet merged into a single shape
+        std::vector<coord_t> added_length_per_offset; //!< Per planned offset, the length of the brim lines it added for these parts
+    };
+
     /*!
      * Defines an order on offsets (potentially from different extruders) based on how far the offset is from the original outline.
      */
@@ -101,6 +118,9 @@ private:
     size_t first_used_extruder_nr_; //!< The first extruder which is used
     int skirt_brim_extruder_nr_; //!< The extruder with which the skirt/brim is printed or -1 if printed with both
     std::vector<ExtruderConfig> extruders_configs_; //!< The brim setup for each extruder
+    bool generate_per_cluster_{ true }; //!< Whether to generate the primary brim per cluster of parts, see \ref generateClusteredPrimaryBrim
+
+    friend class SkirtBrimTest;
 
 public:
     /*!
@@ -148,6 +168,36 @@ private:
      */
     std::vector<coord_t> generatePrimaryBrim(std::vector<Offset>& all_brim_offsets, Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder);
 
+    /*!
+     * Group the starting outlines into clusters of parts whose brims can't reach each other.
+     *
+     * \param all_brim_offsets The planned offsets, which refer to the starting outlines.
+     * \param covered_area The area covered before the primary brim, which is cropped to the reach of each cluster.
+     * \param allowed_areas_per_extruder The allowed areas of all parts, which are cropped to the reach of each cluster.
+     * \return The clusters, or fewer than two clusters if all brims may touch each other.
+     */
+    std::vector<Cluster>
+        clusterStartingOutlines(const std::vector<Offset>& all_brim_offsets, const Shape& covered_area, const std::vector<Shape>& allowed_areas_per_extruder) const;
+
+    /*!
+     * Generate the planned offsets of the primary brim for each cluster of parts separately and in parallel, and merge the resulting brim
+     * lines into the storage.
+     *
+     * The result is the same as that of generating all offsets for all parts at once, because the brim of one cluster only ever affects
+     * the allowed areas within its own reach. Only the order of the lines differs: the lines of each cluster are added after those of the
+     * clusters before it.
+     *
+     * \param all_brim_offsets The planned offsets to perform.
+     * \param[in,out] covered_area The area of the first layer covered by model or generated brim lines.
+     * \param[in,out] allowed_areas_per_extruder The allowed areas, which may still overlap with \p covered_area, like they may for the first
+     * line of the brim. Afterwards they exclude everything that is covered.
+     * \return The length of the brim lines added by each of the planned offsets, or nothing if the parts can't be split into clusters
+     * or if extra offsets to satisfy the minimal length would need to be interleaved with the planned offsets. In that case nothing is
+     * changed.
+     */
+    std::optional<std::vector<coord_t>>
+        generateClusteredPrimaryBrim(const std::vector<Offset>& all_brim_offsets, Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder);
+
     /*!
      * Generate the brim inside the ooze shield and draft shield
      *
@@ -185,17 +235,32 @@ private:
     Shape getInternalHoleExclusionArea(const Shape& outline, const int extruder_nr) const;
 
     /*!
-     * Generate a brim line with offset parameters given by \p offset from the \p starting_outlines and store it in the \ref storage.
+     * Generate a brim line with offset parameters given by \p offset from the \p starting_outlines and store it in \p result.
      *
-     * \warning Has side effects on \p covered_area, \p allowed_areas_per_extruder and \p total_length
+     * \warning Has side effects on \p newly_covered_area and \p allowed_areas_per_extruder
      *
      * \param offset The parameters with which to perform the offset
-     * \param[in,out] covered_area The total area covered by the brims (and models) on the first layer.
-     * \param[in,out] allowed_areas_per_extruder The difference between the machine areas and the \p covered_area
+     * \param extruder_brim The brim lines generated so far for the extruder of the offset, per inset, to offset from
+     * \param[in,out] newly_covered_area The area covered by the new brim line is added to this, without merging it with what is in there
+     * already. The caller merges it when it needs the covered area.
+     * \param[in,out] allowed_areas_per_extruder The difference between the machine areas and the area covered by the brims (and models)
      * \param[out] result Where to store the resulting brim line
      * \return The length of the added lines
      */
-    coord_t generateOffset(const Offset& offset, Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder, MixedLinesSet& result);
+    coord_t generateOffset(
+        const Offset& offset,
+        const std::vector<MixedLinesSet>& extruder_brim,
+        Shape& newly_covered_area,
+        std::vector<Shape>& allowed_areas_per_extruder,
+        MixedLinesSet& result);
+
+    /*!
+     * Remove an area from the allowed areas of all used extruders.
+     *
+     * \param covered_area The area to remove.
+     * \param[in,out] allowed_areas_per_extruder The allowed areas to remove it from.
+     */
+    void excludeFromAllowedAreas(const Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder) const;
 
     /*!
      * Generate a skirt of extruders which don't yet comply with the minimum length requirement.
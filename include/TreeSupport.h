@@ -8,6 +8,7 @@
 #include "TreeSupportBaseCircle.h"
 #include "TreeSupportElement.h"
 #include "TreeSupportEnums.h"
+#include "TreeSupportMoveBounds.h"
 #include "TreeSupportSettings.h"
 #include "boost/functional/hash.hpp" // For combining hashes
 #include "geometry/Polygon.h"
@@ -113,7 +114,7 @@ private:
      * \param move_bounds[out] Storage for the influence areas.
      * \param storage[in] Background storage, required for adding roofs.
      */
-    void generateInitialAreas(const SliceMeshStorage& mesh, std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage);
+    void generateInitialAreas(const SliceMeshStorage& mesh, TreeSupportMoveBounds& move_bounds, SliceDataStorage& storage);
 
 
     /*!
@@ -207,15 +208,17 @@ private:
      * \param to_model_areas[out] Influence areas that do not have to reach the buildplate. This has overlap with new_layer_data, as areas that can reach the buildplate are also
      * considered valid areas to the model. This redundancy is required if a to_buildplate influence area is allowed to merge with a to model influence area. \param
      * influence_areas[out] Area than can reach all further up support points. No assurance is made that the buildplate or the model can be reached in accordance to the
-     * user-supplied settings. \param bypass_merge_areas[out] Influence areas ready to be added to the layer below that do not need merging. \param last_layer[in] Influence areas
-     * of the current layer. \param layer_idx[in] Number of the current layer. \param mergelayer[in] Will the merge method be called on this layer. This information is required as
-     * some calculation can be avoided if they are not required for merging.
+     * user-supplied settings. \param bypass_merge_areas[out] Influence areas ready to be added to the layer below that do not need merging, in the order of their parents in
+     * \p last_layer. \param move_bounds[in,out] The storage the influence areas that bypass merging are allocated in. \param last_layer[in] Influence areas of the current layer.
+     * \param layer_idx[in] Number of the current layer. \param mergelayer[in] Will the merge method be called on this layer. This information is required as some calculation can
+     * be avoided if they are not required for merging.
      */
     void increaseAreas(
         PropertyAreasUnordered& to_bp_areas,
         PropertyAreas& to_model_areas,
         PropertyAreas& influence_areas,
         std::vector<TreeSupportElement*>& bypass_merge_areas,
+        TreeSupportMoveBounds& move_bounds,
         const std::vector<TreeSupportElement*>& last_layer,
         const LayerIndex layer_idx,
         const bool mergelayer);
@@ -225,7 +228,7 @@ private:
      *
      * \param move_bounds[in,out] All currently existing influence areas
      */
-    void createLayerPathing(std::vector<std::set<TreeSupportElement*>>& move_bounds);
+    void createLayerPathing(TreeSupportMoveBounds& move_bounds);
 
 
     /*!
@@ -243,14 +246,14 @@ private:
      * \param layer_idx[in] The current layer.
      * \return Should elem be deleted.
      */
-    bool setToModelContact(std::vector<std::set<TreeSupportElement*>>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx);
+    bool setToModelContact(TreeSupportMoveBounds& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx);
 
     /*!
      * \brief Set the result_on_layer point for all influence areas
      *
      * \param move_bounds[in,out] All currently existing influence areas
      */
-    void createNodesFromArea(std::vector<std::set<TreeSupportElement*>>& move_bounds);
+    void createNodesFromArea(TreeSupportMoveBounds& move_bounds);
 
     /*!
      * \brief Draws circles around result_on_layer points of the influence areas
@@ -262,7 +265,7 @@ private:
      */
     void generateBranchAreas(
         std::vector<std::pair<LayerIndex, TreeSupportElement*>>& linear_data,
-        std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons,
+        std::vector<TreeSupportElementAreas>& layer_tree_polygons,
         const std::map<TreeSupportElement*, TreeSupportElement*>& inverse_tree_order);
 
     /*!
@@ -270,7 +273,7 @@ private:
      *
      * \param layer_tree_polygons[in,out] Resulting branch areas with the layerindex they appear on.
      */
-    void smoothBranchAreas(std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons);
+    void smoothBranchAreas(std::vector<TreeSupportElementAreas>& layer_tree_polygons);
 
     /*!
      * \brief Drop down areas that do rest non-gracefully on the model to ensure the branch actually rests on something.
@@ -281,7 +284,7 @@ private:
      * \param inverse_tree_order[in] A mapping that returns the child of every influence area.
      */
     void dropNonGraciousAreas(
-        std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons,
+        std::vector<TreeSupportElementAreas>& layer_tree_polygons,
         const std::vector<std::pair<LayerIndex, TreeSupportElement*>>& linear_data,
         std::vector<std::vector<std::pair<LayerIndex, Shape>>>& dropped_down_areas,
         const std::map<TreeSupportElement*, TreeSupportElement*>& inverse_tree_order);
@@ -308,7 +311,7 @@ private:
      * \param move_bounds[in] All currently existing influence areas
      * \param storage[in,out] The storage where the support should be stored.
      */
-    void drawAreas(std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage);
+    void drawAreas(TreeSupportMoveBounds& move_bounds, SliceDataStorage& storage);
 
     /*!
      * \brief Settings with the indexes of meshes that use these settings.
@@ -358,6 +358,11 @@ struct TreeSupportElement
      */
     std::vector<Point2LL> additional_ovalization_targets_;
 
+    /*!
+     * \brief Orders the element among all influence areas, independent of where it is allocated.
+     * Will only be set when the element is inserted into TreeSupportMoveBounds, and will be 0 before!
+     */
+    size_t id_ = 0;
 
     bool operator==(const TreeSupportElement& other) const
     {
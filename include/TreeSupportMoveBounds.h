@@ -0,0 +1,146 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef TREESUPPORTMOVEBOUNDS_H
+#define TREESUPPORTMOVEBOUNDS_H
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "TreeSupportElement.h"
+#include "geometry/Shape.h"
+#include "settings/types/LayerIndex.h"
+
+namespace cura
+{
+
+/*!
+ * \brief Orders influence areas by their id, so that the order does not depend on where they were allocated.
+ */
+struct TreeSupportElementIdLess
+{
+    bool operator()(const TreeSupportElement* a, const TreeSupportElement* b) const
+    {
+        return a->id_ < b->id_;
+    }
+};
+
+/*!
+ * \brief Hashes influence areas by their id, so that iterating over a hash map of them doesn't depend on where they were allocated.
+ */
+struct TreeSupportElementIdHash
+{
+    size_t operator()(const TreeSupportElement* element) const
+    {
+        return std::hash<size_t>()(element->id_);
+    }
+};
+
+using TreeSupportElementSet = std::set<TreeSupportElement*, TreeSupportElementIdLess>;
+using TreeSupportElementAreas = std::unordered_map<TreeSupportElement*, Shape, TreeSupportElementIdHash>;
+
+/*!
+ * \brief The influence areas of all layers of a support tree mesh group, and the storage they are allocated in.
+ *
+ * Influence areas and their areas are allocated in chunks per layer, and are only freed all at once when the move bounds are destroyed. Removing an
+ * element from a layer doesn't free it, so pointers to it from other elements stay valid.
+ *
+ * The elements of each layer are ordered by an id that is handed out when they are inserted, so that the elements are visited in the same order
+ * every time the same model is sliced.
+ */
+class TreeSupportMoveBounds
+{
+public:
+    explicit TreeSupportMoveBounds(const size_t layer_count)
+        : layers_(layer_count)
+        , element_arenas_(layer_count)
+        , area_arenas_(layer_count)
+    {
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return layers_.size();
+    }
+
+    TreeSupportElementSet& operator[](const size_t layer_idx)
+    {
+        return layers_[layer_idx];
+    }
+
+    const TreeSupportElementSet& operator[](const size_t layer_idx) const
+    {
+        return layers_[layer_idx];
+    }
+
+    /*!
+     * \brief Allocate a new element for a layer. It is not part of that layer until it is inserted.
+     *
+     * Allocating for different layers at the same time is safe, but allocating for the same layer from multiple threads has to be synchronized.
+     */
+    template<typename... Args>
+    TreeSupportElement* createElement(const LayerIndex layer_idx, Args&&... args)
+    {
+        return element_arenas_[layer_idx].emplace(std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Allocate the area of an element on a layer. The same thread safety applies as for \ref createElement.
+     */
+    Shape* createArea(const LayerIndex layer_idx, Shape area)
+    {
+        return area_arenas_[layer_idx].emplace(std::move(area));
+    }
+
+    /*!
+     * \brief Add an element to a layer, ordered after all elements that were inserted before it.
+     *
+     * Not thread safe, as the order of insertion determines the order of the elements.
+     */
+    void insert(const LayerIndex layer_idx, TreeSupportElement* element)
+    {
+        element->id_ = next_id_++;
+        layers_[layer_idx].emplace(element);
+    }
+
+private:
+    /*!
+     * \brief Allocates items in chunks that never grow, so that the items never move.
+     */
+    template<typename T>
+    class Arena
+    {
+    public:
+        template<typename... Args>
+        T* emplace(Args&&... args)
+        {
+            if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity())
+            {
+                // Layers with few elements are common, so start small and grow the chunks with the amount of items allocated so far.
+                const size_t chunk_size = std::clamp(item_count_, min_chunk_size, max_chunk_size);
+                chunks_.emplace_back();
+                chunks_.back().reserve(chunk_size);
+            }
+            item_count_++;
+            return &chunks_.back().emplace_back(std::forward<Args>(args)...);
+        }
+
+    private:
+        static constexpr size_t min_chunk_size = 4;
+        static constexpr size_t max_chunk_size = 256;
+
+        std::vector<std::vector<T>> chunks_;
+        size_t item_count_ = 0;
+    };
+
+    std::vector<TreeSupportElementSet> layers_;
+    std::vector<Arena<TreeSupportElement>> element_arenas_;
+    std::vector<Arena<Shape>> area_arenas_;
+    size_t next_id_ = 1;
+};
+
+} // namespace cura
+
+#endif // TREESUPPORTMOVEBOUNDS_H
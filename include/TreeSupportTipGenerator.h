@@ -41,7 +41,7 @@ public:
     void generateTips(
         SliceDataStorage& storage,
         const SliceMeshStorage& mesh,
-        std::vector<std::set<TreeSupportElement*>>& move_bounds,
+        TreeSupportMoveBounds& move_bounds,
         std::vector<Shape>& additional_support_areas,
         std::vector<std::vector<FakeRoofArea>>& placed_fake_roof_areas);
 
@@ -133,7 +133,8 @@ private:
 
     /*!
      * \brief Add a point as a tip
-     * \param move_bounds[out] The storage for the tips.
+     * \param move_bounds[in,out] The storage the tips are allocated in.
+     * \param new_tips[out] The added tips per layer, not yet inserted into \p move_bounds.
      * \param p[in] The point that will be added and its LineStatus.
      * \param dtt[in] The distance to top the added tip will have.
      * \param insert_layer[in] The layer the tip will be on.
@@ -142,7 +143,8 @@ private:
      * \param skip_ovalisation[in] Whether the tip may be ovalized when drawn later.
      */
     void addPointAsInfluenceArea(
-        std::vector<std::set<TreeSupportElement*>>& move_bounds,
+        TreeSupportMoveBounds& move_bounds,
+        std::vector<std::vector<TreeSupportElement*>>& new_tips,
         std::pair<Point2LL, LineStatus> p,
         size_t dtt,
         LayerIndex insert_layer,
@@ -154,7 +156,8 @@ private:
 
     /*!
      * \brief Add all points of a line as a tip
-     * \param move_bounds[out] The storage for the tips.
+     * \param move_bounds[in,out] The storage the tips are allocated in.
+     * \param new_tips[out] The added tips per layer, not yet inserted into \p move_bounds.
      * \param lines[in] The lines of which points will be added.
      * \param roof_tip_layers[in] Amount of layers the tip should be drawn as roof.
      * \param insert_layer_idx[in] The layer the tip will be on.
@@ -162,7 +165,8 @@ private:
      * \param dont_move_until[in] Until which dtt the branch should not move if possible.
      */
     void addLinesAsInfluenceAreas(
-        std::vector<std::set<TreeSupportElement*>>& move_bounds,
+        TreeSupportMoveBounds& move_bounds,
+        std::vector<std::vector<TreeSupportElement*>>& new_tips,
         std::vector<TreeSupportTipGenerator::LineInformation> lines,
         size_t roof_tip_layers,
         LayerIndex insert_layer_idx,
@@ -172,11 +176,11 @@ private:
 
     /*!
      * \brief Remove tips that should not have been added in the first place.
-     * \param move_bounds[in,out] The already added tips
+     * \param new_tips[in,out] The already added tips
      * \param storage[in] Background storage, required for adding roofs.
      * \param additional_support_areas[in] Areas that should have been roofs, but are now support, as they would not generate any lines as roof.
      */
-    void removeUselessAddedPoints(std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage, std::vector<Shape>& additional_support_areas);
+    void removeUselessAddedPoints(std::vector<std::vector<TreeSupportElement*>>& new_tips, SliceDataStorage& storage, std::vector<Shape>& additional_support_areas);
 
     /*!
      * \brief Contains config settings to avoid loading them in every function. This was done to improve readability of the code.
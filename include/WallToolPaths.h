@@ -122,6 +122,51 @@ protected:
     static void simplifyToolPaths(std::vector<VariableWidthLines>& toolpaths, const Settings& settings);
 
 private:
+    friend class WallsComputationTest;
+    friend class MechanicalPartWallTestFixture;
+
+    /*!
+     * Find the regions of an outline that are thinner than twice the radius,
+     * other than its convex corners that aren't sharper than the transitioning
+     * angle. Elsewhere the walls are offsets of the outline.
+     * \param outline The outline, with the material on the left.
+     * \param radius Half the thickness from which the outline gets the maximum
+     * number of walls without any transitions.
+     * \param transitioning_angle Corners sharper than this get transitions.
+     * \return The thin regions.
+     */
+    static Shape findThinRegions(const Shape& outline, const coord_t radius, const AngleRadians transitioning_angle);
+
+    /*!
+     * Generate the walls of an outline as offsets of it, at the locations and
+     * with the widths that the beading strategy gives the walls of the
+     * thickest parts of an outline. This includes the 0-width marker of the
+     * inner contour. The walls go the same way as those of the skeletal
+     * trapezoidation.
+     * \param toolpaths The toolpaths to add the closed walls to, binned by
+     * inset_idx.
+     */
+    static void generateOffsetWalls(const Shape& outline, const BeadingStrategy& beading_strategy, const coord_t max_bead_count, std::vector<VariableWidthLines>& toolpaths);
+
+    /*!
+     * Cut the toolpaths at the border of an area and keep only the parts of
+     * them inside or outside of it. The width is interpolated where the lines
+     * are cut.
+     * \param toolpaths The toolpaths to clip, binned by inset_idx.
+     * \param keep_inside Whether to keep the parts inside the area, or those
+     * outside of it.
+     * \return The junctions at which the lines were cut.
+     */
+    static std::vector<ExtrusionJunction> clipToolPaths(std::vector<VariableWidthLines>& toolpaths, const Shape& area, const bool keep_inside);
+
+    /*!
+     * Whether the lines cut on both sides of a border meet each other, so
+     * that they can be stitched together: every cut has a cut of the same
+     * wall with the same width nearby on the other side.
+     * \param max_distance How far apart the cuts of the same wall may be.
+     */
+    static bool wallsConnect(const std::vector<ExtrusionJunction>& cuts, const std::vector<ExtrusionJunction>& other_cuts, const coord_t max_distance);
+
     const Shape& outline_; //<! A reference to the outline polygon that is the designated area
     coord_t bead_width_0_; //<! The nominal or first extrusion line width with which libArachne generates its walls
     coord_t bead_width_x_; //<! The subsequently extrusion line width with which libArachne generates its walls if WallToolPaths was called with the nominal_bead_width Constructor
@@ -139,6 +184,7 @@ private:
     const Settings& settings_;
     int layer_idx_;
     SectionType section_type_;
+    bool offset_fast_path_{ true }; //<! Whether to generate the walls outside of the thin regions as offsets. Only turned off to compare.
 };
 } // namespace cura
 
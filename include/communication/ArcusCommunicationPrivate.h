@@ -5,9 +5,12 @@
 #define ARCUSCOMMUNICATIONPRIVATE_H
 #ifdef ARCUS
 
-#include <sstream> //For ostringstream.
+#include <deque>
+#include <memory>
+#include <utility>
 
 #include "ArcusCommunication.h" //We're adding a subclass to this.
+#include "GCodeSink.h"
 #include "SliceDataStruct.h"
 #include "settings/types/LayerIndex.h"
 
@@ -30,6 +33,31 @@ public:
      */
     std::shared_ptr<proto::LayerOptimized> getOptimizedLayerById(LayerIndex::value_type layer_nr);
 
+    /*
+     * Mark the optimised layer data for a specific layer as complete. It is
+     * sent as soon as the layer view data moves on to another layer.
+     * \param layer_nr The layer number of the completed layer.
+     */
+    void completeOptimizedLayer(LayerIndex::value_type layer_nr);
+
+    /*
+     * Send the optimised layer data for a specific layer and stop buffering it,
+     * if that layer is complete.
+     * \param layer_nr The layer number of the layer that the layer view data
+     * moves away from.
+     */
+    void sendCompletedOptimizedLayer(LayerIndex::value_type layer_nr);
+
+    /*
+     * Send the optimised layer data of a layer to the front-end.
+     *
+     * This applies back-pressure: while more than
+     * max_optimized_layer_bytes_in_flight of layer data is still queued in the
+     * socket, this waits for the socket to send it.
+     * \param layer The layer data to send.
+     */
+    void sendOptimizedLayer(std::shared_ptr<proto::LayerOptimized> layer);
+
     /*
      * Reads the global settings from a Protobuf message.
      *
@@ -50,11 +78,20 @@ public:
     Arcus::Socket* socket; //!< Socket to send data to.
     size_t object_count; //!< Number of objects that need to be sliced.
     std::string temp_gcode_file; //!< Temporary buffer for the g-code.
-    std::ostringstream gcode_output_stream; //!< The stream to write g-code to.
+    std::shared_ptr<BufferGCodeSink> gcode_output; //!< The sink to write g-code to, which is taken over by the g-code messages.
 
     SliceDataStruct<cura::proto::Layer> sliced_layers;
     SliceDataStruct<cura::proto::LayerOptimized> optimized_layers;
 
+    /*
+     * The optimised layers that were handed to the socket, and their size in
+     * bytes. The socket releases the messages once they are sent, which
+     * expires the pointers.
+     */
+    std::deque<std::pair<std::weak_ptr<const proto::LayerOptimized>, size_t>> optimized_layers_in_flight;
+    size_t optimized_layer_bytes_in_flight; //!< Sum of the sizes of optimized_layers_in_flight.
+    static constexpr size_t max_optimized_layer_bytes_in_flight = 64 * 1024 * 1024;
+
     int last_sent_progress; //!< Last sent progress promille (1/1000th). Used to not send duplicate messages with the same promille.
 
     /*
@@ -4,7 +4,9 @@
 #ifndef COMMANDLINE_H
 #define COMMANDLINE_H
 
+#include <deque>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <rapidjson/document.h> //Loading JSON documents to get settings from them.
 #include <string> //To store the command line arguments.
@@ -36,6 +38,14 @@ public:
      */
     CommandLine(const std::vector<std::string>& arguments);
 
+    /*
+     * \brief Construct a new communicator that slices a batch of jobs, one
+     * after another.
+     * \param jobs The command line arguments of each job, as if the
+     * application was called with them.
+     */
+    explicit CommandLine(std::vector<std::vector<std::string>> jobs);
+
     /*
      * \brief Indicate that we're beginning to send g-code.
      * This does nothing to the command line.
@@ -143,6 +153,21 @@ public:
      */
     void sliceNext() override;
 
+    /*
+     * \brief Read the jobs of a batch manifest.
+     *
+     * Every non-empty line of the manifest is a job, consisting of the
+     * arguments that would follow `CuraEngine slice` on the command line,
+     * separated by whitespace. Arguments containing whitespace can be put in
+     * double quotes. Lines starting with # are comments.
+     * \param manifest_filename The location of the manifest.
+     * \param executable The name of the executable, to put in front of the
+     * arguments of each job.
+     * \return The arguments of each job, or nothing if the manifest could not
+     * be read.
+     */
+    static std::optional<std::vector<std::vector<std::string>>> readJobManifest(const std::filesystem::path& manifest_filename, const std::string& executable);
+
 protected:
     /*
      * \brief The command line arguments that the application was called with.
@@ -150,8 +175,40 @@ protected:
     std::vector<std::string> arguments_;
 
 private:
+    /*
+     * \brief A parsed JSON file, with the time the file was last modified when
+     * it was parsed.
+     */
+    struct CachedDocument
+    {
+        std::filesystem::file_time_type last_write_time;
+        std::shared_ptr<const rapidjson::Document> document;
+    };
+
     std::vector<std::filesystem::path> search_directories_;
 
+    /*
+     * \brief The search directories from the environment, that every slice
+     * starts with.
+     */
+    std::vector<std::filesystem::path> default_search_directories_;
+
+    /*
+     * \brief The arguments of the slices that are yet to be started after the
+     * current one.
+     */
+    std::deque<std::vector<std::string>> queued_jobs_;
+
+    /*
+     * \brief The JSON files that have been parsed, by their absolute path.
+     *
+     * Every extruder train of a machine inherits from the same files, and all
+     * slices of a batch generally use the same machine, so most files are
+     * requested many times. They are parsed again only when they were modified
+     * in the meantime.
+     */
+    std::unordered_map<std::string, CachedDocument> document_cache_;
+
     /*
      * The last progress update that we output to stdcerr.
      */
@@ -169,6 +226,17 @@ private:
      */
     int loadJSON(const std::filesystem::path& json_filename, Settings& settings, bool force_read_parent = false, bool force_read_nondefault = false);
 
+    /*
+     * \brief Get the parsed contents of a JSON file, from the cache if it was
+     * parsed before.
+     * \param json_filename The location of the JSON file.
+     * \param document Output parameter for the parsed document.
+     * \return Error code. If it's 0, the document was loaded. If it's 1, the
+     * file could not be opened. If it's 2, there was a syntax error in the
+     * file.
+     */
+    int readJSONDocument(const std::filesystem::path& json_filename, std::shared_ptr<const rapidjson::Document>& document);
+
     /*
      * \brief Load a JSON document and store the settings inside it.
      * \param document The JSON document to load the settings from.
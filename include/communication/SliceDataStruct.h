@@ -7,6 +7,7 @@
 
 #include <memory> //To store pointers to slice data.
 #include <unordered_map> //To store the slice data by layer.
+#include <unordered_set> //To store which layers are complete.
 
 namespace cura
 {
@@ -39,6 +40,11 @@ public:
      * The slice data itself, which can be of any type.
      */
     std::unordered_map<int, std::shared_ptr<T>> slice_data;
+
+    /*
+     * The layers in slice_data that won't get any more data, so that they can be sent as soon as possible.
+     */
+    std::unordered_set<int> completed_layers;
 };
 
 }
@@ -8,10 +8,12 @@
 #ifdef BUILD_TESTS
 #include <gtest/gtest_prod.h> //To allow tests to use protected members.
 #endif
+#include <memory>
 #include <optional>
 #include <sstream> // for stream.str()
 #include <stdio.h>
 
+#include "GCodeSink.h"
 #include "TravelAntiOozing.h"
 #include "geometry/Point2LL.h"
 #include "settings/EnumSettings.h"
@@ -138,7 +140,7 @@ private:
     std::string machine_name_;
     std::string slice_uuid_; //!< The UUID of the current slice.
 
-    std::ostream* output_stream_;
+    std::shared_ptr<GCodeSink> output_; //!< Where the g-code is written to.
     std::string new_line_;
 
     double current_e_value_; //!< The last E value written to gcode (in mm or mm^3)
@@ -257,6 +259,14 @@ public:
 
     void setLayerNr(const LayerIndex& layer_nr);
 
+    /*!
+     * Write the g-code to the given sink from now on.
+     */
+    void setOutput(std::shared_ptr<GCodeSink> output);
+
+    /*!
+     * Write the g-code to the given stream from now on.
+     */
     void setOutputStream(std::ostream* stream);
 
     bool getExtruderIsUsed(const int extruder_nr) const; //!< return whether the extruder has been used throughout printing all meshgroup up till now
@@ -423,7 +433,7 @@ public:
     bool needPrimeBlob() const;
 
     /*
-     *  Function is used to write the content of output_stream to the gcode file
+     *  Function is used to write the content of the output buffer to the gcode file
      */
     void flushOutputStream();
 
@@ -0,0 +1,152 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GEOMETRY_POINTS_KERNELS_H
+#define GEOMETRY_POINTS_KERNELS_H
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "geometry/Point2LL.h"
+#include "utils/Coord_t.h"
+
+namespace cura::kernels
+{
+
+/*!
+ * \brief The instruction sets for which the geometry kernels are implemented.
+ *
+ * Every kernel gives exactly the same result for every instruction set. The vectorized implementations fall back to the scalar one
+ * for inputs they can't handle exactly, e.g. coordinates too large for their intermediate values.
+ */
+enum class InstructionSet
+{
+    SCALAR,
+    AVX2,
+};
+
+/*!
+ * Whether the CPU that we're running on supports an instruction set, and the engine was compiled with an implementation for it.
+ */
+[[nodiscard]] bool isSupported(const InstructionSet instruction_set);
+
+/*!
+ * The fastest instruction set supported by this CPU. This is detected once, on first use.
+ */
+[[nodiscard]] InstructionSet activeInstructionSet();
+
+/*!
+ * The signed area of a closed polygon, positive if it winds counter-clockwise.
+ *
+ * Unlike \p ClipperLib::Area, the cross products are summed exactly in integers.
+ */
+[[nodiscard]] double area(std::span<const Point2LL> points, const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * The sum of the lengths of the segments between consecutive points, each rounded the same way as \ref vSize.
+ * \param closed Whether to include the segment from the last point back to the first.
+ */
+[[nodiscard]] coord_t length(std::span<const Point2LL> points, const bool closed, const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * Extend a bounding box so that it includes all points.
+ * \param min [in, out] The minimum X and Y coordinates, which are only ever decreased.
+ * \param max [in, out] The maximum X and Y coordinates, which are only ever increased.
+ */
+void bounds(std::span<const Point2LL> points, Point2LL& min, Point2LL& max, const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * Whether a point lies inside a closed polygon, with exactly the same result as \p ClipperLib::PointInPolygon.
+ * \return 0 if the point is outside, 1 if it is inside, -1 if it lies on the border.
+ */
+[[nodiscard]] int pointInPolygon(const Point2LL& point, std::span<const Point2LL> polygon, const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * Same as the other \ref pointInPolygon, but on the coordinates of the polygon stored as separate arrays. See \ref PointsSoAView.
+ */
+[[nodiscard]] int pointInPolygon(
+    const Point2LL& point,
+    std::span<const coord_t> xs,
+    std::span<const coord_t> ys,
+    const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * A single step of \ref pointInPolygon: whether a point lies on the edge from (\p x0, \p y0) to (\p x1, \p y1), or the edge crosses
+ * the horizontal ray to the right of the point. The results of all edges of a polygon combine into the result of \ref pointInPolygon.
+ * \return -1 if the point lies on the edge, 1 if the edge crosses the ray, 0 otherwise.
+ */
+[[nodiscard]] int crossEdge(const Point2LL& point, const coord_t x0, const coord_t y0, const coord_t x1, const coord_t y1);
+
+/*!
+ * Find the point on a closed polygon closest to \p from, with exactly the same result as \p PolygonUtils::findClosest without a
+ * penalty function: the first segment with the smallest distance wins, and the first vertex is used if no segment is closer to it.
+ * \return The closest location and the index of the vertex starting the segment on which it lies.
+ */
+[[nodiscard]] std::pair<Point2LL, size_t> closestOnPolygon(const Point2LL& from, std::span<const Point2LL> polygon, const InstructionSet instruction_set = activeInstructionSet());
+
+/*!
+ * \brief Structure-of-arrays view on the coordinates of a list of points.
+ *
+ * The view refers to the points, and only copies their coordinates into separate X and Y arrays when a query needs them. This pays off
+ * when the same points are queried many times, e.g. when testing many points against the same polygon. The points must stay alive
+ * and unchanged for as long as the view is used.
+ */
+class PointsSoAView
+{
+public:
+    explicit PointsSoAView(std::span<const Point2LL> points)
+        : points_(points)
+    {
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return points_.size();
+    }
+
+    [[nodiscard]] std::span<const coord_t> xs() const
+    {
+        materialize();
+        return xs_;
+    }
+
+    [[nodiscard]] std::span<const coord_t> ys() const
+    {
+        materialize();
+        return ys_;
+    }
+
+    /*!
+     * Whether a point lies inside the polygon formed by the points.
+     * \return 0 if the point is outside, 1 if it is inside, -1 if it lies on the border.
+     */
+    [[nodiscard]] int pointInPolygon(const Point2LL& point) const
+    {
+        return kernels::pointInPolygon(point, xs(), ys());
+    }
+
+private:
+    void materialize() const
+    {
+        if (xs_.size() == points_.size())
+        {
+            return;
+        }
+        xs_.resize(points_.size());
+        ys_.resize(points_.size());
+        for (size_t point_idx = 0; point_idx < points_.size(); ++point_idx)
+        {
+            xs_[point_idx] = points_[point_idx].X;
+            ys_[point_idx] = points_[point_idx].Y;
+        }
+    }
+
+    std::span<const Point2LL> points_;
+    mutable std::vector<coord_t> xs_; //!< The X coordinates, once materialized.
+    mutable std::vector<coord_t> ys_; //!< The Y coordinates, once materialized.
+};
+
+} // namespace cura::kernels
+
+#endif // GEOMETRY_POINTS_KERNELS_H
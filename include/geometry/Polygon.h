@@ -5,6 +5,7 @@
 #define GEOMETRY_POLYGON_H
 
 #include "geometry/ClosedPolyline.h"
+#include "geometry/PointsKernels.h"
 
 namespace cura
 {
@@ -83,7 +84,7 @@ public:
 
     [[nodiscard]] double area() const
     {
-        return ClipperLib::Area(getPoints());
+        return kernels::area(getPoints());
     }
 
     [[nodiscard]] Point2LL centerOfMass() const;
@@ -89,6 +89,15 @@ public:
      */
     [[nodiscard]] Shape offset(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const;
 
+    /*!
+     * Offset the shape by each of a number of distances, for instance to get the concentric regions around the same shape.
+     *
+     * The results are the same as those of \ref offset for each of the distances, but the shape is only unioned and prepared for offsetting
+     * once, and equal distances are only computed once.
+     * \return The offset shape for each of the distances, in the same order as the distances.
+     */
+    [[nodiscard]] std::vector<Shape> offsetNested(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const;
+
     /*!
      * Intersect polylines with the area covered by the shape.
      *
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GEOMETRY_SHAPE_EDGE_INDEX_H
+#define GEOMETRY_SHAPE_EDGE_INDEX_H
+
+#include <vector>
+
+#include "geometry/Point2LL.h"
+#include "utils/Coord_t.h"
+
+namespace cura
+{
+
+class Shape;
+
+/*!
+ * \brief Spatial index over the edges of a shape, to test many points and line segments against the same shape.
+ *
+ * The edges are sorted into horizontal bands of equal height, so that a query only evaluates the edges of the bands it overlaps instead
+ * of all edges of the shape. The queries evaluate each edge with the same predicates as their linear counterparts on \ref Shape and
+ * \ref PolygonUtils, so that they give the same results.
+ *
+ * The index keeps a copy of the edges, so it stays valid when the shape it was built from changes or goes away.
+ */
+class ShapeEdgeIndex
+{
+public:
+    /*!
+     * Create an index of an empty shape.
+     */
+    ShapeEdgeIndex() = default;
+
+    /*!
+     * Index all edges of a shape, including the closing edge of each polygon.
+     */
+    explicit ShapeEdgeIndex(const Shape& shape);
+
+    [[nodiscard]] bool empty() const;
+
+    /*!
+     * Same as \ref Shape::inside.
+     * \param p The point to check
+     * \param border_result What to return when the point lies exactly on the border
+     * \return Whether the point lies inside an odd number of polygons of the shape.
+     */
+    [[nodiscard]] bool inside(const Point2LL& p, const bool border_result = false) const;
+
+    /*!
+     * Same as \ref PolygonUtils::polygonCollidesWithLineSegment on the shape: whether any edge of the shape touches the line segment.
+     */
+    [[nodiscard]] bool collidesWithLineSegment(const Point2LL& start, const Point2LL& end) const;
+
+    /*!
+     * Same as \ref Shape::intersectionsWithSegment, except for the order of the results.
+     * \return The parameters along the segment from \p start to \p end at which it crosses an edge of the shape, in no particular order.
+     */
+    [[nodiscard]] std::vector<float> intersectionsWithSegment(const Point2LL& start, const Point2LL& end) const;
+
+private:
+    struct Edge
+    {
+        Point2LL start;
+        Point2LL end;
+        Point2LL min; //!< The lower corner of the bounding box of the edge
+        Point2LL max; //!< The upper corner of the bounding box of the edge
+        bool bounds_area; //!< Whether the polygon of this edge has at least 3 vertices, otherwise it doesn't count for inside-tests
+    };
+
+    /*!
+     * The band that contains a Y coordinate, clamped to the existing bands.
+     */
+    [[nodiscard]] size_t bandAt(const coord_t y) const;
+
+    /*!
+     * Visit every edge whose bounding box overlaps the bounding box of a segment, grown by \p margin, exactly once.
+     * \param visitor Called with each edge. When it returns true, the search stops.
+     * \return Whether the visitor stopped the search.
+     */
+    template<typename Visitor>
+    bool visitEdgesNear(const Point2LL& start, const Point2LL& end, const coord_t margin, Visitor&& visitor) const;
+
+    std::vector<Edge> edges_;
+    Point2LL min_; //!< The lower corner of the bounding box of all edges
+    Point2LL max_; //!< The upper corner of the bounding box of all edges
+    coord_t band_height_ = 1;
+    std::vector<size_t> band_starts_; //!< Per band, where its edges start in \ref band_edges_, plus the end of the last band
+    std::vector<size_t> band_edges_; //!< The indices of the edges overlapping each band, per band sorted by their smallest X coordinate
+};
+
+} // namespace cura
+
+#endif // GEOMETRY_SHAPE_EDGE_INDEX_H
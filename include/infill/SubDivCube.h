@@ -4,30 +4,37 @@
 #ifndef INFILL_SUBDIVCUBE_H
 #define INFILL_SUBDIVCUBE_H
 
+#include <vector>
+
 #include "geometry/OpenLinesSet.h"
 #include "geometry/Point2LL.h"
 #include "geometry/Point3LL.h"
 #include "geometry/Point3Matrix.h"
 #include "geometry/PointMatrix.h"
+#include "geometry/Shape.h"
 #include "settings/types/LayerIndex.h"
-#include "settings/types/Ratio.h"
 
 namespace cura
 {
 
-class Polygon;
 class SliceMeshStorage;
 
+/*!
+ * Octree of subdivided cubes for the cubic subdivision infill.
+ *
+ * The cubes are stored in a single array in depth-first order, so that no cube needs pointers to its children. For each recursion
+ * depth, the cubes are also indexed by the height of their center, so that generating the lines of a layer only visits the cubes
+ * that have lines on that layer.
+ */
 class SubDivCube
 {
 public:
     /*!
-     * Constructor for SubDivCube. Recursively calls itself eight times to flesh out the octree.
+     * Build the octree of subdivided cubes. The subtrees of the eight children of the top-level cube are built in parallel.
      * \param mesh contains infill layer data and settings
-     * \param my_center the center of the cube
-     * \param depth the recursion depth of the cube (0 is most recursed)
+     * \param infill_origin the center of the top-level cube
      */
-    SubDivCube(SliceMeshStorage& mesh, Point3LL& center, size_t depth);
+    SubDivCube(const SliceMeshStorage& mesh, const Point2LL& infill_origin);
 
     /*!
      * Precompute the octree of subdivided cubes
@@ -36,21 +43,13 @@ public:
     static void precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill_origin);
 
     /*!
-     * Generates the lines of subdivision of the specific cube at the specific layer. It recursively calls itself, so it ends up drawing all the subdivision lines of sub-cubes too.
+     * Generates the lines of subdivision of all cubes at the specific layer.
      * \param z the specified layer height
      * \param result (output) The resulting lines
      */
-    void generateSubdivisionLines(const coord_t z, OpenLinesSet& result);
+    void generateSubdivisionLines(const coord_t z, OpenLinesSet& result) const;
 
 private:
-    /*!
-     * Generates the lines of subdivision of the specific cube at the specific layer. It recursively calls itself, so it ends up drawing all the subdivision lines of sub-cubes too.
-     * \param z the specified layer height
-     * \param result (output) The resulting lines
-     * \param directional_line_groups Array of 3 times a polylines. Used to keep track of line segments that are all pointing the same direction for line segment combining
-     */
-    void generateSubdivisionLines(const coord_t z, OpenLinesSet (&directional_line_groups)[3]);
-
     struct CubeProperties
     {
         coord_t side_length; //!< side length of cubes
@@ -60,6 +59,44 @@ private:
         coord_t max_line_offset; //!< maximum line offsets. This is the maximum distance at which subdivision lines should be drawn from the 2d cube center.
     };
 
+    struct Cube
+    {
+        Point3LL center; //!< center location of the cube in absolute coordinates
+        size_t depth; //!< the recursion depth of the cube (0 is most recursed)
+    };
+
+    /*!
+     * Add a cube and, recursively, all of its subdivisions to \p cubes, in depth-first order.
+     * \param layer_infill_areas the infill areas of all parts, per layer
+     * \param center the center of the cube
+     * \param depth the recursion depth of the cube (0 is most recursed)
+     * \param[out] cubes the cubes of the subtree
+     */
+    void addSubtree(const std::vector<Shape>& layer_infill_areas, const Point3LL& center, const size_t depth, std::vector<Cube>& cubes) const;
+
+    /*!
+     * Get the center of one of the eight children of a cube.
+     * \param center the center of the parent cube
+     * \param depth the recursion depth of the parent cube
+     * \param child_idx which of the children
+     */
+    Point3LL childCenter(const Point3LL& center, const size_t depth, const size_t child_idx) const;
+
+    /*!
+     * Get the radius of the sphere enclosing the children of a cube, within which the infill border must lie for the children to be
+     * subdivided.
+     * \param depth the recursion depth of the parent cube
+     */
+    coord_t childRadius(const size_t depth) const;
+
+    /*!
+     * Generates the lines of subdivision of the specific cube at the specific layer.
+     * \param cube the cube to draw the lines of
+     * \param z the specified layer height
+     * \param directional_line_groups Array of 3 times a polylines. Used to keep track of line segments that are all pointing the same direction for line segment combining
+     */
+    void generateSubdivisionLines(const Cube& cube, const coord_t z, OpenLinesSet (&directional_line_groups)[3]) const;
+
     /*!
      * Rotates a point 120 degrees about the origin.
      * \param target the point to rotate.
@@ -70,41 +107,41 @@ private:
      * Rotates a point to align it with the orientation of the infill.
      * \param target the point to rotate.
      */
-    static void rotatePointInitial(Point2LL& target);
+    void rotatePointInitial(Point2LL& target) const;
 
     /*!
      * Determines if a described theoretical cube should be subdivided based on if a sphere that encloses the cube touches the infill mesh.
-     * \param mesh contains infill layer data and settings
+     * \param layer_infill_areas the infill areas of all parts, per layer
      * \param center the center of the described cube
      * \param radius the radius of the enclosing sphere
      * \return the described cube should be subdivided
      */
-    static bool isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, coord_t radius);
+    bool isValidSubdivision(const std::vector<Shape>& layer_infill_areas, const Point3LL& center, const coord_t radius) const;
 
     /*!
      * Finds the distance to the infill border at the specified layer from the specified point.
-     * \param mesh contains infill layer data and settings
+     * \param layer_infill_areas the infill areas of all parts, per layer
      * \param layer_nr the number of the specified layer
      * \param location the location of the specified point
      * \param[out] distance2 the squared distance to the infill border
      * \return Code 0: outside, 1: inside, 2: boundary does not exist at specified layer
      */
-    static coord_t distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point2LL& location, coord_t* distance2);
+    static coord_t distanceFromPointToMesh(const std::vector<Shape>& layer_infill_areas, const LayerIndex layer_nr, const Point2LL& location, coord_t* distance2);
 
     /*!
      * Adds the defined line to the specified polygons. It assumes that the specified polygons are all parallel lines. Combines line segments with touching ends closer than
      * epsilon. \param[out] group the polygons to add the line to \param from the first endpoint of the line \param to the second endpoint of the line
      */
-    void addLineAndCombine(OpenLinesSet& group, Point2LL from, Point2LL to);
-
-    size_t depth_; //!< the recursion depth of the cube (0 is most recursed)
-    Point3LL center_; //!< center location of the cube in absolute coordinates
-    std::array<std::shared_ptr<SubDivCube>, 8> children_; //!< pointers to this cube's eight octree children
-    static std::vector<CubeProperties> cube_properties_per_recursion_step_; //!< precomputed array of basic properties of cubes based on recursion depth.
-    static Ratio radius_multiplier_; //!< multiplier for the bounding radius when determining if a cube should be subdivided
-    static Point3Matrix rotation_matrix_; //!< The rotation matrix to get from axis aligned cubes to cubes standing on a corner point aligned with the infill_angle
-    static PointMatrix infill_rotation_matrix_; //!< Horizontal rotation applied to infill
-    static coord_t radius_addition_; //!< addition to the bounding radius when determining if a cube should be subdivided
+    static void addLineAndCombine(OpenLinesSet& group, Point2LL from, Point2LL to);
+
+    std::vector<CubeProperties> cube_properties_per_recursion_step_; //!< precomputed array of basic properties of cubes based on recursion depth.
+    Point3Matrix rotation_matrix_; //!< The rotation matrix to get from axis aligned cubes to cubes standing on a corner point aligned with the infill_angle
+    PointMatrix infill_rotation_matrix_; //!< Horizontal rotation applied to infill
+    coord_t radius_addition_; //!< addition to the bounding radius when determining if a cube should be subdivided
+    coord_t layer_height_; //!< the layer height of the mesh, to find the layer at some height
+
+    std::vector<Cube> cubes_; //!< all cubes of the octree, in depth-first order
+    std::vector<std::vector<size_t>> cubes_by_z_; //!< for each recursion depth, the indices of its cubes sorted by the height of their center
 };
 
 } // namespace cura
@@ -203,6 +203,26 @@ public:
      */
     bool canInterlock() const;
 
+    /*!
+     * Get a hash of the geometry of this mesh, which doesn't change when the
+     * mesh is translated horizontally.
+     *
+     * \return The hash of the vertex positions relative to the minimum X and Y
+     * of the mesh, and of the faces.
+     */
+    size_t getShapeHash() const;
+
+    /*!
+     * Get the horizontal translation which turns \p original into this mesh,
+     * if this mesh has exactly the same vertices and faces apart from that
+     * translation.
+     *
+     * \param original The mesh to compare to.
+     * \return The translation from \p original to this mesh, or nothing if
+     * this mesh is not a translated copy.
+     */
+    std::optional<Point2LL> getTranslationFrom(const Mesh& original) const;
+
 private:
     mutable bool has_disconnected_faces; //!< Whether it has been logged that this mesh contains disconnected faces
     mutable bool has_overlapping_faces; //!< Whether it has been logged that this mesh contains overlapping faces
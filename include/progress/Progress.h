@@ -9,6 +9,7 @@
 #include <string>
 #include <string_view>
 
+#include "utils/Tracer.h"
 #include "utils/gettime.h"
 
 namespace cura
@@ -54,10 +55,12 @@ private:
         0.1 // FINISH  = 6
     };
 
-    static constexpr std::array<std::string_view, N_PROGRESS_STAGES> names{ "start", "slice", "layerparts", "inset+skin", "support", "export", "process" };
+    static constexpr std::array<std::string_view, N_PROGRESS_STAGES>
+        names{ "start", "split multimaterial", "slice", "layerparts", "inset+skin", "support", "export", "process" };
     static std::array<double, N_PROGRESS_STAGES> accumulated_times; //!< Time past before each stage
     static double total_timing; //!< An estimate of the total time
     static std::optional<LayerIndex> first_skipped_layer; //!< The index of the layer for which we skipped time reporting
+    static std::optional<TraceSpan> stage_span; //!< The trace span of the current stage, when tracing is enabled
     /*!
      * Give an estimate between 0 and 1 of how far the process is.
      *
@@ -94,11 +94,13 @@ private:
     coord_t threshold_;
 
     /*!
-     * Stores the found slopes of each face using the same index.
+     * Stores the found slopes of each face, together with the z range of the
+     * face at the same index. The faces are sorted by their minimum z, so that
+     * the faces which start below a layer form a prefix of these vectors.
      */
     std::vector<double> face_slopes_;
-    std::vector<int> face_min_z_values_;
-    std::vector<int> face_max_z_values_;
+    std::vector<coord_t> face_min_z_values_;
+    std::vector<coord_t> face_max_z_values_;
     const MeshGroup* meshgroup_;
 
     /*!
@@ -112,7 +114,8 @@ private:
     void calculateLayers();
 
     /*!
-     * Calculates the slopes for each triangle in the mesh.
+     * Calculates the slopes for each triangle in the mesh, and sorts them by
+     * the minimum z of the triangles.
      * These are uses later by calculateLayers to find the steepest triangle in a potential layer.
      */
     void calculateMeshTriangleSlopes();
@@ -96,6 +96,18 @@ public:
      */
     void setParent(Settings* new_parent);
 
+    /*!
+     * \brief Indicate whether this settings instance has the same entries as
+     * \p other, and the same parent.
+     *
+     * If so, every setting evaluates to the same value in both instances.
+     * \param other The settings to compare to.
+     * \param ignored_keys Settings of which the values are allowed to differ.
+     * \return Whether the two instances are equal, apart from the ignored
+     * settings.
+     */
+    bool hasSameEntries(const Settings& other, const std::vector<std::string>& ignored_keys = {}) const;
+
     std::unordered_map<std::string, std::string> getFlattendSettings() const;
 
     std::vector<std::string> getKeys() const;
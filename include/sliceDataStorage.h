@@ -6,7 +6,10 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "SupportInfillPart.h"
 #include "TopSurface.h"
@@ -157,6 +160,57 @@ public:
      * \return true if there is at least one ExtrusionLine at the specified wall index, false otherwise
      */
     bool hasWallAtInsetIndex(size_t inset_idx) const;
+
+    /*!
+     * Whether the part has any infill area of its own, see \ref getOwnInfillArea. This also works while the part is compressed.
+     */
+    bool hasOwnInfillArea() const;
+
+    /*!
+     * Whether any skin part of this part has a non-empty fill area of the given kind. This also works while the part is compressed.
+     * \param fill The fill area of the skin parts to check: SkinPart::skin_fill, SkinPart::roofing_fill or SkinPart::flooring_fill.
+     */
+    bool hasSkinFill(Shape SkinPart::*fill) const;
+
+    /*!
+     * Add the outline of this part to \p result. This also works while the part is compressed.
+     * \param result The collection to add the outline polygons to.
+     * \param external_polys_only Whether to only add the outermost polygon of the outline.
+     */
+    void getOutlines(Shape& result, const bool external_polys_only) const;
+
+    /*!
+     * Store the slice data of this part compactly, and free the data it was stored from.
+     *
+     * This covers the outlines, the print outline, the inner area, the skin parts, the wall toolpaths, the infill wall toolpaths, the top and
+     * bottom most surfaces and the infill areas. While the part is compressed these are empty, but \ref hasWallAtInsetIndex,
+     * \ref hasOwnInfillArea, \ref hasSkinFill and \ref getOutlines read the compressed data instead.
+     *
+     * The compressed data is kept when the part is decompressed, so compressing it again only frees the decompressed data. Changes made to the
+     * decompressed data are lost that way.
+     */
+    void compress();
+
+    /*!
+     * Restore the data that \ref compress stored compactly, exactly as it was when it was compressed.
+     */
+    void decompress();
+
+    /*!
+     * Free the decompressed data of a part that was compressed before, see \ref compress. Parts that were never compressed are left as
+     * they are, since their data can't be restored.
+     */
+    void release();
+
+    /*!
+     * \return Whether the data of the part is currently only available in compressed form, see \ref compress.
+     */
+    bool isCompressed() const;
+
+private:
+    struct Compressed;
+    std::shared_ptr<const Compressed> compressed_; //!< The data stored compactly by compress(), if the part was ever compressed.
+    bool is_decompressed_{ false }; //!< Whether the data stored in compressed_ is also available decompressed.
 };
 
 /*!
@@ -203,6 +257,21 @@ public:
      */
     void getOutlines(Shape& result, bool external_polys_only = false) const;
 
+    /*!
+     * Compress all parts of this layer, see SliceLayerPart::compress.
+     */
+    void compress();
+
+    /*!
+     * Decompress all parts of this layer, see SliceLayerPart::decompress.
+     */
+    void decompress();
+
+    /*!
+     * Free the decompressed data of all parts of this layer, see SliceLayerPart::release.
+     */
+    void release();
+
     ~SliceLayer();
 };
 
@@ -350,6 +419,14 @@ public:
      */
     bool getExtruderIsUsed(const size_t extruder_nr, const LayerIndex& layer_nr) const;
 
+    /*!
+     * Compress all layers of this mesh in parallel, see SliceLayerPart::compress.
+     *
+     * This is done once all slice data of the mesh is complete, so that it takes less memory while the rest of the slice data is generated
+     * and the layers are written one by one.
+     */
+    void compressLayers();
+
     /*!
      * Gets whether this is a printable mesh (not an infill mesh, slicing mesh,
      * etc.)
@@ -408,6 +485,12 @@ public:
     /*!
      * Get all outlines within a given layer.
      *
+     * The outlines are computed once for each combination of arguments and
+     * cached, so that repeated calls only return a reference. This is
+     * thread-safe, but the cache has to be cleared with
+     * invalidateLayerOutlines() whenever the outlines of the parts, the
+     * support, the prime tower or the raft are modified.
+     *
      * \param layer_nr The index of the layer for which to get the outlines
      * (negative layer numbers indicate the raft).
      * \param include_support Whether to include support in the outline.
@@ -415,8 +498,9 @@ public:
      * \param include_models Whether to include the models in the outline
      * \param external_polys_only Whether to disregard all hole polygons.
      * \param extruder_nr (optional) only give back outlines for this extruder (where the walls are printed with this extruder)
+     * \return The outlines, which stay valid until the next call to invalidateLayerOutlines(), or to evictLayerOutlines() for this layer
      */
-    Shape getLayerOutlines(
+    const Shape& getLayerOutlines(
         const LayerIndex layer_nr,
         const bool include_support,
         const bool include_prime_tower,
@@ -424,6 +508,21 @@ public:
         const int extruder_nr = -1,
         const bool include_models = true) const;
 
+    /*!
+     * Clear the cached results of getLayerOutlines(). This must not be called
+     * while another thread may still use a previously returned outline.
+     */
+    void invalidateLayerOutlines();
+
+    /*!
+     * Remove the cached results of getLayerOutlines() for a single layer, once
+     * that layer is written, so that the cache does not keep the outlines of
+     * every layer during the g-code export. This must not be called while
+     * another thread may still use a previously returned outline of that layer.
+     * \param layer_nr The layer of which to remove the outlines.
+     */
+    void evictLayerOutlines(const LayerIndex layer_nr);
+
     /*!
      * Get the axis-aligned bounding-box of the complete model (all meshes).
      */
@@ -445,6 +544,27 @@ public:
      */
     std::vector<bool> getExtrudersUsed(LayerIndex layer_nr) const;
 
+    /*!
+     * Decompress the layers of all meshes in the given range, to write a layer that reads them. Every call must be followed by a call to
+     * \ref releaseLayers with the same range once the data is no longer read.
+     *
+     * The layers are counted in use until then, so that processing several layers in parallel decompresses every layer only once, and frees it
+     * only once the last layer that reads it is done.
+     *
+     * \param first_layer_nr The first layer to decompress. There is nothing to decompress for the raft and filler layers.
+     * \param last_layer_nr The last layer to decompress, inclusive.
+     */
+    void decompressLayers(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr);
+
+    /*!
+     * Stop using the layers of all meshes in the given range, see \ref decompressLayers. The decompressed data of layers that are no longer
+     * in use is freed; their compressed data stays available.
+     *
+     * \param first_layer_nr The first layer to release.
+     * \param last_layer_nr The last layer to release, inclusive.
+     */
+    void releaseLayers(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr);
+
     /*!
      * Gets whether prime blob is enabled for the given extruder number.
      *
@@ -464,10 +584,63 @@ public:
     void initializePrimeTower();
 
 private:
+    //! The arguments of getLayerOutlines(), used as key of the cache
+    struct LayerOutlinesKey
+    {
+        LayerIndex layer_nr;
+        int extruder_nr;
+        bool include_support;
+        bool include_prime_tower;
+        bool external_polys_only;
+        bool include_models;
+
+        bool operator==(const LayerOutlinesKey& other) const = default;
+    };
+
+    struct LayerOutlinesKeyHash
+    {
+        size_t operator()(const LayerOutlinesKey& key) const
+        {
+            const size_t flags = (key.include_support << 0) | (key.include_prime_tower << 1) | (key.external_polys_only << 2) | (key.include_models << 3);
+            return std::hash<int64_t>()(key.layer_nr.value) ^ (std::hash<int>()(key.extruder_nr) << 4) ^ flags;
+        }
+    };
+
+    /*!
+     * How many layers that are being processed currently read a layer, see \ref decompressLayers.
+     */
+    struct LayerUse
+    {
+        std::mutex mutex;
+        size_t use_count{ 0 };
+    };
+
+    std::mutex layer_uses_mutex_; //!< Guards the size of layer_uses_, not the uses themselves.
+    std::vector<std::unique_ptr<LayerUse>> layer_uses_; //!< Created on demand, and never moved, so that each use can be locked on its own.
+
+    /*!
+     * Get the use of the layer with the given number, creating it if needed.
+     */
+    LayerUse& getLayerUse(const LayerIndex layer_nr);
+
+    mutable std::shared_mutex layer_outlines_mutex_;
+    mutable std::unordered_map<LayerOutlinesKey, Shape, LayerOutlinesKeyHash> layer_outlines_cache_; //!< Node-based, so that the returned references stay valid
+
     /*!
      * Construct the retraction_wipe_config_per_extruder
      */
     std::vector<RetractionAndWipeConfig> initializeRetractionAndWipeConfigs();
+
+    /*!
+     * Actually compute the outlines of a layer, see getLayerOutlines()
+     */
+    Shape computeLayerOutlines(
+        const LayerIndex layer_nr,
+        const bool include_support,
+        const bool include_prime_tower,
+        const bool external_polys_only,
+        const int extruder_nr,
+        const bool include_models) const;
 };
 
 } // namespace cura
@@ -5,6 +5,7 @@
 #define SUPPORT_H
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "settings/types/LayerIndex.h"
@@ -189,6 +190,23 @@ private:
      */
     static void generateSupportRoof(SliceDataStorage& storage, const SliceMeshStorage& mesh, std::vector<Shape>& global_support_areas_per_layer);
 
+    /*!
+     * \brief Compute the union of the outlines of a mesh over ranges of
+     * consecutive layers, as needed by the support roofs and bottoms.
+     *
+     * The layers are split into blocks of \p window_size layers, in which the
+     * unions from the start of the block and up to the end of the block are
+     * accumulated once (van Herk/Gil-Werman scheme). Any range that is not
+     * longer than a block is then the union of the end of one block and the
+     * start of the next, instead of a union of all its layers.
+     *
+     * \param mesh The mesh of which to stack the outlines.
+     * \param window_size The maximum number of layers in a range.
+     * \param windows The [first, last] ranges of layers to stack.
+     * \return The unioned outlines for each range of \p windows.
+     */
+    static std::vector<Shape> stackMeshOutlines(const SliceMeshStorage& mesh, const size_t window_size, const std::vector<std::pair<LayerIndex, LayerIndex>>& windows);
+
     /*!
      * \brief Generate a single layer of support interface.
      *
@@ -197,9 +215,9 @@ private:
      *
      * \param support_areas The areas where support infill is going to be
      * printed.
-     * \param mesh_outlines The outlines of the mesh above or below the layer
-     * we're generating interface for. These layers determine what areas are
-     * going to be filled with the interface.
+     * \param mesh_outlines The unioned outlines of the mesh above or below the
+     * layer we're generating interface for. These layers determine what areas
+     * are going to be filled with the interface.
      * \param safety_offset An offset applied to the result to make sure
      * everything can be printed.
      * \param outline_offset An offset applied to the result outlines.
@@ -208,7 +226,7 @@ private:
      */
     static void generateSupportInterfaceLayer(
         Shape& support_areas,
-        const Shape mesh_outlines,
+        const Shape& mesh_outlines,
         const coord_t safety_offset,
         const coord_t outline_offset,
         const double minimum_interface_area,
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_COMPRESSED_GEOMETRY_H
+#define UTILS_COMPRESSED_GEOMETRY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry/Shape.h"
+#include "utils/ExtrusionLine.h"
+
+namespace cura
+{
+
+/*!
+ * A \ref Shape stored compactly, for as long as it is not used.
+ *
+ * Each coordinate is stored as the difference with the same coordinate of the previous vertex, as a variable-length integer. Consecutive
+ * vertices are mostly less than a few millimetres apart, so most coordinates take one or two bytes instead of eight.
+ *
+ * The compression is lossless: \ref decompress gives back exactly the shape that was compressed.
+ */
+class CompressedShape
+{
+public:
+    CompressedShape() = default;
+
+    explicit CompressedShape(const Shape& shape);
+
+    [[nodiscard]] Shape decompress() const;
+
+    /*!
+     * Whether the compressed shape has no polygons, without decompressing it.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /*!
+     * The number of bytes that the compressed shape takes, not counting the object itself.
+     */
+    [[nodiscard]] size_t byteSize() const;
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+/*!
+ * Variable-width toolpaths, binned by inset index, stored compactly for as long as they are not used.
+ *
+ * The positions and widths of the junctions are stored like the vertices of a \ref CompressedShape. The perimeter index of a junction is
+ * almost always the inset index of its line, so it is stored as the difference with that.
+ *
+ * The compression is lossless: \ref decompress gives back exactly the toolpaths that were compressed.
+ */
+class CompressedToolPaths
+{
+public:
+    CompressedToolPaths() = default;
+
+    explicit CompressedToolPaths(const std::vector<VariableWidthLines>& toolpaths);
+
+    [[nodiscard]] std::vector<VariableWidthLines> decompress() const;
+
+    /*!
+     * Whether there is at least one line with the given inset index, without decompressing the toolpaths.
+     * \see SliceLayerPart::hasWallAtInsetIndex
+     */
+    [[nodiscard]] bool hasInsetIndex(size_t inset_idx) const;
+
+    /*!
+     * The number of bytes that the compressed toolpaths take, not counting the object itself.
+     */
+    [[nodiscard]] size_t byteSize() const;
+
+private:
+    std::vector<uint8_t> data_;
+    std::vector<size_t> inset_indices_; //!< The inset indices that the lines have, sorted, to answer \ref hasInsetIndex quickly.
+};
+
+} // namespace cura
+
+#endif // UTILS_COMPRESSED_GEOMETRY_H
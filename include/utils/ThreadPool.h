@@ -24,6 +24,8 @@ namespace cura
  * Consider using `parallel_for()` instead, interfacing directly with this class should be reserved to concurrency primitives.
  * ThreadPool can be described as a synchronized FIFO queue shared by a fleet of `std::thread`s.
  * Tasks have the responsibility of unlocking the queue's lock passed as an argument while they do asynchronous work.
+ *
+ * Tasks may push tasks of their own and wait for them with `help_while()`, which is how `parallel_for()` can be nested.
  */
 class ThreadPool
 {
@@ -60,8 +62,19 @@ public:
     void push(const lock_t& lock [[maybe_unused]], F&& func)
     {
         assert(lock);
-        tasks.push_back(std::forward<F>(func));
+        tasks.push_back({ next_task_sequence++, std::forward<F>(func) });
         condition.notify_one();
+        if (helpers_waiting > 0)
+        {
+            helper_condition.notify_all();
+        }
+    }
+
+    //! Returns the sequence number the next pushed task will get. Tasks are numbered in the order they are pushed.
+    size_t next_sequence(const lock_t& lock [[maybe_unused]]) const
+    {
+        assert(lock);
+        return next_task_sequence;
     }
     /*!
      * \brief Executes pending tasks while the predicates returns true
@@ -74,7 +87,7 @@ public:
         while (predicate() && ! tasks.empty()) // Order is important: predicate() might wait on an empty queue
         {
             assert(! tasks.empty());
-            task_t task = std::move(tasks.front());
+            task_t task = std::move(tasks.front().task);
             tasks.pop_front();
 
             task(lock);
@@ -82,15 +95,66 @@ public:
         }
     }
 
+    /*!
+     * \brief Executes the tasks pushed since `first_sequence` while the predicate returns true, and waits for more while there are none.
+     *
+     * Tasks are taken newest first, and tasks pushed before `first_sequence` are left to the workers. A caller waiting for its own
+     * tasks thus only helps with those tasks and the tasks they push in turn, and is never held up by unrelated work that was queued
+     * earlier. This makes it safe and cheap to wait from inside a task, without blocking a thread that could do useful work.
+     * \param first_sequence The sequence number of the first task that may be run, see `next_sequence()`.
+     * \param predicate Evaluated with the lock held. Whoever makes it false has to call `notify_helpers()`.
+     */
+    template<typename P>
+    void help_while(lock_t& lock, const size_t first_sequence, P predicate)
+    {
+        assert(lock);
+        while (predicate())
+        {
+            if (! tasks.empty() && tasks.back().sequence >= first_sequence) // The queue is sorted by sequence number, so the eligible tasks are at the back
+            {
+                task_t task = std::move(tasks.back().task);
+                tasks.pop_back();
+
+                task(lock);
+                assert(lock);
+            }
+            else
+            { // Wait for a task to complete, or for a task to push new tasks. Signaled by notify_helpers() and push()
+                helpers_waiting++;
+                helper_condition.wait(lock);
+                helpers_waiting--;
+            }
+        }
+    }
+
+    //! Wakes up the threads waiting in `help_while()`, so that they evaluate their predicate again.
+    void notify_helpers(const lock_t& lock [[maybe_unused]])
+    {
+        assert(lock);
+        if (helpers_waiting > 0)
+        {
+            helper_condition.notify_all();
+        }
+    }
+
 private:
     void worker();
 
     void join();
 
+    struct queued_task_t
+    {
+        size_t sequence;
+        task_t task;
+    };
+
     std::mutex mutex;
     std::condition_variable condition;
-    std::deque<task_t> tasks;
+    std::condition_variable helper_condition; //!< Signals threads waiting in help_while()
+    std::deque<queued_task_t> tasks;
     std::vector<std::thread> threads;
+    size_t next_task_sequence = 0;
+    size_t helpers_waiting = 0;
     bool wait_for_new_tasks;
 };
 
@@ -114,6 +178,9 @@ inline Signed distance(const Int& first, const Int& last)
  * The range of items is divided in chunks such that there is a maximum number of `chunks_per_worker` and such that
  * chunk size is a multiple of `chunk_size_factor`.
  *
+ * The loop body may itself call `parallel_for()`. The calling thread only helps with the chunks of its own loop and the tasks
+ * those push, so nested loops share the thread pool without oversubscribing it, and without one loop waiting on another.
+ *
  * \param from, to: The [inclusive, exclusive) range of iteration. Integers or random access iterators
  * \param body The loop-body, as a closure. Receives the index on invocation.
  * \param chunk_size_factor Chunk size will be a multiple of this number.
@@ -160,11 +227,11 @@ void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1,
     {
         std::decay_t<F> loop_body; // User's closure data
         size_t chunks_remaining;
-        std::condition_variable work_done = {};
     } shared_state = { std::forward<F>(loop_body), chunks };
 
     // Schedules a task per chunk on the thread pool
     lock_t lock = thread_pool->get_lock();
+    const size_t first_sequence = thread_pool->next_sequence(lock);
     T chunk_last;
     for (T chunk_first = first; chunk_first < last; chunk_first = chunk_last)
     {
@@ -179,7 +246,7 @@ void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1,
 
         thread_pool->push(
             lock,
-            [&shared_state, chunk_first, chunk_last](lock_t& th_lock)
+            [&shared_state, thread_pool, chunk_first, chunk_last](lock_t& th_lock)
             {
                 th_lock.unlock(); // Enter unsynchronized region
                 for (T i = chunk_first; i < chunk_last; ++i)
@@ -189,22 +256,19 @@ void parallel_for(T first, T last, F&& loop_body, size_t chunk_size_factor = 1,
                 th_lock.lock();
                 if (--shared_state.chunks_remaining == 0)
                 {
-                    shared_state.work_done.notify_one();
+                    thread_pool->notify_helpers(th_lock);
                 }
             });
     }
 
-    // Do work while parallel_for's tasks are running
-    thread_pool->work_while(
+    // Do work while parallel_for's tasks are running, and wait until all the tasks are completed
+    thread_pool->help_while(
         lock,
+        first_sequence,
         [&]
         {
             return shared_state.chunks_remaining > 0;
         });
-    while (shared_state.chunks_remaining > 0) // Wait until all the task are completed
-    {
-        shared_state.work_done.wait(lock);
-    }
 }
 
 /*!
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef UTILS_TRACER_H
+#define UTILS_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "utils/NoCopy.h"
+
+namespace cura
+{
+
+/*!
+ * Opt-in recorder of timing spans and counters, which are written as a Chrome trace (JSON "Trace Event Format") file that can be
+ * opened with chrome://tracing or https://ui.perfetto.dev
+ *
+ * Tracing is enabled by setting the CURAENGINE_TRACE_FILE environment variable to the path of the file to be written. Events are
+ * recorded in per-thread buffers, so that recording a span never contends on a lock. When tracing is disabled, creating a span
+ * only costs a relaxed atomic load.
+ */
+class Tracer : NoCopy
+{
+public:
+    /*!
+     * A single recorded event, either a complete span or a counter value
+     */
+    struct Event
+    {
+        char phase; //!< 'X' for a complete span, 'C' for a counter
+        std::string_view category; //!< Static string, the category (stage) of the event
+        std::string name;
+        int64_t timestamp_us; //!< Start time of the event, relative to the moment the tracer was enabled
+        int64_t duration_us; //!< Duration of a span, unused for counters
+        std::optional<int64_t> layer_nr;
+        std::optional<size_t> mesh_idx;
+        double value; //!< Value of a counter, unused for spans
+    };
+
+    /*!
+     * All events recorded by a single thread
+     */
+    struct ThreadEvents
+    {
+        size_t thread_index;
+        bool is_main_thread;
+        std::vector<Event> events;
+    };
+
+    static Tracer& getInstance();
+
+    /*!
+     * Start recording events, which will be written to the given file when calling flush()
+     */
+    void enable(const std::filesystem::path& output_file);
+
+    /*!
+     * Start recording events if the CURAENGINE_TRACE_FILE environment variable is set
+     */
+    void enableFromEnvironment();
+
+    bool isEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Get the current time in microseconds, relative to the moment the tracer was enabled
+     */
+    int64_t now() const;
+
+    /*!
+     * Record a span that has been measured by the caller, most of the time through a TraceSpan
+     */
+    void addSpan(std::string_view category, std::string name, int64_t start_us, int64_t duration_us, std::optional<int64_t> layer_nr, std::optional<size_t> mesh_idx);
+
+    /*!
+     * Record the current value of a counter, which is displayed as a graph over time
+     * \param name The name of the counter, which should be a static string
+     * \param value The current value
+     * \param layer_nr The optional index of the layer the value relates to
+     */
+    void addCounter(std::string_view name, double value, std::optional<int64_t> layer_nr = std::nullopt);
+
+    /*!
+     * Record the current resident set size of the process as a counter, when it can be measured on this platform
+     */
+    void addMemoryCounter();
+
+    /*!
+     * Write all the events recorded so far to the output file, and clear them. This should only be called when no other thread
+     * is recording events.
+     */
+    void flush();
+
+    /*!
+     * Get a copy of all the events recorded so far, per thread, e.g. to compute statistics from them. Like flush(), this should only
+     * be called when no other thread is recording events.
+     */
+    std::vector<ThreadEvents> getEvents();
+
+    /*!
+     * Get the current resident set size of the process, in bytes
+     * \return The RSS, or nullopt if it can not be measured on this platform
+     */
+    static std::optional<size_t> currentResidentSetSize();
+
+private:
+    struct ThreadBuffer
+    {
+        size_t thread_index;
+        bool is_main_thread;
+        std::vector<Event> events;
+    };
+
+    Tracer() = default;
+
+    /*!
+     * Get the buffer of the calling thread, creating it when this is the first event recorded by this thread
+     */
+    ThreadBuffer& getThreadBuffer();
+
+    std::atomic<bool> enabled_{ false };
+    std::filesystem::path output_file_;
+    std::chrono::steady_clock::time_point origin_;
+    std::thread::id main_thread_id_;
+    std::mutex buffers_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/*!
+ * RAII helper recording a span from its construction to its destruction, on the calling thread. Does nothing when tracing is
+ * disabled.
+ *
+ * \code
+ * TraceSpan span("walls", "processWalls", layer_nr, mesh_idx);
+ * \endcode
+ */
+class TraceSpan : NoCopy
+{
+public:
+    /*!
+     * \param category The category of the span, usually the pipeline stage. Must be a static string.
+     * \param name The name of the span
+     * \param layer_nr The optional index of the processed layer
+     * \param mesh_idx The optional index of the processed mesh
+     */
+    TraceSpan(std::string_view category, std::string_view name, std::optional<int64_t> layer_nr = std::nullopt, std::optional<size_t> mesh_idx = std::nullopt)
+    {
+        Tracer& tracer = Tracer::getInstance();
+        if (tracer.isEnabled())
+        {
+            category_ = category;
+            name_ = name;
+            layer_nr_ = layer_nr;
+            mesh_idx_ = mesh_idx;
+            start_us_ = tracer.now();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (start_us_ >= 0)
+        {
+            Tracer& tracer = Tracer::getInstance();
+            tracer.addSpan(category_, std::move(name_), start_us_, tracer.now() - start_us_, layer_nr_, mesh_idx_);
+        }
+    }
+
+private:
+    std::string_view category_;
+    std::string name_;
+    std::optional<int64_t> layer_nr_;
+    std::optional<size_t> mesh_idx_;
+    int64_t start_us_{ -1 }; //!< Negative when the tracer was disabled at construction
+};
+
+} // namespace cura
+
+#endif // UTILS_TRACER_H
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_VOXEL_BIT_GRID_H
+#define UTILS_VOXEL_BIT_GRID_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "utils/VoxelUtils.h"
+
+namespace cura
+{
+
+/*!
+ * Dense set of voxel cells within a bounding box, storing a single bit per cell.
+ *
+ * Compared to a hash set of cells, marking a cell is a single bit operation and combining sets is a word-wise operation. The bits
+ * of each z plane start at a new word, so that a grid covering a slab of z planes of a larger grid (see emptySlab) can be merged
+ * into the larger grid word by word. This allows filling slabs of the grid in parallel, each with their own grid.
+ */
+class VoxelBitGrid
+{
+public:
+    /*!
+     * Create an empty grid.
+     * \param min_cell The lowest cell in each dimension which the grid can hold.
+     * \param max_cell The highest cell in each dimension which the grid can hold, inclusive.
+     */
+    VoxelBitGrid(const GridPoint3& min_cell, const GridPoint3& max_cell)
+        : min_cell_(min_cell)
+        , max_cell_(max_cell)
+        , size_x_(std::max(coord_t(0), max_cell.x_ - min_cell.x_ + 1))
+        , size_y_(std::max(coord_t(0), max_cell.y_ - min_cell.y_ + 1))
+        , plane_words_((static_cast<size_t>(size_x_ * size_y_) + bits_per_word - 1) / bits_per_word)
+        , words_(plane_words_ * static_cast<size_t>(std::max(coord_t(0), max_cell.z_ - min_cell.z_ + 1)), 0)
+    {
+    }
+
+    /*!
+     * Create an empty grid with the same X and Y range as this grid, but only for a range of z planes.
+     * \param min_z The lowest z plane, which is limited to the range of this grid.
+     * \param max_z The highest z plane (inclusive), which is limited to the range of this grid.
+     */
+    VoxelBitGrid emptySlab(const coord_t min_z, const coord_t max_z) const
+    {
+        return VoxelBitGrid(GridPoint3(min_cell_.x_, min_cell_.y_, std::max(min_z, min_cell_.z_)), GridPoint3(max_cell_.x_, max_cell_.y_, std::min(max_z, max_cell_.z_)));
+    }
+
+    bool contains(const GridPoint3& cell) const
+    {
+        return cell.x_ >= min_cell_.x_ && cell.x_ <= max_cell_.x_ && cell.y_ >= min_cell_.y_ && cell.y_ <= max_cell_.y_ && cell.z_ >= min_cell_.z_ && cell.z_ <= max_cell_.z_;
+    }
+
+    /*!
+     * Add a cell to the set. Cells outside of the bounding box of the grid are ignored.
+     */
+    void set(const GridPoint3& cell)
+    {
+        assert(contains(cell) && "The bounding box of the grid should contain all cells that are added.");
+        if (! contains(cell))
+        {
+            return;
+        }
+        const size_t bit_idx = bitIndex(cell);
+        words_[bit_idx / bits_per_word] |= uint64_t(1) << (bit_idx % bits_per_word);
+    }
+
+    bool test(const GridPoint3& cell) const
+    {
+        if (! contains(cell))
+        {
+            return false;
+        }
+        const size_t bit_idx = bitIndex(cell);
+        return (words_[bit_idx / bits_per_word] >> (bit_idx % bits_per_word)) & 1;
+    }
+
+    /*!
+     * Add all cells of another grid, which has the same X and Y range as this grid, and covers the same or a smaller range of z planes.
+     */
+    VoxelBitGrid& operator|=(const VoxelBitGrid& other)
+    {
+        assert(other.min_cell_.x_ == min_cell_.x_ && other.max_cell_.x_ == max_cell_.x_ && other.min_cell_.y_ == min_cell_.y_ && other.max_cell_.y_ == max_cell_.y_);
+        assert(other.words_.empty() || (other.min_cell_.z_ >= min_cell_.z_ && other.max_cell_.z_ <= max_cell_.z_));
+        if (other.words_.empty())
+        {
+            return *this;
+        }
+        const size_t first_word = static_cast<size_t>(other.min_cell_.z_ - min_cell_.z_) * plane_words_;
+        for (size_t word_idx = 0; word_idx < other.words_.size(); ++word_idx)
+        {
+            words_[first_word + word_idx] |= other.words_[word_idx];
+        }
+        return *this;
+    }
+
+    /*!
+     * Only keep the cells which are also in another grid with the same bounding box.
+     */
+    VoxelBitGrid& operator&=(const VoxelBitGrid& other)
+    {
+        assert(other.min_cell_ == min_cell_ && other.max_cell_ == max_cell_);
+        for (size_t word_idx = 0; word_idx < words_.size(); ++word_idx)
+        {
+            words_[word_idx] &= other.words_[word_idx];
+        }
+        return *this;
+    }
+
+    /*!
+     * Remove all the cells of another grid with the same bounding box.
+     */
+    void subtract(const VoxelBitGrid& other)
+    {
+        assert(other.min_cell_ == min_cell_ && other.max_cell_ == max_cell_);
+        for (size_t word_idx = 0; word_idx < words_.size(); ++word_idx)
+        {
+            words_[word_idx] &= ~other.words_[word_idx];
+        }
+    }
+
+    /*!
+     * Get the number of cells in the set.
+     */
+    size_t count() const
+    {
+        size_t count = 0;
+        for (const uint64_t word : words_)
+        {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    /*!
+     * Call a function on every cell in the set, in order of z, then y, then x.
+     */
+    template<typename F>
+    void forEach(F&& process_cell_func) const
+    {
+        for (size_t word_idx = 0; word_idx < words_.size(); ++word_idx)
+        {
+            const coord_t z = min_cell_.z_ + static_cast<coord_t>(word_idx / plane_words_);
+            const size_t first_bit_in_plane = (word_idx % plane_words_) * bits_per_word;
+            for (uint64_t word = words_[word_idx]; word != 0; word &= word - 1)
+            {
+                const coord_t bit_in_plane = static_cast<coord_t>(first_bit_in_plane + static_cast<size_t>(std::countr_zero(word)));
+                process_cell_func(GridPoint3(min_cell_.x_ + bit_in_plane % size_x_, min_cell_.y_ + bit_in_plane / size_x_, z));
+            }
+        }
+    }
+
+private:
+    static constexpr size_t bits_per_word = 64;
+
+    size_t bitIndex(const GridPoint3& cell) const
+    {
+        return static_cast<size_t>(cell.z_ - min_cell_.z_) * plane_words_ * bits_per_word + static_cast<size_t>((cell.y_ - min_cell_.y_) * size_x_ + (cell.x_ - min_cell_.x_));
+    }
+
+    GridPoint3 min_cell_;
+    GridPoint3 max_cell_;
+    coord_t size_x_; //!< Number of cells in the X direction.
+    coord_t size_y_; //!< Number of cells in the Y direction.
+    size_t plane_words_; //!< Number of words used for each z plane.
+    std::vector<uint64_t> words_;
+};
+
+} // namespace cura
+
+#endif // UTILS_VOXEL_BIT_GRID_H
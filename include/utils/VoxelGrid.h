@@ -4,13 +4,21 @@
 #ifndef UTILS_VOXELGRID_H
 #define UTILS_VOXELGRID_H
 
-#include <execution>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
-#include <boost/unordered/concurrent_flat_map.hpp>
+#include <boost/container_hash/hash.hpp>
 
 #include "Coord_t.h"
 #include "geometry/Triangle3D.h"
+#include "utils/NoCopy.h"
 #include "utils/Point3D.h"
+#include "utils/ThreadPool.h"
 
 
 namespace cura
@@ -19,11 +27,11 @@ namespace cura
 struct AABB3D;
 
 /*!
- * Represent a voxel grid in 3D space. It is strongly optimized for huge grid with low memory consumption, and is completely thread-safe. The empty voxels are not represented,
- * only the "occupied" ones are, with a data value. The data value is currently a uint8_t but it could easily be upgraded to support anything else,
- * at the cost of a higher memory usage.
+ * Represent a voxel grid in 3D space. It is optimized for huge grids of which only a part is occupied, and is completely thread-safe. The grid is divided in bricks of
+ * 16x16x16 voxels, which are only allocated once a voxel inside them gets occupied. Inside a brick, the occupation of each voxel is stored densely as a single byte, so that
+ * looking up a voxel is a matter of indexing instead of hashing.
  */
-class VoxelGrid
+class VoxelGrid : NoCopy
 {
 public:
     /*! Local coordinates of voxels are stored on XYZ being unsigned 16-bit integers, so that we can store the whole position on a 64-bit integer. It can represent a build plate
@@ -71,6 +79,8 @@ public:
      */
     explicit VoxelGrid(const AABB3D& bounding_box, const coord_t max_resolution);
 
+    ~VoxelGrid();
+
     const Point3D& getResolution() const
     {
         return resolution_;
@@ -87,43 +97,109 @@ public:
 
     void setOrUpdateOccupation(const LocalCoordinates& position, const uint8_t extruder_nr);
 
+    /*!
+     * Reserve an empty voxel, so that it can be evaluated later on. This allows multiple threads to find the voxels to be evaluated, without evaluating any of them twice.
+     * A reserved voxel is not occupied yet, until its occupation is set.
+     * @param position The voxel to be reserved
+     * @return True if the voxel was empty and is now reserved by the caller, false if it was occupied or reserved already
+     */
+    bool reserve(const LocalCoordinates& position);
+
     std::optional<uint8_t> getOccupation(const LocalCoordinates& local_position) const;
 
+    /*! Gets the number of occupied voxels, including the ones that are reserved */
     size_t occupiedCount() const;
 
     /*!
      * Visits alls the occupied voxels with the function given as argument. Ths functions should take a single argument which is a pair containing the key (local coordinate)
      * and the value (extruder occupation)
-     * @warning The occupied voxels are processed in parallel, so make sure the given function doesn't use external elements that are not thread-safe. Also, since we are iterating
-     *          on the occupied voxels list, it is impossible to do any other operation on the voxels grid itself, e.g. looking for the occupation of an other voxel.
+     * @warning The occupied voxels are processed in parallel, brick by brick, so make sure the given function doesn't use external elements that are not thread-safe.
      */
-    template<class... Args>
-    void visitOccupiedVoxels(Args&&... args)
+    template<typename F>
+    void visitOccupiedVoxels(F&& visit_function) const
     {
-        occupied_voxels_.visit_all(
-#ifdef __cpp_lib_execution
-            std::execution::par,
-#endif
-            args...);
+        cura::parallel_for<size_t>(
+            0,
+            bricks_.size(),
+            [&](const size_t brick_index)
+            {
+                visitBrickVoxels(brick_index, visit_function);
+            });
     }
 
     /*!
-     * Visits alls the occupied voxels with the function given as argument. Ths functions should take a single argument which is a pair containing the key (local coordinate)
-     * and the value (extruder occupation)
-     * @warning The occupied voxels are processed in parallel, so make sure the given function doesn't use external elements that are not thread-safe. Also, since we are iterating
-     *          on the occupied voxels list, it is impossible to do any other operation on the voxels grid itself, e.g. looking for the occupation of an other voxel.
+     * Gets all the occupied voxels for which the given function returns true. The function is called in parallel, with the same argument as for visitOccupiedVoxels.
      */
-    template<class... Args>
-    void visitOccupiedVoxels(Args&&... args) const
+    template<typename F>
+    std::vector<LocalCoordinates> findOccupiedVoxels(F&& filter) const
     {
-        occupied_voxels_.cvisit_all(
-#ifdef __cpp_lib_execution
-            std::execution::par,
-#endif
-            args...);
+        std::vector<LocalCoordinates> found_voxels;
+        std::mutex mutex;
+        cura::parallel_for<size_t>(
+            0,
+            bricks_.size(),
+            [&](const size_t brick_index)
+            {
+                std::vector<LocalCoordinates> found_in_brick;
+                visitBrickVoxels(
+                    brick_index,
+                    [&](const auto& voxel)
+                    {
+                        if (filter(voxel))
+                        {
+                            found_in_brick.push_back(voxel.first);
+                        }
+                    });
+                if (! found_in_brick.empty())
+                {
+                    const std::lock_guard lock(mutex);
+                    found_voxels.insert(found_voxels.end(), found_in_brick.begin(), found_in_brick.end());
+                }
+            });
+        return found_voxels;
     }
 
-    std::vector<LocalCoordinates> getVoxelsAround(const LocalCoordinates& point) const;
+    /*!
+     * Visits the (up to) 26 voxels around the given one, that are inside the grid.
+     * @param point The voxel to visit around
+     * @param visit_function The function to be called with the LocalCoordinates of each voxel around
+     */
+    template<typename F>
+    void visitVoxelsAround(const LocalCoordinates& point, F&& visit_function) const
+    {
+        const Point3U16& position = point.position;
+        for (int delta_x = -1; delta_x < 2; ++delta_x)
+        {
+            const int64_t pos_x = position.x + delta_x;
+            if (pos_x < 0 || pos_x >= slices_count_.x_)
+            {
+                continue;
+            }
+
+            for (int delta_y = -1; delta_y < 2; ++delta_y)
+            {
+                const int64_t pos_y = position.y + delta_y;
+                if (pos_y < 0 || pos_y >= slices_count_.y_)
+                {
+                    continue;
+                }
+
+                for (int delta_z = -1; delta_z < 2; ++delta_z)
+                {
+                    const int64_t pos_z = position.z + delta_z;
+                    if (pos_z < 0 || pos_z >= slices_count_.z_)
+                    {
+                        continue;
+                    }
+
+                    if (delta_x || delta_y || delta_z)
+                    {
+                        visit_function(LocalCoordinates(pos_x, pos_y, pos_z));
+                    }
+                }
+            }
+        }
+    }
 
     LocalCoordinates toLocalCoordinates(const Point3D& position) const;
 
@@ -152,10 +228,77 @@ public:
     std::vector<LocalCoordinates> getTraversedVoxels(const Triangle3D& triangle) const;
 
 private:
+    static constexpr uint16_t brick_side_bits = 4;
+    static constexpr uint16_t brick_side = 1 << brick_side_bits;
+    static constexpr uint16_t brick_mask = brick_side - 1;
+    static constexpr size_t brick_voxels_count = brick_side * brick_side * brick_side;
+
+    /*! Stored values of the voxels: an occupied voxel stores its extruder number plus one, so that a zero-filled brick is empty */
+    static constexpr uint8_t empty_voxel = 0;
+    static constexpr uint8_t reserved_voxel = std::numeric_limits<uint8_t>::max();
+
+    struct Brick
+    {
+        std::array<std::atomic<uint8_t>, brick_voxels_count> voxels{};
+    };
+
+    size_t getBrickIndex(const Point3U16& position) const
+    {
+        return (static_cast<size_t>(position.z >> brick_side_bits) * bricks_count_.y_ + (position.y >> brick_side_bits)) * bricks_count_.x_ + (position.x >> brick_side_bits);
+    }
+
+    static size_t getIndexInBrick(const Point3U16& position)
+    {
+        return ((position.z & brick_mask) << (2 * brick_side_bits)) | ((position.y & brick_mask) << brick_side_bits) | (position.x & brick_mask);
+    }
+
+    bool isInGrid(const Point3U16& position) const
+    {
+        return position.x < slices_count_.x_ && position.y < slices_count_.y_ && position.z < slices_count_.z_;
+    }
+
+    /*! Gets the stored value of a voxel, or nullptr if its brick has not been allocated (yet) */
+    const std::atomic<uint8_t>* findVoxel(const LocalCoordinates& position) const;
+
+    /*! Gets the stored value of a voxel, allocating its brick if required */
+    std::atomic<uint8_t>& getOrCreateVoxel(const LocalCoordinates& position);
+
+    /*! Visits the occupied voxels of a single brick, see visitOccupiedVoxels */
+    template<typename F>
+    void visitBrickVoxels(const size_t brick_index, F&& visit_function) const
+    {
+        const Brick* brick = bricks_[brick_index].load(std::memory_order_acquire);
+        if (brick == nullptr)
+        {
+            return;
+        }
+
+        const auto brick_x = static_cast<uint16_t>((brick_index % bricks_count_.x_) << brick_side_bits);
+        const auto brick_y = static_cast<uint16_t>(((brick_index / bricks_count_.x_) % bricks_count_.y_) << brick_side_bits);
+        const auto brick_z = static_cast<uint16_t>((brick_index / (bricks_count_.x_ * bricks_count_.y_)) << brick_side_bits);
+        for (size_t index_in_brick = 0; index_in_brick < brick_voxels_count; ++index_in_brick)
+        {
+            const uint8_t value = brick->voxels[index_in_brick].load(std::memory_order_relaxed);
+            if (value == empty_voxel || value == reserved_voxel)
+            {
+                continue;
+            }
+
+            const std::pair<const LocalCoordinates, uint8_t> voxel{ LocalCoordinates(
+                                                                         brick_x + (index_in_brick & brick_mask),
+                                                                         brick_y + ((index_in_brick >> brick_side_bits) & brick_mask),
+                                                                         brick_z + (index_in_brick >> (2 * brick_side_bits))),
+                                                                     static_cast<uint8_t>(value - 1) };
+            visit_function(voxel);
+        }
+    }
+
     Point3D resolution_;
     Point3D origin_;
     Point3LL slices_count_;
-    boost::concurrent_flat_map<LocalCoordinates, uint8_t> occupied_voxels_;
+    Point3LL bricks_count_;
+    std::vector<std::atomic<Brick*>> bricks_; //!< Bricks of the grid, ordered by Z then Y then X. Unoccupied bricks are not allocated.
+    std::atomic<size_t> occupied_count_{ 0 };
 };
 
 inline std::size_t hash_value(VoxelGrid::LocalCoordinates const& position)
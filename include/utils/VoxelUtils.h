@@ -4,11 +4,14 @@
 #ifndef UTILS_VOXEL_UTILS_H
 #define UTILS_VOXEL_UTILS_H
 
-#include <functional>
+#include <cassert>
+#include <limits>
 #include <unordered_set>
+#include <vector>
 
 #include "geometry/Point3LL.h"
 #include "geometry/Polygon.h"
+#include "geometry/Shape.h"
 
 namespace cura
 {
@@ -75,12 +78,62 @@ public:
     /*!
      * Process voxels which a line segment crosses.
      *
+     * The walking functions take the cell processing function as a template argument, so that it can be inlined into the walk,
+     * which is the inner loop of voxelizing a model.
+     *
      * \param start Start point of the line
      * \param end End point of the line
      * \param process_cell_func Function to perform on each cell the line crosses
      * \return Whether executing was stopped short as indicated by the \p cell_processing_function
      */
-    bool walkLine(Point3LL start, Point3LL end, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool walkLine(Point3LL start, Point3LL end, F&& process_cell_func) const
+    {
+        Point3LL diff = end - start;
+
+        const GridPoint3 start_cell = toGridPoint(start);
+        const GridPoint3 end_cell = toGridPoint(end);
+        if (start_cell == end_cell)
+        {
+            return process_cell_func(start_cell);
+        }
+
+        Point3LL current_cell = start_cell;
+        while (true)
+        {
+            bool continue_ = process_cell_func(current_cell);
+
+            if (! continue_)
+            {
+                return false;
+            }
+
+            int stepping_dim = -1; // dimension in which the line next exits the current cell
+            double percentage_along_line = std::numeric_limits<double>::max();
+            for (int dim = 0; dim < 3; dim++)
+            {
+                if (diff[dim] == 0)
+                {
+                    continue;
+                }
+                coord_t crossing_boundary = toLowerCoord(current_cell[dim], dim) + (diff[dim] > 0) * cell_size_[dim];
+                double percentage_along_line_here = (crossing_boundary - start[dim]) / static_cast<double>(diff[dim]);
+                if (percentage_along_line_here < percentage_along_line)
+                {
+                    percentage_along_line = percentage_along_line_here;
+                    stepping_dim = dim;
+                }
+            }
+            assert(stepping_dim != -1);
+            if (percentage_along_line > 1.0)
+            {
+                // next cell is beyond the end
+                return true;
+            }
+            current_cell[stepping_dim] += (diff[stepping_dim] > 0) ? 1 : -1;
+        }
+        return true;
+    }
 
     /*!
      * Process voxels which the line segments of a polygon crosses.
@@ -92,7 +145,24 @@ public:
      * \param process_cell_func Function to perform on each voxel cell
      * \return Whether executing was stopped short as indicated by the \p cell_processing_function
      */
-    bool walkPolygons(const Shape& polys, coord_t z, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool walkPolygons(const Shape& polys, coord_t z, F&& process_cell_func) const
+    {
+        for (const Polygon& poly : polys)
+        {
+            Point2LL last = poly.back();
+            for (Point2LL p : poly)
+            {
+                bool continue_ = walkLine(Point3LL(last.X, last.Y, z), Point3LL(p.X, p.Y, z), process_cell_func);
+                if (! continue_)
+                {
+                    return false;
+                }
+                last = p;
+            }
+        }
+        return true;
+    }
 
     /*!
      * Process voxels near the line segments of a polygon.
@@ -105,13 +175,40 @@ public:
      * \param process_cell_func Function to perform on each voxel cell
      * \return Whether executing was stopped short as indicated by the \p cell_processing_function
      */
-    bool walkDilatedPolygons(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool walkDilatedPolygons(const Shape& polys, coord_t z, const DilationKernel& kernel, F&& process_cell_func) const
+    {
+        Shape translated = polys;
+        const Point3LL translation = (Point3LL(1, 1, 1) - kernel.kernel_size_ % 2) * cell_size_ / 2;
+        if (translation.x_ && translation.y_)
+        {
+            translated.translate(Point2LL(translation.x_, translation.y_));
+        }
+        return walkPolygons(translated, z + translation.z_, dilate(kernel, process_cell_func));
+    }
 
 private:
     /*!
      * \warning the \p polys is assumed to be translated by half the cell_size in xy already
      */
-    bool _walkAreas(const Shape& polys, coord_t z, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool _walkAreas(const Shape& polys, coord_t z, F&& process_cell_func) const
+    {
+        for (Point2LL p : spreadDotsArea(polys))
+        {
+            bool continue_ = process_cell_func(toGridPoint(Point3LL(p.X + cell_size_.x_ / 2, p.Y + cell_size_.y_ / 2, z)));
+            if (! continue_)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * Get a dot for each voxel cell inside an area, on the lower corners of the cells.
+     */
+    std::vector<Point2LL> spreadDotsArea(const Shape& polys) const;
 
 public:
     /*!
@@ -124,7 +221,17 @@ public:
      * \param process_cell_func Function to perform on each voxel cell
      * \return Whether executing was stopped short as indicated by the \p cell_processing_function
      */
-    bool walkAreas(const Shape& polys, coord_t z, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool walkAreas(const Shape& polys, coord_t z, F&& process_cell_func) const
+    {
+        Shape translated = polys;
+        const Point3LL translation = -cell_size_ / 2; // offset half a cell so that the dots of spreadDotsArea are centered on the middle of the cell isntead of the lower corners.
+        if (translation.x_ && translation.y_)
+        {
+            translated.translate(Point2LL(translation.x_, translation.y_));
+        }
+        return _walkAreas(translated, z, process_cell_func);
+    }
 
     /*!
      * Process all voxels inside the area of a polygons object.
@@ -137,7 +244,18 @@ public:
      * \param process_cell_func Function to perform on each voxel cell
      * \return Whether executing was stopped short as indicated by the \p cell_processing_function
      */
-    bool walkDilatedAreas(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    bool walkDilatedAreas(const Shape& polys, coord_t z, const DilationKernel& kernel, F&& process_cell_func) const
+    {
+        Shape translated = polys;
+        const Point3LL translation = (Point3LL(1, 1, 1) - kernel.kernel_size_ % 2) * cell_size_ / 2 // offset half a cell when using a n even kernel
+                                   - cell_size_ / 2; // offset half a cell so that the dots of spreadDotsArea are centered on the middle of the cell isntead of the lower corners.
+        if (translation.x_ && translation.y_)
+        {
+            translated.translate(Point2LL(translation.x_, translation.y_));
+        }
+        return _walkAreas(translated, z + translation.z_, dilate(kernel, process_cell_func));
+    }
 
     /*!
      * Dilate with a kernel.
@@ -149,7 +267,20 @@ public:
      * \param kernel The offset positions relative to the input of \p process_cell_func
      * \param process_cell_func Function to perform on each voxel cell
      */
-    std::function<bool(GridPoint3)> dilate(const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
+    template<typename F>
+    auto dilate(const DilationKernel& kernel, F& process_cell_func) const
+    {
+        return [&process_cell_func, &kernel](GridPoint3 loc)
+        {
+            for (const GridPoint3& rel : kernel.relative_cells_)
+            {
+                bool continue_ = process_cell_func(loc + rel);
+                if (! continue_)
+                    return false;
+            }
+            return true;
+        };
+    }
 
     GridPoint3 toGridPoint(const Point3LL& point) const
     {
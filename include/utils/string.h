@@ -4,14 +4,19 @@
 #ifndef UTILS_STRING_H
 #define UTILS_STRING_H
 
+#include <algorithm> // copy
+#include <charconv> // to_chars
 #include <cmath>
+#include <cstdint>
 #include <cstdio> // sprintf
 #include <ctype.h>
 #include <sstream> // ostringstream
+#include <string_view>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/ostream_iterator.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
 namespace cura
@@ -124,6 +129,48 @@ static inline void writeInt2mm(const int32_t coord, std::ostream& ss)
     }
 }
 
+/*!
+ * Efficient conversion of micron integer type to millimeter string, written to a character buffer instead of a stream.
+ *
+ * Produces exactly the same characters as writeInt2mm, including its quirks: zero is written as "0.00", and values between -1mm
+ * and -0.1mm are written without leading zero (e.g. "-.5"). Unlike writeInt2mm, the full 64-bit range is supported.
+ *
+ * \param coord The micron unit to convert
+ * \param out The buffer to write to, which must have room for at least 24 characters
+ * \return Pointer past the last written character
+ */
+static inline char* writeInt2mm(const int64_t coord, char* out)
+{
+    if (coord == 0)
+    {
+        constexpr std::string_view zero = "0.00";
+        return std::copy(zero.begin(), zero.end(), out);
+    }
+    const uint64_t magnitude = coord < 0 ? uint64_t(0) - static_cast<uint64_t>(coord) : static_cast<uint64_t>(coord);
+    const uint64_t integer_part = magnitude / 1000;
+    const uint64_t fraction = magnitude % 1000;
+    if (coord < 0)
+    {
+        *out++ = '-';
+    }
+    if (integer_part != 0)
+    {
+        out = std::to_chars(out, out + 21, integer_part).ptr;
+        if (fraction == 0)
+        {
+            return out;
+        }
+    }
+    else if (coord > 0 || magnitude < 100)
+    {
+        *out++ = '0';
+    }
+    *out++ = '.';
+    const char digits[3] = { static_cast<char>('0' + fraction / 100), static_cast<char>('0' + fraction / 10 % 10), static_cast<char>('0' + fraction % 10) };
+    const int digit_count = digits[2] != '0' ? 3 : (digits[1] != '0' ? 2 : 1);
+    return std::copy(digits, digits + digit_count, out);
+}
+
 /*!
  * Struct to make it possible to inline calls to writeInt2mm with writing other stuff to the output stream
  */
@@ -189,6 +236,45 @@ static inline void writeDoubleToStream(const uint8_t precision, const double coo
     ss << buffer;
 }
 
+/*!
+ * Efficient writing of a double to a character buffer instead of a stream.
+ *
+ * Produces exactly the same characters as writeDoubleToStream, but formats the number without going through printf.
+ *
+ * \param precision The number of (non-zero) digits after the decimal dot
+ * \param coord double to output
+ * \param out The buffer to write to, which must have room for at least 400 characters
+ * \return Pointer past the last written character
+ */
+static inline char* writeDoubleToBuffer(const uint8_t precision, const double coord, char* out)
+{
+    char* end;
+    if (std::isfinite(coord))
+    {
+        end = fmt::format_to(out, "{:.{}f}", coord, precision);
+    }
+    else
+    {
+        // printf writes "INF" and "NAN" in upper case for the %F format
+        char format[5] = "%.xF";
+        format[2] = '0' + static_cast<char>(precision);
+        end = out + std::max(0, sprintf(out, format, coord));
+    }
+    const auto char_count = end - out;
+    if (char_count > precision && out[char_count - precision - 1] == '.')
+    {
+        while (*(end - 1) == '0')
+        {
+            end--;
+        }
+        if (*(end - 1) == '.')
+        {
+            end--;
+        }
+    }
+    return end;
+}
+
 /*!
  * Struct to make it possible to inline calls to writeDoubleToStream with writing other stuff to the output stream
  */
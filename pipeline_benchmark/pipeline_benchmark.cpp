@@ -0,0 +1,684 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <docopt/docopt.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <source_location>
+#include <sstream>
+#include <string_view>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <spdlog/spdlog.h>
+
+#include "Application.h"
+#include "FffProcessor.h"
+#include "GCodeSink.h"
+#include "Slice.h"
+#include "communication/Communication.h"
+#include "geometry/Point3LL.h"
+#include "progress/Progress.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
+
+
+constexpr std::string_view USAGE = R"(Pipeline Benchmark.
+
+Slices a set of procedurally generated scenes end-to-end with CuraEngine, and reports the time spent in each stage, the time spent
+per layer while exporting, the utilization of the threads and the peak memory use.
+
+Usage:
+  pipeline_benchmark -o FILE [-j THREADS] [--timeout SECONDS] [--trace DIR] [-s SETTING]... [SCENARIO...]
+  pipeline_benchmark --list
+  pipeline_benchmark (-h | --help)
+  pipeline_benchmark --version
+
+Options:
+  -h --help                      Show this screen.
+  --version                      Show version.
+  --list                         List the available scenarios.
+  -o FILE                        Specify the output Json file.
+  -j THREADS                     Number of threads to slice with, 0 for one per core [default: 0].
+  --timeout SECONDS              Time after which a scenario is aborted [default: 600].
+  --trace DIR                    Also write a Chrome trace of every scenario to this directory.
+  -s SETTING                     Override a setting in every scenario, as KEY=VALUE, e.g. to compare an optional feature.
+)";
+
+/*!
+ * Communication that ignores everything, since the benchmark only needs the g-code to be generated.
+ */
+class BenchmarkCommunication : public cura::Communication
+{
+public:
+    bool hasSlice() const override
+    {
+        return false;
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+    void sendProgress(double progress) const override
+    {
+    }
+
+    void sendLayerComplete(const cura::LayerIndex::value_type& layer_nr, const cura::coord_t& z, const cura::coord_t& thickness) override
+    {
+    }
+
+    void sendLineTo(
+        const cura::PrintFeatureType& type,
+        const cura::Point3LL& to,
+        const cura::coord_t& line_width,
+        const cura::coord_t& line_thickness,
+        const cura::Velocity& velocity) override
+    {
+    }
+
+    void sendCurrentPosition(const cura::Point3LL& position) override
+    {
+    }
+
+    void setExtruderForSend(const cura::ExtruderTrain& extruder) override
+    {
+    }
+
+    void setLayerForSend(const cura::LayerIndex::value_type& layer_nr) override
+    {
+    }
+
+    void sendOptimizedLayerData() override
+    {
+    }
+
+    void sendPrintTimeMaterialEstimates() const override
+    {
+    }
+
+    void beginGCode() override
+    {
+    }
+
+    void flushGCode() override
+    {
+    }
+
+    void sendGCodePrefix(const std::string& prefix) const override
+    {
+    }
+
+    void sendSliceUUID(const std::string& slice_uuid) const override
+    {
+    }
+
+    void sendFinishedSlicing() const override
+    {
+    }
+
+    void sliceNext() override
+    {
+    }
+};
+
+/*!
+ * Sink that only counts the g-code, so that writing it out does not distort the timings.
+ */
+class CountingGCodeSink : public cura::GCodeSink
+{
+public:
+    CountingGCodeSink()
+        : GCodeSink(1024 * 1024)
+    {
+    }
+
+    size_t byteCount() const
+    {
+        return byte_count_;
+    }
+
+protected:
+    void consume(std::string& gcode) override
+    {
+        byte_count_ += gcode.size();
+    }
+
+private:
+    size_t byte_count_{ 0 };
+};
+
+/*!
+ * Add a closed prism to a mesh: a cylinder approximated by \p segments sides, with an optional round hole through it.
+ * \param inner_radius The radius of the hole, or 0 for a solid prism.
+ * \param start_angle The angle of the first corner, e.g. a quarter pi for an axis-aligned box of 4 segments.
+ */
+void addPrism(
+    cura::Mesh& mesh,
+    const cura::Point2LL center,
+    const cura::coord_t outer_radius,
+    const cura::coord_t inner_radius,
+    const cura::coord_t z_bottom,
+    const cura::coord_t z_top,
+    const size_t segments,
+    const double start_angle = 0.0)
+{
+    const auto corner = [&](const cura::coord_t radius, const size_t segment_idx, const cura::coord_t z)
+    {
+        const double angle = start_angle + 2.0 * std::numbers::pi * static_cast<double>(segment_idx % segments) / static_cast<double>(segments);
+        return cura::Point3LL(
+            center.X + std::llrint(static_cast<double>(radius) * std::cos(angle)),
+            center.Y + std::llrint(static_cast<double>(radius) * std::sin(angle)),
+            z);
+    };
+
+    // Corners go counter-clockwise, so these faces all point outwards.
+    for (size_t segment_idx = 0; segment_idx < segments; segment_idx++)
+    {
+        const cura::Point3LL outer_bottom = corner(outer_radius, segment_idx, z_bottom);
+        const cura::Point3LL outer_bottom_next = corner(outer_radius, segment_idx + 1, z_bottom);
+        const cura::Point3LL outer_top = corner(outer_radius, segment_idx, z_top);
+        const cura::Point3LL outer_top_next = corner(outer_radius, segment_idx + 1, z_top);
+        const cura::Point3LL inner_bottom = corner(inner_radius, segment_idx, z_bottom);
+        const cura::Point3LL inner_bottom_next = corner(inner_radius, segment_idx + 1, z_bottom);
+        const cura::Point3LL inner_top = corner(inner_radius, segment_idx, z_top);
+        const cura::Point3LL inner_top_next = corner(inner_radius, segment_idx + 1, z_top);
+
+        mesh.addFace(outer_bottom, outer_bottom_next, outer_top_next);
+        mesh.addFace(outer_bottom, outer_top_next, outer_top);
+
+        mesh.addFace(outer_top, outer_top_next, inner_top_next);
+        mesh.addFace(outer_bottom, inner_bottom_next, outer_bottom_next);
+        if (inner_radius > 0) // Without a hole, these would be degenerate.
+        {
+            mesh.addFace(inner_bottom, inner_top_next, inner_bottom_next);
+            mesh.addFace(inner_bottom, inner_top, inner_top_next);
+
+            mesh.addFace(outer_top, inner_top_next, inner_top);
+            mesh.addFace(outer_bottom, inner_bottom, inner_bottom_next);
+        }
+    }
+}
+
+/*!
+ * Add an axis-aligned box to a mesh.
+ */
+void addBox(cura::Mesh& mesh, const cura::Point2LL center, const cura::coord_t size, const cura::coord_t z_bottom, const cura::coord_t z_top)
+{
+    addPrism(mesh, center, std::llrint(static_cast<double>(size) / std::numbers::sqrt2), 0, z_bottom, z_top, 4, std::numbers::pi / 4.0);
+}
+
+/*!
+ * Add an empty mesh to the scene, printed with the given extruder.
+ */
+cura::Mesh& addMesh(cura::Scene& scene, const size_t extruder_nr)
+{
+    cura::MeshGroup& mesh_group = scene.mesh_groups.front();
+    mesh_group.meshes.emplace_back(scene.extruders[extruder_nr].settings_);
+    return mesh_group.meshes.back();
+}
+
+/*!
+ * A representative scene to slice, generated procedurally so that no models need to be shipped.
+ *
+ * The meshes are placed around the origin, which is the centre of the build plate after finalizing the mesh group.
+ */
+struct Scenario
+{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> settings; //!< Overrides of the default test settings.
+    std::function<void(cura::Scene&)> build; //!< Adds the meshes to the scene, after the extruders were created.
+};
+
+std::vector<Scenario> getScenarios()
+{
+    // Undo the odd duplicate infill settings at the end of the default test settings.
+    const std::vector<std::pair<std::string, std::string>> infill{ { "infill_pattern", "grid" }, { "infill_sparse_density", "20" }, { "infill_line_distance", "4.0" } };
+    const auto with_infill = [&infill](std::vector<std::pair<std::string, std::string>> settings)
+    {
+        settings.insert(settings.begin(), infill.begin(), infill.end());
+        return settings;
+    };
+
+    return {
+        Scenario{ .name = "tall_thin_walled",
+                  .settings = with_infill({}),
+                  .build =
+                      [](cura::Scene& scene)
+                  {
+                      addPrism(addMesh(scene, 0), cura::Point2LL(0, 0), MM2INT(20), MM2INT(19.2), 0, MM2INT(150), 128);
+                  } },
+        Scenario{ .name = "dense_multi_part_plate",
+                  .settings = with_infill({}),
+                  .build =
+                      [](cura::Scene& scene)
+                  {
+                      cura::Mesh& mesh = addMesh(scene, 0);
+                      constexpr int grid_size = 12;
+                      for (int x = 0; x < grid_size; x++)
+                      {
+                          for (int y = 0; y < grid_size; y++)
+                          {
+                              const cura::Point2LL center(MM2INT(9) * (2 * x - grid_size + 1) / 2, MM2INT(9) * (2 * y - grid_size + 1) / 2);
+                              addPrism(mesh, center, MM2INT(3), 0, 0, MM2INT(5), 32);
+                          }
+                      }
+                  } },
+        Scenario{ .name = "tree_support",
+                  .settings = with_infill({ { "support_enable", "true" }, { "support_structure", "tree" } }),
+                  .build =
+                      [](cura::Scene& scene)
+                  {
+                      cura::Mesh& mesh = addMesh(scene, 0);
+                      addBox(mesh, cura::Point2LL(0, 0), MM2INT(6), 0, MM2INT(30));
+                      addBox(mesh, cura::Point2LL(0, 0), MM2INT(50), MM2INT(30), MM2INT(34));
+                  } },
+        Scenario{ .name = "lightning",
+                  .settings = { { "infill_pattern", "lightning" }, { "infill_sparse_density", "15" }, { "infill_line_distance", "2.667" } },
+                  .build =
+                      [](cura::Scene& scene)
+                  {
+                      addPrism(addMesh(scene, 0), cura::Point2LL(0, 0), MM2INT(30), 0, 0, MM2INT(40), 128);
+                  } },
+        Scenario{ .name = "multi_extruder_prime_tower",
+                  .settings = with_infill({ { "machine_extruder_count", "2" }, { "extruders_enabled_count", "2" }, { "prime_tower_enable", "true" } }),
+                  .build =
+                      [](cura::Scene& scene)
+                  {
+                      addPrism(addMesh(scene, 0), cura::Point2LL(MM2INT(-15), 0), MM2INT(10), 0, 0, MM2INT(30), 64);
+                      addBox(addMesh(scene, 1), cura::Point2LL(MM2INT(15), 0), MM2INT(20), 0, MM2INT(30));
+                  } },
+    };
+}
+
+struct Metric
+{
+    std::string name;
+    std::string unit;
+    double value;
+};
+
+/*!
+ * Get the value at the given percentile of sorted values, using the nearest rank.
+ */
+double percentile(const std::vector<double>& sorted_values, const double percent)
+{
+    if (sorted_values.empty())
+    {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted_values.size())));
+    return sorted_values[std::clamp<size_t>(rank, 1, sorted_values.size()) - 1];
+}
+
+/*!
+ * Compute the metrics of a slice from the events recorded by the tracer.
+ *
+ * The thread utilization only counts the time in traced spans (slicing, walls, skins, support, layer plans and g-code), not in
+ * untraced work, so it is a lower bound that is meant to be compared between releases.
+ */
+std::vector<Metric> computeMetrics(const std::vector<cura::Tracer::ThreadEvents>& threads, const int64_t wall_time_us, const size_t thread_count, const size_t gcode_bytes)
+{
+    constexpr double us_per_s = 1000000.0;
+    constexpr double us_per_ms = 1000.0;
+
+    std::vector<Metric> metrics;
+    metrics.push_back(Metric{ "Total time", "s", static_cast<double>(wall_time_us) / us_per_s });
+
+    std::vector<std::pair<std::string, int64_t>> stage_times; // In the order in which the stages started.
+    std::vector<double> layer_times;
+    int64_t busy_time_us = 0;
+    for (const cura::Tracer::ThreadEvents& thread : threads)
+    {
+        std::vector<std::pair<int64_t, int64_t>> intervals;
+        for (const cura::Tracer::Event& event : thread.events)
+        {
+            if (event.phase != 'X')
+            {
+                continue;
+            }
+            if (event.category == "stage")
+            {
+                auto stage = std::ranges::find(stage_times, event.name, &std::pair<std::string, int64_t>::first);
+                if (stage == stage_times.end())
+                {
+                    stage_times.emplace_back(event.name, event.duration_us);
+                }
+                else
+                {
+                    stage->second += event.duration_us;
+                }
+                continue; // The stages span the whole slice on the main thread, so they say nothing about its utilization.
+            }
+            if (event.category == "layer plan")
+            {
+                layer_times.push_back(static_cast<double>(event.duration_us) / us_per_ms);
+            }
+            intervals.emplace_back(event.timestamp_us, event.timestamp_us + event.duration_us);
+        }
+
+        // Spans can be nested, so only count the time covered by any of them.
+        std::ranges::sort(intervals);
+        int64_t covered_until = std::numeric_limits<int64_t>::min();
+        for (const auto& [start, end] : intervals)
+        {
+            if (end > covered_until)
+            {
+                busy_time_us += end - std::max(start, covered_until);
+                covered_until = end;
+            }
+        }
+    }
+
+    for (const auto& [stage, time_us] : stage_times)
+    {
+        metrics.push_back(Metric{ fmt::format("Stage {}", stage), "s", static_cast<double>(time_us) / us_per_s });
+    }
+
+    std::ranges::sort(layer_times);
+    metrics.push_back(Metric{ "Layers exported", "-", static_cast<double>(layer_times.size()) });
+    metrics.push_back(Metric{ "Layer export p50", "ms", percentile(layer_times, 50.0) });
+    metrics.push_back(Metric{ "Layer export p90", "ms", percentile(layer_times, 90.0) });
+    metrics.push_back(Metric{ "Layer export p99", "ms", percentile(layer_times, 99.0) });
+    metrics.push_back(Metric{ "Layer export max", "ms", layer_times.empty() ? 0.0 : layer_times.back() });
+
+    const double available_time_us = static_cast<double>(wall_time_us) * static_cast<double>(thread_count);
+    metrics.push_back(Metric{ "Thread utilization", "%", available_time_us > 0.0 ? static_cast<double>(busy_time_us) / available_time_us * 100.0 : 0.0 });
+    metrics.push_back(Metric{ "G-code size", "MB", static_cast<double>(gcode_bytes) / (1024.0 * 1024.0) });
+    return metrics;
+}
+
+/*!
+ * Slice a scenario and send its metrics to the parent process, one tab-separated name, unit and value per line.
+ */
+[[noreturn]] void handleChildProcess(
+    const Scenario& scenario,
+    const std::filesystem::path& settings_file,
+    const std::vector<std::string>& setting_overrides,
+    const long thread_count,
+    const std::string& trace_dir,
+    const int output_fd)
+{
+    cura::Application& application = cura::Application::getInstance();
+    application.communication_ = std::make_shared<BenchmarkCommunication>();
+    application.startThreadPool(static_cast<int>(thread_count));
+    cura::Progress::init();
+
+    application.current_slice_ = std::make_shared<cura::Slice>(1);
+    cura::Scene& scene = application.current_slice_->scene;
+
+    std::ifstream file{ settings_file };
+    if (! file)
+    {
+        spdlog::critical("Could not read settings from: {}", settings_file.string());
+        exit(EXIT_FAILURE);
+    }
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::string key;
+        std::string value;
+        if (std::getline(std::getline(iss, key, '='), value))
+        {
+            scene.settings.add(key, value);
+        }
+    }
+    for (const auto& [key, value] : scenario.settings)
+    {
+        scene.settings.add(key, value);
+    }
+    for (const std::string& setting : setting_overrides)
+    {
+        const size_t separator = setting.find('=');
+        if (separator == std::string::npos)
+        {
+            spdlog::critical("Setting override is not KEY=VALUE: {}", setting);
+            exit(EXIT_FAILURE);
+        }
+        scene.settings.add(setting.substr(0, separator), setting.substr(separator + 1));
+    }
+
+    const size_t extruder_count = scene.settings.get<size_t>("machine_extruder_count");
+    scene.extruders.reserve(extruder_count);
+    for (size_t extruder_nr = 0; extruder_nr < extruder_count; extruder_nr++)
+    {
+        scene.extruders.emplace_back(extruder_nr, &scene.settings);
+        scene.extruders.back().settings_.add("extruder_nr", std::to_string(extruder_nr));
+    }
+    scenario.build(scene);
+    for (cura::Mesh& mesh : scene.mesh_groups.front().meshes)
+    {
+        mesh.finish();
+    }
+
+    const auto sink = std::make_shared<CountingGCodeSink>();
+    cura::FffProcessor::getInstance()->setTargetSink(sink);
+
+    cura::Tracer& tracer = cura::Tracer::getInstance();
+    tracer.enable(trace_dir.empty() ? std::filesystem::path{} : std::filesystem::path{ trace_dir } / fmt::format("{}.json", scenario.name));
+    const int64_t start_us = tracer.now();
+    scene.mesh_groups.front().finalize();
+    application.current_slice_->compute();
+    cura::FffProcessor::getInstance()->finalize();
+    sink->flush();
+    const int64_t wall_time_us = tracer.now() - start_us;
+
+    const size_t used_threads = application.thread_pool_ ? application.thread_pool_->thread_count() + 1 : 1;
+    std::string output;
+    for (const Metric& metric : computeMetrics(tracer.getEvents(), wall_time_us, used_threads, sink->byteCount()))
+    {
+        output += fmt::format("{}\t{}\t{}\n", metric.name, metric.unit, metric.value);
+    }
+    for (size_t written = 0; written < output.size();)
+    {
+        const ssize_t result = write(output_fd, output.data() + written, output.size() - written);
+        if (result <= 0)
+        {
+            spdlog::critical("Unable to send the results of {}", scenario.name);
+            exit(EXIT_FAILURE);
+        }
+        written += static_cast<size_t>(result);
+    }
+    close(output_fd);
+
+    if (! trace_dir.empty())
+    {
+        tracer.flush();
+    }
+    exit(EXIT_SUCCESS);
+}
+
+/*!
+ * Parse the metrics that a child process sent.
+ */
+std::vector<Metric> parseMetrics(const std::string& output)
+{
+    std::vector<Metric> metrics;
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        std::istringstream fields(line);
+        Metric metric;
+        std::string value;
+        if (std::getline(fields, metric.name, '\t') && std::getline(fields, metric.unit, '\t') && std::getline(fields, value))
+        {
+            metric.value = std::stod(value);
+            metrics.push_back(metric);
+        }
+    }
+    return metrics;
+}
+
+rapidjson::Value
+    createRapidJSONObject(rapidjson::Document::AllocatorType& allocator, const std::string& test_name, const auto value, const std::string& unit, const std::string& extra_info)
+{
+    rapidjson::Value obj(rapidjson::kObjectType);
+    rapidjson::Value key("name", allocator);
+    rapidjson::Value val1(test_name.c_str(), test_name.length(), allocator);
+    obj.AddMember(key, val1, allocator);
+    key.SetString("unit", allocator);
+    rapidjson::Value val2(unit.c_str(), unit.length(), allocator);
+    obj.AddMember(key, val2, allocator);
+    key.SetString("value", allocator);
+    rapidjson::Value val3(value);
+    obj.AddMember(key, val3, allocator);
+    key.SetString("extra", allocator);
+    rapidjson::Value val4(extra_info.c_str(), extra_info.length(), allocator);
+    obj.AddMember(key, val4, allocator);
+    return obj;
+}
+
+void writeJson(const std::filesystem::path& out_file, rapidjson::Document& doc)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    spdlog::info("Writing Json results: {}", std::filesystem::absolute(out_file).string());
+    std::ofstream file{ out_file };
+    if (! file)
+    {
+        spdlog::critical("Failed to open the file: {}", out_file.string());
+        exit(EXIT_FAILURE);
+    }
+    file.write(buffer.GetString(), buffer.GetSize());
+    file.close();
+}
+
+int main(int argc, const char** argv)
+{
+    constexpr bool show_help = true;
+    constexpr std::string_view version = "0.1.0";
+    const std::map<std::string, docopt::value> args = docopt::docopt(fmt::format("{}", USAGE), { argv + 1, argv + argc }, show_help, fmt::format("{}", version));
+
+    std::vector<Scenario> scenarios = getScenarios();
+    if (args.at("--list").asBool())
+    {
+        for (const Scenario& scenario : scenarios)
+        {
+            fmt::print("{}\n", scenario.name);
+        }
+        return EXIT_SUCCESS;
+    }
+    if (const std::vector<std::string> selected = args.at("SCENARIO").asStringList(); ! selected.empty())
+    {
+        for (const std::string& name : selected)
+        {
+            if (std::ranges::find(scenarios, name, &Scenario::name) == scenarios.end())
+            {
+                spdlog::critical("Unknown scenario: {}", name);
+                return EXIT_FAILURE;
+            }
+        }
+        std::erase_if(
+            scenarios,
+            [&selected](const Scenario& scenario)
+            {
+                return std::ranges::find(selected, scenario.name) == selected.end();
+            });
+    }
+
+    const auto settings_file = std::filesystem::path(std::source_location::current().file_name()).parent_path().parent_path().append("tests").append("test_default_settings.txt");
+    const long thread_count = args.at("-j").asLong();
+    const unsigned int timeout = static_cast<unsigned int>(args.at("--timeout").asLong());
+    const std::string trace_dir = args.at("--trace") ? args.at("--trace").asString() : std::string{};
+    const std::vector<std::string> setting_overrides = args.at("-s").asStringList();
+
+    rapidjson::Document doc;
+    doc.SetArray();
+    rapidjson::Document::AllocatorType& allocator = doc.GetAllocator();
+    std::vector<std::string> failed_scenarios;
+
+    for (const Scenario& scenario : scenarios)
+    {
+        spdlog::critical("Starting scenario {}", scenario.name);
+        int pipe_fds[2];
+        if (pipe(pipe_fds) == -1)
+        {
+            spdlog::critical("Unable to create a pipe");
+            return EXIT_FAILURE;
+        }
+
+        pid_t engine_pid = fork();
+        if (engine_pid == -1)
+        {
+            spdlog::critical("Unable to fork - engine");
+            return EXIT_FAILURE;
+        }
+        else if (engine_pid == 0)
+        {
+            close(pipe_fds[0]);
+            handleChildProcess(scenario, settings_file, setting_overrides, thread_count, trace_dir, pipe_fds[1]);
+        }
+        close(pipe_fds[1]);
+
+        pid_t waiter_pid = fork();
+        if (waiter_pid == -1)
+        {
+            spdlog::critical("Unable to fork - waiter");
+            return EXIT_FAILURE;
+        }
+        else if (waiter_pid == 0)
+        {
+            sleep(timeout);
+            kill(engine_pid, SIGKILL);
+            return EXIT_SUCCESS;
+        }
+
+        // Read everything before waiting, so that the engine never blocks on a full pipe.
+        std::string output;
+        char buffer[4096];
+        ssize_t read_size;
+        while ((read_size = read(pipe_fds[0], buffer, sizeof(buffer))) > 0)
+        {
+            output.append(buffer, static_cast<size_t>(read_size));
+        }
+        close(pipe_fds[0]);
+
+        int status;
+        rusage usage{};
+        wait4(engine_pid, &status, 0, &usage);
+        kill(waiter_pid, SIGKILL);
+        waitpid(waiter_pid, nullptr, 0);
+
+        if (WIFSIGNALED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+        {
+            spdlog::error("# Scenario {} crashed or timed out", scenario.name);
+            failed_scenarios.push_back(scenario.name);
+            continue;
+        }
+
+        std::vector<Metric> metrics = parseMetrics(output);
+        metrics.push_back(Metric{ "Peak RSS", "MB", static_cast<double>(usage.ru_maxrss) / 1024.0 }); // ru_maxrss is in kilobytes on Linux.
+        for (const Metric& metric : metrics)
+        {
+            spdlog::info("{}: {} = {:.3f} [{}]", scenario.name, metric.name, metric.value, metric.unit);
+            auto obj = createRapidJSONObject(allocator, fmt::format("{}: {}", scenario.name, metric.name), metric.value, metric.unit, "");
+            doc.PushBack(obj, allocator);
+        }
+    }
+
+    auto failed_obj = createRapidJSONObject(allocator, "Failed scenarios", failed_scenarios.size(), "-", fmt::format("Failed: {}", fmt::join(failed_scenarios, ", ")));
+    doc.PushBack(failed_obj, allocator);
+
+    writeJson(std::filesystem::path{ args.at("-o").asString() }, doc);
+    return failed_scenarios.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -5,7 +5,9 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <boost/uuid/random_generator.hpp> //For generating a UUID.
 #include <boost/uuid/uuid_io.hpp> //For generating a UUID.
@@ -24,6 +26,7 @@
 #include "communication/EmscriptenCommunication.h" // To use Emscripten to slice stuff.
 #include "progress/Progress.h"
 #include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
 #include "utils/string.h" //For stringcasecompare.
 
 namespace cura
@@ -43,6 +46,8 @@ Application::Application()
     {
         spdlog::cfg::helpers::load_levels(spdlog_val);
     };
+
+    Tracer::getInstance().enableFromEnvironment();
 }
 
 Application::~Application()
@@ -140,6 +145,11 @@ void Application::printHelp() const
     fmt::print("  --next\n\tGenerate gcode for the previously supplied mesh group and append that to \n\tthe gcode of further models for one-at-a-time printing.\n");
     fmt::print("  -o <output_file>\n\tSpecify a file to which to write the generated gcode.\n");
     fmt::print("\n");
+    fmt::print("CuraEngine batch <manifest>\n");
+    fmt::print("  Slice all jobs of the manifest file in a single process, keeping the thread pool and \n\tthe loaded definition files between them. "
+               "Every non-empty line of the manifest \n\tis a job, consisting of the arguments of a slice command (without `CuraEngine slice`). \n\tLines starting with # are "
+               "ignored. Give every job its own -o output file.\n");
+    fmt::print("\n");
     fmt::print("The settings are appended to the last supplied object:\n");
     fmt::print("CuraEngine slice [general settings] \n\t-g [current group settings] \n\t-e0 [extruder train 0 settings] \n\t-l obj_inheriting_from_last_extruder_train.stl [object "
                "settings] \n\t--next [next group settings]\n\t... etc.\n");
@@ -147,6 +157,9 @@ void Application::printHelp() const
     fmt::print("In order to load machine definitions from custom locations, you need to create the environment variable CURA_ENGINE_SEARCH_PATH, which should contain all search "
                "paths delimited by a (semi-)colon.\n");
     fmt::print("\n");
+    fmt::print("In order to record a Chrome trace (chrome://tracing or ui.perfetto.dev) of the slicing stages, layers and threads, set the environment variable "
+               "CURAENGINE_TRACE_FILE to the path of the trace file to be written.\n");
+    fmt::print("\n");
 }
 
 void Application::printHeader() const
@@ -222,6 +235,24 @@ void Application::slice()
 #endif
 }
 
+void Application::batch()
+{
+    if (argc_ < 3)
+    {
+        spdlog::error("Missing manifest file for the batch command.");
+        printCall();
+        printHelp();
+        exit(1);
+    }
+    std::optional<std::vector<std::vector<std::string>>> jobs = CommandLine::readJobManifest(argv_[2], argv_[0]);
+    if (! jobs.has_value())
+    {
+        spdlog::error("Failed to load manifest file: {}", argv_[2]);
+        exit(1);
+    }
+    communication_ = std::make_shared<CommandLine>(std::move(jobs.value()));
+}
+
 void Application::run(const size_t argc, char** argv)
 {
     argc_ = argc;
@@ -248,6 +279,10 @@ void Application::run(const size_t argc, char** argv)
         {
             slice();
         }
+        else if (stringcasecompare(argv[1], "batch") == 0)
+        {
+            batch();
+        }
         else if (stringcasecompare(argv[1], "help") == 0)
         {
             printHelp();
@@ -273,6 +308,8 @@ void Application::run(const size_t argc, char** argv)
     {
         communication_->sliceNext();
     }
+
+    Tracer::getInstance().flush();
 }
 
 void Application::startThreadPool(int nworkers)
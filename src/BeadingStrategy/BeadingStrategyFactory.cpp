@@ -8,6 +8,7 @@
 #include <spdlog/spdlog.h>
 
 #include "BeadingStrategy/DistributedBeadingStrategy.h"
+#include "BeadingStrategy/FlattenedBeadingStrategy.h"
 #include "BeadingStrategy/LimitedBeadingStrategy.h"
 #include "BeadingStrategy/OuterWallInsetBeadingStrategy.h"
 #include "BeadingStrategy/RedistributeBeadingStrategy.h"
@@ -30,6 +31,37 @@ BeadingStrategyPtr BeadingStrategyFactory::makeStrategy(
     const coord_t outer_wall_offset,
     const int inward_distributed_center_wall_count,
     const Ratio minimum_variable_line_ratio)
+{
+    return std::make_unique<FlattenedBeadingStrategy>(
+        preferred_bead_width_outer,
+        preferred_bead_width_inner,
+        preferred_transition_length,
+        transitioning_angle,
+        print_thin_walls,
+        min_bead_width,
+        min_feature_size,
+        wall_split_middle_threshold,
+        wall_add_middle_threshold,
+        max_bead_count,
+        outer_wall_offset,
+        inward_distributed_center_wall_count,
+        minimum_variable_line_ratio);
+}
+
+BeadingStrategyPtr BeadingStrategyFactory::makeStrategyStack(
+    const coord_t preferred_bead_width_outer,
+    const coord_t preferred_bead_width_inner,
+    const coord_t preferred_transition_length,
+    const double transitioning_angle,
+    const bool print_thin_walls,
+    const coord_t min_bead_width,
+    const coord_t min_feature_size,
+    const Ratio wall_split_middle_threshold,
+    const Ratio wall_add_middle_threshold,
+    const coord_t max_bead_count,
+    const coord_t outer_wall_offset,
+    const int inward_distributed_center_wall_count,
+    const Ratio minimum_variable_line_ratio)
 {
     using std::make_unique;
     using std::move;
@@ -0,0 +1,441 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "BeadingStrategy/FlattenedBeadingStrategy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "utils/macros.h"
+
+namespace cura
+{
+
+/*!
+ * How many beadings to memoize before starting over, to keep the memory of a strategy bounded.
+ */
+constexpr size_t max_memoized_beadings = 1 << 12;
+
+FlattenedBeadingStrategy::FlattenedBeadingStrategy(
+    const coord_t preferred_bead_width_outer,
+    const coord_t preferred_bead_width_inner,
+    const coord_t preferred_transition_length,
+    const double transitioning_angle,
+    const bool print_thin_walls,
+    const coord_t min_bead_width,
+    const coord_t min_feature_size,
+    const Ratio wall_split_middle_threshold,
+    const Ratio wall_add_middle_threshold,
+    const coord_t max_bead_count,
+    const coord_t outer_wall_offset,
+    const int inward_distributed_center_wall_count,
+    const Ratio minimum_variable_line_ratio)
+    : BeadingStrategy(preferred_bead_width_inner, wall_split_middle_threshold, wall_add_middle_threshold, preferred_transition_length, AngleRadians(transitioning_angle))
+    , optimal_width_outer_(preferred_bead_width_outer)
+    , minimum_variable_line_ratio_(minimum_variable_line_ratio)
+    , print_thin_walls_(print_thin_walls)
+    , min_input_width_(min_feature_size)
+    , min_output_width_(min_bead_width)
+    , outer_wall_offset_(outer_wall_offset)
+    , max_bead_count_(max_bead_count)
+{
+    if (inward_distributed_center_wall_count >= 2)
+    {
+        one_over_distribution_radius_squared_ = 1.0f / (inward_distributed_center_wall_count - 1) * 1.0f / (inward_distributed_center_wall_count - 1);
+    }
+    else
+    {
+        one_over_distribution_radius_squared_ = 1.0f / 1 * 1.0f / 1;
+    }
+    if (max_bead_count % 2 == 1)
+    {
+        RUN_ONCE(spdlog::warn("LimitedBeadingStrategy with odd bead count is odd indeed!"));
+    }
+    name_ = "FlattenedBeadingStrategy";
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::compute(coord_t thickness, coord_t bead_count) const
+{
+    if (memoized_beadings_.size() >= max_memoized_beadings)
+    {
+        memoized_beadings_.clear();
+    }
+
+    const BeadingKey key{ thickness, bead_count };
+    if (const auto memoized = memoized_beadings_.find(key); memoized != memoized_beadings_.end())
+    {
+        return memoized->second;
+    }
+    return memoized_beadings_.emplace(key, computeLimited(thickness, bead_count)).first->second;
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalThickness(coord_t bead_count) const
+{
+    if (bead_count <= max_bead_count_)
+    {
+        return getOptimalThicknessRedistributed(bead_count);
+    }
+    return 10000000; // 10 meter
+}
+
+coord_t FlattenedBeadingStrategy::getTransitionThickness(coord_t lower_bead_count) const
+{
+    if (lower_bead_count < max_bead_count_)
+    {
+        return getTransitionThicknessWidened(lower_bead_count);
+    }
+    if (lower_bead_count == max_bead_count_)
+    {
+        return getOptimalThicknessRedistributed(lower_bead_count + 1) - 10;
+    }
+    return 9000000; // 9 meter
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalBeadCount(coord_t thickness) const
+{
+    coord_t parent_bead_count = getOptimalBeadCountWidened(thickness);
+    if (parent_bead_count <= max_bead_count_)
+    {
+        return parent_bead_count;
+    }
+    else if (parent_bead_count == max_bead_count_ + 1)
+    {
+        if (thickness < getOptimalThicknessRedistributed(max_bead_count_ + 1) - 10)
+            return max_bead_count_;
+        else
+            return max_bead_count_ + 1;
+    }
+    else
+        return max_bead_count_ + 1;
+}
+
+coord_t FlattenedBeadingStrategy::getTransitioningLength(coord_t lower_bead_count) const
+{
+    if (lower_bead_count == 0)
+    {
+        return 10;
+    }
+    return default_transition_length_;
+}
+
+double FlattenedBeadingStrategy::getTransitionAnchorPos(coord_t lower_bead_count) const
+{
+    return getTransitionAnchorPosInset(lower_bead_count);
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::computeLimited(coord_t thickness, coord_t bead_count) const
+{
+    if (bead_count <= max_bead_count_)
+    {
+        Beading ret = computeInset(thickness, bead_count);
+        bead_count = ret.toolpath_locations.size();
+
+        if (bead_count % 2 == 0 && bead_count == max_bead_count_)
+        {
+            const coord_t innermost_toolpath_location = ret.toolpath_locations[max_bead_count_ / 2 - 1];
+            const coord_t innermost_toolpath_width = ret.bead_widths[max_bead_count_ / 2 - 1];
+            ret.toolpath_locations.insert(ret.toolpath_locations.begin() + max_bead_count_ / 2, innermost_toolpath_location + innermost_toolpath_width / 2);
+            ret.bead_widths.insert(ret.bead_widths.begin() + max_bead_count_ / 2, 0);
+        }
+        return ret;
+    }
+    assert(bead_count == max_bead_count_ + 1);
+    if (bead_count != max_bead_count_ + 1)
+    {
+        RUN_ONCE(spdlog::warn("Too many beads! {} != {}", bead_count, max_bead_count_ + 1));
+    }
+
+    coord_t optimal_thickness = getOptimalThicknessRedistributed(max_bead_count_);
+    Beading ret = computeInset(optimal_thickness, max_bead_count_);
+    bead_count = ret.toolpath_locations.size();
+    ret.left_over += thickness - ret.total_thickness;
+    ret.total_thickness = thickness;
+
+    // Enforce symmetry
+    if (bead_count % 2 == 1)
+    {
+        ret.toolpath_locations[bead_count / 2] = thickness / 2;
+        ret.bead_widths[bead_count / 2] = thickness - optimal_thickness;
+    }
+    for (coord_t bead_idx = 0; bead_idx < (bead_count + 1) / 2; bead_idx++)
+    {
+        ret.toolpath_locations[bead_count - 1 - bead_idx] = thickness - ret.toolpath_locations[bead_idx];
+    }
+
+    // Create a "fake" inner wall with 0 width to indicate the edge of the walled area.
+    coord_t innermost_toolpath_location = ret.toolpath_locations[max_bead_count_ / 2 - 1];
+    coord_t innermost_toolpath_width = ret.bead_widths[max_bead_count_ / 2 - 1];
+    ret.toolpath_locations.insert(ret.toolpath_locations.begin() + max_bead_count_ / 2, innermost_toolpath_location + innermost_toolpath_width / 2);
+    ret.bead_widths.insert(ret.bead_widths.begin() + max_bead_count_ / 2, 0);
+
+    // Symmetry on both sides.
+    const size_t opposite_bead = bead_count - (max_bead_count_ / 2 - 1);
+    innermost_toolpath_location = ret.toolpath_locations[opposite_bead];
+    innermost_toolpath_width = ret.bead_widths[opposite_bead];
+    ret.toolpath_locations.insert(ret.toolpath_locations.begin() + opposite_bead, innermost_toolpath_location - innermost_toolpath_width / 2);
+    ret.bead_widths.insert(ret.bead_widths.begin() + opposite_bead, 0);
+
+    return ret;
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::computeInset(coord_t thickness, coord_t bead_count) const
+{
+    Beading ret = computeWidened(thickness, bead_count);
+    if (outer_wall_offset_ <= 0)
+    {
+        return ret;
+    }
+
+    // Actual count and thickness as represented by extant walls. Don't count any potential zero-width 'signaling' walls.
+    bead_count = std::count_if(
+        ret.bead_widths.begin(),
+        ret.bead_widths.end(),
+        [](const coord_t width)
+        {
+            return width > 0;
+        });
+
+    // No need to apply any inset if there is just a single wall.
+    if (bead_count < 2)
+    {
+        return ret;
+    }
+
+    // Actually move the outer wall inside. Ensure that the outer wall never goes beyond the middle line.
+    ret.toolpath_locations[0] = std::min(ret.toolpath_locations[0] + outer_wall_offset_, thickness / 2);
+    return ret;
+}
+
+double FlattenedBeadingStrategy::getTransitionAnchorPosInset(coord_t lower_bead_count) const
+{
+    if (outer_wall_offset_ <= 0)
+    {
+        return getTransitionAnchorPosDistributed(lower_bead_count); // The widening and redistribution steps don't change the anchor position.
+    }
+
+    // The outer wall inset step doesn't pass this on, so it is computed from the optimal and transition thicknesses of the steps below it.
+    coord_t lower_optimum = getOptimalThicknessRedistributed(lower_bead_count);
+    coord_t transition_point = getTransitionThicknessWidened(lower_bead_count);
+    coord_t upper_optimum = getOptimalThicknessRedistributed(lower_bead_count + 1);
+    return 1.0 - static_cast<double>(transition_point - lower_optimum) / static_cast<double>(upper_optimum - lower_optimum);
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::computeWidened(coord_t thickness, coord_t bead_count) const
+{
+    if (! print_thin_walls_ || thickness >= optimal_width_)
+    {
+        return computeRedistributed(thickness, bead_count);
+    }
+
+    Beading ret;
+    ret.total_thickness = thickness;
+    if (thickness >= min_input_width_)
+    {
+        ret.bead_widths.emplace_back(std::max(thickness, min_output_width_));
+        ret.toolpath_locations.emplace_back(thickness / 2);
+        ret.left_over = 0; // Not covered by the widening step, which leaves this undefined.
+    }
+    else
+    {
+        ret.left_over = thickness;
+    }
+    return ret;
+}
+
+coord_t FlattenedBeadingStrategy::getTransitionThicknessWidened(coord_t lower_bead_count) const
+{
+    if (print_thin_walls_ && lower_bead_count == 0)
+    {
+        return min_input_width_;
+    }
+    return getTransitionThicknessRedistributed(lower_bead_count);
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalBeadCountWidened(coord_t thickness) const
+{
+    if (! print_thin_walls_)
+    {
+        return getOptimalBeadCountRedistributed(thickness);
+    }
+    if (thickness < min_input_width_)
+        return 0;
+    coord_t ret = getOptimalBeadCountRedistributed(thickness);
+    if (thickness >= min_input_width_ && ret < 1)
+        return 1;
+    return ret;
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::computeRedistributed(coord_t thickness, coord_t bead_count) const
+{
+    Beading ret;
+
+    // Take care of all situations in which no lines are actually produced:
+    if (bead_count == 0 || thickness < minimum_variable_line_ratio_ * optimal_width_outer_)
+    {
+        ret.left_over = thickness;
+        ret.total_thickness = thickness;
+        return ret;
+    }
+
+    // Compute the beadings of the inner walls, if any:
+    const coord_t inner_bead_count = bead_count - 2;
+    const coord_t inner_thickness = thickness - 2 * optimal_width_outer_;
+    if (inner_bead_count > 0 && inner_thickness > 0)
+    {
+        ret = computeDistributed(inner_thickness, inner_bead_count);
+        for (auto& toolpath_location : ret.toolpath_locations)
+        {
+            toolpath_location += optimal_width_outer_;
+        }
+    }
+
+    // Insert the outer wall(s) around the previously computed inner wall(s), which may be empty:
+    const coord_t actual_outer_thickness = bead_count > 2 ? std::min(thickness / 2, optimal_width_outer_) : thickness / bead_count;
+    ret.bead_widths.insert(ret.bead_widths.begin(), actual_outer_thickness);
+    ret.toolpath_locations.insert(ret.toolpath_locations.begin(), actual_outer_thickness / 2);
+    if (bead_count > 1)
+    {
+        ret.bead_widths.push_back(actual_outer_thickness);
+        ret.toolpath_locations.push_back(thickness - actual_outer_thickness / 2);
+    }
+
+    // Ensure correct total and left over thickness.
+    ret.total_thickness = thickness;
+    ret.left_over = thickness - std::accumulate(ret.bead_widths.cbegin(), ret.bead_widths.cend(), static_cast<coord_t>(0));
+    return ret;
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalThicknessRedistributed(coord_t bead_count) const
+{
+    const coord_t inner_bead_count = std::max(static_cast<coord_t>(0), bead_count - 2);
+    const coord_t outer_bead_count = bead_count - inner_bead_count;
+    return getOptimalThicknessDistributed(inner_bead_count) + optimal_width_outer_ * outer_bead_count;
+}
+
+coord_t FlattenedBeadingStrategy::getTransitionThicknessRedistributed(coord_t lower_bead_count) const
+{
+    switch (lower_bead_count)
+    {
+    case 0:
+        return minimum_variable_line_ratio_ * optimal_width_outer_;
+    case 1:
+        return (1.0 + wall_split_middle_threshold_) * optimal_width_outer_;
+    default:
+        return getTransitionThicknessDistributed(lower_bead_count - 2) + 2 * optimal_width_outer_;
+    }
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalBeadCountRedistributed(coord_t thickness) const
+{
+    if (thickness < minimum_variable_line_ratio_ * optimal_width_outer_)
+    {
+        return 0;
+    }
+    if (thickness <= 2 * optimal_width_outer_)
+    {
+        return thickness > (1.0 + wall_split_middle_threshold_) * optimal_width_outer_ ? 2 : 1;
+    }
+    return getOptimalBeadCountDistributed(thickness - 2 * optimal_width_outer_) + 2;
+}
+
+FlattenedBeadingStrategy::Beading FlattenedBeadingStrategy::computeDistributed(coord_t thickness, coord_t bead_count) const
+{
+    Beading ret;
+
+    ret.total_thickness = thickness;
+    if (bead_count > 2)
+    {
+        const coord_t to_be_divided = thickness - bead_count * optimal_width_;
+        const double middle = static_cast<double>(bead_count - 1) / 2;
+
+        const auto getWeight = [middle, this](coord_t bead_idx)
+        {
+            const double dev_from_middle = bead_idx - middle;
+            return std::max(0.0, 1.0 - one_over_distribution_radius_squared_ * dev_from_middle * dev_from_middle);
+        };
+
+        std::vector<double> weights;
+        weights.resize(bead_count);
+        for (coord_t bead_idx = 0; bead_idx < bead_count; bead_idx++)
+        {
+            weights[bead_idx] = getWeight(bead_idx);
+        }
+
+        const double total_weight = std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+        ret.bead_widths.reserve(bead_count + 2); // The outer walls and the limiting marker are added later on.
+        ret.toolpath_locations.reserve(bead_count + 2);
+        for (coord_t bead_idx = 0; bead_idx < bead_count; bead_idx++)
+        {
+            const double weight_fraction = weights[bead_idx] / total_weight;
+            const coord_t splitup_left_over_weight = to_be_divided * weight_fraction;
+            const coord_t width = optimal_width_ + splitup_left_over_weight;
+            if (bead_idx == 0)
+            {
+                ret.toolpath_locations.emplace_back(width / 2);
+            }
+            else
+            {
+                ret.toolpath_locations.emplace_back(ret.toolpath_locations.back() + (ret.bead_widths.back() + width) / 2);
+            }
+            ret.bead_widths.emplace_back(width);
+        }
+        ret.left_over = 0;
+    }
+    else if (bead_count == 2)
+    {
+        const coord_t outer_width = thickness / 2;
+        ret.bead_widths.emplace_back(outer_width);
+        ret.bead_widths.emplace_back(outer_width);
+        ret.toolpath_locations.emplace_back(outer_width / 2);
+        ret.toolpath_locations.emplace_back(thickness - outer_width / 2);
+        ret.left_over = 0;
+    }
+    else if (bead_count == 1)
+    {
+        const coord_t outer_width = thickness;
+        ret.bead_widths.emplace_back(outer_width);
+        ret.toolpath_locations.emplace_back(outer_width / 2);
+        ret.left_over = 0;
+    }
+    else
+    {
+        ret.left_over = thickness;
+    }
+
+    return ret;
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalThicknessDistributed(coord_t bead_count) const
+{
+    return optimal_width_ * bead_count;
+}
+
+coord_t FlattenedBeadingStrategy::getTransitionThicknessDistributed(coord_t lower_bead_count) const
+{
+    const coord_t lower_ideal_width = getOptimalThicknessDistributed(lower_bead_count);
+    const coord_t higher_ideal_width = getOptimalThicknessDistributed(lower_bead_count + 1);
+    const Ratio threshold = lower_bead_count % 2 == 1 ? wall_split_middle_threshold_ : wall_add_middle_threshold_;
+    return lower_ideal_width + threshold * (higher_ideal_width - lower_ideal_width);
+}
+
+coord_t FlattenedBeadingStrategy::getOptimalBeadCountDistributed(coord_t thickness) const
+{
+    const coord_t naive_count = thickness / optimal_width_; // How many lines we can fit in for sure.
+    const coord_t remainder = thickness - naive_count * optimal_width_; // Space left after fitting that many lines.
+    const coord_t minimum_line_width = optimal_width_ * (naive_count % 2 == 1 ? wall_split_middle_threshold_ : wall_add_middle_threshold_);
+    return naive_count + (remainder >= minimum_line_width); // If there's enough space, fit an extra one.
+}
+
+double FlattenedBeadingStrategy::getTransitionAnchorPosDistributed(coord_t lower_bead_count) const
+{
+    coord_t lower_optimum = getOptimalThicknessDistributed(lower_bead_count);
+    coord_t transition_point = getTransitionThicknessDistributed(lower_bead_count);
+    coord_t upper_optimum = getOptimalThicknessDistributed(lower_bead_count + 1);
+    return 1.0 - static_cast<double>(transition_point - lower_optimum) / static_cast<double>(upper_optimum - lower_optimum);
+}
+
+} // namespace cura
@@ -14,6 +14,7 @@
 
 #include <range/v3/view/chunk_by.hpp>
 #include <range/v3/view/concat.hpp>
+#include <range/v3/view/map.hpp>
 #include <spdlog/spdlog.h>
 
 #include "Application.h"
@@ -35,6 +36,7 @@
 #include "raft.h"
 #include "utils/Simplify.h" //Removing micro-segments created by offsetting.
 #include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
 #include "utils/linearAlg2D.h"
 #include "utils/math.h"
 #include "utils/orderOptimizer.h"
@@ -58,9 +60,9 @@ FffGcodeWriter::FffGcodeWriter()
     }
 }
 
-void FffGcodeWriter::setTargetStream(std::ostream* stream)
+void FffGcodeWriter::setTargetSink(std::shared_ptr<GCodeSink> sink)
 {
-    gcode.setOutputStream(stream);
+    gcode.setOutput(std::move(sink));
 }
 
 bool FffGcodeWriter::getExtruderActualUse(int extruder_nr)
@@ -80,10 +82,10 @@ std::vector<Duration> FffGcodeWriter::getTotalPrintTimePerFeature()
 
 bool FffGcodeWriter::setTargetFile(const char* filename)
 {
-    output_file.open(filename);
-    if (output_file.is_open())
+    auto output_file = std::make_shared<FileGCodeSink>(filename);
+    if (output_file->isOpen())
     {
-        gcode.setOutputStream(&output_file);
+        gcode.setOutput(std::move(output_file));
         return true;
     }
     return false;
@@ -91,6 +93,7 @@ bool FffGcodeWriter::setTargetFile(const char* filename)
 
 void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keeper)
 {
+    storage.invalidateLayerOutlines(); // Start the export with the final state of the outlines
     const size_t start_extruder_nr = getStartExtruder(storage);
     gcode.preSetup(start_extruder_nr);
     gcode.setSliceUUID(slice_uuid);
@@ -188,18 +191,40 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
         }
     }
 
+    // Processing a layer reads the slice data of a few layers around it, so all of those are decompressed while it is processed.
+    LayerIndex::value_type layers_below = 3; // Bridging skin looks up to three layers down.
+    LayerIndex::value_type layers_above = 0;
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        const Settings& settings = mesh->settings;
+        const auto flooring_layer_count = std::min(settings.get<size_t>("flooring_layer_count"), settings.get<size_t>("bottom_layers"));
+        const auto roofing_layer_count = std::min(settings.get<size_t>("roofing_layer_count"), settings.get<size_t>("top_layers"));
+        const auto skin_edge_support_layers = settings.get<size_t>("skin_edge_support_layers");
+        layers_below = std::max(layers_below, static_cast<LayerIndex::value_type>(flooring_layer_count));
+        layers_above = std::max({ layers_above, static_cast<LayerIndex::value_type>(roofing_layer_count), static_cast<LayerIndex::value_type>(1 + skin_edge_support_layers) });
+    }
+
     run_multiple_producers_ordered_consumer(
         process_layer_starting_layer_nr,
         total_layers,
-        [&storage, total_layers, this](int layer_nr)
+        [&storage, total_layers, layers_below, layers_above, this](int layer_nr)
         {
-            return std::make_optional(processLayer(storage, layer_nr, total_layers));
+            TraceSpan span("layer plan", "processLayer", layer_nr);
+            const LayerIndex first_read_layer_nr = LayerIndex(layer_nr) - layers_below;
+            const LayerIndex last_read_layer_nr = LayerIndex(layer_nr) + layers_above;
+            storage.decompressLayers(first_read_layer_nr, last_read_layer_nr);
+            std::optional<ProcessLayerResult> result = std::make_optional(processLayer(storage, layer_nr, total_layers));
+            storage.releaseLayers(first_read_layer_nr, last_read_layer_nr);
+            storage.evictLayerOutlines(layer_nr);
+            return result;
         },
         [this, total_layers](std::optional<ProcessLayerResult> result_opt)
         {
             const ProcessLayerResult& result = result_opt.value();
+            TraceSpan span("gcode", "writeLayer", result.layer_plan->getLayerNr());
             Progress::messageProgressLayer(result.layer_plan->getLayerNr(), total_layers, result.total_elapsed_time, result.stages_times);
             layer_plan_buffer.handle(*result.layer_plan, gcode);
+            Tracer::getInstance().addMemoryCounter();
         });
 
     layer_plan_buffer.flush();
@@ -3040,7 +3065,7 @@ bool FffGcodeWriter::processInsets(
     {
         // accumulate the outlines of all of the parts that are on the layer below
 
-        Shape outlines_below;
+        std::vector<const Shape*> areas_below;
         AABB boundaryBox(part.outline);
         for (const std::shared_ptr<SliceMeshStorage>& mesh_ptr : storage.meshes)
         {
@@ -3051,7 +3076,7 @@ bool FffGcodeWriter::processInsets(
                 {
                     if (boundaryBox.hit(prevLayerPart.boundaryBox))
                     {
-                        outlines_below.push_back(prevLayerPart.outline);
+                        areas_below.push_back(&prevLayerPart.outline);
                     }
                 }
             }
@@ -3077,7 +3102,7 @@ bool FffGcodeWriter::processInsets(
                     AABB support_roof_bb(support_layer.support_roof);
                     if (boundaryBox.hit(support_roof_bb))
                     {
-                        outlines_below.push_back(support_layer.support_roof);
+                        areas_below.push_back(&support_layer.support_roof);
                     }
                 }
                 else
@@ -3087,7 +3112,7 @@ bool FffGcodeWriter::processInsets(
                         AABB support_part_bb(support_part.getInfillArea());
                         if (boundaryBox.hit(support_part_bb))
                         {
-                            outlines_below.push_back(support_part.getInfillArea());
+                            areas_below.push_back(&support_part.getInfillArea());
                         }
                     }
                 }
@@ -3096,9 +3121,9 @@ bool FffGcodeWriter::processInsets(
 
         const int half_outer_wall_width = mesh_config.inset0_config.getLineWidth() / 2;
 
-        // remove those parts of the layer below that are narrower than a wall line width as they will not be printed
-
-        outlines_below = outlines_below.offset(-half_outer_wall_width).offset(half_outer_wall_width);
+        // Parts resting on the same areas, like many small parts on a large one, share the regions supported by them.
+        LayerPlan::SupportedRegions& supported_regions = gcode_layer.getSupportedRegions(std::move(areas_below), half_outer_wall_width);
+        const Shape& outlines_below = supported_regions.outlines_below;
 
         if (mesh.settings.get<bool>("bridge_settings_enabled"))
         {
@@ -3133,26 +3158,28 @@ bool FffGcodeWriter::processInsets(
             gcode_layer.setBridgeWallMask(Shape());
         }
 
-        const Shape fully_supported_region = outlines_below.offset(-half_outer_wall_width);
         const Shape part_print_region = part.outline.offset(-half_outer_wall_width);
 
-        const auto get_supported_region = [&fully_supported_region, &layer_height](const AngleDegrees& overhang_angle) -> Shape
+        // the supported region is made up of those areas that really are supported by either model or support on the layer below
+        // expanded to take into account the overhang angle, the greater the overhang angle, the larger the supported area is
+        // considered to be
+        const auto supported_distance = [&layer_height](const AngleDegrees& overhang_angle) -> coord_t
+        {
+            const coord_t overhang_width = layer_height * std::tan(AngleRadians(overhang_angle));
+            return overhang_width + 10;
+        };
+        const auto get_supported_region = [&supported_regions, &supported_distance](const AngleDegrees& overhang_angle) -> Shape
         {
-            // the overhang mask is set to the area of the current part's outline minus the region that is considered to be supported
-            // the supported region is made up of those areas that really are supported by either model or support on the layer below
-            // expanded to take into account the overhang angle, the greater the overhang angle, the larger the supported area is
-            // considered to be
             if (overhang_angle < 90.0)
             {
-                const coord_t overhang_width = layer_height * std::tan(AngleRadians(overhang_angle));
-                return fully_supported_region.offset(overhang_width + 10);
+                return supported_regions.expanded_regions.at(supported_distance(overhang_angle));
             }
 
             return Shape();
         };
 
         // Build supported regions for all the overhang speeds. For a visual explanation of the result, see doc/gradual_overhang_speed.svg
-        std::vector<LayerPlan::OverhangMask> overhang_masks;
+        std::vector<std::pair<AngleDegrees, Ratio>> overhang_mask_angles;
         const auto overhang_speed_factors = mesh.settings.get<std::vector<Ratio>>("wall_overhang_speed_factors");
         const size_t overhang_angles_count = overhang_speed_factors.size();
         const auto wall_overhang_angle = mesh.settings.get<AngleDegrees>("wall_overhang_angle");
@@ -3197,15 +3224,37 @@ bool FffGcodeWriter::processInsets(
                 for (const auto& regions : merged_regions)
                 {
                     const SpeedRegion& last_region = *ranges::prev(regions.end());
-                    overhang_masks.push_back(LayerPlan::OverhangMask{ get_supported_region(last_region.overhang_angle), last_region.speed_factor });
+                    overhang_mask_angles.emplace_back(last_region.overhang_angle, last_region.speed_factor);
                 }
             }
         }
+        const AngleDegrees seam_overhang_angle = mesh.settings.get<AngleDegrees>("seam_overhang_angle");
+
+        // All supported regions are concentric around the same fully supported region, so compute the ones that are used all at once.
+        std::vector<coord_t> supported_distances;
+        for (const AngleDegrees& overhang_angle : overhang_mask_angles | ranges::views::keys)
+        {
+            if (overhang_angle < 90.0)
+            {
+                supported_distances.push_back(supported_distance(overhang_angle));
+            }
+        }
+        if (seam_overhang_angle < 90.0)
+        {
+            supported_distances.push_back(supported_distance(seam_overhang_angle));
+        }
+        supported_regions.expand(supported_distances);
+
+        std::vector<LayerPlan::OverhangMask> overhang_masks;
+        for (const auto& [overhang_angle, speed_factor] : overhang_mask_angles)
+        {
+            // the overhang mask is set to the area of the current part's outline minus the region that is considered to be supported
+            overhang_masks.push_back(LayerPlan::OverhangMask{ get_supported_region(overhang_angle), speed_factor });
+        }
         gcode_layer.setOverhangMasks(overhang_masks);
 
         // the seam overhang mask is set to the area of the current part's outline minus the region that is considered to be supported,
         // which will then be empty if everything is considered supported i.r.t. the angle
-        const AngleDegrees seam_overhang_angle = mesh.settings.get<AngleDegrees>("seam_overhang_angle");
         if (seam_overhang_angle < 90.0)
         {
             const Shape supported_region_seam = get_supported_region(seam_overhang_angle);
@@ -49,6 +49,7 @@
 #include "settings/types/LayerIndex.h"
 #include "utils/algorithm.h"
 #include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
 #include "utils/gettime.h"
 #include "utils/math.h"
 #include "PrimeTower/PrimeTower.h"
@@ -206,28 +207,17 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         return true; // This is NOT an error state!
     }
 
-    std::vector<Slicer*> slicerList;
-    for (unsigned int mesh_idx = 0; mesh_idx < meshgroup->meshes.size(); mesh_idx++)
+    // Check if adaptive layers is populated to prevent accessing a method on NULL
+    std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
+    if (adaptive_layer_heights != nullptr)
     {
-        // Check if adaptive layers is populated to prevent accessing a method on NULL
-        std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
-        if (adaptive_layer_heights != nullptr)
-        {
-            adaptive_layer_height_values = adaptive_layer_heights->getLayers();
-        }
-
-        Mesh& mesh = meshgroup->meshes[mesh_idx];
-
-        const SlicingTolerance slicing_tolerance = mesh.settings_.get<SlicingTolerance>("slicing_tolerance");
-
-        Slicer* slicer
-            = new Slicer(&mesh, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values, slicing_tolerance, initial_layer_thickness);
-
-        slicerList.push_back(slicer);
-
-        Progress::messageProgress(Progress::Stage::SLICING, mesh_idx + 1, meshgroup->meshes.size());
+        adaptive_layer_height_values = adaptive_layer_heights->getLayers();
     }
 
+    std::vector<Slicer*> slicerList
+        = Slicer::sliceMeshes(*meshgroup, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values, initial_layer_thickness);
+    Progress::messageProgress(Progress::Stage::SLICING, 1, 1);
+
     // Clear the mesh face and vertex data, it is no longer needed after this point, and it saves a lot of memory.
     meshgroup->clear();
 
@@ -414,10 +404,24 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
 
     Progress::messageProgressStage(Progress::Stage::SUPPORT, &time_keeper);
 
-    AreaSupport::generateOverhangAreas(storage);
-    AreaSupport::generateSupportAreas(storage);
-    TreeSupport tree_support_generator(storage);
-    tree_support_generator.generateSupportAreas(storage);
+    // The walls have set the print outlines of the parts, and empty first layers may have been removed
+    storage.invalidateLayerOutlines();
+
+    {
+        TraceSpan span("support", "generateOverhangAreas");
+        AreaSupport::generateOverhangAreas(storage);
+    }
+    {
+        TraceSpan span("support", "generateSupportAreas");
+        AreaSupport::generateSupportAreas(storage);
+        storage.invalidateLayerOutlines();
+    }
+    {
+        TraceSpan span("tree support", "generateSupportAreas");
+        TreeSupport tree_support_generator(storage);
+        tree_support_generator.generateSupportAreas(storage);
+        storage.invalidateLayerOutlines();
+    }
 
     computePrintHeightStatistics(storage);
 
@@ -436,6 +440,7 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     {
         spdlog::debug("Processing platform adhesion");
         processPlatformAdhesion(storage);
+        storage.invalidateLayerOutlines(); // The raft outlines are set and the brim is removed from the support
     }
 
     spdlog::debug("Meshes post-processing");
@@ -443,6 +448,10 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     for (std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
     {
         processDerivedWallsSkinInfill(*mesh);
+
+        // The slice data of this mesh is complete. Store it compactly until the layers that read it are written.
+        TraceSpan span("slice data", "compressLayers");
+        mesh->compressLayers();
     }
 
     spdlog::debug("Processing gradual support");
@@ -507,6 +516,7 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
         [&](size_t layer_number)
         {
             spdlog::debug("Processing insets for layer {} of {}", layer_number, mesh.layers.size());
+            TraceSpan span("walls", "processWalls", layer_number, mesh_idx);
             processWalls(mesh, layer_number);
             guarded_progress++;
         });
@@ -552,6 +562,7 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
             spdlog::debug("Processing skins and infill layer {} of {}", layer_number, mesh.layers.size());
             if (! magic_spiralize || layer_number < mesh_max_initial_bottom_layer_count) // Only generate up/downskin and infill for the first X layers when spiralize is choosen.
             {
+                TraceSpan span("skins", "processSkinsAndInfill", layer_number, mesh_idx);
                 processSkinsAndInfill(mesh, layer_number, process_infill);
             }
             guarded_progress++;
@@ -10,32 +10,37 @@ FffProcessor FffProcessor::instance; // definition must be in cpp
 
 bool FffProcessor::setTargetFile(const char* filename)
 {
-    return gcode_writer.setTargetFile(filename);
+    return gcode_writer->setTargetFile(filename);
 }
 
-void FffProcessor::setTargetStream(std::ostream* stream)
+void FffProcessor::setTargetSink(std::shared_ptr<GCodeSink> sink)
 {
-    return gcode_writer.setTargetStream(stream);
+    gcode_writer->setTargetSink(std::move(sink));
 }
 
 bool FffProcessor::getExtruderActualUse(int extruder_nr)
 {
-    return gcode_writer.getExtruderActualUse(extruder_nr);
+    return gcode_writer->getExtruderActualUse(extruder_nr);
 }
 
 double FffProcessor::getTotalFilamentUsed(int extruder_nr)
 {
-    return gcode_writer.getTotalFilamentUsed(extruder_nr);
+    return gcode_writer->getTotalFilamentUsed(extruder_nr);
 }
 
 std::vector<Duration> FffProcessor::getTotalPrintTimePerFeature()
 {
-    return gcode_writer.getTotalPrintTimePerFeature();
+    return gcode_writer->getTotalPrintTimePerFeature();
 }
 
 void FffProcessor::finalize()
 {
-    gcode_writer.finalize();
+    gcode_writer->finalize();
+}
+
+void FffProcessor::reset()
+{
+    gcode_writer = std::make_unique<FffGcodeWriter>();
 }
 
 } // namespace cura
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "GCodeSink.h"
+
+#include <limits>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace cura
+{
+
+namespace
+{
+constexpr size_t max_reserved_chunk_size = 4 * 1024 * 1024; //!< Larger chunk sizes are considered unbounded.
+constexpr size_t unbounded_reserved_size = 64 * 1024; //!< Initial capacity of the buffer when the chunk size is unbounded.
+constexpr size_t reserved_slack = 4096; //!< Room for the write that crosses the chunk size, so that the buffer doesn't reallocate.
+} // namespace
+
+GCodeSink::GCodeSink(const size_t chunk_size)
+    : chunk_size_(chunk_size)
+{
+    reserveBuffer();
+}
+
+void GCodeSink::flush()
+{
+    if (! buffer_.empty())
+    {
+        drain();
+    }
+}
+
+void GCodeSink::drain()
+{
+    consume(buffer_);
+    buffer_.clear();
+    reserveBuffer(); // In case the implementation took the buffer.
+}
+
+void GCodeSink::reserveBuffer()
+{
+    buffer_.reserve(chunk_size_ <= max_reserved_chunk_size ? chunk_size_ + reserved_slack : unbounded_reserved_size);
+}
+
+StreamGCodeSink::StreamGCodeSink(std::ostream* stream)
+    : GCodeSink(0)
+    , stream_(stream)
+{
+}
+
+StreamGCodeSink::~StreamGCodeSink()
+{
+    GCodeSink::flush();
+}
+
+void StreamGCodeSink::flush()
+{
+    GCodeSink::flush();
+    stream_->flush();
+}
+
+void StreamGCodeSink::consume(std::string& gcode)
+{
+    stream_->write(gcode.data(), static_cast<std::streamsize>(gcode.size()));
+}
+
+FileGCodeSink::FileGCodeSink(const std::filesystem::path& path)
+    : GCodeSink(chunk_size)
+    , file_(std::fopen(path.string().c_str(), "w")) // Text mode, so that line endings are the same as for a std::ofstream.
+{
+    if (file_ != nullptr)
+    {
+        // The chunks are large enough, the C library doesn't need to copy them into a buffer of its own first.
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+    }
+}
+
+FileGCodeSink::~FileGCodeSink()
+{
+    GCodeSink::flush();
+    if (file_ != nullptr)
+    {
+        std::fclose(file_);
+    }
+}
+
+bool FileGCodeSink::isOpen() const
+{
+    return file_ != nullptr;
+}
+
+void FileGCodeSink::consume(std::string& gcode)
+{
+    if (file_ == nullptr)
+    {
+        return;
+    }
+    if (std::fwrite(gcode.data(), 1, gcode.size(), file_) != gcode.size() && ! write_failed_)
+    {
+        write_failed_ = true;
+        spdlog::error("Failed to write the g-code to the output file.");
+    }
+}
+
+BufferGCodeSink::BufferGCodeSink()
+    : GCodeSink(std::numeric_limits<size_t>::max())
+{
+}
+
+std::string BufferGCodeSink::take()
+{
+    flush();
+    return std::exchange(taken_, std::string());
+}
+
+void BufferGCodeSink::consume(std::string& gcode)
+{
+    if (taken_.empty())
+    {
+        taken_.swap(gcode); // Hand over the buffer itself, without copying the g-code.
+    }
+    else
+    {
+        taken_.append(gcode);
+    }
+}
+
+} // namespace cura
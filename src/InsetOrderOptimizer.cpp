@@ -3,28 +3,28 @@
 
 #include "InsetOrderOptimizer.h"
 
-#include <functional>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <range/v3/algorithm/max.hpp>
-#include <range/v3/algorithm/stable_sort.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/addressof.hpp>
 #include <range/v3/view/any_view.hpp>
 #include <range/v3/view/drop.hpp>
 #include <range/v3/view/drop_last.hpp>
-#include <range/v3/view/filter.hpp>
 #include <range/v3/view/join.hpp>
 #include <range/v3/view/remove_if.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/take_exactly.hpp>
-#include <range/v3/view/transform.hpp>
 
 #include "ExtruderTrain.h"
 #include "FffGcodeWriter.h"
 #include "LayerPlan.h"
+#include "utils/AABB.h"
 #include "utils/views/convert.h"
-#include "utils/views/dfs.h"
 
 namespace rg = ranges;
 namespace rv = ranges::views;
@@ -32,6 +32,91 @@ namespace rv = ranges::views;
 namespace cura
 {
 
+namespace
+{
+
+/*!
+ * Undirected graph between extrusion lines, identified by their index.
+ *
+ * The neighbours of all lines are stored in a single array, in which the neighbours of each line are stored consecutively.
+ */
+class LineGraph
+{
+public:
+    static constexpr size_t no_line = std::numeric_limits<size_t>::max();
+
+    /*!
+     * \param line_count The number of lines in the graph.
+     * \param edges The pairs of lines which are connected to each other.
+     */
+    LineGraph(const size_t line_count, const std::vector<std::pair<size_t, size_t>>& edges)
+        : offsets_(line_count + 1, 0)
+        , neighbours_(edges.size() * 2)
+        , visited_(line_count, false)
+    {
+        for (const auto& [a, b] : edges)
+        {
+            offsets_[a + 1]++;
+            offsets_[b + 1]++;
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+        std::vector<size_t> fill = offsets_;
+        for (const auto& [a, b] : edges)
+        {
+            neighbours_[fill[a]++] = b;
+            neighbours_[fill[b]++] = a;
+        }
+    }
+
+    /*!
+     * Walk through all lines connected to a line, depth-first.
+     * \param start The line to start from.
+     * \param handle_node Called once for every line that is reached, with the line, the line through which it was reached (or \ref no_line
+     * for the start line) and the number of steps from the start line.
+     */
+    template<typename F>
+    void dfs(const size_t start, F&& handle_node)
+    {
+        struct Visit
+        {
+            size_t line;
+            size_t parent;
+            unsigned int depth;
+        };
+        std::vector<Visit> stack{ Visit{ start, no_line, 0 } };
+        std::vector<size_t> visited_lines;
+        while (! stack.empty())
+        {
+            const Visit visit = stack.back();
+            stack.pop_back();
+            if (visited_[visit.line])
+            {
+                continue;
+            }
+            visited_[visit.line] = true;
+            visited_lines.push_back(visit.line);
+            handle_node(visit.line, visit.parent, visit.depth);
+
+            // Push the neighbours in reverse, so that they are visited in order.
+            for (size_t neighbour_idx = offsets_[visit.line + 1]; neighbour_idx > offsets_[visit.line]; neighbour_idx--)
+            {
+                stack.push_back(Visit{ neighbours_[neighbour_idx - 1], visit.line, visit.depth + 1 });
+            }
+        }
+        for (const size_t line : visited_lines)
+        {
+            visited_[line] = false;
+        }
+    }
+
+private:
+    std::vector<size_t> offsets_; //!< The neighbours of line i are stored from offsets_[i] up to offsets_[i + 1].
+    std::vector<size_t> neighbours_;
+    std::vector<bool> visited_; //!< Lines visited by the current walk through the graph.
+};
+
+} // namespace
+
 InsetOrderOptimizer::InsetOrderOptimizer(
     const FffGcodeWriter& gcode_writer,
     const SliceDataStorage& storage,
@@ -303,126 +388,126 @@ InsetOrderOptimizer::value_type InsetOrderOptimizer::getRegionOrder(const std::v
         return {};
     }
 
-    // view on the extrusion lines, sorted by area
-    const std::vector<const ExtrusionLine*> sorted_extrusion_lines = [&extrusion_lines]()
+    // indices of the extrusion lines, sorted by area
+    const std::vector<size_t> sorted_line_indices = [&extrusion_lines]()
     {
-        auto extrusion_lines_area = extrusion_lines | ranges::views::addressof
-                                  | ranges::views::transform(
-                                        [](const ExtrusionLine* line)
-                                        {
-                                            const Polygon poly = line->toPolygon();
-                                            AABB aabb;
-                                            aabb.include(poly);
-                                            return std::make_pair(line, aabb.area());
-                                        })
-                                  | ranges::to_vector;
-
-        ranges::stable_sort(
-            extrusion_lines_area,
-            [](const auto& lhs, const auto& rhs)
+        std::vector<coord_t> areas;
+        areas.reserve(extrusion_lines.size());
+        for (const ExtrusionLine& line : extrusion_lines)
+        {
+            AABB aabb;
+            for (const ExtrusionJunction& junction : line)
             {
-                return std::get<1>(lhs) < std::get<1>(rhs);
-            });
+                aabb.include(junction.p_);
+            }
+            areas.push_back(aabb.area());
+        }
 
-        return extrusion_lines_area
-             | ranges::views::transform(
-                   [](const auto& pair)
-                   {
-                       return std::get<0>(pair);
-                   })
-             | ranges::to_vector;
+        std::vector<size_t> indices(extrusion_lines.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::stable_sort(
+            indices.begin(),
+            indices.end(),
+            [&areas](const size_t lhs, const size_t rhs)
+            {
+                return areas[lhs] < areas[rhs];
+            });
+        return indices;
     }();
 
-    // graph will contain the parent-child relationships between the extrusion lines
-    // an edge is added for both the parent to child and child to parent relationship
-    std::unordered_multimap<const ExtrusionLine*, const ExtrusionLine*> graph;
+    // edges will contain the parent-child relationships between the extrusion lines
+    std::vector<std::pair<size_t, size_t>> edges;
     // during the loop we maintain a list of invariant parents; these are the parents
     // that we have found so far
-    std::unordered_set<const ExtrusionLine*> invariant_outer_parents;
-    for (const auto& extrusion_line : sorted_extrusion_lines)
+    std::vector<size_t> invariant_outer_parents;
+    for (const size_t line_idx : sorted_line_indices)
     {
-        // Create a polygon representing the inner area of the extrusion line; any
-        // point inside this polygon is considered to the child of the extrusion line.
-        Shape hole_polygons;
-        if (extrusion_line->is_closed_)
+        const ExtrusionLine& extrusion_line = extrusion_lines[line_idx];
+        if (! extrusion_line.is_closed_)
         {
-            hole_polygons.push_back(extrusion_line->toPolygon());
-        }
-
-        if (hole_polygons.empty())
-        {
-            invariant_outer_parents.emplace(extrusion_line);
+            invariant_outer_parents.push_back(line_idx);
             continue;
         }
 
+        // Create a polygon representing the inner area of the extrusion line; any
+        // point inside this polygon is considered to the child of the extrusion line.
+        Shape hole_polygons;
+        hole_polygons.push_back(extrusion_line.toPolygon());
+
         // go through all the invariant parents and see if they are inside the hole polygon
         // if they are, then that means we have found a child for this extrusion line
-        std::vector<const ExtrusionLine*> removed_parent_invariants;
-        for (const ExtrusionLine* invariant_parent : invariant_outer_parents)
+        size_t kept_parents = 0;
+        for (const size_t invariant_parent : invariant_outer_parents)
         {
-            if (hole_polygons.inside(invariant_parent->junctions_[0].p_, false))
+            if (hole_polygons.inside(extrusion_lines[invariant_parent].junctions_[0].p_, false))
             {
                 // The root polygon is inside the location polygon. It is no longer a root in the graph we are building.
                 // Add this relationship (locator <-> root) to the graph, and remove root from roots.
-                graph.emplace(extrusion_line, invariant_parent);
-                graph.emplace(invariant_parent, extrusion_line);
-                removed_parent_invariants.emplace_back(invariant_parent);
+                edges.emplace_back(line_idx, invariant_parent);
+            }
+            else
+            {
+                invariant_outer_parents[kept_parents++] = invariant_parent;
             }
         }
-        for (const auto& node : removed_parent_invariants)
-        {
-            invariant_outer_parents.erase(node);
-        }
+        invariant_outer_parents.resize(kept_parents);
 
         // the current extrusion line is now an invariant parent
-        invariant_outer_parents.emplace(extrusion_line);
+        invariant_outer_parents.push_back(line_idx);
     }
+    LineGraph graph(extrusion_lines.size(), edges);
 
-    const std::vector<const ExtrusionLine*> outer_walls = extrusion_lines | ranges::views::filter(&ExtrusionLine::is_outer_wall) | ranges::views::addressof | ranges::to_vector;
+    std::vector<size_t> outer_walls;
+    for (size_t line_idx = 0; line_idx < extrusion_lines.size(); line_idx++)
+    {
+        if (extrusion_lines[line_idx].is_outer_wall())
+        {
+            outer_walls.push_back(line_idx);
+        }
+    }
 
     // find for each line the closest outer line, and store this in closest_outer_wall_line
-    std::unordered_map<const ExtrusionLine*, const ExtrusionLine*> closest_outer_wall_line;
-    std::unordered_map<const ExtrusionLine*, unsigned int> min_depth;
-    for (const ExtrusionLine* outer_wall : outer_walls)
+    std::vector<size_t> closest_outer_wall_line(extrusion_lines.size(), LineGraph::no_line);
+    std::vector<unsigned int> min_depth(extrusion_lines.size(), std::numeric_limits<unsigned int>::max());
+    for (const size_t outer_wall : outer_walls)
     {
-        const std::function<void(const ExtrusionLine*, const unsigned int)> update_nodes
-            = [&outer_wall, &min_depth, &closest_outer_wall_line](const ExtrusionLine* current_line, const unsigned int depth)
-        {
-            if (min_depth.find(current_line) == min_depth.end() || depth < min_depth[current_line])
+        graph.dfs(
+            outer_wall,
+            [outer_wall, &min_depth, &closest_outer_wall_line](const size_t current_line, const size_t, const unsigned int depth)
             {
-                min_depth[current_line] = depth;
-                closest_outer_wall_line[current_line] = outer_wall;
-            }
-        };
-        actions::dfs_depth_state(outer_wall, graph, update_nodes);
+                if (depth < min_depth[current_line])
+                {
+                    min_depth[current_line] = depth;
+                    closest_outer_wall_line[current_line] = outer_wall;
+                }
+            });
     }
 
     // for each of the outer walls, perform a dfs until we have found an extrusion line that is
     // _not_ closest to the current outer wall, then stop the dfs traversal for that branch. For
     // each extrusion $e$ traversed in the dfs, add an order constraint between to $e$ and the
     // previous line in the dfs traversal of $e$.
-    std::unordered_multimap<const ExtrusionLine*, const ExtrusionLine*> order;
-    for (const ExtrusionLine* outer_wall : outer_walls)
+    value_type order;
+    for (const size_t outer_wall : outer_walls)
     {
-        const std::function<void(const ExtrusionLine*, const ExtrusionLine*)> set_order_constraints
-            = [&order, &closest_outer_wall_line, &outer_wall, &outer_to_inner](const auto& current_line, const auto& parent_line)
-        {
-            // if the closest
-            if (closest_outer_wall_line[current_line] == outer_wall && parent_line != nullptr)
+        graph.dfs(
+            outer_wall,
+            [&order, &extrusion_lines, &closest_outer_wall_line, outer_wall, outer_to_inner](const size_t current_line, const size_t parent_line, const unsigned int)
             {
-                // flip the key values if we want to print from inner to outer walls
-                if (outer_to_inner)
-                {
-                    order.insert(std::make_pair(parent_line, current_line));
-                }
-                else
+                // if the closest
+                if (closest_outer_wall_line[current_line] == outer_wall && parent_line != LineGraph::no_line)
                 {
-                    order.insert(std::make_pair(current_line, parent_line));
+                    // flip the key values if we want to print from inner to outer walls
+                    if (outer_to_inner)
+                    {
+                        order.emplace(&extrusion_lines[parent_line], &extrusion_lines[current_line]);
+                    }
+                    else
+                    {
+                        order.emplace(&extrusion_lines[current_line], &extrusion_lines[parent_line]);
+                    }
                 }
-            }
-        };
-
-        actions::dfs_parent_state(outer_wall, graph, set_order_constraints);
+            });
     }
 
     return order;
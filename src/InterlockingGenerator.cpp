@@ -15,6 +15,9 @@
 #include "geometry/PointMatrix.h"
 #include "settings/types/LayerIndex.h"
 #include "slicer.h"
+#include "utils/AABB.h"
+#include "utils/ThreadPool.h"
+#include "utils/VoxelBitGrid.h"
 #include "utils/VoxelUtils.h"
 #include "utils/polygonUtils.h"
 
@@ -90,7 +93,7 @@ std::pair<Shape, Shape> InterlockingGenerator::growBorderAreasPerpendicular(cons
     return { from_border_a, from_border_b };
 }
 
-void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>& has_all_meshes) const
+void InterlockingGenerator::handleThinAreas(const VoxelBitGrid& has_all_meshes) const
 {
     Settings& global_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const coord_t boundary_avoidance = global_settings.get<int>("interlocking_boundary_avoidance");
@@ -107,14 +110,17 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
     // Make an inclusionary polygon, to only actually handle thin areas near actual microstructures (so not in skin for example).
     std::vector<Shape> near_interlock_per_layer;
     near_interlock_per_layer.assign(std::min(mesh_a_.layers.size(), mesh_b_.layers.size()), Shape());
-    for (const auto& cell : has_all_meshes)
-    {
-        const Point3LL bottom_corner = vu_.toLowerCorner(cell);
-        for (coord_t layer_nr = bottom_corner.z_; layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < static_cast<coord_t>(near_interlock_per_layer.size()); ++layer_nr)
+    has_all_meshes.forEach(
+        [&](const GridPoint3& cell)
         {
-            near_interlock_per_layer[static_cast<size_t>(layer_nr)].push_back(vu_.toPolygon(cell));
-        }
-    }
+            const Point3LL bottom_corner = vu_.toLowerCorner(cell);
+            for (coord_t layer_nr = std::max(coord_t(0), bottom_corner.z_);
+                 layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < static_cast<coord_t>(near_interlock_per_layer.size());
+                 ++layer_nr)
+            {
+                near_interlock_per_layer[static_cast<size_t>(layer_nr)].push_back(vu_.toPolygon(cell));
+            }
+        });
     for (auto& near_interlock : near_interlock_per_layer)
     {
         near_interlock = near_interlock.offset(rounding_errors).offset(-rounding_errors).unionPolygons().offset(detect);
@@ -150,23 +156,19 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
 
 void InterlockingGenerator::generateInterlockingStructure() const
 {
-    std::vector<std::unordered_set<GridPoint3>> voxels_per_mesh = getShellVoxels(interface_dilation_);
+    const std::vector<Shape> layer_regions = computeUnionedVolumeRegions();
+    const VoxelBitGrid empty_grid = createEmptyGrid(layer_regions);
 
-    std::unordered_set<GridPoint3>& has_any_mesh = voxels_per_mesh[0];
-    std::unordered_set<GridPoint3>& has_all_meshes = voxels_per_mesh[1];
-    has_any_mesh.merge(has_all_meshes); // perform union and intersection simultaneously. Cannibalizes voxels_per_mesh
+    std::vector<VoxelBitGrid> voxels_per_mesh = getShellVoxels(interface_dilation_, empty_grid);
 
-    const std::vector<Shape> layer_regions = computeUnionedVolumeRegions();
+    VoxelBitGrid& has_all_meshes = voxels_per_mesh[0];
+    has_all_meshes &= voxels_per_mesh[1];
 
     if (air_filtering_)
     {
-        std::unordered_set<GridPoint3> air_cells;
+        VoxelBitGrid air_cells = empty_grid;
         addBoundaryCells(layer_regions, air_dilation_, air_cells);
-
-        for (const GridPoint3& p : air_cells)
-        {
-            has_all_meshes.erase(p);
-        }
+        has_all_meshes.subtract(air_cells);
 
         handleThinAreas(has_all_meshes);
     }
@@ -174,49 +176,130 @@ void InterlockingGenerator::generateInterlockingStructure() const
     applyMicrostructureToOutlines(has_all_meshes, layer_regions);
 }
 
-std::vector<std::unordered_set<GridPoint3>> InterlockingGenerator::getShellVoxels(const DilationKernel& kernel) const
+VoxelBitGrid InterlockingGenerator::createEmptyGrid(const std::vector<Shape>& layer_regions) const
+{
+    // The unioned regions are rotated already, but the outlines of the meshes are not. The morphological close of the unioned regions can
+    // cause them to be slightly smaller than the meshes, so include the meshes as well.
+    AABB bounding_box;
+    for (const Shape& layer_region : layer_regions)
+    {
+        bounding_box.include(AABB(layer_region));
+    }
+    for (const Slicer* mesh : { &mesh_a_, &mesh_b_ })
+    {
+        for (const SlicerLayer& layer : mesh->layers)
+        {
+            for (const Polygon& poly : layer.polygons_)
+            {
+                for (const Point2LL& point : poly)
+                {
+                    bounding_box.include(rotation_.apply(point));
+                }
+            }
+        }
+    }
+    if (bounding_box.min_.X > bounding_box.max_.X)
+    {
+        bounding_box = AABB(Point2LL(0, 0), Point2LL(0, 0)); // No outlines at all.
+    }
+
+    // Leave room for the half cell translation of the walkers and for the dilation kernels.
+    GridPoint3 margin(1, 1, 1);
+    for (const DilationKernel* kernel : { &interface_dilation_, &air_dilation_ })
+    {
+        for (size_t dim = 0; dim < 3; dim++)
+        {
+            margin[dim] = std::max(margin[dim], kernel->kernel_size_[dim] + 1);
+        }
+    }
+    const coord_t layer_count = static_cast<coord_t>(layer_regions.size());
+    const GridPoint3 min_cell = vu_.toGridPoint(Point3LL(bounding_box.min_.X, bounding_box.min_.Y, 0)) - margin;
+    const GridPoint3 max_cell = vu_.toGridPoint(Point3LL(bounding_box.max_.X, bounding_box.max_.Y, layer_count + cell_size_.z_)) + margin;
+    return VoxelBitGrid(min_cell, max_cell);
+}
+
+std::vector<VoxelBitGrid> InterlockingGenerator::getShellVoxels(const DilationKernel& kernel, const VoxelBitGrid& empty_grid) const
 {
-    std::vector<std::unordered_set<GridPoint3>> voxels_per_mesh(2);
+    std::vector<VoxelBitGrid> voxels_per_mesh(2, empty_grid);
 
     // mark all cells which contain some boundary
     for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
     {
         Slicer* mesh = (mesh_idx == 0) ? &mesh_a_ : &mesh_b_;
-        std::unordered_set<GridPoint3>& mesh_voxels = voxels_per_mesh[mesh_idx];
 
         std::vector<Shape> rotated_polygons_per_layer(mesh->layers.size());
-        for (size_t layer_nr = 0; layer_nr < mesh->layers.size(); layer_nr++)
-        {
-            SlicerLayer& layer = mesh->layers[layer_nr];
-            rotated_polygons_per_layer[layer_nr] = layer.polygons_;
-            rotated_polygons_per_layer[layer_nr].applyMatrix(rotation_);
-        }
+        cura::parallel_for<size_t>(
+            0,
+            mesh->layers.size(),
+            [&](const size_t layer_nr)
+            {
+                rotated_polygons_per_layer[layer_nr] = mesh->layers[layer_nr].polygons_;
+                rotated_polygons_per_layer[layer_nr].applyMatrix(rotation_);
+            });
 
-        addBoundaryCells(rotated_polygons_per_layer, kernel, mesh_voxels);
+        addBoundaryCells(rotated_polygons_per_layer, kernel, voxels_per_mesh[mesh_idx]);
     }
 
     return voxels_per_mesh;
 }
 
-void InterlockingGenerator::addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, std::unordered_set<GridPoint3>& cells) const
+void InterlockingGenerator::addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, VoxelBitGrid& cells) const
 {
-    auto voxel_emplacer = [&cells](GridPoint3 p)
+    if (layers.empty())
     {
-        cells.emplace(p);
-        return true;
-    };
+        return;
+    }
 
-    for (size_t layer_nr = 0; layer_nr < layers.size(); layer_nr++)
+    // Each block of layers marks its cells in its own slab of the grid, so that the blocks can be processed in parallel. A layer marks cells
+    // up to a kernel size below and above the cell it is in, so neighbouring slabs overlap and are merged afterwards.
+    const size_t worker_count = Application::getInstance().thread_pool_ ? Application::getInstance().thread_pool_->thread_count() + 1 : 1;
+    const size_t layers_per_cell = static_cast<size_t>(cell_size_.z_);
+    const size_t cells_per_block = std::max(size_t(1), static_cast<size_t>(round_up_divide(round_up_divide(layers.size(), layers_per_cell), 4 * worker_count)));
+    const size_t layers_per_block = cells_per_block * layers_per_cell;
+    const size_t block_count = round_up_divide(layers.size(), layers_per_block);
+
+    std::vector<VoxelBitGrid> slabs;
+    slabs.reserve(block_count);
+    for (size_t block_idx = 0; block_idx < block_count; block_idx++)
     {
-        const coord_t z = static_cast<coord_t>(layer_nr);
-        vu_.walkDilatedPolygons(layers[layer_nr], z, kernel, voxel_emplacer);
-        Shape skin = layers[layer_nr];
-        if (layer_nr > 0)
+        const coord_t first_layer = static_cast<coord_t>(block_idx * layers_per_block);
+        const coord_t last_layer = static_cast<coord_t>(std::min(layers.size(), (block_idx + 1) * layers_per_block)) - 1;
+        const coord_t kernel_margin = kernel.kernel_size_.z_ + 1;
+        slabs.push_back(cells.emptySlab(
+            vu_.toGridCoord(first_layer, 2) - kernel_margin,
+            vu_.toGridCoord(last_layer + cell_size_.z_, 2) + kernel_margin)); // Walkers may translate the layers by half a cell upward.
+    }
+
+    cura::parallel_for<size_t>(
+        0,
+        block_count,
+        [&](const size_t block_idx)
         {
-            skin = skin.xorPolygons(layers[layer_nr - 1]);
-        }
-        skin = skin.offset(-cell_size_.x_ / 2).offset(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
-        vu_.walkDilatedAreas(skin, z, kernel, voxel_emplacer);
+            VoxelBitGrid& slab = slabs[block_idx];
+            const auto voxel_emplacer = [&slab](const GridPoint3& p)
+            {
+                slab.set(p);
+                return true;
+            };
+
+            const size_t block_end = std::min(layers.size(), (block_idx + 1) * layers_per_block);
+            for (size_t layer_nr = block_idx * layers_per_block; layer_nr < block_end; layer_nr++)
+            {
+                const coord_t z = static_cast<coord_t>(layer_nr);
+                vu_.walkDilatedPolygons(layers[layer_nr], z, kernel, voxel_emplacer);
+                Shape skin = layers[layer_nr];
+                if (layer_nr > 0)
+                {
+                    skin = skin.xorPolygons(layers[layer_nr - 1]);
+                }
+                skin = skin.offset(-cell_size_.x_ / 2).offset(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
+                vu_.walkDilatedAreas(skin, z, kernel, voxel_emplacer);
+            }
+        });
+
+    for (const VoxelBitGrid& slab : slabs)
+    {
+        cells |= slab;
     }
 }
 
@@ -225,21 +308,24 @@ std::vector<Shape> InterlockingGenerator::computeUnionedVolumeRegions() const
     const auto max_layer_count = std::max(mesh_a_.layers.size(), mesh_b_.layers.size()) + 1; // introduce ghost layer on top for correct skin computation of topmost layer.
     std::vector<Shape> layer_regions(max_layer_count);
 
-    for (LayerIndex layer_nr = 0; layer_nr < LayerIndex(max_layer_count); layer_nr++)
-    {
-        Shape& layer_region = layer_regions[static_cast<size_t>(layer_nr)];
-        for (Slicer* mesh : { &mesh_a_, &mesh_b_ })
+    cura::parallel_for<size_t>(
+        0,
+        max_layer_count,
+        [&](const size_t layer_nr)
         {
-            if (layer_nr >= mesh->layers.size())
+            Shape& layer_region = layer_regions[layer_nr];
+            for (Slicer* mesh : { &mesh_a_, &mesh_b_ })
             {
-                break;
+                if (layer_nr >= mesh->layers.size())
+                {
+                    break;
+                }
+                const SlicerLayer& layer = mesh->layers[layer_nr];
+                layer_region.push_back(layer.polygons_);
             }
-            const SlicerLayer& layer = mesh->layers[static_cast<size_t>(layer_nr)];
-            layer_region.push_back(layer.polygons_);
-        }
-        layer_region = layer_region.offset(ignored_gap_).offset(-ignored_gap_); // Morphological close to merge meshes into single volume
-        layer_region.applyMatrix(rotation_);
-    }
+            layer_region = layer_region.offset(ignored_gap_).offset(-ignored_gap_); // Morphological close to merge meshes into single volume
+            layer_region.applyMatrix(rotation_);
+        });
     return layer_regions;
 }
 
@@ -276,7 +362,7 @@ std::vector<std::vector<Shape>> InterlockingGenerator::generateMicrostructure()
     return cell_area_per_mesh_per_layer;
 }
 
-void InterlockingGenerator::applyMicrostructureToOutlines(const std::unordered_set<GridPoint3>& cells, const std::vector<Shape>& layer_regions) const
+void InterlockingGenerator::applyMicrostructureToOutlines(const VoxelBitGrid& cells, const std::vector<Shape>& layer_regions) const
 {
     std::vector<std::vector<Shape>> cell_area_per_mesh_per_layer = generateMicrostructure();
 
@@ -293,19 +379,22 @@ void InterlockingGenerator::applyMicrostructureToOutlines(const std::unordered_s
     structure_per_layer[1].resize(num_interlocking_layers);
 
     // Only compute cell structure for half the layers, because since our beams are two layers high, every odd layer of the structure will be the same as the layer below.
-    for (const GridPoint3& grid_loc : cells)
-    {
-        Point3LL bottom_corner = vu_.toLowerCorner(grid_loc);
-        for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
+    cells.forEach(
+        [&](const GridPoint3& grid_loc)
         {
-            for (LayerIndex layer_nr = bottom_corner.z_; layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < max_layer_count; layer_nr += beam_layer_count_)
+            Point3LL bottom_corner = vu_.toLowerCorner(grid_loc);
+            for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
             {
-                Shape areas_here = cell_area_per_mesh_per_layer[static_cast<size_t>(layer_nr / beam_layer_count_) % cell_area_per_mesh_per_layer.size()][mesh_idx];
-                areas_here.translate(Point2LL(bottom_corner.x_, bottom_corner.y_));
-                structure_per_layer[mesh_idx][static_cast<size_t>(layer_nr / beam_layer_count_)].push_back(areas_here);
+                // Cells below the build plate start at a multiple of the beam layer count below zero, so clamping keeps the beams aligned.
+                for (LayerIndex layer_nr = std::max(coord_t(0), bottom_corner.z_); layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < max_layer_count;
+                     layer_nr += beam_layer_count_)
+                {
+                    Shape areas_here = cell_area_per_mesh_per_layer[static_cast<size_t>(layer_nr / beam_layer_count_) % cell_area_per_mesh_per_layer.size()][mesh_idx];
+                    areas_here.translate(Point2LL(bottom_corner.x_, bottom_corner.y_));
+                    structure_per_layer[mesh_idx][static_cast<size_t>(layer_nr / beam_layer_count_)].push_back(areas_here);
+                }
             }
-        }
-    }
+        });
 
     for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
     {
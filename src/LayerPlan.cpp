@@ -603,9 +603,9 @@ void LayerPlan::addExtrusionMoveWithGradualOverhang(
     // First, find the speed region where the segment starts
     const Point2LL start = last_planned_position_.value();
     size_t actual_speed_region_index = overhang_masks_.size() - 1; // Default to last region, which is infinity and beyond
-    for (const auto& [index, overhang_region] : overhang_masks_ | ranges::views::drop_last(1) | ranges::views::enumerate)
+    for (const auto& [index, overhang_region] : overhang_mask_indices_ | ranges::views::drop_last(1) | ranges::views::enumerate)
     {
-        if (overhang_region.supported_region.inside(start, true))
+        if (overhang_region.inside(start, true))
         {
             actual_speed_region_index = index;
             break;
@@ -617,9 +617,9 @@ void LayerPlan::addExtrusionMoveWithGradualOverhang(
     const Point2LL vector = end - start;
     std::vector<std::vector<float>> speed_regions_intersections;
     speed_regions_intersections.reserve(overhang_masks_.size() - 1);
-    for (const OverhangMask& overhang_region : overhang_masks_ | ranges::views::drop_last(1))
+    for (const ShapeEdgeIndex& overhang_region : overhang_mask_indices_ | ranges::views::drop_last(1))
     {
-        std::vector<float> intersections = overhang_region.supported_region.intersectionsWithSegment(start, end);
+        std::vector<float> intersections = overhang_region.intersectionsWithSegment(start, end);
         ranges::stable_sort(intersections);
         speed_regions_intersections.push_back(intersections);
     }
@@ -1036,7 +1036,7 @@ void LayerPlan::addWallLine(
         }
     };
 
-    const auto use_skin_config = [&default_config, &p0, &p1](const Shape& mask, const GCodePathConfig& config) -> bool
+    const auto use_skin_config = [&default_config, &p0, &p1](const ShapeEdgeIndex& mask, const GCodePathConfig& config) -> bool
     {
         if (config == default_config)
         {
@@ -1044,7 +1044,7 @@ void LayerPlan::addWallLine(
             // what part of the line segment will be printed with what config.
             return false;
         }
-        return PolygonUtils::polygonCollidesWithLineSegment(mask, p0.toPoint2LL(), p1.toPoint2LL()) || mask.inside(p1.toPoint2LL(), true);
+        return mask.collidesWithLineSegment(p0.toPoint2LL(), p1.toPoint2LL()) || mask.inside(p1.toPoint2LL(), true);
     };
 
     const auto add_skin_extrusion = [&](const Shape& mask, const GCodePathConfig& config) -> void
@@ -1117,7 +1117,7 @@ void LayerPlan::addWallLine(
         }
     };
 
-    if (use_skin_config(roofing_mask_, roofing_config))
+    if (use_skin_config(roofing_mask_index_, roofing_config))
     {
         add_skin_extrusion(roofing_mask_, roofing_config);
     }
@@ -1135,7 +1135,7 @@ void LayerPlan::addWallLine(
             GCodePathConfig::FAN_SPEED_DEFAULT,
             travel_to_z);
     }
-    else if (PolygonUtils::polygonCollidesWithLineSegment(bridge_wall_mask_, p0.toPoint2LL(), p1.toPoint2LL()))
+    else if (bridge_wall_mask_index_.collidesWithLineSegment(p0.toPoint2LL(), p1.toPoint2LL()))
     {
         // the line crosses the boundary between supported and non-supported regions so one or more bridges are required
 
@@ -1209,13 +1209,13 @@ void LayerPlan::addWallLine(
         // if we haven't yet reached p1, fill the gap with default_config line
         addNonBridgeLine(p1);
     }
-    else if (bridge_wall_mask_.inside(p0.toPoint2LL(), true) && (p0 - p1).vSize() >= min_bridge_line_len)
+    else if (bridge_wall_mask_index_.inside(p0.toPoint2LL(), true) && (p0 - p1).vSize() >= min_bridge_line_len)
     {
         // both p0 and p1 must be above air (the result will be ugly!)
         addExtrusionMoveWithGradualOverhang(p1, bridge_config, SpaceFillType::Polygons, flow, width_factor);
         non_bridge_line_volume = 0;
     }
-    else if (use_skin_config(flooring_mask_, flooring_config))
+    else if (use_skin_config(flooring_mask_index_, flooring_config))
     {
         add_skin_extrusion(flooring_mask_, flooring_config);
     }
@@ -1651,7 +1651,7 @@ coord_t LayerPlan::computeDistanceToBridgeStart(const ExtrusionLine& wall, const
             const ExtrusionJunction& p0 = wall[point_idx];
             const ExtrusionJunction& p1 = wall[(point_idx + 1) % wall.size()];
 
-            if (PolygonUtils::polygonCollidesWithLineSegment(bridge_wall_mask_, p0.p_, p1.p_))
+            if (bridge_wall_mask_index_.collidesWithLineSegment(p0.p_, p1.p_))
             {
                 // the line crosses the boundary between supported and non-supported regions so it will contain one or more bridge segments
 
@@ -1705,7 +1705,7 @@ coord_t LayerPlan::computeDistanceToBridgeStart(const ExtrusionLine& wall, const
                     line_polys.removeAt(nearest);
                 }
             }
-            else if (! bridge_wall_mask_.inside(p0.p_, true))
+            else if (! bridge_wall_mask_index_.inside(p0.p_, true))
             {
                 // none of the line is over air
                 distance_to_bridge_start += vSize(p1.p_ - p0.p_);
@@ -3728,11 +3728,61 @@ size_t LayerPlan::getExtruder() const
 void LayerPlan::setBridgeWallMask(const Shape& polys)
 {
     bridge_wall_mask_ = polys;
+    bridge_wall_mask_index_ = ShapeEdgeIndex(bridge_wall_mask_);
+}
+
+void LayerPlan::SupportedRegions::expand(const std::vector<coord_t>& distances)
+{
+    std::vector<coord_t> missing_distances;
+    for (const coord_t distance : distances)
+    {
+        if (! expanded_regions.contains(distance) && std::find(missing_distances.begin(), missing_distances.end(), distance) == missing_distances.end())
+        {
+            missing_distances.push_back(distance);
+        }
+    }
+    std::vector<Shape> missing_regions = fully_supported_region.offsetNested(missing_distances);
+    for (size_t distance_idx = 0; distance_idx < missing_distances.size(); ++distance_idx)
+    {
+        expanded_regions.emplace(missing_distances[distance_idx], std::move(missing_regions[distance_idx]));
+    }
+}
+
+LayerPlan::SupportedRegions& LayerPlan::getSupportedRegions(std::vector<const Shape*> sources, const coord_t half_outer_wall_width)
+{
+    for (SupportedRegions& regions : supported_regions_)
+    {
+        if (regions.sources == sources && regions.half_outer_wall_width == half_outer_wall_width)
+        {
+            return regions;
+        }
+    }
+
+    Shape outlines_below;
+    for (const Shape* source : sources)
+    {
+        outlines_below.push_back(*source);
+    }
+    // remove those parts of the layer below that are narrower than a wall line width as they will not be printed
+    outlines_below = outlines_below.offset(-half_outer_wall_width).offset(half_outer_wall_width);
+    Shape fully_supported_region = outlines_below.offset(-half_outer_wall_width);
+
+    supported_regions_.push_back(SupportedRegions{ .sources = std::move(sources),
+                                                   .half_outer_wall_width = half_outer_wall_width,
+                                                   .outlines_below = std::move(outlines_below),
+                                                   .fully_supported_region = std::move(fully_supported_region),
+                                                   .expanded_regions = {} });
+    return supported_regions_.back();
 }
 
 void LayerPlan::setOverhangMasks(const std::vector<OverhangMask>& masks)
 {
     overhang_masks_ = masks;
+    overhang_mask_indices_.clear();
+    for (const OverhangMask& mask : overhang_masks_)
+    {
+        overhang_mask_indices_.emplace_back(mask.supported_region);
+    }
 }
 
 void LayerPlan::setSeamOverhangMask(const Shape& polys)
@@ -3748,11 +3798,13 @@ const Shape& LayerPlan::getSeamOverhangMask() const
 void LayerPlan::setRoofingMask(const Shape& polys)
 {
     roofing_mask_ = polys;
+    roofing_mask_index_ = ShapeEdgeIndex(roofing_mask_);
 }
 
 void LayerPlan::setFlooringMask(const Shape& shape)
 {
     flooring_mask_ = shape;
+    flooring_mask_index_ = ShapeEdgeIndex(flooring_mask_);
 }
 
 template void LayerPlan::addLinesByOptimizer(
@@ -8,6 +8,7 @@
 #include <regex>
 #include <stdio.h>
 #include <string.h>
+#include <unordered_map>
 
 #include <fmt/format.h>
 #include <range/v3/view/enumerate.hpp>
@@ -95,6 +96,42 @@ void MeshGroup::clear()
     }
 }
 
+std::vector<std::optional<MeshGroup::MeshCopy>> MeshGroup::findTranslatedCopies() const
+{
+    // The position settings have been applied to the vertices already, so the copies may differ in those.
+    const std::vector<std::string> placement_settings{ "mesh_position_x", "mesh_position_y", "mesh_position_z", "center_object" };
+
+    std::vector<std::optional<MeshCopy>> copies(meshes.size());
+    std::unordered_map<size_t, std::vector<size_t>> originals_by_hash;
+    for (size_t mesh_idx = 0; mesh_idx < meshes.size(); mesh_idx++)
+    {
+        const Mesh& mesh = meshes[mesh_idx];
+        if (mesh.texture_ || mesh.vertices_.empty())
+        {
+            continue;
+        }
+        std::vector<size_t>& originals = originals_by_hash[mesh.getShapeHash()];
+        for (const size_t original_idx : originals)
+        {
+            const Mesh& original = meshes[original_idx];
+            if (! mesh.settings_.hasSameEntries(original.settings_, placement_settings))
+            {
+                continue;
+            }
+            if (const std::optional<Point2LL> offset = mesh.getTranslationFrom(original))
+            {
+                copies[mesh_idx] = MeshCopy{ original_idx, *offset };
+                break;
+            }
+        }
+        if (! copies[mesh_idx].has_value())
+        {
+            originals.push_back(mesh_idx);
+        }
+    }
+    return copies;
+}
+
 void MeshGroup::finalize()
 {
     // If the machine settings have been supplied, offset the given position vertices to the center of vertices (0,0,0) is at the bed center.
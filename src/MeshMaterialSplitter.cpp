@@ -28,6 +28,7 @@
 #include "utils/SpatialLookup.h"
 #include "utils/ThreadPool.h"
 #include "utils/VoxelGrid.h"
+#include "utils/math.h"
 
 
 namespace cura::MeshMaterialSplitter
@@ -378,51 +379,84 @@ bool isInside(const VoxelGrid& voxel_grid, const VoxelGrid::LocalCoordinates& po
     return sliced_mesh.at(position.position.z).inside(Point2LL(global_position.x_, global_position.y_), border_result);
 }
 
+/*!
+ * Process the voxels of a frontier in parallel, each of them possibly outputting voxels for the next frontier
+ * @param frontier The voxels to be processed
+ * @param process_voxel The function to be called for each voxel of the frontier, with as arguments the voxel and the list to output voxels to
+ * @return The list of all the output voxels
+ *
+ * The frontier is split in blocks which each have their own output list, so that processing doesn't need any synchronization.
+ */
+template<typename F>
+std::vector<VoxelGrid::LocalCoordinates> processFrontier(const std::vector<VoxelGrid::LocalCoordinates>& frontier, F&& process_voxel)
+{
+    constexpr size_t min_block_size = 1024;
+    constexpr size_t blocks_per_worker = 8;
+    const size_t worker_count = Application::getInstance().thread_pool_ ? Application::getInstance().thread_pool_->thread_count() + 1 : 1;
+    const size_t block_size = std::max(min_block_size, static_cast<size_t>(round_up_divide(frontier.size(), blocks_per_worker * worker_count)));
+    const size_t block_count = round_up_divide(frontier.size(), block_size);
+
+    std::vector<std::vector<VoxelGrid::LocalCoordinates>> output_per_block(block_count);
+    cura::parallel_for<size_t>(
+        0,
+        block_count,
+        [&](const size_t block_index)
+        {
+            const size_t block_end = std::min(frontier.size(), (block_index + 1) * block_size);
+            for (size_t voxel_index = block_index * block_size; voxel_index < block_end; ++voxel_index)
+            {
+                process_voxel(frontier[voxel_index], output_per_block[block_index]);
+            }
+        });
+
+    std::vector<VoxelGrid::LocalCoordinates> output;
+    size_t output_size = 0;
+    for (const std::vector<VoxelGrid::LocalCoordinates>& block_output : output_per_block)
+    {
+        output_size += block_output.size();
+    }
+    output.reserve(output_size);
+    for (const std::vector<VoxelGrid::LocalCoordinates>& block_output : output_per_block)
+    {
+        output.insert(output.end(), block_output.begin(), block_output.end());
+    }
+    return output;
+}
+
 /*!
  * Find the voxels to be evaluated next, given the ones that have been previously evaluated
- * @param voxel_grid The current voxel grid to be checked. Some voxels may also be directly filled.
+ * @param voxel_grid The current voxel grid to be checked. Some voxels may also be directly filled, and the returned ones are reserved.
  * @param previously_evaluated_voxels The list of voxels that were just evaluated
  * @param sliced_mesh The pre-sliced mesh, used to check for points insideness
- * @return The list of new voxels to be evaluated
+ * @return The list of new voxels to be evaluated, each of them appearing only once
  */
-boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>
-    findVoxelsToEvaluate(VoxelGrid& voxel_grid, const boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>& previously_evaluated_voxels, const std::vector<Shape>& sliced_mesh)
+std::vector<VoxelGrid::LocalCoordinates>
+    findVoxelsToEvaluate(VoxelGrid& voxel_grid, const std::vector<VoxelGrid::LocalCoordinates>& previously_evaluated_voxels, const std::vector<Shape>& sliced_mesh)
 {
-    boost::concurrent_flat_set<VoxelGrid::LocalCoordinates> voxels_to_evaluate;
-
-    previously_evaluated_voxels.visit_all(
-#ifdef __cpp_lib_execution
-        std::execution::par,
-#endif
-        [&](const VoxelGrid::LocalCoordinates& previously_evaluated_voxel)
+    return processFrontier(
+        previously_evaluated_voxels,
+        [&](const VoxelGrid::LocalCoordinates& previously_evaluated_voxel, std::vector<VoxelGrid::LocalCoordinates>& voxels_to_evaluate)
         {
-            for (const VoxelGrid::LocalCoordinates& voxel_around : voxel_grid.getVoxelsAround(previously_evaluated_voxel))
-            {
-                if (voxels_to_evaluate.contains(voxel_around))
+            voxel_grid.visitVoxelsAround(
+                previously_evaluated_voxel,
+                [&](const VoxelGrid::LocalCoordinates& voxel_around)
                 {
-                    // This voxel has already been registered for evaluation
-                    continue;
-                }
-
-                const std::optional<uint8_t> occupation = voxel_grid.getOccupation(voxel_around);
-                if (occupation.has_value())
-                {
-                    // Voxel is already filled, don't evaluate it anyhow
-                    continue;
-                }
+                    if (! voxel_grid.reserve(voxel_around))
+                    {
+                        // Voxel is already filled, or has already been registered for evaluation
+                        return;
+                    }
 
-                if (! isInside(voxel_grid, voxel_around, sliced_mesh))
-                {
-                    voxel_grid.setOccupation(voxel_around, 0);
-                }
-                else
-                {
-                    voxels_to_evaluate.emplace(voxel_around);
-                }
-            }
+                    if (! isInside(voxel_grid, voxel_around, sliced_mesh))
+                    {
+                        voxel_grid.setOccupation(voxel_around, 0);
+                    }
+                    else
+                    {
+                        voxels_to_evaluate.push_back(voxel_around);
+                    }
+                });
         });
-
-    return voxels_to_evaluate;
 }
 
 /*!
@@ -432,18 +466,14 @@ boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>
  * @param texture_data The lookup containing the rasterized texture data
  * @param deepness_squared The maximum deepness, squared
  */
-void evaluateVoxels(
-    VoxelGrid& voxel_grid,
-    const boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>& voxels_to_evaluate,
-    const SpatialLookup& texture_data,
-    const coord_t deepness_squared)
+void evaluateVoxels(VoxelGrid& voxel_grid, const std::vector<VoxelGrid::LocalCoordinates>& voxels_to_evaluate, const SpatialLookup& texture_data, const coord_t deepness_squared)
 {
-    voxels_to_evaluate.visit_all(
-#ifdef __cpp_lib_execution
-        std::execution::par,
-#endif
-        [&voxel_grid, &texture_data, &deepness_squared](const VoxelGrid::LocalCoordinates& voxel_to_evaluate)
+    cura::parallel_for<size_t>(
+        0,
+        voxels_to_evaluate.size(),
+        [&voxel_grid, &voxels_to_evaluate, &texture_data, &deepness_squared](const size_t voxel_index)
         {
+            const VoxelGrid::LocalCoordinates& voxel_to_evaluate = voxels_to_evaluate[voxel_index];
             const Point3D position = voxel_grid.toGlobalCoordinates(voxel_to_evaluate);
 
             // Find the nearest neighbor
@@ -462,27 +492,35 @@ void evaluateVoxels(
         });
 }
 
-void findBoundaryVoxels(boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>& evaluated_voxels, const VoxelGrid& voxel_grid)
+/*!
+ * Keep only the evaluated voxels that have at least one voxel around them with a different occupation
+ * @param evaluated_voxels The voxels that have just been evaluated
+ * @param voxel_grid The voxel grid containing the occupations
+ * @return The voxels that are on the boundary between different occupations
+ */
+std::vector<VoxelGrid::LocalCoordinates> findBoundaryVoxels(const std::vector<VoxelGrid::LocalCoordinates>& evaluated_voxels, const VoxelGrid& voxel_grid)
 {
-    evaluated_voxels.erase_if(
-#ifdef __cpp_lib_execution
-        std::execution::par,
-#endif
-        [&voxel_grid](const VoxelGrid::LocalCoordinates& evaluated_voxel)
+    return processFrontier(
+        evaluated_voxels,
+        [&voxel_grid](const VoxelGrid::LocalCoordinates& evaluated_voxel, std::vector<VoxelGrid::LocalCoordinates>& boundary_voxels)
         {
             bool has_various_voxels_around = false;
             const uint8_t actual_occupation = voxel_grid.getOccupation(evaluated_voxel).value();
-            for (const VoxelGrid::LocalCoordinates& voxel_around : voxel_grid.getVoxelsAround(evaluated_voxel))
-            {
-                const std::optional<uint8_t> around_occupation = voxel_grid.getOccupation(voxel_around);
-                if (around_occupation.has_value() && around_occupation.value() != actual_occupation)
+            voxel_grid.visitVoxelsAround(
+                evaluated_voxel,
+                [&](const VoxelGrid::LocalCoordinates& voxel_around)
                 {
-                    has_various_voxels_around = true;
-                    break;
-                }
-            }
+                    if (! has_various_voxels_around)
+                    {
+                        const std::optional<uint8_t> around_occupation = voxel_grid.getOccupation(voxel_around);
+                        has_various_voxels_around = around_occupation.has_value() && around_occupation.value() != actual_occupation;
+                    }
+                });
 
-            return ! has_various_voxels_around;
+            if (has_various_voxels_around)
+            {
+                boundary_voxels.push_back(evaluated_voxel);
+            }
         });
 }
 
@@ -494,10 +532,13 @@ void findBoundaryVoxels(boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>&
  * @param sliced_mesh The pre-sliced mesh matching the voxel grid
  * @param texture_data The lookup containing the rasterized texture data
  * @param deepness_squared The maximum propagation deepness, squared
+ *
+ * The propagation processes a frontier of voxels at each iteration, which is stored as a plain list. Each voxel of the next frontier is reserved in the grid when it is found,
+ * so that the frontier doesn't contain duplicates without having to store it as a set.
  */
 void propagateVoxels(
     VoxelGrid& voxel_grid,
-    boost::concurrent_flat_set<VoxelGrid::LocalCoordinates>& evaluated_voxels,
+    std::vector<VoxelGrid::LocalCoordinates> evaluated_voxels,
     const coord_t estimated_iterations,
     const std::vector<Shape>& sliced_mesh,
     const SpatialLookup& texture_data,
@@ -520,7 +561,7 @@ void propagateVoxels(
         // Now we have evaluated the candidates, check which of them are to be processed next. We skip all the voxels that have only voxels with similar occupations around
         // them, because they are obviously not part of the boundaries we are looking for. This avoids filling the inside of the points clouds and speeds up calculation a lot.
         spdlog::debug("Find boundary voxels for next round");
-        findBoundaryVoxels(evaluated_voxels, voxel_grid);
+        evaluated_voxels = findBoundaryVoxels(evaluated_voxels, voxel_grid);
 
         ++iteration;
     }
@@ -565,14 +606,10 @@ std::vector<Mesh> makeModifierMeshes(const Mesh& mesh, const std::shared_ptr<Tex
     const std::vector<Shape> sliced_mesh = sliceMesh(mesh, voxel_grid);
 
     spdlog::debug("Get initially filled voxels");
-    boost::concurrent_flat_set<VoxelGrid::LocalCoordinates> previously_evaluated_voxels;
-    voxel_grid.visitOccupiedVoxels(
-        [&previously_evaluated_voxels](const auto& voxel)
+    std::vector<VoxelGrid::LocalCoordinates> previously_evaluated_voxels = voxel_grid.findOccupiedVoxels(
+        [](const auto& voxel)
         {
-            if (voxel.second > 0)
-            {
-                previously_evaluated_voxels.insert(voxel.first);
-            };
+            return voxel.second > 0;
         });
 
     // Make a rough estimation of the max number of iterations, by calculating how deep we may propagate inside the mesh
@@ -581,7 +618,7 @@ std::vector<Mesh> makeModifierMeshes(const Mesh& mesh, const std::shared_ptr<Tex
     const coord_t estimated_iterations = estimated_min_deepness / resolution;
     spdlog::debug("Estimated {} iterations", estimated_iterations);
 
-    propagateVoxels(voxel_grid, previously_evaluated_voxels, estimated_iterations, sliced_mesh, texture_data, deepness_squared);
+    propagateVoxels(voxel_grid, std::move(previously_evaluated_voxels), estimated_iterations, sliced_mesh, texture_data, deepness_squared);
 
     return makeMeshesFromVoxelsGrid(voxel_grid);
 }
@@ -92,7 +92,7 @@ void Scene::processMeshGroup(MeshGroup& mesh_group)
     }
 
     Progress::messageProgressStage(Progress::Stage::EXPORT, &fff_processor->time_keeper);
-    fff_processor->gcode_writer.writeGCode(storage, fff_processor->time_keeper);
+    fff_processor->gcode_writer->writeGCode(storage, fff_processor->time_keeper);
 
     Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
     Application::getInstance().communication_->flushGCode();
@@ -3,6 +3,8 @@
 
 #include "SkirtBrim.h"
 
+#include <range/v3/view/enumerate.hpp>
+#include <range/v3/view/zip.hpp>
 #include <spdlog/spdlog.h>
 
 #include "Application.h"
@@ -16,6 +18,7 @@
 #include "support.h"
 #include "utils/MixedPolylineStitcher.h"
 #include "utils/Simplify.h"
+#include "utils/ThreadPool.h"
 
 namespace cura
 {
@@ -192,6 +195,11 @@ std::vector<coord_t> SkirtBrim::generatePrimaryBrim(std::vector<Offset>& all_bri
 {
     std::vector<coord_t> total_length(extruder_count_, 0U);
 
+    const std::optional<std::vector<coord_t>> clustered_lengths
+        = generate_per_cluster_ ? generateClusteredPrimaryBrim(all_brim_offsets, covered_area, allowed_areas_per_extruder) : std::nullopt;
+    const size_t clustered_offset_count = clustered_lengths.has_value() ? clustered_lengths->size() : 0;
+
+    Shape newly_covered_area;
     for (size_t offset_idx = 0; offset_idx < all_brim_offsets.size(); offset_idx++)
     {
         Offset& offset = all_brim_offsets[offset_idx];
@@ -200,7 +208,15 @@ std::vector<coord_t> SkirtBrim::generatePrimaryBrim(std::vector<Offset>& all_bri
             storage_.skirt_brim[offset.extruder_nr_].resize(offset.inset_idx_ + 1);
         }
         MixedLinesSet& output_location = storage_.skirt_brim[offset.extruder_nr_][offset.inset_idx_];
-        const coord_t added_length = generateOffset(offset, covered_area, allowed_areas_per_extruder, output_location);
+        const coord_t added_length = offset_idx < clustered_offset_count
+                                       ? (*clustered_lengths)[offset_idx]
+                                       : generateOffset(offset, storage_.skirt_brim[offset.extruder_nr_], newly_covered_area, allowed_areas_per_extruder, output_location);
+        if (offset_idx == 0 && clustered_offset_count == 0)
+        {
+            // The first line is only limited by the allowed areas. From here on they also exclude what was covered before, so that each
+            // next offset only has to remove what it newly covers.
+            excludeFromAllowedAreas(covered_area, allowed_areas_per_extruder);
+        }
 
         if (added_length == 0)
         { // no more place for more brim. Trying to satisfy minimum length constraint with generateSecondarySkirtBrim
@@ -230,10 +246,207 @@ std::vector<coord_t> SkirtBrim::generatePrimaryBrim(std::vector<Offset>& all_bri
             std::stable_sort(all_brim_offsets.begin() + offset_idx + 1, all_brim_offsets.end(), OffsetSorter); // reorder remaining offsets
         }
     }
+    covered_area = covered_area.unionPolygons(newly_covered_area);
     return total_length;
 }
 
-coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder, MixedLinesSet& result)
+std::vector<SkirtBrim::Cluster> SkirtBrim::clusterStartingOutlines(
+    const std::vector<Offset>& all_brim_offsets,
+    const Shape& covered_area,
+    const std::vector<Shape>& allowed_areas_per_extruder) const
+{
+    // The brim lines and the areas they cover stay within this distance from the starting outlines.
+    std::vector<const Outline*> starting_outlines(extruder_count_, nullptr);
+    coord_t max_total_offset = 0;
+    coord_t max_line_width = 0;
+    for (const Offset& offset : all_brim_offsets)
+    {
+        if (std::holds_alternative<Outline*>(offset.reference_outline_or_index_))
+        {
+            starting_outlines[offset.extruder_nr_] = std::get<Outline*>(offset.reference_outline_or_index_);
+        }
+        max_total_offset = std::max(max_total_offset, offset.total_offset_);
+        max_line_width = std::max(max_line_width, extruders_configs_[offset.extruder_nr_].line_width_);
+    }
+    const coord_t reach_distance = max_total_offset + 2 * max_line_width;
+
+    struct Item
+    {
+        size_t extruder_nr;
+        bool touching;
+        const Polygon* polygon;
+    };
+    struct Group
+    {
+        AABB reach;
+        std::vector<size_t> item_indices;
+    };
+    std::vector<Item> items;
+    std::vector<Group> groups;
+    for (size_t extruder_nr = 0; extruder_nr < extruder_count_; extruder_nr++)
+    {
+        if (starting_outlines[extruder_nr] == nullptr)
+        {
+            continue;
+        }
+        for (const auto& [shape, touching] : { std::make_pair(&starting_outlines[extruder_nr]->gapped, false), std::make_pair(&starting_outlines[extruder_nr]->touching, true) })
+        {
+            for (const Polygon& polygon : *shape)
+            {
+                Group group{ .reach = AABB(polygon), .item_indices = { items.size() } };
+                group.reach.expand(reach_distance);
+                items.push_back(Item{ .extruder_nr = extruder_nr, .touching = touching, .polygon = &polygon });
+
+                // Merge all groups that the new one hits. As the merged group grows, it may hit groups that were checked before.
+                for (size_t group_idx = 0; group_idx < groups.size();)
+                {
+                    if (groups[group_idx].reach.hit(group.reach))
+                    {
+                        group.reach.include(groups[group_idx].reach);
+                        group.item_indices.insert(group.item_indices.end(), groups[group_idx].item_indices.begin(), groups[group_idx].item_indices.end());
+                        groups.erase(groups.begin() + static_cast<std::ptrdiff_t>(group_idx));
+                        group_idx = 0;
+                    }
+                    else
+                    {
+                        group_idx++;
+                    }
+                }
+                groups.push_back(std::move(group));
+            }
+        }
+    }
+    if (groups.size() < 2)
+    {
+        return {};
+    }
+
+    std::vector<Cluster> clusters(groups.size());
+    for (auto [group, cluster] : ranges::views::zip(groups, clusters))
+    {
+        // Keep the polygons in their original order, so that the brim is the same as when generating it for all parts at once.
+        std::sort(group.item_indices.begin(), group.item_indices.end());
+        cluster.reach = group.reach;
+        cluster.starting_outlines.resize(extruder_count_);
+        for (const size_t item_idx : group.item_indices)
+        {
+            const Item& item = items[item_idx];
+            Outline& outline = cluster.starting_outlines[item.extruder_nr];
+            (item.touching ? outline.touching : outline.gapped).push_back(*item.polygon);
+        }
+
+        Shape reach_area;
+        reach_area.push_back(cluster.reach.toPolygon());
+        const auto crop_to_reach = [&cluster, &reach_area](const Shape& area)
+        {
+            // Only the polygons near the reach can affect the area within it. Skip the others before cropping.
+            Shape nearby_area;
+            for (const Polygon& polygon : area)
+            {
+                if (AABB(polygon).hit(cluster.reach))
+                {
+                    nearby_area.push_back(polygon);
+                }
+            }
+            return nearby_area.intersection(reach_area);
+        };
+        cluster.allowed_areas_per_extruder.resize(extruder_count_);
+        for (size_t extruder_nr = 0; extruder_nr < extruder_count_; extruder_nr++)
+        {
+            cluster.allowed_areas_per_extruder[extruder_nr] = crop_to_reach(allowed_areas_per_extruder[extruder_nr]);
+        }
+        cluster.previously_covered_area = crop_to_reach(covered_area);
+        cluster.skirt_brim.resize(extruder_count_);
+    }
+    return clusters;
+}
+
+std::optional<std::vector<coord_t>>
+    SkirtBrim::generateClusteredPrimaryBrim(const std::vector<Offset>& all_brim_offsets, Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder)
+{
+    std::vector<Cluster> clusters = clusterStartingOutlines(all_brim_offsets, covered_area, allowed_areas_per_extruder);
+    if (clusters.empty())
+    {
+        return std::nullopt;
+    }
+
+    cura::parallel_for<size_t>(
+        0,
+        clusters.size(),
+        [this, &clusters, &all_brim_offsets](const size_t cluster_idx)
+        {
+            Cluster& cluster = clusters[cluster_idx];
+            cluster.added_length_per_offset.resize(all_brim_offsets.size());
+            for (const auto& [offset_idx, planned_offset] : all_brim_offsets | ranges::views::enumerate)
+            {
+                Offset offset = planned_offset;
+                if (std::holds_alternative<Outline*>(offset.reference_outline_or_index_))
+                {
+                    offset.reference_outline_or_index_ = &cluster.starting_outlines[offset.extruder_nr_];
+                }
+                std::vector<MixedLinesSet>& extruder_brim = cluster.skirt_brim[offset.extruder_nr_];
+                if (extruder_brim.size() <= offset.inset_idx_)
+                {
+                    extruder_brim.resize(offset.inset_idx_ + 1);
+                }
+                cluster.added_length_per_offset[offset_idx]
+                    = generateOffset(offset, extruder_brim, cluster.covered_area, cluster.allowed_areas_per_extruder, extruder_brim[offset.inset_idx_]);
+                if (offset_idx == 0)
+                {
+                    // Like generatePrimaryBrim does for all parts at once, only the first line may overlap with what was covered before.
+                    excludeFromAllowedAreas(cluster.previously_covered_area, cluster.allowed_areas_per_extruder);
+                }
+            }
+        });
+
+    std::vector<coord_t> added_length_per_offset(all_brim_offsets.size(), 0);
+    std::vector<coord_t> total_length(extruder_count_, 0);
+    for (const auto& [offset_idx, offset] : all_brim_offsets | ranges::views::enumerate)
+    {
+        for (const Cluster& cluster : clusters)
+        {
+            added_length_per_offset[offset_idx] += cluster.added_length_per_offset[offset_idx];
+        }
+        total_length[offset.extruder_nr_] += added_length_per_offset[offset_idx];
+
+        const bool needs_extra_offset = offset.is_last_ && added_length_per_offset[offset_idx] > 0
+                                     && total_length[offset.extruder_nr_] < extruders_configs_[offset.extruder_nr_].skirt_brim_minimal_length_;
+        if (needs_extra_offset && offset_idx + 1 < all_brim_offsets.size())
+        {
+            // The extra offset would have to be generated before the remaining planned offsets of other extruders, for all parts at once.
+            return std::nullopt;
+        }
+    }
+
+    Shape newly_covered_area;
+    for (Cluster& cluster : clusters)
+    {
+        for (size_t extruder_nr = 0; extruder_nr < extruder_count_; extruder_nr++)
+        {
+            std::vector<MixedLinesSet>& extruder_brim = storage_.skirt_brim[extruder_nr];
+            if (extruder_brim.size() < cluster.skirt_brim[extruder_nr].size())
+            {
+                extruder_brim.resize(cluster.skirt_brim[extruder_nr].size());
+            }
+            for (auto [lines, cluster_lines] : ranges::views::zip(extruder_brim, cluster.skirt_brim[extruder_nr]))
+            {
+                lines.insert(lines.end(), cluster_lines.begin(), cluster_lines.end());
+            }
+        }
+        newly_covered_area.push_back(std::move(cluster.covered_area));
+    }
+    covered_area = covered_area.unionPolygons(newly_covered_area);
+    excludeFromAllowedAreas(covered_area, allowed_areas_per_extruder);
+
+    return added_length_per_offset;
+}
+
+coord_t SkirtBrim::generateOffset(
+    const Offset& offset,
+    const std::vector<MixedLinesSet>& extruder_brim,
+    Shape& newly_covered_area,
+    std::vector<Shape>& allowed_areas_per_extruder,
+    MixedLinesSet& result)
 {
     coord_t length_added;
     Shape brim;
@@ -243,9 +456,9 @@ coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std
     {
         Outline* reference_outline = std::get<Outline*>(offset.reference_outline_or_index_);
         for (const auto& [shape, offset_value] :
-             { std::make_tuple(reference_outline->gapped, offset.offset_value_gapped_), std::make_tuple(reference_outline->touching, offset.offset_value_touching_) })
+             { std::make_tuple(&reference_outline->gapped, offset.offset_value_gapped_), std::make_tuple(&reference_outline->touching, offset.offset_value_touching_) })
         {
-            for (const Polygon& polygon : shape)
+            for (const Polygon& polygon : *shape)
             {
                 const double area = polygon.area();
                 if (area > 0 && offset.outside_)
@@ -264,7 +477,7 @@ coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std
         const int reference_idx = std::get<int>(offset.reference_outline_or_index_);
         const coord_t offset_dist = extruder_config.line_width_;
 
-        brim.push_back(storage_.skirt_brim[offset.extruder_nr_][reference_idx].offset(offset_dist, ClipperLib::jtRound));
+        brim.push_back(extruder_brim[reference_idx].offset(offset_dist, ClipperLib::jtRound));
     }
 
     // limit brim lines to allowed areas, stitch them and store them in the result
@@ -273,7 +486,7 @@ coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std
     OpenLinesSet brim_lines = allowed_areas_per_extruder[offset.extruder_nr_].intersection(brim, false);
     length_added = brim_lines.length();
 
-    Shape newly_covered = brim_lines.offset(extruder_config.line_width_ / 2 + 10, ClipperLib::jtRound);
+    const Shape newly_covered = brim_lines.offset(extruder_config.line_width_ / 2 + 10, ClipperLib::jtRound).unionPolygons();
 
     const coord_t max_stitch_distance = extruder_config.line_width_;
     MixedPolylineStitcher::stitch(brim_lines, result, max_stitch_distance);
@@ -293,8 +506,15 @@ coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std
             }),
         result.end());
 
-    // update allowed_areas_per_extruder
-    covered_area = covered_area.unionPolygons(newly_covered.unionPolygons());
+    // update allowed_areas_per_extruder. They already exclude everything that was covered before, so only the new area has to be removed.
+    newly_covered_area.push_back(newly_covered);
+    excludeFromAllowedAreas(newly_covered, allowed_areas_per_extruder);
+
+    return length_added;
+}
+
+void SkirtBrim::excludeFromAllowedAreas(const Shape& covered_area, std::vector<Shape>& allowed_areas_per_extruder) const
+{
     for (size_t extruder_nr = 0; extruder_nr < extruder_count_; extruder_nr++)
     {
         if (extruders_configs_[extruder_nr].extruder_is_used_)
@@ -302,8 +522,6 @@ coord_t SkirtBrim::generateOffset(const Offset& offset, Shape& covered_area, std
             allowed_areas_per_extruder[extruder_nr] = allowed_areas_per_extruder[extruder_nr].difference(covered_area);
         }
     }
-
-    return length_added;
 }
 
 SkirtBrim::Outline SkirtBrim::getFirstLayerOutline(const int extruder_nr /* = -1 */)
@@ -414,6 +632,7 @@ SkirtBrim::Outline SkirtBrim::getFirstLayerOutline(const int extruder_nr /* = -1
 
                 // If the gap between the model and the BP is small enough, support starts with the interface instead, so remove it there as well:
                 support_layer.support_roof = support_layer.support_roof.difference(model_brim_covered_area);
+                storage_.invalidateLayerOutlines();
             }
 
             for (const SupportInfillPart& support_infill_part : support_layer.support_infill_parts)
@@ -517,6 +736,7 @@ void SkirtBrim::generateSecondarySkirtBrim(Shape& covered_area, std::vector<Shap
     {
         bool first = true;
         Outline reference_outline{ .touching = covered_area };
+        Shape newly_covered_area;
         const ExtruderConfig& extruder_config = extruders_configs_[extruder_nr];
         while (total_length[extruder_nr] < extruder_config.skirt_brim_minimal_length_)
         {
@@ -547,7 +767,7 @@ void SkirtBrim::generateSecondarySkirtBrim(Shape& covered_area, std::vector<Shap
 
             storage_.skirt_brim[extruder_nr].emplace_back();
             MixedLinesSet& output_location = storage_.skirt_brim[extruder_nr].back();
-            coord_t added_length = generateOffset(extra_offset, covered_area, allowed_areas_per_extruder, output_location);
+            coord_t added_length = generateOffset(extra_offset, storage_.skirt_brim[extruder_nr], newly_covered_area, allowed_areas_per_extruder, output_location);
 
             if (! added_length)
             {
@@ -559,6 +779,7 @@ void SkirtBrim::generateSecondarySkirtBrim(Shape& covered_area, std::vector<Shap
 
             first = false;
         }
+        covered_area = covered_area.unionPolygons(newly_covered_area);
     }
 }
 
@@ -704,6 +925,7 @@ void SkirtBrim::generateSupportBrim()
     }
     const Shape brim_area = support_outline.difference(support_outline.offset(-brim_width));
     support_layer.excludeAreasFromSupportInfillAreas(brim_area, AABB(brim_area));
+    storage_.invalidateLayerOutlines();
 
     coord_t offset_distance = brim_line_width / 2;
     for (size_t skirt_brim_number = 0; skirt_brim_number < line_count; skirt_brim_number++)
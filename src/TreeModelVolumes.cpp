@@ -3,6 +3,9 @@
 
 #include "TreeModelVolumes.h"
 
+#include <functional>
+#include <vector>
+
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -278,30 +281,39 @@ void TreeModelVolumes::precalculate(coord_t max_layer)
 
     // ### Calculate the relevant avoidances in parallel as far as possible
     {
-        std::future<void> placeable_waiter;
-        std::future<void> avoidance_waiter;
-
+        // Each of these loops over the radii, and is limited by the radius with the most layers. Running them as nested parallel loops lets the threads that finished
+        // one of them work on the others. Only the avoidance to model depends on another one, the placeables.
+        std::vector<std::function<void()>> avoidance_calculations;
         if (support_rests_on_model_)
         {
-            calculatePlaceables(relevant_avoidance_radiis_to_model);
+            avoidance_calculations.emplace_back(
+                [&]()
+                {
+                    calculatePlaceables(relevant_avoidance_radiis_to_model);
+                    calculateAvoidanceToModel(relevant_avoidance_radiis_to_model);
+                });
         }
         if (support_rest_preference_ == RestPreference::BUILDPLATE)
         {
-            calculateAvoidance(relevant_avoidance_radiis);
+            avoidance_calculations.emplace_back(
+                [&]()
+                {
+                    calculateAvoidance(relevant_avoidance_radiis);
+                });
         }
+        avoidance_calculations.emplace_back(
+            [&]()
+            {
+                calculateWallRestrictions(relevant_avoidance_radiis);
+            });
 
-        calculateWallRestrictions(relevant_avoidance_radiis);
-        if (support_rests_on_model_)
-        {
-            // FIXME: When nowait (parellel-for) is implemented, ensure here the following is calculated: calculatePlaceables.
-            calculateAvoidanceToModel(relevant_avoidance_radiis_to_model);
-            // FIXME: When nowait (parellel-for) is implemented, ensure here the following is calculated: calculateAvoidanceToModel.
-        }
-        if (support_rest_preference_ == RestPreference::BUILDPLATE)
-        {
-            // FIXME: When nowait (parellel-for) is implemented, ensure here the following is calculated: calculateAvoidance.
-        }
-        // FIXME: When nowait (parellel-for) is implemented, ensure here the following is calculated: calculateWallRestrictions.
+        cura::parallel_for<size_t>(
+            0,
+            avoidance_calculations.size(),
+            [&](const size_t calculation_idx)
+            {
+                avoidance_calculations[calculation_idx]();
+            });
     }
     const auto t_avo = std::chrono::high_resolution_clock::now();
 
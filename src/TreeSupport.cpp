@@ -109,13 +109,14 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
         AreaSupport::precomputeCrossInfillTree(storage);
     }
 
-    // Process every mesh group. These groups can not be processed parallel, as the processing in each group is parallelized, and nested parallelization is disables and slow.
+    // Process every mesh group. These groups can not be processed parallel, as each group has to avoid the support generated by the groups before it (see exclude below).
+    // Instead the processing in each group is parallelized, using nested parallel loops where independent steps can overlap.
     for (auto [counter, processing] : grouped_meshes | ranges::views::enumerate)
     {
         // process each combination of meshes
-        std::vector<std::set<TreeSupportElement*>> move_bounds(
-            storage.support.supportLayers
-                .size()); // Value is the area where support may be placed. As this is calculated in CreateLayerPathing it is saved and reused in drawAreas.
+        // Value is the area where support may be placed. As this is calculated in CreateLayerPathing it is saved and reused in drawAreas.
+        // All influence areas of this mesh group are freed at once when it goes out of scope.
+        TreeSupportMoveBounds move_bounds(storage.support.supportLayers.size());
 
         additional_required_support_area = std::vector<Shape>(storage.support.supportLayers.size(), Shape());
 
@@ -198,16 +199,6 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
             dur_path,
             dur_place,
             dur_draw);
-
-
-        for (auto& layer : move_bounds)
-        {
-            for (auto elem : layer)
-            {
-                delete elem->area_;
-                delete elem;
-            }
-        }
     }
 
     storage.support.generated = true;
@@ -253,7 +244,7 @@ LayerIndex TreeSupport::precalculate(const SliceDataStorage& storage, std::vecto
 }
 
 
-void TreeSupport::generateInitialAreas(const SliceMeshStorage& mesh, std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage)
+void TreeSupport::generateInitialAreas(const SliceMeshStorage& mesh, TreeSupportMoveBounds& move_bounds, SliceDataStorage& storage)
 {
     TreeSupportTipGenerator tip_gen(mesh, volumes_);
     tip_gen.generateTips(storage, mesh, move_bounds, additional_required_support_area, fake_roof_areas);
@@ -894,11 +885,13 @@ void TreeSupport::increaseAreas(
     PropertyAreas& to_model_areas,
     PropertyAreas& influence_areas,
     std::vector<TreeSupportElement*>& bypass_merge_areas,
+    TreeSupportMoveBounds& move_bounds,
     const std::vector<TreeSupportElement*>& last_layer,
     const LayerIndex layer_idx,
     const bool mergelayer)
 {
     std::mutex critical_sections;
+    std::vector<TreeSupportElement*> bypass_merge_area_per_parent(last_layer.size(), nullptr); // Indexed like last_layer, so that the order doesn't depend on the threads.
     cura::parallel_for<size_t>(
         0,
         last_layer.size(),
@@ -1250,9 +1243,8 @@ void TreeSupport::increaseAreas(
                     std::lock_guard<std::mutex> critical_section_newLayer(critical_sections);
                     if (bypass_merge)
                     {
-                        Shape* new_area = new Shape(max_influence_area);
-                        TreeSupportElement* next = new TreeSupportElement(elem, new_area);
-                        bypass_merge_areas.emplace_back(next);
+                        Shape* new_area = move_bounds.createArea(layer_idx - 1, max_influence_area);
+                        bypass_merge_area_per_parent[idx] = move_bounds.createElement(layer_idx - 1, elem, new_area);
                     }
                     else
                     {
@@ -1276,9 +1268,17 @@ void TreeSupport::increaseAreas(
                 parent->result_on_layer_ = Point2LL(-1, -1);
             }
         });
+
+    for (TreeSupportElement* next : bypass_merge_area_per_parent)
+    {
+        if (next != nullptr)
+        {
+            bypass_merge_areas.emplace_back(next);
+        }
+    }
 }
 
-void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>& move_bounds)
+void TreeSupport::createLayerPathing(TreeSupportMoveBounds& move_bounds)
 {
     const double data_size_inverse = 1 / double(move_bounds.size());
     double progress_total = TREE_PROGRESS_PRECALC_AVO + TREE_PROGRESS_PRECALC_COLL + TREE_PROGRESS_GENERATE_NODES;
@@ -1322,7 +1322,7 @@ void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>&
         last_layer.insert(last_layer.begin(), move_bounds[layer_idx].begin(), move_bounds[layer_idx].end());
 
         // ### Increase the influence areas by the allowed movement distance
-        increaseAreas(to_bp_areas, to_model_areas, influence_areas, bypass_merge_areas, last_layer, layer_idx, merge_this_layer);
+        increaseAreas(to_bp_areas, to_model_areas, influence_areas, bypass_merge_areas, move_bounds, last_layer, layer_idx, merge_this_layer);
 
         const auto time_b = std::chrono::high_resolution_clock::now();
         if (merge_this_layer)
@@ -1346,13 +1346,13 @@ void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>&
 
         new_element = ! move_bounds[layer_idx - 1].empty();
 
-        // Save calculated elements to output, and allocate Polygons on heap, as they will not be changed again.
+        // Save calculated elements to output, and allocate Polygons in the move bounds, as they will not be changed again.
         for (std::pair<TreeSupportElement, Shape> tup : influence_areas)
         {
             const TreeSupportElement elem = tup.first;
-            Shape* new_area = new Shape(TreeSupportUtils::safeUnion(tup.second));
-            TreeSupportElement* next = new TreeSupportElement(elem, new_area);
-            move_bounds[layer_idx - 1].emplace(next);
+            Shape* new_area = move_bounds.createArea(layer_idx - 1, TreeSupportUtils::safeUnion(tup.second));
+            TreeSupportElement* next = move_bounds.createElement(layer_idx - 1, elem, new_area);
+            move_bounds.insert(layer_idx - 1, next);
 
             if (new_area->area() < 1)
             {
@@ -1367,7 +1367,7 @@ void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>&
             {
                 spdlog::error("Insert Error of Influence area bypass on layer {}.", layer_idx - 1);
             }
-            move_bounds[layer_idx - 1].emplace(elem);
+            move_bounds.insert(layer_idx - 1, elem);
         }
 
         progress_total += data_size_inverse * TREE_PROGRESS_AREA_CALC;
@@ -1410,7 +1410,7 @@ void TreeSupport::setPointsOnAreas(const TreeSupportElement* elem)
     }
 }
 
-bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx)
+bool TreeSupport::setToModelContact(TreeSupportMoveBounds& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx)
 {
     if (first_elem->to_model_gracious_)
     {
@@ -1459,8 +1459,6 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
                 for (LayerIndex layer = layer_idx; layer <= first_elem->next_height_; layer++)
                 {
                     move_bounds[layer].erase(checked[layer - layer_idx]);
-                    delete checked[layer - layer_idx]->area_;
-                    delete checked[layer - layer_idx];
                 }
                 return true;
             }
@@ -1476,8 +1474,6 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
              ++layer) // NOTE: Use of 'itoa' will make this crash in the loop, even though the operation should be equivalent.
         {
             move_bounds[layer].erase(checked[layer - layer_idx]);
-            delete checked[layer - layer_idx]->area_;
-            delete checked[layer - layer_idx];
         }
 
         // If resting on the buildplate keep bp location
@@ -1545,7 +1541,7 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
     }
 }
 
-void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>& move_bounds)
+void TreeSupport::createNodesFromArea(TreeSupportMoveBounds& move_bounds)
 {
     // Initialize points on layer 0, with a "random" point in the influence area. Point is chosen based on an inaccurate estimate where the branches will split into two, but every
     // point inside the influence area would produce a valid result.
@@ -1579,8 +1575,6 @@ void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>
     for (TreeSupportElement* del : remove)
     {
         move_bounds[0].erase(del);
-        delete del->area_;
-        delete del;
     }
     remove.clear();
 
@@ -1629,12 +1623,10 @@ void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>
             }
         }
 
-        // Delete all not needed support elements.
+        // Remove all not needed support elements. They are freed together with the move bounds.
         for (TreeSupportElement* del : remove)
         {
             move_bounds[layer_idx].erase(del);
-            delete del->area_;
-            delete del;
         }
         remove.clear();
     }
@@ -1642,7 +1634,7 @@ void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>
 
 void TreeSupport::generateBranchAreas(
     std::vector<std::pair<LayerIndex, TreeSupportElement*>>& linear_data,
-    std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons,
+    std::vector<TreeSupportElementAreas>& layer_tree_polygons,
     const std::map<TreeSupportElement*, TreeSupportElement*>& inverse_tree_order)
 {
     double progress_total = TREE_PROGRESS_PRECALC_AVO + TREE_PROGRESS_PRECALC_COLL + TREE_PROGRESS_GENERATE_NODES + TREE_PROGRESS_AREA_CALC;
@@ -1799,7 +1791,7 @@ void TreeSupport::generateBranchAreas(
     }
 }
 
-void TreeSupport::smoothBranchAreas(std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons)
+void TreeSupport::smoothBranchAreas(std::vector<TreeSupportElementAreas>& layer_tree_polygons)
 {
     double progress_total = TREE_PROGRESS_PRECALC_AVO + TREE_PROGRESS_PRECALC_COLL + TREE_PROGRESS_GENERATE_NODES + TREE_PROGRESS_AREA_CALC + TREE_PROGRESS_GENERATE_BRANCH_AREAS;
     const coord_t max_radius_change_per_layer = 1 + config.support_line_width / 2; // This is the upper limit a radius may change per layer. +1 to avoid rounding errors.
@@ -1921,7 +1913,7 @@ void TreeSupport::smoothBranchAreas(std::vector<std::unordered_map<TreeSupportEl
 }
 
 void TreeSupport::dropNonGraciousAreas(
-    std::vector<std::unordered_map<TreeSupportElement*, Shape>>& layer_tree_polygons,
+    std::vector<TreeSupportElementAreas>& layer_tree_polygons,
     const std::vector<std::pair<LayerIndex, TreeSupportElement*>>& linear_data,
     std::vector<std::vector<std::pair<LayerIndex, Shape>>>& dropped_down_areas,
     const std::map<TreeSupportElement*, TreeSupportElement*>& inverse_tree_order)
@@ -2305,7 +2297,7 @@ void TreeSupport::finalizeInterfaceAndSupportAreas(
         });
 }
 
-void TreeSupport::drawAreas(std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage)
+void TreeSupport::drawAreas(TreeSupportMoveBounds& move_bounds, SliceDataStorage& storage)
 {
     std::vector<Shape> support_layer_storage(move_bounds.size());
     std::vector<Shape> support_layer_storage_fractional(move_bounds.size());
@@ -2342,7 +2334,7 @@ void TreeSupport::drawAreas(std::vector<std::set<TreeSupportElement*>>& move_bou
 
 
     // Reorder the processed data by layers again. The map also could be a vector<pair<SupportElement*,Shape>>:
-    std::vector<std::unordered_map<TreeSupportElement*, Shape>> layer_tree_polygons(move_bounds.size());
+    std::vector<TreeSupportElementAreas> layer_tree_polygons(move_bounds.size());
     const auto t_start = std::chrono::high_resolution_clock::now();
 
     // Generate the circles that will be the branches.
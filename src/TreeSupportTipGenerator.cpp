@@ -3,11 +3,13 @@
 
 #include "TreeSupportTipGenerator.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <numbers>
 #include <string>
+#include <unordered_set>
 
 #include <range/v3/view/drop_last.hpp>
 #include <range/v3/view/enumerate.hpp>
@@ -624,7 +626,8 @@ void TreeSupportTipGenerator::calculateRoofAreas(const cura::SliceMeshStorage& m
 
 
 void TreeSupportTipGenerator::addPointAsInfluenceArea(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    TreeSupportMoveBounds& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& new_tips,
     std::pair<Point2LL, TreeSupportTipGenerator::LineStatus> p,
     size_t dtt,
     LayerIndex insert_layer,
@@ -654,7 +657,8 @@ void TreeSupportTipGenerator::addPointAsInfluenceArea(
         {
             // Normalize the point a bit to also catch points which are so close that inserting it would achieve nothing.
             already_inserted_[insert_layer].emplace(p.first / ((config_.min_radius + 1) / 10));
-            TreeSupportElement* elem = new TreeSupportElement(
+            TreeSupportElement* elem = move_bounds.createElement(
+                insert_layer,
                 dtt,
                 insert_layer,
                 p.first,
@@ -668,21 +672,22 @@ void TreeSupportTipGenerator::addPointAsInfluenceArea(
                 skip_ovalisation,
                 support_tree_limit_branch_reach_,
                 support_tree_branch_reach_limit_);
-            elem->area_ = new Shape(area);
+            elem->area_ = move_bounds.createArea(insert_layer, area);
 
             for (Point2LL target : additional_ovalization_targets)
             {
                 elem->additional_ovalization_targets_.emplace_back(target);
             }
 
-            move_bounds[insert_layer].emplace(elem);
+            new_tips[insert_layer].emplace_back(elem);
         }
     }
 }
 
 
 void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    TreeSupportMoveBounds& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& new_tips,
     std::vector<TreeSupportTipGenerator::LineInformation> lines,
     size_t roof_tip_layers,
     LayerIndex insert_layer_idx,
@@ -716,7 +721,7 @@ void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
             {
                 for (std::pair<Point2LL, TreeSupportTipGenerator::LineStatus> point_data : line)
                 {
-                    addPointAsInfluenceArea(move_bounds, point_data, 0, insert_layer_idx - dtt_roof_tip, roof_tip_layers - dtt_roof_tip, dtt_roof_tip != 0, false);
+                    addPointAsInfluenceArea(move_bounds, new_tips, point_data, 0, insert_layer_idx - dtt_roof_tip, roof_tip_layers - dtt_roof_tip, dtt_roof_tip != 0, false);
                 }
             }
 
@@ -728,7 +733,7 @@ void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
             {
                 for (std::pair<Point2LL, TreeSupportTipGenerator::LineStatus> point_data : line)
                 {
-                    addPointAsInfluenceArea(move_bounds, point_data, 0, insert_layer_idx - dtt_roof_tip, roof_tip_layers - dtt_roof_tip, dtt_roof_tip != 0, false);
+                    addPointAsInfluenceArea(move_bounds, new_tips, point_data, 0, insert_layer_idx - dtt_roof_tip, roof_tip_layers - dtt_roof_tip, dtt_roof_tip != 0, false);
                 }
             }
 
@@ -781,6 +786,7 @@ void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
             }
             addPointAsInfluenceArea(
                 move_bounds,
+                new_tips,
                 point_data,
                 0,
                 insert_layer_idx - dtt_roof_tip,
@@ -794,28 +800,28 @@ void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
 
 
 void TreeSupportTipGenerator::removeUselessAddedPoints(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& new_tips,
     SliceDataStorage& storage,
     std::vector<Shape>& additional_support_areas)
 {
     cura::parallel_for<coord_t>(
         0,
-        move_bounds.size(),
+        new_tips.size(),
         [&](const LayerIndex layer_idx)
         {
             if (layer_idx + 1 < storage.support.supportLayers.size())
             {
-                std::vector<TreeSupportElement*> to_be_removed;
+                std::unordered_set<TreeSupportElement*> to_be_removed;
                 Shape roof_on_layer_above = use_fake_roof_ ? support_roof_drawn_[layer_idx + 1]
                                                            : storage.support.supportLayers[layer_idx + 1].support_roof.unionPolygons(additional_support_areas[layer_idx + 1]);
                 Shape roof_on_layer
                     = use_fake_roof_ ? support_roof_drawn_[layer_idx] : storage.support.supportLayers[layer_idx].support_roof.unionPolygons(additional_support_areas[layer_idx]);
 
-                for (TreeSupportElement* elem : move_bounds[layer_idx])
+                for (TreeSupportElement* elem : new_tips[layer_idx])
                 {
                     if (roof_on_layer.inside(elem->result_on_layer_)) // Remove branches that start inside of support interface
                     {
-                        to_be_removed.emplace_back(elem);
+                        to_be_removed.emplace(elem);
                     }
                     else if (elem->supports_roof_)
                     {
@@ -826,18 +832,19 @@ void TreeSupportTipGenerator::removeUselessAddedPoints(
                             || (! roof_on_layer_above.inside(elem->result_on_layer_)
                                 && vSize2(from - elem->result_on_layer_) > config_.getRadius(0) * config_.getRadius(0) + FUDGE_LENGTH * FUDGE_LENGTH))
                         {
-                            to_be_removed.emplace_back(elem);
+                            to_be_removed.emplace(elem);
                             spdlog::warn("Removing already placed tip that should have roof above it?");
                         }
                     }
                 }
 
-                for (auto elem : to_be_removed)
-                {
-                    move_bounds[layer_idx].erase(elem);
-                    delete elem->area_;
-                    delete elem;
-                }
+                // The removed tips stay allocated in the move bounds until the support of this mesh group is done.
+                std::erase_if(
+                    new_tips[layer_idx],
+                    [&to_be_removed](TreeSupportElement* elem)
+                    {
+                        return to_be_removed.contains(elem);
+                    });
             }
         });
 }
@@ -846,11 +853,11 @@ void TreeSupportTipGenerator::removeUselessAddedPoints(
 void TreeSupportTipGenerator::generateTips(
     SliceDataStorage& storage,
     const SliceMeshStorage& mesh,
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    TreeSupportMoveBounds& move_bounds,
     std::vector<Shape>& additional_support_areas,
     std::vector<std::vector<FakeRoofArea>>& placed_fake_roof_areas)
 {
-    std::vector<std::set<TreeSupportElement*>> new_tips(move_bounds.size());
+    std::vector<std::vector<TreeSupportElement*>> new_tips(move_bounds.size());
 
     const coord_t circle_length_to_half_linewidth_change
         = config_.min_radius < config_.support_line_width ? config_.min_radius / 2 : sqrt(square(config_.min_radius) - square(config_.min_radius - config_.support_line_width / 2));
@@ -1041,6 +1048,7 @@ void TreeSupportTipGenerator::generateTips(
                         // ^^^ Set all now valid lines to their correct LineStatus. Easiest way is to just discard Avoidance information for each point and evaluate them again.
 
                         addLinesAsInfluenceAreas(
+                            move_bounds,
                             new_tips,
                             fresh_valid_points,
                             (force_tip_to_roof_ && lag_ctr <= support_roof_layers_) ? support_roof_layers_ : 0,
@@ -1130,6 +1138,7 @@ void TreeSupportTipGenerator::generateTips(
 
                 size_t dont_move_for_layers = support_roof_layers_ ? (force_tip_to_roof_ ? support_roof_layers_ : (roof_allowed_for_this_part ? 0 : support_roof_layers_)) : 0;
                 addLinesAsInfluenceAreas(
+                    move_bounds,
                     new_tips,
                     overhang_lines,
                     force_tip_to_roof_ ? support_roof_layers_ : 0,
@@ -1206,7 +1215,18 @@ void TreeSupportTipGenerator::generateTips(
 
     for (auto [layer_idx, tips_on_layer] : new_tips | ranges::views::enumerate)
     {
-        move_bounds[layer_idx].insert(tips_on_layer.begin(), tips_on_layer.end());
+        // The tips were added from multiple threads, so sort them before they get their ids. Tips on the same layer never share a position.
+        std::sort(
+            tips_on_layer.begin(),
+            tips_on_layer.end(),
+            [](const TreeSupportElement* a, const TreeSupportElement* b)
+            {
+                return *a < *b;
+            });
+        for (TreeSupportElement* tip : tips_on_layer)
+        {
+            move_bounds.insert(layer_idx, tip);
+        }
     }
 }
 
@@ -4,6 +4,8 @@
 #include "WallToolPaths.h"
 
 #include <algorithm> //For std::partition_copy and std::min_element.
+#include <cmath>
+#include <iterator>
 #include <unordered_set>
 
 #include <range/v3/range/conversion.hpp>
@@ -15,6 +17,7 @@
 #include "SkeletalTrapezoidation.h"
 #include "utils/ExtrusionLineStitcher.h"
 #include "utils/Simplify.h"
+#include "utils/AABB.h"
 #include "utils/SparsePointGrid.h" //To stitch the inner contour.
 #include "utils/actions/smooth.h"
 #include "utils/polygonUtils.h"
@@ -147,17 +150,77 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
         wall_distribution_count);
     const auto transition_filter_dist = settings_.get<coord_t>("wall_transition_filter_distance");
     const auto allowed_filter_deviation = settings_.get<coord_t>("wall_transition_filter_deviation");
-    SkeletalTrapezoidation wall_maker(
-        prepared_outline,
-        *beading_strat,
-        beading_strat->getTransitioningAngle(),
-        discretization_step_size,
-        transition_filter_dist,
-        allowed_filter_deviation,
-        wall_transition_length,
-        layer_idx_,
-        section_type_);
-    wall_maker.generateToolpaths(toolpaths_);
+    const auto generate_skeletal_walls = [&](const Shape& outline, std::vector<VariableWidthLines>& toolpaths)
+    {
+        SkeletalTrapezoidation wall_maker(
+            outline,
+            *beading_strat,
+            beading_strat->getTransitioningAngle(),
+            discretization_step_size,
+            transition_filter_dist,
+            allowed_filter_deviation,
+            wall_transition_length,
+            layer_idx_,
+            section_type_);
+        wall_maker.generateToolpaths(toolpaths);
+    };
+
+    // Where the outline is thick enough to get the maximum number of walls, the walls have constant width and are much cheaper to
+    // generate as offsets of the outline. The skeletal trapezoidation is then only needed around the thin regions. An unlimited number of
+    // walls is never constant.
+    if (offset_fast_path_ && max_bead_count > 0 && max_bead_count < static_cast<size_t>(std::numeric_limits<coord_t>::max() / 2))
+    {
+        // Thinner than this, the skeletal trapezoidation gives fewer walls, or a transition to fewer walls that its filter could dissolve
+        // into the thicker surroundings.
+        const coord_t uniform_radius = beading_strat->getTransitionThickness(static_cast<coord_t>(max_bead_count)) / 2 + allowed_filter_deviation;
+        const Shape thin_regions = findThinRegions(prepared_outline, uniform_radius, beading_strat->getTransitioningAngle());
+        bool spliced = thin_regions.empty();
+        if (spliced)
+        {
+            generateOffsetWalls(prepared_outline, *beading_strat, static_cast<coord_t>(max_bead_count), toolpaths_);
+        }
+        else
+        {
+            // The transitions near the thin regions reach about a transition length further. Beyond that, the walls are offsets again.
+            const coord_t reach = 2 * uniform_radius + 2 * wall_transition_length;
+            // Cutting the outline creates new boundaries, which get walls of their own. Keep those walls out of the thin zone.
+            const Shape skeletal_outline = prepared_outline.intersection(thin_regions.offset(2 * reach, ClipperLib::jtRound)).removeNearSelfIntersections();
+            constexpr double max_skeletal_share = 0.75; // Cutting out most of the outline would cost more than it saves.
+            if (skeletal_outline.area() > 0 && skeletal_outline.area() < prepared_outline.area() * max_skeletal_share)
+            {
+                const Shape thin_zone = thin_regions.offset(reach, ClipperLib::jtRound).intersection(prepared_outline);
+                std::vector<VariableWidthLines> skeletal_walls;
+                generate_skeletal_walls(skeletal_outline, skeletal_walls);
+                const std::vector<ExtrusionJunction> skeletal_cuts = clipToolPaths(skeletal_walls, thin_zone, true);
+                generateOffsetWalls(prepared_outline, *beading_strat, static_cast<coord_t>(max_bead_count), toolpaths_);
+                const std::vector<ExtrusionJunction> offset_cuts = clipToolPaths(toolpaths_, thin_zone, false);
+
+                // Where the cut meets the outline at a sharp angle, it may have changed the walls up to the thin zone. Then they don't connect.
+                spliced = wallsConnect(skeletal_cuts, offset_cuts, bead_width_x_ / 8);
+                if (spliced)
+                {
+                    toolpaths_.resize(std::max(toolpaths_.size(), skeletal_walls.size()));
+                    for (size_t inset_idx = 0; inset_idx < skeletal_walls.size(); ++inset_idx)
+                    {
+                        VariableWidthLines& inset = skeletal_walls[inset_idx];
+                        toolpaths_[inset_idx].insert(toolpaths_[inset_idx].end(), std::make_move_iterator(inset.begin()), std::make_move_iterator(inset.end()));
+                    }
+                }
+                else
+                {
+                    toolpaths_.clear();
+                }
+            }
+        }
+        if (! spliced)
+        {
+            generate_skeletal_walls(prepared_outline, toolpaths_);
+        }
+    }
+    else
+    {
+        generate_skeletal_walls(prepared_outline, toolpaths_);
+    }
     scripta::log(
         "toolpaths_0",
         toolpaths_,
@@ -241,6 +304,232 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
     return toolpaths_;
 }
 
+Shape WallToolPaths::findThinRegions(const Shape& outline, const coord_t radius, const AngleRadians transitioning_angle)
+{
+    // The offsets are rounded, which leaves slivers along the outline. Count those as covered, and make up for it in the radius.
+    constexpr coord_t sliver_width = 50;
+    const coord_t cover_radius = radius + sliver_width;
+
+    // Everything that can't be reached by a disk of the radius that fits inside the outline. That's the thin regions and the convex corners.
+    Shape uncovered = outline.difference(outline.offset(-cover_radius, ClipperLib::jtRound).offset(cover_radius, ClipperLib::jtRound));
+    if (uncovered.empty())
+    {
+        return uncovered;
+    }
+
+    // Corners that aren't sharper than the transitioning angle don't get any transitions, unless their edges are too short to fit the disk.
+    constexpr double angle_margin = 0.05; // To keep corners at about the transitioning angle thin.
+    Shape corners;
+    for (const Polygon& polygon : outline)
+    {
+        for (size_t point_idx = 0; point_idx < polygon.size(); ++point_idx)
+        {
+            const Point2LL& vertex = polygon[point_idx];
+            const Point2LL to_previous = polygon[(point_idx + polygon.size() - 1) % polygon.size()] - vertex;
+            const Point2LL to_next = polygon[(point_idx + 1) % polygon.size()] - vertex;
+            if (cross(to_next, to_previous) <= 0)
+            {
+                continue; // Not convex. The material is on the left of the outline.
+            }
+            const double angle = std::atan2(static_cast<double>(cross(to_next, to_previous)), static_cast<double>(dot(to_next, to_previous)));
+            if (angle < static_cast<double>(transitioning_angle) + angle_margin)
+            {
+                continue;
+            }
+            const coord_t leg = static_cast<coord_t>(cover_radius / std::tan(angle / 2)) + sliver_width;
+            if (vSize(to_previous) < leg || vSize(to_next) < leg)
+            {
+                continue;
+            }
+            Polygon& corner = corners.newLine();
+            corner.push_back(vertex);
+            corner.push_back(vertex + normal(to_next, leg));
+            corner.push_back(vertex + normal(to_previous, leg));
+        }
+    }
+    uncovered = uncovered.difference(corners.unionPolygons().offset(sliver_width));
+    return uncovered.offset(-sliver_width / 2).offset(sliver_width / 2);
+}
+
+void WallToolPaths::generateOffsetWalls(const Shape& outline, const BeadingStrategy& beading_strategy, const coord_t max_bead_count, std::vector<VariableWidthLines>& toolpaths)
+{
+    // In the thickest parts, the beading strategy puts the walls on either side of a 0-width marker for the inner contour.
+    const size_t wall_count = static_cast<size_t>(max_bead_count / 2);
+    const BeadingStrategy::Beading beading = beading_strategy.compute(beading_strategy.getOptimalThickness(max_bead_count + 1), max_bead_count + 1);
+    assert(beading.bead_widths.size() > wall_count && beading.bead_widths[wall_count] == 0);
+
+    std::vector<coord_t> distances;
+    distances.reserve(wall_count + 1);
+    for (size_t inset_idx = 0; inset_idx <= wall_count; ++inset_idx)
+    {
+        distances.push_back(-beading.toolpath_locations[inset_idx]);
+    }
+    // Rounding only applies to the reflex corners when insetting. The convex corners stay sharp, like those of the skeletal trapezoidation.
+    const std::vector<Shape> offsets = outline.offsetNested(distances, ClipperLib::jtRound);
+
+    toolpaths.resize(wall_count + 1); // Including the marker, from which the inner contour is separated out like any other.
+    for (size_t inset_idx = 0; inset_idx <= wall_count; ++inset_idx)
+    {
+        const coord_t width = beading.bead_widths[inset_idx];
+        for (const Polygon& polygon : offsets[inset_idx])
+        {
+            // The skeletal trapezoidation goes along each segment of the outline from its end to its start, so its walls go the other way.
+            ExtrusionLine& line = toolpaths[inset_idx].emplace_back(inset_idx, false, true);
+            line.junctions_.reserve(polygon.size());
+            for (auto point = polygon.rbegin(); point != polygon.rend(); ++point)
+            {
+                line.junctions_.emplace_back(*point, width, inset_idx);
+            }
+        }
+    }
+}
+
+std::vector<ExtrusionJunction> WallToolPaths::clipToolPaths(std::vector<VariableWidthLines>& toolpaths, const Shape& area, const bool keep_inside)
+{
+    std::vector<ExtrusionJunction> cuts;
+    const AABB area_box(area);
+    for (VariableWidthLines& inset : toolpaths)
+    {
+        VariableWidthLines clipped;
+        for (ExtrusionLine& line : inset)
+        {
+            AABB line_box;
+            for (const ExtrusionJunction& junction : line)
+            {
+                line_box.include(junction.p_);
+            }
+            if (line.size() < 2 || ! area_box.hit(line_box))
+            {
+                if (! keep_inside)
+                {
+                    clipped.push_back(std::move(line));
+                }
+                continue;
+            }
+
+            VariableWidthLines pieces;
+            ExtrusionLine piece(line.inset_idx_, line.is_odd_);
+            bool first_is_kept = false; // Whether the first piece starts at the start of the line.
+            bool last_is_kept = false; // Whether the last piece ends at the end of the line.
+            bool is_cut = false;
+            const size_t segment_count = line.is_closed_ ? line.size() : line.size() - 1;
+            for (size_t segment_idx = 0; segment_idx < segment_count; ++segment_idx)
+            {
+                const ExtrusionJunction& start = line.junctions_[segment_idx];
+                const ExtrusionJunction& end = line.junctions_[(segment_idx + 1) % line.size()];
+                const auto junction_at = [&start, &end](const double t)
+                {
+                    return ExtrusionJunction(lerp(start.p_, end.p_, t), start.w_ + std::llrint(static_cast<double>(end.w_ - start.w_) * t), start.perimeter_index_);
+                };
+
+                std::vector<double> params{ 0.0, 1.0 };
+                AABB segment_box;
+                segment_box.include(start.p_);
+                segment_box.include(end.p_);
+                if (area_box.hit(segment_box))
+                {
+                    for (const float t : area.intersectionsWithSegment(start.p_, end.p_))
+                    {
+                        params.push_back(t);
+                    }
+                    std::sort(params.begin(), params.end());
+                }
+                for (size_t param_idx = 0; param_idx + 1 < params.size(); ++param_idx)
+                {
+                    const double from = params[param_idx];
+                    const double to = params[param_idx + 1];
+                    if (to <= from)
+                    {
+                        continue;
+                    }
+                    const bool is_kept = area.inside(lerp(start.p_, end.p_, (from + to) / 2)) == keep_inside;
+                    if (segment_idx == 0 && param_idx == 0)
+                    {
+                        first_is_kept = is_kept;
+                    }
+                    last_is_kept = is_kept;
+                    if (is_kept)
+                    {
+                        if (piece.empty())
+                        {
+                            piece.junctions_.push_back(junction_at(from));
+                        }
+                        piece.junctions_.push_back(junction_at(to));
+                    }
+                    else
+                    {
+                        is_cut = true;
+                        if (! piece.empty())
+                        {
+                            pieces.push_back(std::move(piece));
+                            piece = ExtrusionLine(line.inset_idx_, line.is_odd_);
+                        }
+                    }
+                }
+            }
+            if (! is_cut)
+            {
+                clipped.push_back(std::move(line));
+                continue;
+            }
+            if (! piece.empty())
+            {
+                pieces.push_back(std::move(piece));
+            }
+            if (line.is_closed_ && first_is_kept && last_is_kept && pieces.size() > 1)
+            {
+                // The first and the last piece meet at the start of the closed line.
+                pieces.back().junctions_.insert(pieces.back().junctions_.end(), std::next(pieces.front().junctions_.begin()), pieces.front().junctions_.end());
+                pieces.erase(pieces.begin());
+            }
+            for (ExtrusionLine& kept : pieces)
+            {
+                // The ends of the line itself weren't cut, unless they are inside a piece of a closed line.
+                if (line.is_closed_ || &kept != &pieces.front() || ! first_is_kept)
+                {
+                    cuts.push_back(kept.junctions_.front());
+                }
+                if (line.is_closed_ || &kept != &pieces.back() || ! last_is_kept)
+                {
+                    cuts.push_back(kept.junctions_.back());
+                }
+                clipped.push_back(std::move(kept));
+            }
+        }
+        inset = std::move(clipped);
+    }
+    return cuts;
+}
+
+bool WallToolPaths::wallsConnect(const std::vector<ExtrusionJunction>& cuts, const std::vector<ExtrusionJunction>& other_cuts, const coord_t max_distance)
+{
+    if (cuts.size() != other_cuts.size())
+    {
+        return false;
+    }
+    constexpr coord_t max_width_difference = 10;
+    std::vector<bool> is_matched(other_cuts.size(), false);
+    for (const ExtrusionJunction& cut : cuts)
+    {
+        bool found = false;
+        for (size_t other_idx = 0; other_idx < other_cuts.size(); ++other_idx)
+        {
+            const ExtrusionJunction& other = other_cuts[other_idx];
+            if (! is_matched[other_idx] && other.perimeter_index_ == cut.perimeter_index_ && std::abs(other.w_ - cut.w_) <= max_width_difference
+                && shorterThan(other.p_ - cut.p_, max_distance))
+            {
+                is_matched[other_idx] = true;
+                found = true;
+                break;
+            }
+        }
+        if (! found)
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
 void WallToolPaths::stitchToolPaths(std::vector<VariableWidthLines>& toolpaths, const Settings& settings)
 {
@@ -253,7 +542,12 @@ void WallToolPaths::stitchToolPaths(std::vector<VariableWidthLines>& toolpaths,
 
         VariableWidthLines stitched_polylines;
         VariableWidthLines closed_polygons;
-        ExtrusionLineStitcher::stitch(wall_lines, stitched_polylines, closed_polygons, stitch_distance);
+        VariableWidthLines open_lines; // Walls generated as offsets are closed already.
+        for (ExtrusionLine& line : wall_lines)
+        {
+            (line.is_closed_ ? closed_polygons : open_lines).push_back(std::move(line));
+        }
+        ExtrusionLineStitcher::stitch(open_lines, stitched_polylines, closed_polygons, stitch_distance);
         wall_lines = stitched_polylines; // replace input toolpaths with stitched polylines
 
         for (ExtrusionLine& wall_polygon : closed_polygons)
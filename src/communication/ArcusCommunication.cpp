@@ -110,6 +110,7 @@ public:
         if (_layer_nr != new_layer_nr)
         {
             flushPathSegments();
+            _cs_private_data.sendCompletedOptimizedLayer(_layer_nr); // Stream the previous layer to the front-end if it's done.
             _layer_nr = new_layer_nr;
         }
     }
@@ -171,30 +172,17 @@ public:
         path_segment->set_extruder(extruder);
         path_segment->set_point_type(data_point_type);
 
-        std::string line_type_data;
-        line_type_data.append(reinterpret_cast<const char*>(line_types.data()), line_types.size() * sizeof(PrintFeatureType));
+        // Copy the buffers straight into the message (and its arena), without intermediate strings.
+        path_segment->set_line_type(line_types.data(), line_types.size() * sizeof(PrintFeatureType));
         line_types.clear();
-        path_segment->set_line_type(line_type_data);
-
-        std::string polygon_data;
-        polygon_data.append(reinterpret_cast<const char*>(points.data()), points.size() * sizeof(float));
+        path_segment->set_points(points.data(), points.size() * sizeof(float));
         points.clear();
-        path_segment->set_points(polygon_data);
-
-        std::string line_width_data;
-        line_width_data.append(reinterpret_cast<const char*>(line_widths.data()), line_widths.size() * sizeof(float));
+        path_segment->set_line_width(line_widths.data(), line_widths.size() * sizeof(float));
         line_widths.clear();
-        path_segment->set_line_width(line_width_data);
-
-        std::string line_thickness_data;
-        line_thickness_data.append(reinterpret_cast<const char*>(line_thicknesses.data()), line_thicknesses.size() * sizeof(float));
+        path_segment->set_line_thickness(line_thicknesses.data(), line_thicknesses.size() * sizeof(float));
         line_thicknesses.clear();
-        path_segment->set_line_thickness(line_thickness_data);
-
-        std::string line_velocity_data;
-        line_velocity_data.append(reinterpret_cast<const char*>(line_velocities.data()), line_velocities.size() * sizeof(float));
+        path_segment->set_line_feedrate(line_velocities.data(), line_velocities.size() * sizeof(float));
         line_velocities.clear();
-        path_segment->set_line_feedrate(line_velocity_data);
     }
 
     /*!
@@ -314,24 +302,22 @@ void ArcusCommunication::setSocketMock(Arcus::Socket* socket)
 
 void ArcusCommunication::beginGCode()
 {
-    FffProcessor::getInstance()->setTargetStream(&private_data->gcode_output_stream);
+    FffProcessor::getInstance()->setTargetSink(private_data->gcode_output);
 }
 
 void ArcusCommunication::flushGCode()
 {
-    std::string gcode_output_stream = private_data->gcode_output_stream.str();
-    auto message_str = slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(gcode_output_stream);
+    std::string gcode = private_data->gcode_output->take();
+    auto message_str = slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(gcode);
     if (message_str.size() == 0)
     {
         return;
     }
     std::shared_ptr<proto::GCodeLayer> message = std::make_shared<proto::GCodeLayer>();
-    message->set_data(message_str);
+    message->set_data(std::move(message_str));
 
     // Send the g-code to the front-end! Yay!
     private_data->socket->sendMessage(message);
-
-    private_data->gcode_output_stream.str("");
 }
 
 bool ArcusCommunication::isSequential() const
@@ -377,6 +363,7 @@ void ArcusCommunication::sendLayerComplete(const LayerIndex::value_type& layer_n
     std::shared_ptr<proto::LayerOptimized> layer = private_data->getOptimizedLayerById(layer_nr);
     layer->set_height(z);
     layer->set_thickness(thickness);
+    private_data->completeOptimizedLayer(layer_nr);
 }
 
 void ArcusCommunication::sendLineTo(const PrintFeatureType& type, const Point3LL& to, const coord_t& line_width, const coord_t& line_thickness, const Velocity& velocity)
@@ -388,24 +375,26 @@ void ArcusCommunication::sendOptimizedLayerData()
 {
     path_compiler->flushPathSegments(); // Make sure the last path segment has been flushed from the compiler.
 
+    // Most layers have been streamed to the front-end already, while writing the g-code. Send the ones that are left.
     SliceDataStruct<proto::LayerOptimized>& data = private_data->optimized_layers;
-    data.sliced_objects++;
-    data.current_layer_offset = data.current_layer_count;
-    if (data.sliced_objects < private_data->object_count) // Nothing to send.
+    spdlog::info("Sending the last {} of {} layers.", data.slice_data.size(), data.current_layer_count);
+    for (auto& entry : data.slice_data) // Note: This is in no particular order!
     {
-        return;
+        spdlog::debug("Sending layer data for layer {}.", entry.first);
+        private_data->sendOptimizedLayer(std::move(entry.second)); // Send the actual layers.
     }
-    spdlog::info("Sending {} layers.", data.current_layer_count);
+    data.slice_data.clear();
+    data.completed_layers.clear();
 
-    for (const auto& entry : data.slice_data) // Note: This is in no particular order!
+    data.sliced_objects++;
+    data.current_layer_offset = data.current_layer_count;
+    if (data.sliced_objects < private_data->object_count)
     {
-        spdlog::debug("Sending layer data for layer {} of {}.", entry.first, data.slice_data.size());
-        private_data->socket->sendMessage(entry.second); // Send the actual layers.
+        return;
     }
     data.sliced_objects = 0;
     data.current_layer_count = 0;
     data.current_layer_offset = 0;
-    data.slice_data.clear();
 }
 
 void ArcusCommunication::sendPrintTimeMaterialEstimates() const
@@ -5,8 +5,13 @@
 
 #include "communication/ArcusCommunicationPrivate.h"
 
+#include <chrono>
 #include <fstream>
 #include <png.h>
+#include <thread>
+
+#include <Arcus/Socket.h>
+#include <google/protobuf/arena.h>
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/memorystream.h>
@@ -26,6 +31,8 @@ namespace cura
 ArcusCommunication::Private::Private()
     : socket(nullptr)
     , object_count(0)
+    , gcode_output(std::make_shared<BufferGCodeSink>())
+    , optimized_layer_bytes_in_flight(0)
     , last_sent_progress(-1)
     , slice_count(0)
     , millisecUntilNextTry(100)
@@ -43,7 +50,13 @@ std::shared_ptr<proto::LayerOptimized> ArcusCommunication::Private::getOptimized
     }
     else // Not in the cache yet. Create an empty layer.
     {
-        std::shared_ptr<proto::LayerOptimized> layer = std::make_shared<proto::LayerOptimized>();
+        // The layer and all its path segments are allocated in an arena that lives as long as the layer message, so that building
+        // the message doesn't need an allocation for every path segment, and freeing it is a single deallocation.
+        google::protobuf::ArenaOptions arena_options;
+        arena_options.start_block_size = 64 * 1024;
+        arena_options.max_block_size = 1024 * 1024;
+        auto arena = std::make_shared<google::protobuf::Arena>(arena_options);
+        std::shared_ptr<proto::LayerOptimized> layer(arena, google::protobuf::Arena::Create<proto::LayerOptimized>(arena.get()));
         layer->set_id(layer_nr);
         optimized_layers.current_layer_count++;
         optimized_layers.slice_data[layer_nr] = layer;
@@ -51,6 +64,51 @@ std::shared_ptr<proto::LayerOptimized> ArcusCommunication::Private::getOptimized
     }
 }
 
+void ArcusCommunication::Private::completeOptimizedLayer(LayerIndex::value_type layer_nr)
+{
+    optimized_layers.completed_layers.insert(layer_nr + optimized_layers.current_layer_offset);
+}
+
+void ArcusCommunication::Private::sendCompletedOptimizedLayer(LayerIndex::value_type layer_nr)
+{
+    layer_nr += optimized_layers.current_layer_offset;
+    if (optimized_layers.completed_layers.erase(layer_nr) == 0)
+    {
+        return; // There may still be data coming for this layer.
+    }
+    const auto find_result = optimized_layers.slice_data.find(layer_nr);
+    if (find_result == optimized_layers.slice_data.end())
+    {
+        return;
+    }
+    std::shared_ptr<proto::LayerOptimized> layer = std::move(find_result->second);
+    optimized_layers.slice_data.erase(find_result);
+    sendOptimizedLayer(std::move(layer));
+}
+
+void ArcusCommunication::Private::sendOptimizedLayer(std::shared_ptr<proto::LayerOptimized> layer)
+{
+    while (true)
+    {
+        // The socket sends its messages in order, so the layers are released in the order in which they were queued.
+        while (! optimized_layers_in_flight.empty() && optimized_layers_in_flight.front().first.expired())
+        {
+            optimized_layer_bytes_in_flight -= optimized_layers_in_flight.front().second;
+            optimized_layers_in_flight.pop_front();
+        }
+        if (optimized_layer_bytes_in_flight <= max_optimized_layer_bytes_in_flight || socket->getState() != Arcus::SocketState::Connected)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const size_t layer_size = layer->ByteSizeLong();
+    optimized_layers_in_flight.emplace_back(layer, layer_size);
+    optimized_layer_bytes_in_flight += layer_size;
+    socket->sendMessage(std::move(layer));
+}
+
 void ArcusCommunication::Private::readGlobalSettingsMessage(const proto::SettingList& global_settings_message)
 {
     auto slice = Application::getInstance().current_slice_;
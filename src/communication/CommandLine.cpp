@@ -3,10 +3,15 @@
 
 #include "communication/CommandLine.h"
 
+#include <algorithm>
+#include <cctype> //For isspace.
 #include <cerrno> // error number when trying to read file
 #include <cstring> //For strtok and strcopy.
 #include <filesystem>
 #include <fstream> //To check if files exist.
+#include <iostream> //To write g-code to stdout again after a job of a batch.
+#include <iterator>
+#include <memory>
 #include <numeric> //For std::accumulate.
 #include <optional>
 #include <rapidjson/error/en.h> //Loading JSON documents to get settings from them.
@@ -41,8 +46,15 @@ CommandLine::CommandLine(const std::vector<std::string>& arguments)
 {
     if (auto search_paths = spdlog::details::os::getenv("CURA_ENGINE_SEARCH_PATH"); ! search_paths.empty())
     {
-        search_directories_ = search_paths | views::split_paths | ranges::to<std::vector<std::filesystem::path>>();
+        default_search_directories_ = search_paths | views::split_paths | ranges::to<std::vector<std::filesystem::path>>();
     };
+    search_directories_ = default_search_directories_;
+}
+
+CommandLine::CommandLine(std::vector<std::vector<std::string>> jobs)
+    : CommandLine(std::vector<std::string>{})
+{
+    queued_jobs_.assign(std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
 }
 
 // These are not applicable to command line slicing.
@@ -76,7 +88,7 @@ void CommandLine::setLayerForSend(const LayerIndex::value_type&)
 
 bool CommandLine::hasSlice() const
 {
-    return ! arguments_.empty();
+    return ! arguments_.empty() || ! queued_jobs_.empty();
 }
 
 bool CommandLine::isSequential() const
@@ -118,6 +130,22 @@ void CommandLine::sendProgress(double progress) const
 
 void CommandLine::sliceNext()
 {
+    if (arguments_.empty())
+    {
+        if (queued_jobs_.empty())
+        {
+            return;
+        }
+        // Start the next job of the batch from a clean state. Only the parsed JSON files and the thread pool are kept. The new g-code writer
+        // also closes the output file of the previous job.
+        arguments_ = std::move(queued_jobs_.front());
+        queued_jobs_.pop_front();
+        search_directories_ = default_search_directories_;
+        last_shown_progress_ = 0;
+        FffProcessor::getInstance()->reset();
+        spdlog::info("Starting the next job of the batch, {} more to go.", queued_jobs_.size());
+    }
+
     FffProcessor::getInstance()->time_keeper.restart();
 
     // Count the number of mesh groups to slice for.
@@ -504,8 +532,104 @@ void CommandLine::sliceNext()
     FffProcessor::getInstance()->finalize();
 }
 
+std::optional<std::vector<std::vector<std::string>>> CommandLine::readJobManifest(const std::filesystem::path& manifest_filename, const std::string& executable)
+{
+    std::ifstream file(manifest_filename);
+    if (! file)
+    {
+        spdlog::error("Couldn't open manifest file: {}", manifest_filename.generic_string());
+        return std::nullopt;
+    }
+
+    std::vector<std::vector<std::string>> jobs;
+    std::string line;
+    size_t line_nr = 0;
+    while (std::getline(file, line))
+    {
+        line_nr++;
+        std::vector<std::string> job{ executable, "slice" }; // The arguments are parsed as if the application was called with them.
+        std::string argument;
+        bool in_argument = false;
+        bool in_quotes = false;
+        for (const char character : line)
+        {
+            if (character == '"')
+            {
+                in_quotes = ! in_quotes;
+                in_argument = true; // Also for a pair of quotes without anything in between, which is an empty argument.
+            }
+            else if (! in_quotes && std::isspace(static_cast<unsigned char>(character)))
+            {
+                if (in_argument)
+                {
+                    job.push_back(std::move(argument));
+                    argument.clear();
+                    in_argument = false;
+                }
+            }
+            else
+            {
+                argument.push_back(character);
+                in_argument = true;
+            }
+        }
+        if (in_quotes)
+        {
+            spdlog::error("Missing closing quote on line {} of manifest file {}", line_nr, manifest_filename.generic_string());
+            return std::nullopt;
+        }
+        if (in_argument)
+        {
+            job.push_back(std::move(argument));
+        }
+
+        if (job.size() == 2 || job[2].starts_with('#')) // Empty line or comment.
+        {
+            continue;
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    if (jobs.empty())
+    {
+        spdlog::warn("Manifest file {} contains no jobs.", manifest_filename.generic_string());
+    }
+    return jobs;
+}
+
 int CommandLine::loadJSON(const std::filesystem::path& json_filename, Settings& settings, bool force_read_parent, bool force_read_nondefault)
 {
+    std::shared_ptr<const rapidjson::Document> json_document;
+    if (const int error_code = readJSONDocument(json_filename, json_document); error_code != 0)
+    {
+        return error_code;
+    }
+
+    // Directories that are searched already are found first anyway, so don't add them again for every file loaded from them.
+    const std::filesystem::path directory = json_filename.parent_path();
+    if (std::find(search_directories_.begin(), search_directories_.end(), directory) == search_directories_.end())
+    {
+        search_directories_.push_back(directory);
+    }
+    return loadJSON(*json_document, search_directories_, settings, force_read_parent, force_read_nondefault);
+}
+
+int CommandLine::readJSONDocument(const std::filesystem::path& json_filename, std::shared_ptr<const rapidjson::Document>& document)
+{
+    // Files that can't be stat-ed are not cached, so that they get the same error handling as before.
+    std::error_code error;
+    const std::string cache_key = std::filesystem::absolute(json_filename, error).lexically_normal().string();
+    const std::filesystem::file_time_type last_write_time = error ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(json_filename, error);
+    const bool cacheable = ! error;
+    if (cacheable)
+    {
+        if (const auto cached = document_cache_.find(cache_key); cached != document_cache_.end() && cached->second.last_write_time == last_write_time)
+        {
+            document = cached->second.document;
+            return 0;
+        }
+    }
+
     std::ifstream file(json_filename, std::ios::binary);
     if (! file)
     {
@@ -516,16 +640,20 @@ int CommandLine::loadJSON(const std::filesystem::path& json_filename, Settings&
     std::vector<char> read_buffer(std::istreambuf_iterator<char>(file), {});
     rapidjson::MemoryStream memory_stream(read_buffer.data(), read_buffer.size());
 
-    rapidjson::Document json_document;
-    json_document.ParseStream(memory_stream);
-    if (json_document.HasParseError())
+    auto json_document = std::make_shared<rapidjson::Document>();
+    json_document->ParseStream(memory_stream);
+    if (json_document->HasParseError())
     {
-        spdlog::error("Error parsing JSON (offset {}): {}", json_document.GetErrorOffset(), GetParseError_En(json_document.GetParseError()));
+        spdlog::error("Error parsing JSON (offset {}): {}", json_document->GetErrorOffset(), GetParseError_En(json_document->GetParseError()));
         return 2;
     }
 
-    search_directories_.push_back(std::filesystem::path(json_filename).parent_path());
-    return loadJSON(json_document, search_directories_, settings, force_read_parent, force_read_nondefault);
+    document = std::move(json_document);
+    if (cacheable)
+    {
+        document_cache_.insert_or_assign(cache_key, CachedDocument{ .last_write_time = last_write_time, .document = document });
+    }
+    return 0;
 }
 
 int CommandLine::loadJSON(
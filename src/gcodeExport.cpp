@@ -39,13 +39,11 @@ std::string transliterate(const std::string& text)
 }
 
 GCodeExport::GCodeExport()
-    : output_stream_(&std::cout)
+    : output_(std::make_shared<StreamGCodeSink>(&std::cout))
     , current_position_(0, 0, MM2INT(20))
     , layer_nr_(0)
     , relative_extrusion_(false)
 {
-    *output_stream_ << std::fixed;
-
     current_e_value_ = 0;
     current_extruder_ = 0;
 
@@ -349,10 +347,15 @@ void GCodeExport::setLayerNr(const LayerIndex& layer_nr)
     layer_nr_ = layer_nr;
 }
 
+void GCodeExport::setOutput(std::shared_ptr<GCodeSink> output)
+{
+    output_->flush();
+    output_ = std::move(output);
+}
+
 void GCodeExport::setOutputStream(std::ostream* stream)
 {
-    output_stream_ = stream;
-    *output_stream_ << std::fixed;
+    setOutput(std::make_shared<StreamGCodeSink>(stream));
 }
 
 bool GCodeExport::getExtruderIsUsed(const int extruder_nr) const
@@ -577,24 +580,24 @@ void GCodeExport::writeComment(const std::string& unsanitized_comment)
 {
     const std::string comment = transliterate(unsanitized_comment);
 
-    *output_stream_ << ";";
+    *output_ << ";";
     for (unsigned int i = 0; i < comment.length(); i++)
     {
         if (comment[i] == '\n')
         {
-            *output_stream_ << new_line_ << ";";
+            *output_ << new_line_ << ";";
         }
         else
         {
-            *output_stream_ << comment[i];
+            *output_ << comment[i];
         }
     }
-    *output_stream_ << new_line_;
+    *output_ << new_line_;
 }
 
 void GCodeExport::writeTimeComment(const Duration time)
 {
-    *output_stream_ << ";TIME_ELAPSED:" << time << new_line_;
+    *output_ << ";TIME_ELAPSED:" << time << new_line_;
 }
 
 void GCodeExport::writeTypeComment(const PrintFeatureType& type)
@@ -602,31 +605,31 @@ void GCodeExport::writeTypeComment(const PrintFeatureType& type)
     switch (type)
     {
     case PrintFeatureType::OuterWall:
-        *output_stream_ << ";TYPE:WALL-OUTER" << new_line_;
+        *output_ << ";TYPE:WALL-OUTER" << new_line_;
         break;
     case PrintFeatureType::InnerWall:
-        *output_stream_ << ";TYPE:WALL-INNER" << new_line_;
+        *output_ << ";TYPE:WALL-INNER" << new_line_;
         break;
     case PrintFeatureType::Skin:
-        *output_stream_ << ";TYPE:SKIN" << new_line_;
+        *output_ << ";TYPE:SKIN" << new_line_;
         break;
     case PrintFeatureType::Support:
-        *output_stream_ << ";TYPE:SUPPORT" << new_line_;
+        *output_ << ";TYPE:SUPPORT" << new_line_;
         break;
     case PrintFeatureType::SkirtBrim:
-        *output_stream_ << ";TYPE:SKIRT" << new_line_;
+        *output_ << ";TYPE:SKIRT" << new_line_;
         break;
     case PrintFeatureType::Infill:
-        *output_stream_ << ";TYPE:FILL" << new_line_;
+        *output_ << ";TYPE:FILL" << new_line_;
         break;
     case PrintFeatureType::SupportInfill:
-        *output_stream_ << ";TYPE:SUPPORT" << new_line_;
+        *output_ << ";TYPE:SUPPORT" << new_line_;
         break;
     case PrintFeatureType::SupportInterface:
-        *output_stream_ << ";TYPE:SUPPORT-INTERFACE" << new_line_;
+        *output_ << ";TYPE:SUPPORT-INTERFACE" << new_line_;
         break;
     case PrintFeatureType::PrimeTower:
-        *output_stream_ << ";TYPE:PRIME-TOWER" << new_line_;
+        *output_ << ";TYPE:PRIME-TOWER" << new_line_;
         break;
     case PrintFeatureType::MoveUnretracted:
     case PrintFeatureType::MoveRetracted:
@@ -643,17 +646,17 @@ void GCodeExport::writeTypeComment(const PrintFeatureType& type)
 
 void GCodeExport::writeLayerComment(const LayerIndex layer_nr)
 {
-    *output_stream_ << ";LAYER:" << layer_nr << new_line_;
+    *output_ << ";LAYER:" << layer_nr << new_line_;
 }
 
 void GCodeExport::writeLayerCountComment(const size_t layer_count)
 {
-    *output_stream_ << ";LAYER_COUNT:" << layer_count << new_line_;
+    *output_ << ";LAYER_COUNT:" << layer_count << new_line_;
 }
 
 void GCodeExport::writeLine(const char* line)
 {
-    *output_stream_ << line << new_line_;
+    *output_ << line << new_line_;
 }
 
 void GCodeExport::resetExtrusionMode()
@@ -666,11 +669,11 @@ void GCodeExport::writeExtrusionMode(bool set_relative_extrusion_mode)
 {
     if (set_relative_extrusion_mode)
     {
-        *output_stream_ << "M83 ;relative extrusion mode" << new_line_;
+        *output_ << "M83 ;relative extrusion mode" << new_line_;
     }
     else
     {
-        *output_stream_ << "M82 ;absolute extrusion mode" << new_line_;
+        *output_ << "M82 ;absolute extrusion mode" << new_line_;
     }
 }
 
@@ -678,7 +681,7 @@ void GCodeExport::resetExtrusionValue()
 {
     if (! relative_extrusion_)
     {
-        *output_stream_ << "G92 " << extruder_attr_[current_extruder_].extruder_character_ << "0" << new_line_;
+        *output_ << "G92 " << extruder_attr_[current_extruder_].extruder_character_ << "0" << new_line_;
     }
     double current_extruded_volume = getCurrentExtrudedVolume();
     extruder_attr_[current_extruder_].total_filament_ += current_extruded_volume;
@@ -852,7 +855,7 @@ void GCodeExport::writeRawRetract(const RetractionAmounts& retraction_amounts)
 
     current_e_value_ += retraction_amounts.diff_e;
     const double output_e = (relative_extrusion_) ? retraction_amounts.diff_e : current_e_value_;
-    *output_stream_ << " " << extr_attr.extruder_character_ << PrecisionedDouble{ 5, output_e };
+    *output_ << " " << extr_attr.extruder_character_ << PrecisionedDouble{ 5, output_e };
     extr_attr.retraction_e_amount_current_ = retraction_amounts.new_e;
 }
 
@@ -917,7 +920,7 @@ bool GCodeExport::needPrimeBlob() const
 
 void GCodeExport::writeDelay(const Duration& time_amount)
 {
-    *output_stream_ << "G4 P" << int(time_amount * 1000) << new_line_;
+    *output_ << "G4 P" << int(time_amount * 1000) << new_line_;
     estimate_calculator_.addTime(time_amount);
 }
 
@@ -982,11 +985,11 @@ void GCodeExport::writeMoveBFB(const int x, const int y, const int z, const Velo
             {
                 // fprintf(f, "; %f e-per-mm %d mm-width %d mm/s\n", extrusion_per_mm, lineWidth, speed);
                 // fprintf(f, "M108 S%0.1f\r\n", rpm);
-                *output_stream_ << "M108 S" << PrecisionedDouble{ 1, rpm } << new_line_;
+                *output_ << "M108 S" << PrecisionedDouble{ 1, rpm } << new_line_;
                 current_speed_ = double(rpm);
             }
             // Add M101 or M201 to enable the proper extruder.
-            *output_stream_ << "M" << int((current_extruder_ + 1) * 100 + 1) << new_line_;
+            *output_ << "M" << int((current_extruder_ + 1) * 100 + 1) << new_line_;
             extruder_attr_[current_extruder_].retraction_e_amount_current_ = 0.0;
         }
         // Fix the speed by the actual RPM we are asking, because of rounding errors we cannot get all RPM values, but we have a lot more resolution in the feedrate value.
@@ -1003,13 +1006,13 @@ void GCodeExport::writeMoveBFB(const int x, const int y, const int z, const Velo
         // If we are not extruding, check if we still need to disable the extruder. This causes a retraction due to auto-retraction.
         if (! extruder_attr_[current_extruder_].retraction_e_amount_current_)
         {
-            *output_stream_ << "M103" << new_line_;
+            *output_ << "M103" << new_line_;
             extruder_attr_[current_extruder_].retraction_e_amount_current_
                 = 1.0; // 1.0 used as stub; BFB doesn't use the actual retraction amount; it performs retraction on the firmware automatically
         }
     }
-    *output_stream_ << "G1 X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y } << " Z" << MMtoStream{ z };
-    *output_stream_ << " F" << PrecisionedDouble{ 1, fspeed } << new_line_;
+    *output_ << "G1 X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y } << " Z" << MMtoStream{ z };
+    *output_ << " F" << PrecisionedDouble{ 1, fspeed } << new_line_;
 
     current_position_ = Point3LL(x, y, z);
     estimate_calculator_.plan(
@@ -1038,7 +1041,7 @@ void GCodeExport::writeTravel(const coord_t x, const coord_t y, const coord_t z,
 
     const PrintFeatureType travel_move_type = sendTravel(Point3LL(x, y, z), speed, extruder_attr, retraction_amounts);
 
-    *output_stream_ << "G0";
+    *output_ << "G0";
     writeFXYZE(speed, x, y, z, current_e_value_, travel_move_type, retraction_amounts);
 }
 
@@ -1110,13 +1113,13 @@ void GCodeExport::writeExtrusion(
     if (update_extrusion_offset && (extrusion_offset != current_e_offset_))
     {
         current_e_offset_ = extrusion_offset;
-        *output_stream_ << ";FLOW_RATE_COMPENSATED_OFFSET = " << current_e_offset_ << new_line_;
+        *output_ << ";FLOW_RATE_COMPENSATED_OFFSET = " << current_e_offset_ << new_line_;
     }
 
     extruder_attr_[current_extruder_].last_e_value_after_wipe_ += extrusion_per_mm * diff_length;
     const double new_e_value = current_e_value_ + extrusion_per_mm * diff_length;
 
-    *output_stream_ << "G1";
+    *output_ << "G1";
     writeFXYZE(speed, x, y, z, new_e_value, feature);
 }
 
@@ -1131,17 +1134,17 @@ void GCodeExport::writeFXYZE(
 {
     if (current_speed_ != speed)
     {
-        *output_stream_ << " F" << PrecisionedDouble{ 1, speed * 60 };
+        *output_ << " F" << PrecisionedDouble{ 1, speed * 60 };
         current_speed_ = speed;
     }
 
     Point2LL gcode_pos = getGcodePos(x, y, current_extruder_);
     total_bounding_box_.include(Point3LL(gcode_pos.X, gcode_pos.Y, z));
 
-    *output_stream_ << " X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y };
+    *output_ << " X" << MMtoStream{ gcode_pos.X } << " Y" << MMtoStream{ gcode_pos.Y };
     if (z != current_position_.z_)
     {
-        *output_stream_ << " Z" << MMtoStream{ z };
+        *output_ << " Z" << MMtoStream{ z };
     }
 
     if (retraction_amounts.has_value())
@@ -1154,10 +1157,10 @@ void GCodeExport::writeFXYZE(
     else if (e + current_e_offset_ != current_e_value_)
     {
         const double output_e = (relative_extrusion_) ? e + current_e_offset_ - current_e_value_ : e + current_e_offset_;
-        *output_stream_ << " " << extruder_attr_[current_extruder_].extruder_character_ << PrecisionedDouble{ 5, output_e };
+        *output_ << " " << extruder_attr_[current_extruder_].extruder_character_ << PrecisionedDouble{ 5, output_e };
         current_e_value_ = e;
     }
-    *output_stream_ << new_line_;
+    *output_ << new_line_;
 
     current_position_ = Point3LL(x, y, z);
     estimate_calculator_.plan(TimeEstimateCalculator::Position(INT2MM(x), INT2MM(y), INT2MM(z), eToMm(e)), speed, feature);
@@ -1172,12 +1175,12 @@ void GCodeExport::writeUnretractionAndPrime()
     {
         if (extruder_attr_[current_extruder_].machine_firmware_retract_)
         { // note that BFB is handled differently
-            *output_stream_ << "G11" << new_line_;
+            *output_ << "G11" << new_line_;
             // Assume default UM2 retraction settings.
             if (prime_volume != 0)
             {
                 const double output_e = (relative_extrusion_) ? prime_volume_e : current_e_value_;
-                *output_stream_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
+                *output_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
                                 << extruder_attr_[current_extruder_].extruder_character_ << PrecisionedDouble{ 5, output_e } << new_line_;
                 current_speed_ = extruder_attr_[current_extruder_].last_retraction_prime_speed_;
             }
@@ -1190,7 +1193,7 @@ void GCodeExport::writeUnretractionAndPrime()
         {
             current_e_value_ += extruder_attr_[current_extruder_].retraction_e_amount_current_;
             const double output_e = (relative_extrusion_) ? extruder_attr_[current_extruder_].retraction_e_amount_current_ + prime_volume_e : current_e_value_;
-            *output_stream_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
+            *output_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
                             << extruder_attr_[current_extruder_].extruder_character_ << PrecisionedDouble{ 5, output_e } << new_line_;
             current_speed_ = extruder_attr_[current_extruder_].last_retraction_prime_speed_;
             estimate_calculator_.plan(
@@ -1202,9 +1205,9 @@ void GCodeExport::writeUnretractionAndPrime()
     else if (prime_volume != 0.0)
     {
         const double output_e = (relative_extrusion_) ? prime_volume_e : current_e_value_;
-        *output_stream_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
+        *output_ << "G1 F" << PrecisionedDouble{ 1, extruder_attr_[current_extruder_].last_retraction_prime_speed_ * 60 } << " "
                         << extruder_attr_[current_extruder_].extruder_character_;
-        *output_stream_ << PrecisionedDouble{ 5, output_e } << new_line_;
+        *output_ << PrecisionedDouble{ 5, output_e } << new_line_;
         current_speed_ = extruder_attr_[current_extruder_].last_retraction_prime_speed_;
         estimate_calculator_.plan(
             TimeEstimateCalculator::Position(INT2MM(current_position_.x_), INT2MM(current_position_.y_), INT2MM(current_position_.z_), eToMm(current_e_value_)),
@@ -1235,7 +1238,7 @@ bool GCodeExport::writeRetraction(const RetractionConfig& config, bool force, bo
         {
             if (! extr_attr.retraction_e_amount_current_)
             {
-                *output_stream_ << "M103" << new_line_;
+                *output_ << "M103" << new_line_;
             }
             extr_attr.retraction_e_amount_current_ = 1.0; // 1.0 is a stub; BFB doesn't use the actual retracted amount; retraction is performed by firmware
         }
@@ -1279,12 +1282,12 @@ bool GCodeExport::writeRetraction(const RetractionConfig& config, bool force, bo
         {
             return true;
         }
-        *output_stream_ << "G10";
+        *output_ << "G10";
         if (extruder_switch && flavor_ == EGCodeFlavor::REPETIER)
         {
-            *output_stream_ << " S1";
+            *output_ << " S1";
         }
-        *output_stream_ << new_line_;
+        *output_ << new_line_;
         // Assume default UM2 retraction settings.
         estimate_calculator_.plan(
             TimeEstimateCalculator::Position(
@@ -1300,9 +1303,9 @@ bool GCodeExport::writeRetraction(const RetractionConfig& config, bool force, bo
     else
     {
         const double speed = ((retraction_amounts.diff_e < 0.0) ? config.speed : extr_attr.last_retraction_prime_speed_);
-        *output_stream_ << "G1 F" << PrecisionedDouble{ 1, speed * 60 };
+        *output_ << "G1 F" << PrecisionedDouble{ 1, speed * 60 };
         writeRawRetract(retraction_amounts);
-        *output_stream_ << new_line_;
+        *output_ << new_line_;
         current_speed_ = speed;
         estimate_calculator_.plan(
             TimeEstimateCalculator::Position(INT2MM(current_position_.x_), INT2MM(current_position_.y_), INT2MM(current_position_.z_), eToMm(current_e_value_)),
@@ -1374,12 +1377,12 @@ void GCodeExport::writeZhop(Velocity speed /*= 0*/, const coord_t height, const
     is_z_hopped_ = height;
     const coord_t target_z = current_layer_z_ + is_z_hopped_;
     current_speed_ = speed;
-    *output_stream_ << "G1 F" << PrecisionedDouble{ 1, speed * 60 } << " Z" << MMtoStream{ target_z };
+    *output_ << "G1 F" << PrecisionedDouble{ 1, speed * 60 } << " Z" << MMtoStream{ target_z };
     if (retraction_amounts.has_retraction())
     {
         writeRawRetract(retraction_amounts);
     }
-    *output_stream_ << new_line_;
+    *output_ << new_line_;
 
     sendTravel(Point3LL(current_position_.x_, current_position_.y_, target_z), speed, extruder_attr, retraction_amounts);
 
@@ -1436,11 +1439,11 @@ void GCodeExport::startExtruder(const size_t new_extruder)
     {
         if (flavor_ == EGCodeFlavor::MAKERBOT)
         {
-            *output_stream_ << "M135 T" << new_extruder << new_line_;
+            *output_ << "M135 T" << new_extruder << new_line_;
         }
         else
         {
-            *output_stream_ << "T" << new_extruder << new_line_;
+            *output_ << "T" << new_extruder << new_line_;
         }
         // Only add time is we are actually changing extruders
         estimate_calculator_.addTime(extruder_change_duration);
@@ -1522,7 +1525,7 @@ void GCodeExport::switchExtruder(size_t new_extruder, const RetractionConfig& re
 
 void GCodeExport::writeCode(const char* str)
 {
-    *output_stream_ << str << new_line_;
+    *output_ << str << new_line_;
 }
 
 void GCodeExport::resetExtruderToPrimed(const size_t extruder, const double initial_retraction)
@@ -1566,7 +1569,7 @@ void GCodeExport::writePrimeTrain(const Velocity& travel_speed)
             command += " S1"; // use S1 to disable prime blob
             should_correct_z = true;
         }
-        *output_stream_ << command << new_line_;
+        *output_ << command << new_line_;
 
         // There was an issue with the S1 strategy parameter, where it would only change the material-position,
         //   as opposed to 'be a prime-blob maneuvre without actually printing the prime blob', as we assumed here.
@@ -1576,7 +1579,7 @@ void GCodeExport::writePrimeTrain(const Velocity& travel_speed)
         {
             // Can't output via 'writeTravel', since if this is needed, the value saved for 'current height' will not be correct.
             // For similar reasons, this isn't written to the front-end via command-socket.
-            *output_stream_ << "G0 Z" << MMtoStream{ getPositionZ() } << new_line_;
+            *output_ << "G0 Z" << MMtoStream{ getPositionZ() } << new_line_;
         }
     }
     else
@@ -1616,11 +1619,11 @@ void GCodeExport::writeSpecificFanCommand(double speed, size_t fan_number)
         {
             if (new_on)
             {
-                *output_stream_ << "M126 T0" << new_line_;
+                *output_ << "M126 T0" << new_line_;
             }
             else
             {
-                *output_stream_ << "M127 T0" << new_line_;
+                *output_ << "M127 T0" << new_line_;
             }
         }
     }
@@ -1648,19 +1651,19 @@ void GCodeExport::writeSpecificFanCommand(double speed, size_t fan_number)
             if (num_new_val.wouldWriteZero())
             {
                 // Turn off when the fan value is zero.
-                *output_stream_ << "M107";
+                *output_ << "M107";
             }
             else
             {
-                *output_stream_ << "M106 S" << new_value_str;
+                *output_ << "M106 S" << new_value_str;
             }
 
             if (fan_number)
             {
-                *output_stream_ << " P" << fan_number;
+                *output_ << " P" << fan_number;
             }
 
-            *output_stream_ << new_line_;
+            *output_ << new_line_;
         }
     }
 
@@ -1712,33 +1715,33 @@ void GCodeExport::writeTemperatureCommand(const size_t extruder, const Temperatu
     {
         if (flavor_ == EGCodeFlavor::MARLIN)
         {
-            *output_stream_ << "M105" << new_line_; // get temperatures from the last update, the M109 will not let get the target temperature
+            *output_ << "M105" << new_line_; // get temperatures from the last update, the M109 will not let get the target temperature
         }
-        *output_stream_ << "M109";
+        *output_ << "M109";
         extruder_attr_[extruder].waited_for_temperature_ = true;
     }
     else
     {
-        *output_stream_ << "M104";
+        *output_ << "M104";
         extruder_attr_[extruder].waited_for_temperature_ = false;
     }
     if (extruder != current_extruder_)
     {
-        *output_stream_ << " T" << extruder;
+        *output_ << " T" << extruder;
     }
 #ifdef ASSERT_INSANE_OUTPUT
     assert(temperature >= 0);
 #endif // ASSERT_INSANE_OUTPUT
-    *output_stream_ << " S" << PrecisionedDouble{ 1, temperature } << new_line_;
+    *output_ << " S" << PrecisionedDouble{ 1, temperature } << new_line_;
     if (extruder != current_extruder_ && always_write_active_tool_)
     {
         // Some firmwares (ie Smoothieware) change tools every time a "T" command is read - even on a M104 line, so we need to switch back to the active tool.
-        *output_stream_ << "T" << current_extruder_ << new_line_;
+        *output_ << "T" << current_extruder_ << new_line_;
     }
     if (wait && flavor_ == EGCodeFlavor::MAKERBOT)
     {
         // Makerbot doesn't use M109 for heat-and-wait. Instead, use M104 and then wait using M116.
-        *output_stream_ << "M116" << new_line_;
+        *output_ << "M116" << new_line_;
     }
     extruder_attr_[extruder].current_temperature_ = temperature;
 }
@@ -1756,18 +1759,18 @@ void GCodeExport::writeBedTemperatureCommand(const Temperature& temperature, con
         {
             if (flavor_ == EGCodeFlavor::MARLIN)
             {
-                *output_stream_ << "M140 S"; // set the temperature, it will be used as target temperature from M105
-                *output_stream_ << PrecisionedDouble{ 1, temperature } << new_line_;
-                *output_stream_ << "M105" << new_line_;
+                *output_ << "M140 S"; // set the temperature, it will be used as target temperature from M105
+                *output_ << PrecisionedDouble{ 1, temperature } << new_line_;
+                *output_ << "M105" << new_line_;
             }
-            *output_stream_ << "M190 S";
+            *output_ << "M190 S";
         }
         else
         {
-            *output_stream_ << "M140 S";
+            *output_ << "M140 S";
         }
 
-        *output_stream_ << PrecisionedDouble{ 1, temperature } << new_line_;
+        *output_ << PrecisionedDouble{ 1, temperature } << new_line_;
 
         bed_temperature_ = temperature;
     }
@@ -1782,13 +1785,13 @@ void GCodeExport::writeBuildVolumeTemperatureCommand(const Temperature& temperat
     }
     if (wait)
     {
-        *output_stream_ << "M191 S";
+        *output_ << "M191 S";
     }
     else
     {
-        *output_stream_ << "M141 S";
+        *output_ << "M141 S";
     }
-    *output_stream_ << PrecisionedDouble{ 1, temperature } << new_line_;
+    *output_ << PrecisionedDouble{ 1, temperature } << new_line_;
 }
 
 void GCodeExport::writePrintAcceleration(const Acceleration& acceleration)
@@ -1798,20 +1801,20 @@ void GCodeExport::writePrintAcceleration(const Acceleration& acceleration)
     case EGCodeFlavor::REPETIER:
         if (current_print_acceleration_ != acceleration)
         {
-            *output_stream_ << "M201 X" << PrecisionedDouble{ 0, acceleration } << " Y" << PrecisionedDouble{ 0, acceleration } << new_line_;
+            *output_ << "M201 X" << PrecisionedDouble{ 0, acceleration } << " Y" << PrecisionedDouble{ 0, acceleration } << new_line_;
         }
         break;
     case EGCodeFlavor::REPRAP:
         if (current_print_acceleration_ != acceleration)
         {
-            *output_stream_ << "M204 P" << PrecisionedDouble{ 0, acceleration } << new_line_;
+            *output_ << "M204 P" << PrecisionedDouble{ 0, acceleration } << new_line_;
         }
         break;
     default:
         // MARLIN, etc. only have one acceleration for both print and travel
         if (current_print_acceleration_ != acceleration)
         {
-            *output_stream_ << "M204 S" << PrecisionedDouble{ 0, acceleration } << new_line_;
+            *output_ << "M204 S" << PrecisionedDouble{ 0, acceleration } << new_line_;
         }
         break;
     }
@@ -1826,13 +1829,13 @@ void GCodeExport::writeTravelAcceleration(const Acceleration& acceleration)
     case EGCodeFlavor::REPETIER:
         if (current_travel_acceleration_ != acceleration)
         {
-            *output_stream_ << "M202 X" << PrecisionedDouble{ 0, acceleration } << " Y" << PrecisionedDouble{ 0, acceleration } << new_line_;
+            *output_ << "M202 X" << PrecisionedDouble{ 0, acceleration } << " Y" << PrecisionedDouble{ 0, acceleration } << new_line_;
         }
         break;
     case EGCodeFlavor::REPRAP:
         if (current_travel_acceleration_ != acceleration)
         {
-            *output_stream_ << "M204 T" << PrecisionedDouble{ 0, acceleration } << new_line_;
+            *output_ << "M204 T" << PrecisionedDouble{ 0, acceleration } << new_line_;
         }
         break;
     default:
@@ -1851,16 +1854,16 @@ void GCodeExport::writeJerk(const Velocity& jerk)
         switch (getFlavor())
         {
         case EGCodeFlavor::REPETIER:
-            *output_stream_ << "M207 X" << PrecisionedDouble{ 2, jerk } << new_line_;
+            *output_ << "M207 X" << PrecisionedDouble{ 2, jerk } << new_line_;
             break;
         case EGCodeFlavor::REPRAP:
-            *output_stream_ << "M566 X" << PrecisionedDouble{ 2, jerk * 60 } << " Y" << PrecisionedDouble{ 2, jerk * 60 } << new_line_;
+            *output_ << "M566 X" << PrecisionedDouble{ 2, jerk * 60 } << " Y" << PrecisionedDouble{ 2, jerk * 60 } << new_line_;
             break;
         case EGCodeFlavor::CHEETAH:
-            *output_stream_ << "M215 X" << PrecisionedDouble{ 2, jerk * 1000 } << " Y" << PrecisionedDouble{ 2, jerk * 1000 } << new_line_;
+            *output_ << "M215 X" << PrecisionedDouble{ 2, jerk * 1000 } << " Y" << PrecisionedDouble{ 2, jerk * 1000 } << new_line_;
             break;
         default:
-            *output_stream_ << "M205 X" << PrecisionedDouble{ 2, jerk } << " Y" << PrecisionedDouble{ 2, jerk } << new_line_;
+            *output_ << "M205 X" << PrecisionedDouble{ 2, jerk } << " Y" << PrecisionedDouble{ 2, jerk } << new_line_;
             break;
         }
         current_jerk_ = jerk;
@@ -1893,7 +1896,7 @@ void GCodeExport::finalize(const char* endCode)
 
 void GCodeExport::flushOutputStream()
 {
-    output_stream_->flush();
+    output_->flush();
 }
 
 double GCodeExport::getExtrudedVolumeAfterLastWipe(size_t extruder)
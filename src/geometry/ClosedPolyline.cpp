@@ -6,6 +6,7 @@
 #include <range/v3/algorithm/all_of.hpp>
 
 #include "geometry/OpenPolyline.h"
+#include "geometry/PointsKernels.h"
 
 namespace cura
 {
@@ -26,7 +27,7 @@ bool ClosedPolyline::isValid() const
 
 bool ClosedPolyline::inside(const Point2LL& p, bool border_result) const
 {
-    int res = ClipperLib::PointInPolygon(p, getPoints());
+    int res = kernels::pointInPolygon(p, getPoints());
     if (res == -1)
     {
         return border_result;
@@ -36,11 +37,13 @@ bool ClosedPolyline::inside(const Point2LL& p, bool border_result) const
 
 bool ClosedPolyline::inside(const ClipperLib::Path& polygon) const
 {
+    // All points are tested against the same polygon, so it pays off to have its coordinates in separate arrays.
+    const kernels::PointsSoAView polygon_view(polygon);
     return ranges::all_of(
         *this,
-        [&polygon](const auto& point)
+        [&polygon_view](const auto& point)
         {
-            return ClipperLib::PointInPolygon(point, polygon);
+            return polygon_view.pointInPolygon(point) != 0;
         });
 }
 
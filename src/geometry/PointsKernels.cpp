@@ -0,0 +1,600 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "geometry/PointsKernels.h"
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "utils/linearAlg2D.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CURA_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace cura::kernels
+{
+
+int crossEdge(const Point2LL& point, const coord_t x0, const coord_t y0, const coord_t x1, const coord_t y1)
+{
+    if (y1 == point.Y)
+    {
+        if (x1 == point.X || (y0 == point.Y && ((x1 > point.X) == (x0 < point.X))))
+        {
+            return -1;
+        }
+    }
+    if ((y0 < point.Y) == (y1 < point.Y))
+    {
+        return 0;
+    }
+    if (x0 >= point.X && x1 > point.X)
+    {
+        return 1;
+    }
+    if (x0 >= point.X || x1 > point.X)
+    {
+        const double d = static_cast<double>(x0 - point.X) * static_cast<double>(y1 - point.Y) - static_cast<double>(x1 - point.X) * static_cast<double>(y0 - point.Y);
+        if (d == 0)
+        {
+            return -1;
+        }
+        return (d > 0) == (y1 > y0) ? 1 : 0;
+    }
+    return 0;
+}
+
+namespace
+{
+
+/*!
+ * Accumulate one edge into the result of a point-in-polygon test.
+ * \return Whether the result is final, because the point lies on the edge.
+ */
+bool accumulateEdge(const Point2LL& point, const coord_t x0, const coord_t y0, const coord_t x1, const coord_t y1, int& result)
+{
+    const int crossing = crossEdge(point, x0, y0, x1, y1);
+    if (crossing < 0)
+    {
+        result = -1;
+        return true;
+    }
+    result ^= crossing;
+    return false;
+}
+
+uint64_t crossProduct(const Point2LL& a, const Point2LL& b)
+{
+    // Computed in unsigned integers, so that an overflow wraps around instead of being undefined. As long as the final sum fits, the
+    // intermediate overflows cancel out.
+    return static_cast<uint64_t>(a.X) * static_cast<uint64_t>(b.Y) - static_cast<uint64_t>(b.X) * static_cast<uint64_t>(a.Y);
+}
+
+double areaScalar(std::span<const Point2LL> points)
+{
+    if (points.size() < 3)
+    {
+        return 0.0;
+    }
+    uint64_t twice_area = 0;
+    const Point2LL* previous = &points.back();
+    for (const Point2LL& point : points)
+    {
+        twice_area += crossProduct(*previous, point);
+        previous = &point;
+    }
+    return static_cast<double>(static_cast<int64_t>(twice_area)) * 0.5;
+}
+
+coord_t lengthScalar(std::span<const Point2LL> points, const bool closed)
+{
+    coord_t total = 0;
+    for (size_t point_idx = 1; point_idx < points.size(); ++point_idx)
+    {
+        total += vSize(points[point_idx] - points[point_idx - 1]);
+    }
+    if (closed && ! points.empty())
+    {
+        total += vSize(points.front() - points.back());
+    }
+    return total;
+}
+
+void boundsScalar(std::span<const Point2LL> points, Point2LL& min, Point2LL& max)
+{
+    for (const Point2LL& point : points)
+    {
+        min.X = std::min(min.X, point.X);
+        min.Y = std::min(min.Y, point.Y);
+        max.X = std::max(max.X, point.X);
+        max.Y = std::max(max.Y, point.Y);
+    }
+}
+
+int pointInPolygonScalar(const Point2LL& point, std::span<const Point2LL> polygon)
+{
+    if (polygon.size() < 3)
+    {
+        return 0;
+    }
+    int result = 0;
+    const Point2LL* previous = &polygon.back();
+    for (const Point2LL& current : polygon)
+    {
+        if (accumulateEdge(point, previous->X, previous->Y, current.X, current.Y, result))
+        {
+            return result;
+        }
+        previous = &current;
+    }
+    return result;
+}
+
+int pointInPolygonScalar(const Point2LL& point, std::span<const coord_t> xs, std::span<const coord_t> ys)
+{
+    if (xs.size() < 3)
+    {
+        return 0;
+    }
+    int result = 0;
+    size_t previous = xs.size() - 1;
+    for (size_t current = 0; current < xs.size(); ++current)
+    {
+        if (accumulateEdge(point, xs[previous], ys[previous], xs[current], ys[current], result))
+        {
+            return result;
+        }
+        previous = current;
+    }
+    return result;
+}
+
+/*!
+ * Track the closest point found so far, the same way \p PolygonUtils::findClosest does.
+ */
+struct ClosestTracker
+{
+    Point2LL location;
+    coord_t score;
+    size_t segment_idx;
+
+    ClosestTracker(const Point2LL& from, const Point2LL& first)
+        : location(first)
+        , score(vSize2(from - first))
+        , segment_idx(0)
+    {
+    }
+
+    /*!
+     * \return Whether the segment is closer than anything found before.
+     */
+    bool update(const Point2LL& from, const Point2LL& p0, const Point2LL& p1, const size_t p0_idx)
+    {
+        const Point2LL closest_here = LinearAlg2D::getClosestOnLineSegment(from, p0, p1);
+        const coord_t score_here = vSize2(from - closest_here);
+        if (score_here < score)
+        {
+            location = closest_here;
+            score = score_here;
+            segment_idx = p0_idx;
+            return true;
+        }
+        return false;
+    }
+};
+
+std::pair<Point2LL, size_t> closestOnPolygonScalar(const Point2LL& from, std::span<const Point2LL> polygon)
+{
+    ClosestTracker closest(from, polygon.front());
+    for (size_t point_idx = 0; point_idx < polygon.size(); ++point_idx)
+    {
+        closest.update(from, polygon[point_idx], polygon[(point_idx + 1) % polygon.size()], point_idx);
+    }
+    return { closest.location, closest.segment_idx };
+}
+
+#ifdef CURA_KERNELS_AVX2
+
+static_assert(sizeof(Point2LL) == 2 * sizeof(coord_t), "The AVX2 kernels load the coordinates of points directly.");
+
+/*
+ * The AVX2 kernels multiply coordinates with 32-bit multiplications and convert them to doubles with the bit trick below. Both are
+ * only exact up to some magnitude of the coordinates. The kernels check the coordinates while processing them, and redo the whole
+ * computation with the scalar kernel when one is too large.
+ */
+constexpr int arithmetic_coordinate_bits = 29; //!< Coordinates must be in [-2^29, 2^29), so that squared lengths stay below 2^61.
+constexpr int closest_coordinate_bits = 19; //!< The integer projection in getClosestOnLineSegment must not overflow.
+
+/*!
+ * Nonzero in the lanes where a coordinate is outside of [-2^bits, 2^bits).
+ */
+template<int Bits>
+__attribute__((target("avx2"))) inline __m256i outOfRange(const __m256i coordinates)
+{
+    return _mm256_srli_epi64(_mm256_add_epi64(coordinates, _mm256_set1_epi64x(coord_t(1) << Bits)), Bits + 1);
+}
+
+__attribute__((target("avx2"))) inline bool anyNonzero(const __m256i values)
+{
+    return ! _mm256_testz_si256(values, values);
+}
+
+/*!
+ * Load the coordinates of 4 consecutive points into separate registers, in order.
+ */
+__attribute__((target("avx2"))) inline void loadPoints(const Point2LL* points, __m256i& xs, __m256i& ys)
+{
+    const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points)); // x0 y0 x1 y1
+    const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + 2)); // x2 y2 x3 y3
+    xs = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+    ys = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+/*!
+ * Convert integers in [-2^51, 2^51) to doubles, exactly.
+ */
+__attribute__((target("avx2"))) inline __m256d toDouble(const __m256i values)
+{
+    constexpr double magic = 6755399441055744.0; // 2^52 + 2^51
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(values, _mm256_castpd_si256(_mm256_set1_pd(magic)))), _mm256_set1_pd(magic));
+}
+
+__attribute__((target("avx2"))) inline uint64_t horizontalSum(const __m256i values)
+{
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), values);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2"))) double areaAVX2(std::span<const Point2LL> points)
+{
+    if (points.size() < 3)
+    {
+        return 0.0;
+    }
+    const size_t count = points.size();
+    uint64_t twice_area = crossProduct(points.back(), points.front());
+    __m256i sum = _mm256_setzero_si256();
+    __m256i out_of_range = _mm256_setzero_si256();
+    size_t point_idx = 1;
+    for (; point_idx + 4 <= count; point_idx += 4)
+    {
+        __m256i previous_x, previous_y, current_x, current_y;
+        loadPoints(&points[point_idx - 1], previous_x, previous_y);
+        loadPoints(&points[point_idx], current_x, current_y);
+        out_of_range = _mm256_or_si256(out_of_range, _mm256_or_si256(outOfRange<arithmetic_coordinate_bits>(current_x), outOfRange<arithmetic_coordinate_bits>(current_y)));
+        const __m256i cross = _mm256_sub_epi64(_mm256_mul_epi32(previous_x, current_y), _mm256_mul_epi32(current_x, previous_y));
+        sum = _mm256_add_epi64(sum, cross);
+    }
+    if (anyNonzero(out_of_range) || anyNonzero(outOfRange<arithmetic_coordinate_bits>(_mm256_set_epi64x(points[0].X, points[0].Y, points[0].X, points[0].Y))))
+    {
+        return areaScalar(points);
+    }
+    twice_area += horizontalSum(sum);
+    for (; point_idx < count; ++point_idx)
+    {
+        twice_area += crossProduct(points[point_idx - 1], points[point_idx]);
+    }
+    return static_cast<double>(static_cast<int64_t>(twice_area)) * 0.5;
+}
+
+__attribute__((target("avx2"))) coord_t lengthAVX2(std::span<const Point2LL> points, const bool closed)
+{
+    const size_t count = points.size();
+    __m256i sum = _mm256_setzero_si256();
+    __m256i out_of_range = _mm256_setzero_si256();
+    const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i magic_bits = _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)); // 2^52
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+    size_t point_idx = 0;
+    for (; point_idx + 5 <= count; point_idx += 4)
+    {
+        __m256i start_x, start_y, end_x, end_y;
+        loadPoints(&points[point_idx], start_x, start_y);
+        loadPoints(&points[point_idx + 1], end_x, end_y);
+        out_of_range = _mm256_or_si256(out_of_range, _mm256_or_si256(outOfRange<arithmetic_coordinate_bits>(start_x), outOfRange<arithmetic_coordinate_bits>(start_y)));
+        const __m256i dx = _mm256_sub_epi64(end_x, start_x);
+        const __m256i dy = _mm256_sub_epi64(end_y, start_y);
+        const __m256i size2 = _mm256_add_epi64(_mm256_mul_epi32(dx, dx), _mm256_mul_epi32(dy, dy)); // Below 2^61.
+
+        // Convert the high and low 32 bits separately. Adding them rounds once, just like converting the 64-bit integer.
+        const __m256d high = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(size2, 32), magic_bits)), magic);
+        const __m256d low = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(size2, low_mask), magic_bits)), magic);
+        const __m256d size2_double = _mm256_add_pd(_mm256_mul_pd(high, _mm256_set1_pd(4294967296.0)), low);
+
+        // Rounds to nearest, like std::llrint. The lengths are below 2^31.
+        const __m128i size = _mm256_cvtpd_epi32(_mm256_sqrt_pd(size2_double));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(size));
+    }
+    if (point_idx > 0)
+    {
+        // The last point of the vectorized part was only used as an end point.
+        const Point2LL& last = points[point_idx];
+        out_of_range = _mm256_or_si256(out_of_range, outOfRange<arithmetic_coordinate_bits>(_mm256_set_epi64x(last.X, last.Y, last.X, last.Y)));
+    }
+    if (anyNonzero(out_of_range))
+    {
+        return lengthScalar(points, closed);
+    }
+    coord_t total = static_cast<coord_t>(horizontalSum(sum));
+    for (point_idx++; point_idx < count; ++point_idx)
+    {
+        total += vSize(points[point_idx] - points[point_idx - 1]);
+    }
+    if (closed && count > 0)
+    {
+        total += vSize(points.front() - points.back());
+    }
+    return total;
+}
+
+__attribute__((target("avx2"))) void boundsAVX2(std::span<const Point2LL> points, Point2LL& min, Point2LL& max)
+{
+    // Two points per register, so the lanes hold X, Y, X, Y.
+    __m256i lanes_min = _mm256_set_epi64x(min.Y, min.X, min.Y, min.X);
+    __m256i lanes_max = _mm256_set_epi64x(max.Y, max.X, max.Y, max.X);
+    size_t point_idx = 0;
+    for (; point_idx + 2 <= points.size(); point_idx += 2)
+    {
+        const __m256i coordinates = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&points[point_idx]));
+        lanes_min = _mm256_blendv_epi8(lanes_min, coordinates, _mm256_cmpgt_epi64(lanes_min, coordinates));
+        lanes_max = _mm256_blendv_epi8(lanes_max, coordinates, _mm256_cmpgt_epi64(coordinates, lanes_max));
+    }
+    alignas(32) coord_t mins[4];
+    alignas(32) coord_t maxs[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), lanes_min);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), lanes_max);
+    min = Point2LL(std::min(mins[0], mins[2]), std::min(mins[1], mins[3]));
+    max = Point2LL(std::max(maxs[0], maxs[2]), std::max(maxs[1], maxs[3]));
+    boundsScalar(points.subspan(point_idx), min, max);
+}
+
+/*!
+ * Mask of the edges ending at Y coordinates \p end_y of which the point lies on the horizontal line through the end point, or the edge
+ * crosses that line. Only those edges need to be evaluated by \ref crossEdge.
+ */
+__attribute__((target("avx2"))) inline int candidateEdges(const __m256i point_y, const __m256i start_y, const __m256i end_y)
+{
+    const __m256i start_below = _mm256_cmpgt_epi64(point_y, start_y);
+    const __m256i end_below = _mm256_cmpgt_epi64(point_y, end_y);
+    const __m256i candidates = _mm256_or_si256(_mm256_xor_si256(start_below, end_below), _mm256_cmpeq_epi64(point_y, end_y));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(candidates));
+}
+
+__attribute__((target("avx2"))) int pointInPolygonAVX2(const Point2LL& point, std::span<const Point2LL> polygon)
+{
+    if (polygon.size() < 3)
+    {
+        return 0;
+    }
+    const size_t count = polygon.size();
+    int result = 0;
+    if (accumulateEdge(point, polygon.back().X, polygon.back().Y, polygon.front().X, polygon.front().Y, result))
+    {
+        return result;
+    }
+    const __m256i point_y = _mm256_set1_epi64x(point.Y);
+    size_t point_idx = 0;
+    for (; point_idx + 5 <= count; point_idx += 4)
+    {
+        __m256i start_x, start_y, end_x, end_y;
+        loadPoints(&polygon[point_idx], start_x, start_y);
+        loadPoints(&polygon[point_idx + 1], end_x, end_y);
+        for (int candidates = candidateEdges(point_y, start_y, end_y); candidates != 0; candidates &= candidates - 1)
+        {
+            const size_t edge_idx = point_idx + static_cast<size_t>(std::countr_zero(static_cast<unsigned int>(candidates)));
+            if (accumulateEdge(point, polygon[edge_idx].X, polygon[edge_idx].Y, polygon[edge_idx + 1].X, polygon[edge_idx + 1].Y, result))
+            {
+                return result;
+            }
+        }
+    }
+    for (; point_idx + 1 < count; ++point_idx)
+    {
+        if (accumulateEdge(point, polygon[point_idx].X, polygon[point_idx].Y, polygon[point_idx + 1].X, polygon[point_idx + 1].Y, result))
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx2"))) int pointInPolygonAVX2(const Point2LL& point, std::span<const coord_t> xs, std::span<const coord_t> ys)
+{
+    if (xs.size() < 3)
+    {
+        return 0;
+    }
+    const size_t count = xs.size();
+    int result = 0;
+    if (accumulateEdge(point, xs.back(), ys.back(), xs.front(), ys.front(), result))
+    {
+        return result;
+    }
+    const __m256i point_y = _mm256_set1_epi64x(point.Y);
+    size_t point_idx = 0;
+    for (; point_idx + 5 <= count; point_idx += 4)
+    {
+        // Only the Y coordinates are needed to find the candidate edges.
+        const __m256i start_y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ys[point_idx]));
+        const __m256i end_y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ys[point_idx + 1]));
+        for (int candidates = candidateEdges(point_y, start_y, end_y); candidates != 0; candidates &= candidates - 1)
+        {
+            const size_t edge_idx = point_idx + static_cast<size_t>(std::countr_zero(static_cast<unsigned int>(candidates)));
+            if (accumulateEdge(point, xs[edge_idx], ys[edge_idx], xs[edge_idx + 1], ys[edge_idx + 1], result))
+            {
+                return result;
+            }
+        }
+    }
+    for (; point_idx + 1 < count; ++point_idx)
+    {
+        if (accumulateEdge(point, xs[point_idx], ys[point_idx], xs[point_idx + 1], ys[point_idx + 1], result))
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+__attribute__((target("avx2"))) std::pair<Point2LL, size_t> closestOnPolygonAVX2(const Point2LL& from, std::span<const Point2LL> polygon)
+{
+    const size_t count = polygon.size();
+    ClosestTracker closest(from, polygon.front());
+
+    // The distance to each segment is first computed in doubles, from which a lower bound is derived for the distance to the point that
+    // getClosestOnLineSegment rounds to. That point is within sqrt(2) of the segment. Only segments of which the lower bound isn't worse
+    // than the best segment so far are evaluated exactly, in order, so the result is the same as evaluating all of them.
+    constexpr double rounding_margin = 2.0;
+    const __m256i from_x_int = _mm256_set1_epi64x(from.X);
+    const __m256i from_y_int = _mm256_set1_epi64x(from.Y);
+    __m256i out_of_range = _mm256_or_si256(outOfRange<closest_coordinate_bits>(from_x_int), outOfRange<closest_coordinate_bits>(from_y_int));
+    const __m256d from_x = toDouble(from_x_int);
+    const __m256d from_y = toDouble(from_y_int);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d margin = _mm256_set1_pd(rounding_margin);
+    __m256d best_score = _mm256_set1_pd(static_cast<double>(closest.score));
+
+    size_t point_idx = 0;
+    for (; point_idx + 5 <= count; point_idx += 4)
+    {
+        __m256i start_x_int, start_y_int, end_x_int, end_y_int;
+        loadPoints(&polygon[point_idx], start_x_int, start_y_int);
+        loadPoints(&polygon[point_idx + 1], end_x_int, end_y_int);
+        out_of_range = _mm256_or_si256(out_of_range, _mm256_or_si256(outOfRange<closest_coordinate_bits>(start_x_int), outOfRange<closest_coordinate_bits>(start_y_int)));
+        const __m256d start_x = toDouble(start_x_int);
+        const __m256d start_y = toDouble(start_y_int);
+        const __m256d dx = _mm256_sub_pd(toDouble(end_x_int), start_x);
+        const __m256d dy = _mm256_sub_pd(toDouble(end_y_int), start_y);
+        const __m256d to_x = _mm256_sub_pd(from_x, start_x);
+        const __m256d to_y = _mm256_sub_pd(from_y, start_y);
+        const __m256d projected = _mm256_add_pd(_mm256_mul_pd(to_x, dx), _mm256_mul_pd(to_y, dy));
+        const __m256d size2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        // For segments of length 0, the division gives NaN, which min_pd replaces by 1. Both ends are the same point then anyway.
+        const __m256d t = _mm256_max_pd(_mm256_min_pd(_mm256_div_pd(projected, size2), one), zero);
+        const __m256d offset_x = _mm256_sub_pd(to_x, _mm256_mul_pd(t, dx));
+        const __m256d offset_y = _mm256_sub_pd(to_y, _mm256_mul_pd(t, dy));
+        const __m256d distance = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(offset_x, offset_x), _mm256_mul_pd(offset_y, offset_y)));
+        const __m256d lower_bound_distance = _mm256_max_pd(_mm256_sub_pd(distance, margin), zero);
+        const __m256d lower_bound = _mm256_mul_pd(lower_bound_distance, lower_bound_distance);
+
+        for (int candidates = _mm256_movemask_pd(_mm256_cmp_pd(lower_bound, best_score, _CMP_NGT_UQ)); candidates != 0; candidates &= candidates - 1)
+        {
+            const size_t segment_idx = point_idx + static_cast<size_t>(std::countr_zero(static_cast<unsigned int>(candidates)));
+            if (closest.update(from, polygon[segment_idx], polygon[segment_idx + 1], segment_idx))
+            {
+                best_score = _mm256_set1_pd(static_cast<double>(closest.score));
+            }
+        }
+    }
+    if (anyNonzero(out_of_range) || (point_idx > 0 && anyNonzero(outOfRange<closest_coordinate_bits>(_mm256_set_epi64x(polygon[point_idx].X, polygon[point_idx].Y, 0, 0)))))
+    {
+        return closestOnPolygonScalar(from, polygon);
+    }
+    for (; point_idx < count; ++point_idx)
+    {
+        closest.update(from, polygon[point_idx], polygon[(point_idx + 1) % count], point_idx);
+    }
+    return { closest.location, closest.segment_idx };
+}
+
+#endif // CURA_KERNELS_AVX2
+
+} // namespace
+
+bool isSupported(const InstructionSet instruction_set)
+{
+    switch (instruction_set)
+    {
+    case InstructionSet::SCALAR:
+        return true;
+    case InstructionSet::AVX2:
+#ifdef CURA_KERNELS_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+InstructionSet activeInstructionSet()
+{
+    static const InstructionSet active = isSupported(InstructionSet::AVX2) ? InstructionSet::AVX2 : InstructionSet::SCALAR;
+    return active;
+}
+
+double area(std::span<const Point2LL> points, const InstructionSet instruction_set)
+{
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        return areaAVX2(points);
+    }
+#endif
+    return areaScalar(points);
+}
+
+coord_t length(std::span<const Point2LL> points, const bool closed, const InstructionSet instruction_set)
+{
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        return lengthAVX2(points, closed);
+    }
+#endif
+    return lengthScalar(points, closed);
+}
+
+void bounds(std::span<const Point2LL> points, Point2LL& min, Point2LL& max, const InstructionSet instruction_set)
+{
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        boundsAVX2(points, min, max);
+        return;
+    }
+#endif
+    boundsScalar(points, min, max);
+}
+
+int pointInPolygon(const Point2LL& point, std::span<const Point2LL> polygon, const InstructionSet instruction_set)
+{
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        return pointInPolygonAVX2(point, polygon);
+    }
+#endif
+    return pointInPolygonScalar(point, polygon);
+}
+
+int pointInPolygon(const Point2LL& point, std::span<const coord_t> xs, std::span<const coord_t> ys, const InstructionSet instruction_set)
+{
+    assert(xs.size() == ys.size());
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        return pointInPolygonAVX2(point, xs, ys);
+    }
+#endif
+    return pointInPolygonScalar(point, xs, ys);
+}
+
+std::pair<Point2LL, size_t> closestOnPolygon(const Point2LL& from, std::span<const Point2LL> polygon, const InstructionSet instruction_set)
+{
+    assert(! polygon.empty());
+#ifdef CURA_KERNELS_AVX2
+    if (instruction_set == InstructionSet::AVX2)
+    {
+        return closestOnPolygonAVX2(from, polygon);
+    }
+#endif
+    return closestOnPolygonScalar(from, polygon);
+}
+
+} // namespace cura::kernels
@@ -5,11 +5,11 @@
 
 #include <algorithm>
 #include <numbers>
-#include <numeric>
 
 #include "geometry/LinesSet.h"
 #include "geometry/OpenLinesSet.h"
 #include "geometry/OpenPolyline.h"
+#include "geometry/PointsKernels.h"
 #include "settings/types/Angle.h"
 #include "utils/linearAlg2D.h"
 
@@ -124,14 +124,7 @@ Polyline::segments_iterator Polyline::endSegments()
 
 coord_t Polyline::length() const
 {
-    return std::accumulate(
-        beginSegments(),
-        endSegments(),
-        0,
-        [](coord_t total, const const_segments_iterator::value_type& segment)
-        {
-            return total + vSize(segment.end - segment.start);
-        });
+    return kernels::length(getPoints(), hasClosingSegment());
 }
 
 bool Polyline::shorterThan(const coord_t check_length) const
@@ -28,6 +28,7 @@
 #include "geometry/MixedLinesSet.h"
 #include "geometry/OpenPolyline.h"
 #include "geometry/PartsView.h"
+#include "geometry/PointsKernels.h"
 #include "geometry/Polygon.h"
 #include "geometry/SingleShape.h"
 #include "settings/types/Ratio.h"
@@ -243,12 +244,50 @@ Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double mit
     return Shape{ std::move(ret) };
 }
 
+std::vector<Shape> Shape::offsetNested(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type, double miter_limit) const
+{
+    std::vector<Shape> result(distances.size());
+    if (empty())
+    {
+        return result;
+    }
+
+    // The offsetter recomputes everything from the paths it was given for every execution, so it can be reused for all distances.
+    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
+    bool clipper_prepared = false;
+    for (size_t distance_idx = 0; distance_idx < distances.size(); ++distance_idx)
+    {
+        const coord_t distance = distances[distance_idx];
+        const auto same_distance = std::find(distances.begin(), distances.begin() + static_cast<std::ptrdiff_t>(distance_idx), distance);
+        if (same_distance != distances.begin() + static_cast<std::ptrdiff_t>(distance_idx))
+        {
+            result[distance_idx] = result[static_cast<size_t>(same_distance - distances.begin())];
+            continue;
+        }
+        if (distance == 0)
+        {
+            result[distance_idx] = *this;
+            continue;
+        }
+        if (! clipper_prepared)
+        {
+            unionPolygons().addPaths(clipper, join_type, ClipperLib::etClosedPolygon);
+            clipper.MiterLimit = miter_limit;
+            clipper_prepared = true;
+        }
+        ClipperLib::Paths ret;
+        clipper.Execute(ret, static_cast<double>(distance));
+        result[distance_idx] = Shape{ std::move(ret) };
+    }
+    return result;
+}
+
 bool Shape::inside(const Point2LL& p, bool border_result) const
 {
     int poly_count_inside = 0;
     for (const Polygon& poly : *this)
     {
-        const int is_inside_this_poly = ClipperLib::PointInPolygon(p, poly.getPoints());
+        const int is_inside_this_poly = kernels::pointInPolygon(p, poly.getPoints());
         if (is_inside_this_poly == -1)
         {
             return border_result;
@@ -0,0 +1,229 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "geometry/ShapeEdgeIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "geometry/PointMatrix.h"
+#include "geometry/PointsKernels.h"
+#include "geometry/Shape.h"
+#include "utils/linearAlg2D.h"
+
+namespace cura
+{
+
+namespace
+{
+
+/*!
+ * How far an edge may lie from a segment for the rounding in \ref LinearAlg2D::lineSegmentsCollide to still report a collision.
+ *
+ * The collision test works on coordinates rotated and rounded to integers, which moves each point by less than a unit.
+ */
+constexpr coord_t collision_margin = 10;
+
+/*!
+ * The (average) number of edges per band. Fewer bands means longer lists of edges per band, more bands means that long edges are
+ * registered in more bands.
+ */
+constexpr size_t edges_per_band = 2;
+
+constexpr size_t max_band_count = 1 << 16;
+
+} // namespace
+
+ShapeEdgeIndex::ShapeEdgeIndex(const Shape& shape)
+    : min_(std::numeric_limits<coord_t>::max(), std::numeric_limits<coord_t>::max())
+    , max_(std::numeric_limits<coord_t>::min(), std::numeric_limits<coord_t>::min())
+{
+    for (const Polygon& polygon : shape)
+    {
+        const bool bounds_area = polygon.size() >= 3;
+        for (size_t point_idx = 0; point_idx < polygon.size(); ++point_idx)
+        {
+            const Point2LL& start = polygon[point_idx];
+            const Point2LL& end = polygon[(point_idx + 1) % polygon.size()];
+            const Point2LL min(std::min(start.X, end.X), std::min(start.Y, end.Y));
+            const Point2LL max(std::max(start.X, end.X), std::max(start.Y, end.Y));
+            edges_.push_back(Edge{ .start = start, .end = end, .min = min, .max = max, .bounds_area = bounds_area });
+            min_ = Point2LL(std::min(min_.X, min.X), std::min(min_.Y, min.Y));
+            max_ = Point2LL(std::max(max_.X, max.X), std::max(max_.Y, max.Y));
+        }
+    }
+    if (edges_.empty())
+    {
+        return;
+    }
+
+    const size_t target_band_count = std::clamp(edges_.size() / edges_per_band, size_t(1), max_band_count);
+    band_height_ = std::max(coord_t(1), (max_.Y - min_.Y) / static_cast<coord_t>(target_band_count) + 1);
+    const size_t band_count = static_cast<size_t>((max_.Y - min_.Y) / band_height_) + 1;
+
+    // Count the edges per band first, so that all bands can share a single array.
+    band_starts_.assign(band_count + 1, 0);
+    for (const Edge& edge : edges_)
+    {
+        for (size_t band = bandAt(edge.min.Y); band <= bandAt(edge.max.Y); ++band)
+        {
+            band_starts_[band + 1]++;
+        }
+    }
+    for (size_t band = 0; band < band_count; ++band)
+    {
+        band_starts_[band + 1] += band_starts_[band];
+    }
+    band_edges_.resize(band_starts_.back());
+    std::vector<size_t> band_fill(band_starts_.begin(), band_starts_.end() - 1);
+    for (size_t edge_idx = 0; edge_idx < edges_.size(); ++edge_idx)
+    {
+        const Edge& edge = edges_[edge_idx];
+        for (size_t band = bandAt(edge.min.Y); band <= bandAt(edge.max.Y); ++band)
+        {
+            band_edges_[band_fill[band]++] = edge_idx;
+        }
+    }
+    for (size_t band = 0; band < band_count; ++band)
+    {
+        std::sort(
+            band_edges_.begin() + static_cast<std::ptrdiff_t>(band_starts_[band]),
+            band_edges_.begin() + static_cast<std::ptrdiff_t>(band_starts_[band + 1]),
+            [this](const size_t a, const size_t b)
+            {
+                return edges_[a].min.X < edges_[b].min.X;
+            });
+    }
+}
+
+bool ShapeEdgeIndex::empty() const
+{
+    return edges_.empty();
+}
+
+bool ShapeEdgeIndex::inside(const Point2LL& p, const bool border_result) const
+{
+    if (edges_.empty() || p.Y < min_.Y || p.Y > max_.Y)
+    {
+        return false;
+    }
+
+    // Only the edges spanning the height of the point can cross the ray from it, and those are all in its band. The parity of all
+    // polygons together is the parity of all their crossings together.
+    const size_t band = bandAt(p.Y);
+    int result = 0;
+    for (size_t band_edge_idx = band_starts_[band]; band_edge_idx < band_starts_[band + 1]; ++band_edge_idx)
+    {
+        const Edge& edge = edges_[band_edges_[band_edge_idx]];
+        if (! edge.bounds_area || edge.max.X < p.X)
+        {
+            continue;
+        }
+        const int crossing = kernels::crossEdge(p, edge.start.X, edge.start.Y, edge.end.X, edge.end.Y);
+        if (crossing < 0)
+        {
+            return border_result;
+        }
+        result ^= crossing;
+    }
+    return result == 1;
+}
+
+bool ShapeEdgeIndex::collidesWithLineSegment(const Point2LL& start, const Point2LL& end) const
+{
+    if (edges_.empty())
+    {
+        return false;
+    }
+
+    const Point2LL diff = end - start;
+    const PointMatrix transformation_matrix(diff);
+    const Point2LL transformed_start = transformation_matrix.apply(start);
+    const Point2LL transformed_end = transformation_matrix.apply(end);
+    const auto collides = [&](const Edge& edge)
+    {
+        return LinearAlg2D::lineSegmentsCollide(transformed_start, transformed_end, transformation_matrix.apply(edge.start), transformation_matrix.apply(edge.end));
+    };
+
+    if (diff == Point2LL(0, 0))
+    {
+        // The transformation is undefined, so there's no telling which edges would collide. Check them all, like the linear version does.
+        return std::any_of(edges_.begin(), edges_.end(), collides);
+    }
+    return visitEdgesNear(start, end, collision_margin, collides);
+}
+
+std::vector<float> ShapeEdgeIndex::intersectionsWithSegment(const Point2LL& start, const Point2LL& end) const
+{
+    std::vector<float> result;
+    if (edges_.empty())
+    {
+        return result;
+    }
+
+    // The intersection parameters are computed in single precision, which can put them slightly inside the segments for edges that
+    // end just beyond them. Search far enough around the segment to include those edges too.
+    const Point2LL diff = end - start;
+    const coord_t margin = collision_margin + (std::abs(diff.X) + std::abs(diff.Y)) / 64;
+    visitEdgesNear(
+        start,
+        end,
+        margin,
+        [&start, &end, &result](const Edge& edge)
+        {
+            float t;
+            float u;
+            if (LinearAlg2D::segmentSegmentIntersection(start, end, edge.start, edge.end, t, u))
+            {
+                result.push_back(t);
+            }
+            return false;
+        });
+    return result;
+}
+
+size_t ShapeEdgeIndex::bandAt(const coord_t y) const
+{
+    const coord_t band = std::clamp((y - min_.Y) / band_height_, coord_t(0), static_cast<coord_t>(band_starts_.size()) - 2);
+    return static_cast<size_t>(band);
+}
+
+template<typename Visitor>
+bool ShapeEdgeIndex::visitEdgesNear(const Point2LL& start, const Point2LL& end, const coord_t margin, Visitor&& visitor) const
+{
+    const Point2LL query_min(std::min(start.X, end.X) - margin, std::min(start.Y, end.Y) - margin);
+    const Point2LL query_max(std::max(start.X, end.X) + margin, std::max(start.Y, end.Y) + margin);
+    if (query_max.X < min_.X || query_min.X > max_.X || query_max.Y < min_.Y || query_min.Y > max_.Y)
+    {
+        return false;
+    }
+
+    const size_t first_band = bandAt(query_min.Y);
+    const size_t last_band = bandAt(query_max.Y);
+    for (size_t band = first_band; band <= last_band; ++band)
+    {
+        for (size_t band_edge_idx = band_starts_[band]; band_edge_idx < band_starts_[band + 1]; ++band_edge_idx)
+        {
+            const Edge& edge = edges_[band_edges_[band_edge_idx]];
+            if (edge.min.X > query_max.X)
+            {
+                break; // The edges of a band are sorted by their smallest X, so none of the rest overlaps either.
+            }
+            if (edge.max.X < query_min.X || edge.max.Y < query_min.Y || edge.min.Y > query_max.Y)
+            {
+                continue;
+            }
+            if (std::max(first_band, bandAt(edge.min.Y)) != band)
+            {
+                continue; // Edges spanning multiple bands are only visited in the first band that both the edge and the query overlap.
+            }
+            if (visitor(edge))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace cura
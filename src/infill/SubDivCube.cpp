@@ -3,13 +3,16 @@
 
 #include "infill/SubDivCube.h"
 
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <cassert>
 
 #include "geometry/OpenPolyline.h"
 #include "geometry/Polygon.h"
 #include "geometry/Shape.h"
 #include "settings/types/Angle.h" //For the infill angle.
 #include "sliceDataStorage.h"
+#include "utils/ThreadPool.h"
 #include "utils/math.h"
 #include "utils/polygonUtils.h"
 
@@ -21,15 +24,29 @@
 namespace cura
 {
 
-std::vector<SubDivCube::CubeProperties> SubDivCube::cube_properties_per_recursion_step_;
-coord_t SubDivCube::radius_addition_ = 0;
-Point3Matrix SubDivCube::rotation_matrix_;
-PointMatrix SubDivCube::infill_rotation_matrix_;
-
-void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill_origin)
+namespace
 {
-    radius_addition_ = mesh.settings.get<coord_t>("sub_div_rad_add");
 
+/*!
+ * The centers of the eight children of a cube, relative to its center, before rotating the cube onto its tip.
+ */
+const std::array<Point3LL, 8> rel_child_centers{
+    Point3LL(1, 1, 1), // top
+    Point3LL(-1, 1, 1), // top three
+    Point3LL(1, -1, 1),
+    Point3LL(1, 1, -1),
+    Point3LL(-1, -1, -1), // bottom
+    Point3LL(1, -1, -1), // bottom three
+    Point3LL(-1, 1, -1),
+    Point3LL(-1, -1, 1),
+};
+
+} // namespace
+
+SubDivCube::SubDivCube(const SliceMeshStorage& mesh, const Point2LL& infill_origin)
+    : radius_addition_(mesh.settings.get<coord_t>("sub_div_rad_add"))
+    , layer_height_(mesh.settings.get<coord_t>("layer_height"))
+{
     // if infill_angles is not empty use the first value, otherwise use 0
     const std::vector<AngleDegrees> infill_angles = mesh.settings.get<std::vector<AngleDegrees>>("infill_angles");
     const AngleDegrees infill_angle = (! infill_angles.empty()) ? infill_angles[0] : AngleDegrees(0);
@@ -38,7 +55,6 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill
         square(mesh.settings.get<coord_t>("machine_height")) + square(mesh.settings.get<coord_t>("machine_depth") / 2) + square(mesh.settings.get<coord_t>("machine_width") / 2));
     const coord_t max_side_length = furthest_dist_from_origin * 2;
 
-    size_t curr_recursion_depth = 0;
     const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
     if (infill_line_distance > 0)
     {
@@ -51,10 +67,12 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill
             cube_properties_here.square_height = sqrt(2) * curr_side_length;
             cube_properties_here.max_draw_z_diff = ONE_OVER_SQRT_3 * curr_side_length;
             cube_properties_here.max_line_offset = ONE_OVER_SQRT_6 * curr_side_length;
-            curr_recursion_depth++;
         }
     }
-    Point3LL center(infill_origin.X, infill_origin.Y, 0);
+    if (cube_properties_per_recursion_step_.empty()) // Infill is set to 0%.
+    {
+        return;
+    }
 
     Point3Matrix tilt; // rotation matrix to get from axis aligned cubes to cubes standing on their tip
     // The Z axis is transformed to go in positive Y direction
@@ -83,18 +101,103 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill
 
     rotation_matrix_ = infill_angle_mat.compose(tilt);
 
-    mesh.base_subdiv_cube = std::make_shared<SubDivCube>(mesh, center, curr_recursion_depth - 1);
+    // Gather the infill areas of each layer once, rather than for every test of every cube.
+    std::vector<Shape> layer_infill_areas(mesh.layers.size());
+    cura::parallel_for<size_t>(
+        0,
+        mesh.layers.size(),
+        [&](const size_t layer_nr)
+        {
+            for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
+            {
+                layer_infill_areas[layer_nr].push_back(part.infill_area);
+            }
+        });
+
+    // The subtrees of the children of the top-level cube are independent, so they are built in parallel and concatenated in order after.
+    const Point3LL center(infill_origin.X, infill_origin.Y, 0);
+    const size_t root_depth = cube_properties_per_recursion_step_.size() - 1;
+    cubes_.push_back(Cube{ center, root_depth });
+    if (root_depth > 0)
+    {
+        std::array<std::vector<Cube>, 8> octants;
+        const coord_t radius = childRadius(root_depth);
+        cura::parallel_for<size_t>(
+            0,
+            octants.size(),
+            [&](const size_t child_idx)
+            {
+                const Point3LL child_center = childCenter(center, root_depth, child_idx);
+                if (isValidSubdivision(layer_infill_areas, child_center, radius))
+                {
+                    addSubtree(layer_infill_areas, child_center, root_depth - 1, octants[child_idx]);
+                }
+            });
+        for (const std::vector<Cube>& octant : octants)
+        {
+            cubes_.insert(cubes_.end(), octant.begin(), octant.end());
+        }
+    }
+
+    cubes_by_z_.resize(cube_properties_per_recursion_step_.size());
+    for (size_t cube_idx = 0; cube_idx < cubes_.size(); cube_idx++)
+    {
+        cubes_by_z_[cubes_[cube_idx].depth].push_back(cube_idx);
+    }
+    for (std::vector<size_t>& depth_cubes : cubes_by_z_)
+    {
+        std::stable_sort(
+            depth_cubes.begin(),
+            depth_cubes.end(),
+            [this](const size_t a, const size_t b)
+            {
+                return cubes_[a].center.z_ < cubes_[b].center.z_;
+            });
+    }
 }
 
-void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet& result)
+void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill_origin)
 {
-    if (cube_properties_per_recursion_step_.empty()) // Infill is set to 0%.
+    mesh.base_subdiv_cube = std::make_shared<SubDivCube>(mesh, infill_origin);
+}
+
+void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet& result) const
+{
+    if (cubes_.empty()) // Infill is set to 0%.
     {
         return;
     }
-    OpenLinesSet directional_line_groups[3];
 
-    generateSubdivisionLines(z, directional_line_groups);
+    // Only cubes of which the center is less than max_draw_z_diff away from the layer have lines on it. Visiting them in depth-first
+    // order, like a walk through the octree would, combines the lines in the same way.
+    std::vector<size_t> drawn_cubes;
+    for (size_t depth = 0; depth < cubes_by_z_.size(); depth++)
+    {
+        const std::vector<size_t>& depth_cubes = cubes_by_z_[depth];
+        const coord_t max_draw_z_diff = cube_properties_per_recursion_step_[depth].max_draw_z_diff;
+        const auto first = std::partition_point(
+            depth_cubes.begin(),
+            depth_cubes.end(),
+            [this, z, max_draw_z_diff](const size_t cube_idx)
+            {
+                return cubes_[cube_idx].center.z_ <= z - max_draw_z_diff;
+            });
+        const auto last = std::partition_point(
+            first,
+            depth_cubes.end(),
+            [this, z, max_draw_z_diff](const size_t cube_idx)
+            {
+                return cubes_[cube_idx].center.z_ < z + max_draw_z_diff;
+            });
+        drawn_cubes.insert(drawn_cubes.end(), first, last);
+    }
+    std::sort(drawn_cubes.begin(), drawn_cubes.end());
+
+    OpenLinesSet directional_line_groups[3];
+    for (const size_t cube_idx : drawn_cubes)
+    {
+        generateSubdivisionLines(cubes_[cube_idx], z, directional_line_groups);
+    }
 
     for (int dir_idx = 0; dir_idx < 3; dir_idx++)
     {
@@ -106,87 +209,68 @@ void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet& result)
     }
 }
 
-void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet (&directional_line_groups)[3])
+void SubDivCube::generateSubdivisionLines(const Cube& cube, const coord_t z, OpenLinesSet (&directional_line_groups)[3]) const
 {
-    CubeProperties cube_properties = cube_properties_per_recursion_step_[depth_];
+    const CubeProperties& cube_properties = cube_properties_per_recursion_step_[cube.depth];
+    const Point3LL& center = cube.center;
 
-    const coord_t z_diff = std::abs(z - center_.z_); //!< the difference between the cube center and the target layer.
-    if (z_diff > cube_properties.height / 2) //!< this cube does not touch the target layer. Early exit.
-    {
-        return;
-    }
-    if (z_diff < cube_properties.max_draw_z_diff) //!< this cube has lines that need to be drawn.
-    {
-        Point2LL relative_a, relative_b; //!< relative coordinates of line endpoints around cube center
-        Point2LL a, b; //!< absolute coordinates of line endpoints
-        relative_a.X = (cube_properties.square_height / 2) * (cube_properties.max_draw_z_diff - z_diff) / cube_properties.max_draw_z_diff;
-        relative_b.X = -relative_a.X;
-        relative_a.Y = cube_properties.max_line_offset - ((z - (center_.z_ - cube_properties.max_draw_z_diff)) * ONE_OVER_SQRT_2);
-        relative_b.Y = relative_a.Y;
-        rotatePointInitial(relative_a);
-        rotatePointInitial(relative_b);
-        for (int dir_idx = 0; dir_idx < 3; dir_idx++) //!< draw the line, then rotate 120 degrees.
-        {
-            a.X = center_.x_ + relative_a.X;
-            a.Y = center_.y_ + relative_a.Y;
-            b.X = center_.x_ + relative_b.X;
-            b.Y = center_.y_ + relative_b.Y;
-            addLineAndCombine(directional_line_groups[dir_idx], a, b);
-            if (dir_idx < 2)
-            {
-                rotatePoint120(relative_a);
-                rotatePoint120(relative_b);
-            }
-        }
-    }
-    for (int idx = 0; idx < 8; idx++) //!< draws the eight children
+    const coord_t z_diff = std::abs(z - center.z_); //!< the difference between the cube center and the target layer.
+    assert(z_diff < cube_properties.max_draw_z_diff && "Only cubes which have lines on this layer should be drawn.");
+
+    Point2LL relative_a, relative_b; //!< relative coordinates of line endpoints around cube center
+    Point2LL a, b; //!< absolute coordinates of line endpoints
+    relative_a.X = (cube_properties.square_height / 2) * (cube_properties.max_draw_z_diff - z_diff) / cube_properties.max_draw_z_diff;
+    relative_b.X = -relative_a.X;
+    relative_a.Y = cube_properties.max_line_offset - ((z - (center.z_ - cube_properties.max_draw_z_diff)) * ONE_OVER_SQRT_2);
+    relative_b.Y = relative_a.Y;
+    rotatePointInitial(relative_a);
+    rotatePointInitial(relative_b);
+    for (int dir_idx = 0; dir_idx < 3; dir_idx++) //!< draw the line, then rotate 120 degrees.
     {
-        if (children_[idx] != nullptr)
+        a.X = center.x_ + relative_a.X;
+        a.Y = center.y_ + relative_a.Y;
+        b.X = center.x_ + relative_b.X;
+        b.Y = center.y_ + relative_b.Y;
+        addLineAndCombine(directional_line_groups[dir_idx], a, b);
+        if (dir_idx < 2)
         {
-            children_[idx]->generateSubdivisionLines(z, directional_line_groups);
+            rotatePoint120(relative_a);
+            rotatePoint120(relative_b);
         }
     }
 }
 
-SubDivCube::SubDivCube(SliceMeshStorage& mesh, Point3LL& center, size_t depth)
-    : depth_(depth)
-    , center_(center)
+void SubDivCube::addSubtree(const std::vector<Shape>& layer_infill_areas, const Point3LL& center, const size_t depth, std::vector<Cube>& cubes) const
 {
-    if (depth_ == 0) // lowest layer, no need for subdivision, exit.
-    {
-        return;
-    }
-    if (depth_ >= cube_properties_per_recursion_step_.size()) // Depth is out of bounds of what we pre-computed.
+    cubes.push_back(Cube{ center, depth });
+    if (depth == 0) // lowest layer, no need for subdivision, exit.
     {
         return;
     }
 
-    CubeProperties cube_properties = cube_properties_per_recursion_step_[depth];
-    Point3LL child_center;
-    coord_t radius = double(cube_properties.height) / 4.0 + radius_addition_;
-
-    int child_nr = 0;
-    std::vector<Point3LL> rel_child_centers;
-    rel_child_centers.emplace_back(1, 1, 1); // top
-    rel_child_centers.emplace_back(-1, 1, 1); // top three
-    rel_child_centers.emplace_back(1, -1, 1);
-    rel_child_centers.emplace_back(1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, -1); // bottom
-    rel_child_centers.emplace_back(1, -1, -1); // bottom three
-    rel_child_centers.emplace_back(-1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, 1);
-    for (Point3LL rel_child_center : rel_child_centers)
+    const coord_t radius = childRadius(depth);
+    for (size_t child_idx = 0; child_idx < rel_child_centers.size(); child_idx++)
     {
-        child_center = center + rotation_matrix_.apply(rel_child_center * int32_t(cube_properties.side_length / 4));
-        if (isValidSubdivision(mesh, child_center, radius))
+        const Point3LL child_center = childCenter(center, depth, child_idx);
+        if (isValidSubdivision(layer_infill_areas, child_center, radius))
         {
-            children_[child_nr] = std::make_shared<SubDivCube>(mesh, child_center, depth - 1);
-            child_nr++;
+            addSubtree(layer_infill_areas, child_center, depth - 1, cubes);
         }
     }
 }
 
-bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, coord_t radius)
+Point3LL SubDivCube::childCenter(const Point3LL& center, const size_t depth, const size_t child_idx) const
+{
+    const CubeProperties& cube_properties = cube_properties_per_recursion_step_[depth];
+    return center + rotation_matrix_.apply(rel_child_centers[child_idx] * int32_t(cube_properties.side_length / 4));
+}
+
+coord_t SubDivCube::childRadius(const size_t depth) const
+{
+    return double(cube_properties_per_recursion_step_[depth].height) / 4.0 + radius_addition_;
+}
+
+bool SubDivCube::isValidSubdivision(const std::vector<Shape>& layer_infill_areas, const Point3LL& center, const coord_t radius) const
 {
     coord_t distance2 = 0;
     coord_t sphere_slice_radius2; //!< squared radius of bounding sphere slice on target layer
@@ -194,16 +278,15 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, co
     bool outside_somewhere = false;
     int inside;
     Ratio part_dist; // what percentage of the radius the target layer is away from the center along the z axis. 0 - 1
-    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height");
-    int bottom_layer = (center.z_ - radius) / layer_height;
-    int top_layer = (center.z_ + radius) / layer_height;
+    int bottom_layer = (center.z_ - radius) / layer_height_;
+    int top_layer = (center.z_ + radius) / layer_height_;
     for (int test_layer = bottom_layer; test_layer <= top_layer; test_layer += 3) // steps of three. Low-hanging speed gain.
     {
-        part_dist = Ratio{ static_cast<Ratio::value_type>(test_layer * layer_height - center.z_) } / radius;
+        part_dist = Ratio{ static_cast<Ratio::value_type>(test_layer * layer_height_ - center.z_) } / radius;
         sphere_slice_radius2 = radius * radius * (1.0 - (part_dist * part_dist));
         Point2LL loc(center.x_, center.y_);
 
-        inside = distanceFromPointToMesh(mesh, test_layer, loc, &distance2);
+        inside = distanceFromPointToMesh(layer_infill_areas, test_layer, loc, &distance2);
         if (inside == 1)
         {
             inside_somewhere = true;
@@ -224,18 +307,13 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, co
     return false;
 }
 
-coord_t SubDivCube::distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point2LL& location, coord_t* distance2)
+coord_t SubDivCube::distanceFromPointToMesh(const std::vector<Shape>& layer_infill_areas, const LayerIndex layer_nr, const Point2LL& location, coord_t* distance2)
 {
-    if (layer_nr < 0 || (unsigned int)layer_nr >= mesh.layers.size()) //!< this layer is outside of valid range
+    if (layer_nr < 0 || (unsigned int)layer_nr >= layer_infill_areas.size()) //!< this layer is outside of valid range
     {
         return 2;
-        *distance2 = 0;
-    }
-    Shape collide;
-    for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
-    {
-        collide.push_back(part.infill_area);
     }
+    const Shape& collide = layer_infill_areas[layer_nr];
 
     Point2LL centerpoint = location;
     bool inside = collide.inside(centerpoint);
@@ -249,8 +327,7 @@ coord_t SubDivCube::distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerI
     return 0;
 }
 
-
-void SubDivCube::rotatePointInitial(Point2LL& target)
+void SubDivCube::rotatePointInitial(Point2LL& target) const
 {
     target = infill_rotation_matrix_.apply(target);
 }
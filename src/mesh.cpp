@@ -3,8 +3,11 @@
 
 #include "mesh.h"
 
+#include <algorithm>
+#include <iterator>
 #include <numbers>
 
+#include <boost/container_hash/hash.hpp>
 #include <spdlog/spdlog.h>
 
 #include "utils/Point3D.h"
@@ -129,6 +132,57 @@ bool Mesh::canInterlock() const
     return ! settings_.get<bool>("infill_mesh") && ! settings_.get<bool>("anti_overhang_mesh");
 }
 
+size_t Mesh::getShapeHash() const
+{
+    const Point3LL origin(min().x_, min().y_, 0);
+    size_t hash = 0;
+    boost::hash_combine(hash, vertices_.size());
+    boost::hash_combine(hash, faces_.size());
+    for (const MeshVertex& vertex : vertices_)
+    {
+        const Point3LL relative = vertex.p_ - origin;
+        boost::hash_combine(hash, relative.x_);
+        boost::hash_combine(hash, relative.y_);
+        boost::hash_combine(hash, relative.z_);
+    }
+    for (const MeshFace& face : faces_)
+    {
+        boost::hash_range(hash, std::begin(face.vertex_index_), std::end(face.vertex_index_));
+    }
+    return hash;
+}
+
+std::optional<Point2LL> Mesh::getTranslationFrom(const Mesh& original) const
+{
+    if (vertices_.empty() || vertices_.size() != original.vertices_.size() || faces_.size() != original.faces_.size())
+    {
+        return std::nullopt;
+    }
+    const Point3LL offset = vertices_[0].p_ - original.vertices_[0].p_;
+    if (offset.z_ != 0)
+    {
+        return std::nullopt;
+    }
+    for (size_t vertex_idx = 0; vertex_idx < vertices_.size(); vertex_idx++)
+    {
+        if (vertices_[vertex_idx].p_ - original.vertices_[vertex_idx].p_ != offset)
+        {
+            return std::nullopt;
+        }
+    }
+    for (size_t face_idx = 0; face_idx < faces_.size(); face_idx++)
+    {
+        const MeshFace& face = faces_[face_idx];
+        const MeshFace& original_face = original.faces_[face_idx];
+        if (! std::equal(std::begin(face.vertex_index_), std::end(face.vertex_index_), std::begin(original_face.vertex_index_))
+            || ! std::equal(std::begin(face.uv_coordinates_), std::end(face.uv_coordinates_), std::begin(original_face.uv_coordinates_)))
+        {
+            return std::nullopt;
+        }
+    }
+    return Point2LL(offset.x_, offset.y_);
+}
+
 int Mesh::findIndexOfVertex(const Point3LL& v)
 {
     uint32_t hash = pointHash(v);
@@ -19,6 +19,7 @@ namespace cura
 std::array<double, N_PROGRESS_STAGES> Progress::accumulated_times = { -1 };
 double Progress::total_timing = -1;
 std::optional<LayerIndex> Progress::first_skipped_layer{};
+std::optional<TraceSpan> Progress::stage_span{};
 
 double Progress::calcOverallProgress(Stage stage, double stage_progress)
 {
@@ -45,6 +46,13 @@ void Progress::messageProgress(Progress::Stage stage, int progress_in_stage, int
 
 void Progress::messageProgressStage(Progress::Stage stage, TimeKeeper* time_keeper)
 {
+    stage_span.reset();
+    Tracer::getInstance().addMemoryCounter();
+    if (static_cast<int>(stage) < static_cast<int>(Stage::FINISH))
+    {
+        stage_span.emplace("stage", names.at(static_cast<size_t>(stage)));
+    }
+
     if (time_keeper != nullptr)
     {
         if (static_cast<int>(stage) > 0)
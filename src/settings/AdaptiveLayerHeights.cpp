@@ -7,11 +7,13 @@
 #include <cmath>
 #include <limits>
 #include <numbers>
+#include <numeric>
 
 #include "Application.h"
 #include "Slice.h"
 #include "settings/EnumSettings.h"
 #include "settings/types/Angle.h"
+#include "utils/ThreadPool.h"
 #include "utils/Point3D.h"
 
 namespace cura
@@ -65,6 +67,12 @@ void AdaptiveLayerHeights::calculateLayers()
     Settings const& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     auto slicing_tolerance = mesh_group_settings.get<SlicingTolerance>("slicing_tolerance");
     std::vector<size_t> triangles_of_interest;
+
+    // The triangles that may intersect a layer of the maximum thickness: the triangles that start below the top of that layer,
+    // and that end above its bottom. Both bounds only go up, so triangles are added in the order of their minimum z and
+    // never come back once they have been removed.
+    std::vector<size_t> active_triangles;
+    size_t next_triangle = 0;
     const coord_t model_max_z = meshgroup_->max().z_;
     coord_t z_level = 0;
     coord_t previous_layer_height = 0;
@@ -93,33 +101,29 @@ void AdaptiveLayerHeights::calculateLayers()
 
             if (layer_height == allowed_layer_heights_[0])
             {
-                // this is the max layer thickness, search through all of the triangles in the mesh to find those
-                // that intersect with a layer this thick
-                triangles_of_interest.clear();
-
-                for (size_t i = 0; i < face_min_z_values_.size(); ++i)
+                // this is the max layer thickness, update the triangles that intersect with a layer this thick
+                for (; next_triangle < face_min_z_values_.size() && face_min_z_values_[next_triangle] <= upper_bound; ++next_triangle)
                 {
-                    if (face_min_z_values_[i] <= upper_bound && face_max_z_values_[i] >= lower_bound)
-                    {
-                        triangles_of_interest.push_back(i);
-                    }
+                    active_triangles.push_back(next_triangle);
                 }
+                std::erase_if(
+                    active_triangles,
+                    [this, lower_bound](const size_t i)
+                    {
+                        return face_max_z_values_[i] < lower_bound;
+                    });
+                triangles_of_interest = active_triangles;
             }
             else
             {
                 // this is a reduced thickness layer, just search those triangles that intersected with the layer
                 // in the previous iteration
-                const std::vector<size_t> last_triangles_of_interest = triangles_of_interest;
-
-                triangles_of_interest.clear();
-
-                for (const auto& i : last_triangles_of_interest)
-                {
-                    if (face_min_z_values_[i] <= upper_bound)
+                std::erase_if(
+                    triangles_of_interest,
+                    [this, upper_bound](const size_t i)
                     {
-                        triangles_of_interest.push_back(i);
-                    }
-                }
+                        return face_min_z_values_[i] > upper_bound;
+                    });
             }
 
             // when there not interesting triangles in this potential layer go to the next one
@@ -132,7 +136,7 @@ void AdaptiveLayerHeights::calculateLayers()
             double minimum_slope = std::numeric_limits<double>::max();
             for (const size_t& triangle_index : triangles_of_interest)
             {
-                const double slope = face_slopes_.at(triangle_index);
+                const double slope = face_slopes_[triangle_index];
                 if (minimum_slope > slope)
                 {
                     minimum_slope = slope;
@@ -187,7 +191,17 @@ void AdaptiveLayerHeights::calculateLayers()
 
 void AdaptiveLayerHeights::calculateMeshTriangleSlopes()
 {
-    // loop over all mesh faces (triangles) and find their slopes
+    // Split the faces of all printable meshes in blocks, so that large and small meshes are processed in a single parallel loop.
+    constexpr size_t faces_per_block = 4096;
+    struct FaceBlock
+    {
+        const Mesh* mesh;
+        size_t first_face;
+        size_t end_face;
+        size_t output_idx; //!< Where to store the values of the first face.
+    };
+    std::vector<FaceBlock> blocks;
+    size_t face_count = 0;
     for (const Mesh& mesh : Application::getInstance().current_slice_->scene.current_mesh_group->meshes)
     {
         // Skip meshes that are not printable
@@ -195,39 +209,66 @@ void AdaptiveLayerHeights::calculateMeshTriangleSlopes()
         {
             continue;
         }
+        for (size_t first_face = 0; first_face < mesh.faces_.size(); first_face += faces_per_block)
+        {
+            const size_t end_face = std::min(first_face + faces_per_block, mesh.faces_.size());
+            blocks.push_back(FaceBlock{ &mesh, first_face, end_face, face_count });
+            face_count += end_face - first_face;
+        }
+    }
 
-        for (const MeshFace& face : mesh.faces_)
+    std::vector<double> slopes(face_count);
+    std::vector<coord_t> min_z_values(face_count);
+    std::vector<coord_t> max_z_values(face_count);
+    cura::parallel_for(
+        blocks,
+        [&](const auto block_it)
         {
-            const MeshVertex& v0 = mesh.vertices_[face.vertex_index_[0]];
-            const MeshVertex& v1 = mesh.vertices_[face.vertex_index_[1]];
-            const MeshVertex& v2 = mesh.vertices_[face.vertex_index_[2]];
-
-            const Point3D p0(v0.p_);
-            const Point3D p1(v1.p_);
-            const Point3D p2(v2.p_);
-
-            double min_z = p0.z_;
-            min_z = std::min(min_z, p1.z_);
-            min_z = std::min(min_z, p2.z_);
-            double max_z = p0.z_;
-            max_z = std::max(max_z, p1.z_);
-            max_z = std::max(max_z, p2.z_);
-
-            // calculate the angle of this triangle in the z direction
-            const Point3D n = (p1 - p0).cross(p2 - p0);
-            const Point3D normal = n.normalized();
-            AngleRadians z_angle = std::acos(std::abs(normal.z_));
-
-            // prevent flat surfaces from influencing the algorithm
-            if (z_angle == 0)
+            const FaceBlock& block = *block_it;
+            const Mesh& mesh = *block.mesh;
+            for (size_t face_idx = block.first_face; face_idx < block.end_face; ++face_idx)
             {
-                z_angle = std::numbers::pi;
+                const MeshFace& face = mesh.faces_[face_idx];
+                const Point3LL& p0 = mesh.vertices_[face.vertex_index_[0]].p_;
+                const Point3LL& p1 = mesh.vertices_[face.vertex_index_[1]].p_;
+                const Point3LL& p2 = mesh.vertices_[face.vertex_index_[2]].p_;
+                const size_t output_idx = block.output_idx + face_idx - block.first_face;
+
+                min_z_values[output_idx] = std::min({ p0.z_, p1.z_, p2.z_ });
+                max_z_values[output_idx] = std::max({ p0.z_, p1.z_, p2.z_ });
+
+                // calculate the angle of this triangle in the z direction
+                const Point3D n = (Point3D(p1) - Point3D(p0)).cross(Point3D(p2) - Point3D(p0));
+                const Point3D normal = n.normalized();
+                AngleRadians z_angle = std::acos(std::abs(normal.z_));
+
+                // prevent flat surfaces from influencing the algorithm
+                if (z_angle == 0)
+                {
+                    z_angle = std::numbers::pi;
+                }
+                slopes[output_idx] = z_angle;
             }
+        });
 
-            face_min_z_values_.push_back(MM2INT(min_z));
-            face_max_z_values_.push_back(MM2INT(max_z));
-            face_slopes_.push_back(z_angle);
-        }
+    // Sort the faces by their minimum z, which is what calculateLayers() sweeps over.
+    std::vector<size_t> order(face_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin(),
+        order.end(),
+        [&min_z_values](const size_t a, const size_t b)
+        {
+            return min_z_values[a] < min_z_values[b];
+        });
+    face_slopes_.resize(face_count);
+    face_min_z_values_.resize(face_count);
+    face_max_z_values_.resize(face_count);
+    for (size_t sorted_idx = 0; sorted_idx < face_count; ++sorted_idx)
+    {
+        face_slopes_[sorted_idx] = slopes[order[sorted_idx]];
+        face_min_z_values_[sorted_idx] = min_z_values[order[sorted_idx]];
+        face_max_z_values_[sorted_idx] = max_z_values[order[sorted_idx]];
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include "settings/Settings.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <fstream>
@@ -839,6 +840,41 @@ bool Settings::has(const std::string& key) const
     return settings.find(key) != settings.end();
 }
 
+bool Settings::hasSameEntries(const Settings& other, const std::vector<std::string>& ignored_keys) const
+{
+    if (parent != other.parent)
+    {
+        return false;
+    }
+    const auto is_ignored = [&ignored_keys](const std::string& key)
+    {
+        return std::find(ignored_keys.begin(), ignored_keys.end(), key) != ignored_keys.end();
+    };
+    size_t compared_count = 0;
+    for (const auto& [key, value] : settings)
+    {
+        if (is_ignored(key))
+        {
+            continue;
+        }
+        const auto other_entry = other.settings.find(key);
+        if (other_entry == other.settings.end() || other_entry->second != value)
+        {
+            return false;
+        }
+        compared_count++;
+    }
+    // All entries of this instance are in the other one as well, so they are equal if the other one has no additional entries.
+    const auto other_count = std::count_if(
+        other.settings.begin(),
+        other.settings.end(),
+        [&is_ignored](const auto& entry)
+        {
+            return ! is_ignored(entry.first);
+        });
+    return compared_count == static_cast<size_t>(other_count);
+}
+
 void Settings::setParent(Settings* new_parent)
 {
     parent = new_parent;
@@ -3,6 +3,7 @@
 
 #include "sliceDataStorage.h"
 
+#include <algorithm>
 #include <numbers>
 
 #include <spdlog/spdlog.h>
@@ -18,7 +19,9 @@
 #include "infill/SierpinskiFillProvider.h"
 #include "infill/SubDivCube.h" // For the destructor
 #include "raft.h"
+#include "utils/CompressedGeometry.h"
 #include "utils/ExtrusionLine.h"
+#include "utils/ThreadPool.h"
 #include "utils/math.h" //For PI.
 
 namespace cura
@@ -53,8 +56,35 @@ const Shape& SliceLayerPart::getOwnInfillArea() const
     }
 }
 
+struct SliceLayerPart::Compressed
+{
+    struct CompressedSkinPart
+    {
+        CompressedShape outline;
+        CompressedShape skin_fill;
+        CompressedShape roofing_fill;
+        CompressedShape flooring_fill;
+    };
+
+    CompressedShape outline;
+    CompressedShape print_outline;
+    CompressedShape inner_area;
+    std::vector<CompressedSkinPart> skin_parts;
+    CompressedToolPaths wall_toolpaths;
+    CompressedToolPaths infill_wall_toolpaths;
+    CompressedShape top_most_surface;
+    CompressedShape bottom_most_surface;
+    CompressedShape infill_area;
+    std::optional<CompressedShape> infill_area_own;
+    std::vector<std::vector<CompressedShape>> infill_area_per_combine_per_density;
+};
+
 bool SliceLayerPart::hasWallAtInsetIndex(size_t inset_idx) const
 {
+    if (isCompressed())
+    {
+        return compressed_->wall_toolpaths.hasInsetIndex(inset_idx);
+    }
     for (const VariableWidthLines& lines : wall_toolpaths)
     {
         for (const ExtrusionLine& line : lines)
@@ -68,6 +98,201 @@ bool SliceLayerPart::hasWallAtInsetIndex(size_t inset_idx) const
     return false;
 }
 
+bool SliceLayerPart::hasOwnInfillArea() const
+{
+    if (isCompressed())
+    {
+        return ! (compressed_->infill_area_own ? *compressed_->infill_area_own : compressed_->infill_area).empty();
+    }
+    return ! getOwnInfillArea().empty();
+}
+
+bool SliceLayerPart::hasSkinFill(Shape SkinPart::*fill) const
+{
+    if (isCompressed())
+    {
+        CompressedShape Compressed::CompressedSkinPart::*compressed_fill = &Compressed::CompressedSkinPart::skin_fill;
+        if (fill == &SkinPart::roofing_fill)
+        {
+            compressed_fill = &Compressed::CompressedSkinPart::roofing_fill;
+        }
+        else if (fill == &SkinPart::flooring_fill)
+        {
+            compressed_fill = &Compressed::CompressedSkinPart::flooring_fill;
+        }
+        return std::ranges::any_of(
+            compressed_->skin_parts,
+            [compressed_fill](const Compressed::CompressedSkinPart& skin_part)
+            {
+                return ! (skin_part.*compressed_fill).empty();
+            });
+    }
+    return std::ranges::any_of(
+        skin_parts,
+        [fill](const SkinPart& skin_part)
+        {
+            return ! (skin_part.*fill).empty();
+        });
+}
+
+void SliceLayerPart::getOutlines(Shape& result, const bool external_polys_only) const
+{
+    if (isCompressed())
+    {
+        if (external_polys_only)
+        {
+            const SingleShape outline_part(compressed_->outline.decompress());
+            result.push_back(outline_part.outerPolygon());
+        }
+        else
+        {
+            const Shape decompressed_print_outline = compressed_->print_outline.decompress();
+            result.push_back(decompressed_print_outline);
+        }
+    }
+    else if (external_polys_only)
+    {
+        result.push_back(outline.outerPolygon());
+    }
+    else
+    {
+        result.push_back(print_outline);
+    }
+}
+
+void SliceLayerPart::compress()
+{
+    if (compressed_)
+    {
+        release(); // Keep the data as it was compressed the first time.
+        return;
+    }
+    auto compressed = std::make_shared<Compressed>();
+    compressed->outline = CompressedShape(outline);
+    compressed->print_outline = CompressedShape(print_outline);
+    compressed->inner_area = CompressedShape(inner_area);
+    compressed->skin_parts.reserve(skin_parts.size());
+    for (const SkinPart& skin_part : skin_parts)
+    {
+        compressed->skin_parts.push_back(Compressed::CompressedSkinPart{ .outline = CompressedShape(skin_part.outline),
+                                                                         .skin_fill = CompressedShape(skin_part.skin_fill),
+                                                                         .roofing_fill = CompressedShape(skin_part.roofing_fill),
+                                                                         .flooring_fill = CompressedShape(skin_part.flooring_fill) });
+    }
+    compressed->wall_toolpaths = CompressedToolPaths(wall_toolpaths);
+    compressed->infill_wall_toolpaths = CompressedToolPaths(infill_wall_toolpaths);
+    compressed->top_most_surface = CompressedShape(top_most_surface);
+    compressed->bottom_most_surface = CompressedShape(bottom_most_surface);
+    compressed->infill_area = CompressedShape(infill_area);
+    if (infill_area_own)
+    {
+        compressed->infill_area_own = CompressedShape(*infill_area_own);
+    }
+    compressed->infill_area_per_combine_per_density.reserve(infill_area_per_combine_per_density.size());
+    for (const std::vector<Shape>& infill_area_per_combine : infill_area_per_combine_per_density)
+    {
+        std::vector<CompressedShape>& compressed_per_combine = compressed->infill_area_per_combine_per_density.emplace_back();
+        compressed_per_combine.reserve(infill_area_per_combine.size());
+        for (const Shape& infill_area_combined : infill_area_per_combine)
+        {
+            compressed_per_combine.emplace_back(infill_area_combined);
+        }
+    }
+    compressed_ = std::move(compressed);
+    is_decompressed_ = true;
+    release();
+}
+
+void SliceLayerPart::release()
+{
+    if (! compressed_ || ! is_decompressed_)
+    {
+        return; // Without a compressed copy, the data can't be restored once released.
+    }
+    // Move-assign empty containers, rather than clearing them, to release their memory.
+    outline = SingleShape();
+    print_outline = Shape();
+    inner_area = Shape();
+    skin_parts = std::vector<SkinPart>();
+    wall_toolpaths = std::vector<VariableWidthLines>();
+    infill_wall_toolpaths = std::vector<VariableWidthLines>();
+    top_most_surface = Shape();
+    bottom_most_surface = Shape();
+    infill_area = Shape();
+    infill_area_own.reset();
+    infill_area_per_combine_per_density = std::vector<std::vector<Shape>>();
+    is_decompressed_ = false;
+}
+
+void SliceLayerPart::decompress()
+{
+    if (! isCompressed())
+    {
+        return;
+    }
+    outline = SingleShape(compressed_->outline.decompress());
+    print_outline = compressed_->print_outline.decompress();
+    inner_area = compressed_->inner_area.decompress();
+    skin_parts.reserve(compressed_->skin_parts.size());
+    for (const Compressed::CompressedSkinPart& compressed_skin_part : compressed_->skin_parts)
+    {
+        SkinPart& skin_part = skin_parts.emplace_back();
+        skin_part.outline = SingleShape(compressed_skin_part.outline.decompress());
+        skin_part.skin_fill = compressed_skin_part.skin_fill.decompress();
+        skin_part.roofing_fill = compressed_skin_part.roofing_fill.decompress();
+        skin_part.flooring_fill = compressed_skin_part.flooring_fill.decompress();
+    }
+    wall_toolpaths = compressed_->wall_toolpaths.decompress();
+    infill_wall_toolpaths = compressed_->infill_wall_toolpaths.decompress();
+    top_most_surface = compressed_->top_most_surface.decompress();
+    bottom_most_surface = compressed_->bottom_most_surface.decompress();
+    infill_area = compressed_->infill_area.decompress();
+    if (compressed_->infill_area_own)
+    {
+        infill_area_own = compressed_->infill_area_own->decompress();
+    }
+    infill_area_per_combine_per_density.reserve(compressed_->infill_area_per_combine_per_density.size());
+    for (const std::vector<CompressedShape>& compressed_per_combine : compressed_->infill_area_per_combine_per_density)
+    {
+        std::vector<Shape>& infill_area_per_combine = infill_area_per_combine_per_density.emplace_back();
+        infill_area_per_combine.reserve(compressed_per_combine.size());
+        for (const CompressedShape& infill_area_combined : compressed_per_combine)
+        {
+            infill_area_per_combine.push_back(infill_area_combined.decompress());
+        }
+    }
+    is_decompressed_ = true;
+}
+
+bool SliceLayerPart::isCompressed() const
+{
+    return compressed_ && ! is_decompressed_;
+}
+
+void SliceLayer::compress()
+{
+    for (SliceLayerPart& part : parts)
+    {
+        part.compress();
+    }
+}
+
+void SliceLayer::release()
+{
+    for (SliceLayerPart& part : parts)
+    {
+        part.release();
+    }
+}
+
+void SliceLayer::decompress()
+{
+    for (SliceLayerPart& part : parts)
+    {
+        part.decompress();
+    }
+}
+
 SliceLayer::~SliceLayer()
 {
 }
@@ -83,14 +308,7 @@ void SliceLayer::getOutlines(Shape& result, bool external_polys_only) const
 {
     for (const SliceLayerPart& part : parts)
     {
-        if (external_polys_only)
-        {
-            result.push_back(part.outline.outerPolygon());
-        }
-        else
-        {
-            result.push_back(part.print_outline);
-        }
+        part.getOutlines(result, external_polys_only);
     }
 }
 
@@ -107,6 +325,17 @@ SliceMeshStorage::SliceMeshStorage(Mesh* mesh, const size_t slice_layer_count)
 }
 
 
+void SliceMeshStorage::compressLayers()
+{
+    cura::parallel_for<size_t>(
+        0,
+        layers.size(),
+        [&](const size_t layer_nr)
+        {
+            layers[layer_nr].compress();
+        });
+}
+
 bool SliceMeshStorage::getExtruderIsUsed(const size_t extruder_nr) const
 {
     if (settings.get<bool>("anti_overhang_mesh") || settings.get<bool>("support_mesh"))
@@ -200,7 +429,7 @@ bool SliceMeshStorage::getExtruderIsUsed(const size_t extruder_nr, const LayerIn
     {
         for (const SliceLayerPart& part : layer.parts)
         {
-            if (part.getOwnInfillArea().size() > 0)
+            if (part.hasOwnInfillArea())
             {
                 return true;
             }
@@ -210,12 +439,9 @@ bool SliceMeshStorage::getExtruderIsUsed(const size_t extruder_nr, const LayerIn
     {
         for (const SliceLayerPart& part : layer.parts)
         {
-            for (const SkinPart& skin_part : part.skin_parts)
+            if (part.hasSkinFill(&SkinPart::skin_fill))
             {
-                if (! skin_part.skin_fill.empty())
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -223,12 +449,9 @@ bool SliceMeshStorage::getExtruderIsUsed(const size_t extruder_nr, const LayerIn
     {
         for (const SliceLayerPart& part : layer.parts)
         {
-            for (const SkinPart& skin_part : part.skin_parts)
+            if (part.hasSkinFill(&SkinPart::roofing_fill))
             {
-                if (! skin_part.roofing_fill.empty())
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -236,12 +459,9 @@ bool SliceMeshStorage::getExtruderIsUsed(const size_t extruder_nr, const LayerIn
     {
         for (const SliceLayerPart& part : layer.parts)
         {
-            for (const SkinPart& skin_part : part.skin_parts)
+            if (part.hasSkinFill(&SkinPart::flooring_fill))
             {
-                if (! skin_part.flooring_fill.empty())
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -293,7 +513,47 @@ SliceDataStorage::~SliceDataStorage()
     delete prime_tower_;
 }
 
-Shape SliceDataStorage::getLayerOutlines(
+const Shape& SliceDataStorage::getLayerOutlines(
+    const LayerIndex layer_nr,
+    const bool include_support,
+    const bool include_prime_tower,
+    const bool external_polys_only,
+    const int extruder_nr,
+    const bool include_models) const
+{
+    const LayerOutlinesKey key{ layer_nr, extruder_nr, include_support, include_prime_tower, external_polys_only, include_models };
+    {
+        std::shared_lock lock(layer_outlines_mutex_);
+        if (const auto cached = layer_outlines_cache_.find(key); cached != layer_outlines_cache_.end())
+        {
+            return cached->second;
+        }
+    }
+
+    // Compute outside of the lock, if another thread did the same meanwhile its result is kept
+    Shape outlines = computeLayerOutlines(layer_nr, include_support, include_prime_tower, external_polys_only, extruder_nr, include_models);
+    std::unique_lock lock(layer_outlines_mutex_);
+    return layer_outlines_cache_.try_emplace(key, std::move(outlines)).first->second;
+}
+
+void SliceDataStorage::invalidateLayerOutlines()
+{
+    std::unique_lock lock(layer_outlines_mutex_);
+    layer_outlines_cache_.clear();
+}
+
+void SliceDataStorage::evictLayerOutlines(const LayerIndex layer_nr)
+{
+    std::unique_lock lock(layer_outlines_mutex_);
+    std::erase_if(
+        layer_outlines_cache_,
+        [layer_nr](const auto& entry)
+        {
+            return entry.first.layer_nr == layer_nr;
+        });
+}
+
+Shape SliceDataStorage::computeLayerOutlines(
     const LayerIndex layer_nr,
     const bool include_support,
     const bool include_prime_tower,
@@ -596,6 +856,62 @@ std::vector<bool> SliceDataStorage::getExtrudersUsed(const LayerIndex layer_nr)
     return ret;
 }
 
+SliceDataStorage::LayerUse& SliceDataStorage::getLayerUse(const LayerIndex layer_nr)
+{
+    std::lock_guard lock(layer_uses_mutex_);
+    if (layer_nr >= LayerIndex(layer_uses_.size()))
+    {
+        layer_uses_.resize(layer_nr + 1);
+    }
+    std::unique_ptr<LayerUse>& layer_use = layer_uses_[layer_nr];
+    if (! layer_use)
+    {
+        layer_use = std::make_unique<LayerUse>();
+    }
+    return *layer_use;
+}
+
+void SliceDataStorage::decompressLayers(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr)
+{
+    for (LayerIndex layer_nr = std::max(first_layer_nr, LayerIndex(0)); layer_nr <= last_layer_nr; ++layer_nr)
+    {
+        LayerUse& layer_use = getLayerUse(layer_nr);
+        std::lock_guard lock(layer_use.mutex);
+        if (layer_use.use_count++ > 0)
+        {
+            continue;
+        }
+        for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
+        {
+            if (layer_nr < LayerIndex(mesh->layers.size()))
+            {
+                mesh->layers[layer_nr].decompress();
+            }
+        }
+    }
+}
+
+void SliceDataStorage::releaseLayers(const LayerIndex first_layer_nr, const LayerIndex last_layer_nr)
+{
+    for (LayerIndex layer_nr = std::max(first_layer_nr, LayerIndex(0)); layer_nr <= last_layer_nr; ++layer_nr)
+    {
+        LayerUse& layer_use = getLayerUse(layer_nr);
+        std::lock_guard lock(layer_use.mutex);
+        assert(layer_use.use_count > 0 && "Layers must be decompressed before they can be released.");
+        if (--layer_use.use_count > 0)
+        {
+            continue;
+        }
+        for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
+        {
+            if (layer_nr < LayerIndex(mesh->layers.size()))
+            {
+                mesh->layers[layer_nr].release();
+            }
+        }
+    }
+}
+
 bool SliceDataStorage::getExtruderPrimeBlobEnabled(const size_t extruder_nr) const
 {
     if (extruder_nr >= Application::getInstance().current_slice_->scene.extruders.size())
@@ -734,6 +1050,7 @@ Shape SliceDataStorage::getMachineBorder(int checking_extruder_nr) const
 void SliceDataStorage::initializePrimeTower()
 {
     prime_tower_ = PrimeTower::createPrimeTower(*this);
+    invalidateLayerOutlines(); // The prime tower has been subtracted from the support
 }
 
 void SupportLayer::excludeAreasFromSupportInfillAreas(const Shape& exclude_polygons, const AABB& exclude_polygons_boundary_box)
@@ -5,12 +5,16 @@
 
 #include <algorithm> // remove_if
 #include <cstdio>
+#include <limits>
+#include <mutex>
 #include <numbers>
 
+#include <range/v3/view/zip.hpp>
 #include <scripta/logger.h>
 #include <spdlog/spdlog.h>
 
 #include "Application.h"
+#include "MeshGroup.h"
 #include "Slice.h"
 #include "SlicedUVCoordinates.h"
 #include "geometry/OpenPolyline.h"
@@ -24,6 +28,7 @@
 #include "utils/Simplify.h"
 #include "utils/SparsePointGridInclusive.h"
 #include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
 #include "utils/gettime.h"
 #include "utils/polygonUtils.h"
 #include "utils/section_type.h"
@@ -69,10 +74,15 @@ void SlicerLayer::makeBasicPolygonLoop(OpenLinesSet& open_polylines, const size_
 
 int SlicerLayer::tryFaceNextSegmentIdx(const SlicerSegment& segment, const int face_idx, const size_t start_segment_idx) const
 {
-    decltype(face_idx_to_segment_idx_.begin()) it;
-    auto it_end = face_idx_to_segment_idx_.end();
-    it = face_idx_to_segment_idx_.find(face_idx);
-    if (it != it_end)
+    const auto it = std::lower_bound(
+        face_idx_to_segment_idx_.begin(),
+        face_idx_to_segment_idx_.end(),
+        face_idx,
+        [](const std::pair<int, int>& face_segment, const int face)
+        {
+            return face_segment.first < face;
+        });
+    if (it != face_idx_to_segment_idx_.end() && (*it).first == face_idx)
     {
         const int segment_idx = (*it).second;
         Point2LL p1 = segments_[segment_idx].start;
@@ -738,6 +748,16 @@ std::optional<ClosePolygonResult> SlicerLayer::findPolygonPointClosestTo(Point2L
 
 void SlicerLayer::makePolygons(const Mesh* mesh)
 {
+    // The segments are generated face by face, so the topology is sorted already, unless the segments were provided differently.
+    const auto by_face = [](const std::pair<int, int>& a, const std::pair<int, int>& b)
+    {
+        return a.first < b.first;
+    };
+    if (! std::is_sorted(face_idx_to_segment_idx_.begin(), face_idx_to_segment_idx_.end(), by_face))
+    {
+        std::sort(face_idx_to_segment_idx_.begin(), face_idx_to_segment_idx_.end(), by_face);
+    }
+
     OpenLinesSet open_polylines;
 
     makeBasicPolygonLoops(open_polylines);
@@ -802,6 +822,7 @@ void SlicerLayer::makePolygons(const Mesh* mesh)
 
     // Clear the segment list to save memory, it is no longer needed after this point.
     segments_.clear();
+    face_idx_to_segment_idx_.clear();
 }
 
 Slicer::Slicer(
@@ -813,168 +834,353 @@ Slicer::Slicer(
     const SlicingTolerance slicing_tolerance,
     const coord_t initial_layer_thickness)
     : mesh(i_mesh)
+    , slicing_tolerance_(slicing_tolerance)
 {
-    assert(slice_layer_count > 0);
+    slice({ this }, thickness, slice_layer_count, use_variable_layer_heights, adaptive_layers, initial_layer_thickness);
+    i_mesh->expandXY(i_mesh->settings_.get<coord_t>("xy_offset"));
+}
 
-    TimeKeeper slice_timer;
+Slicer::Slicer(const Mesh* mesh, const SlicingTolerance slicing_tolerance)
+    : mesh(mesh)
+    , slicing_tolerance_(slicing_tolerance)
+{
+}
 
-    layers = buildLayersWithHeight(slice_layer_count, slicing_tolerance, initial_layer_thickness, thickness, use_variable_layer_heights, adaptive_layers);
-    scripta::setAll(
-        layers,
-        static_cast<int>(mesh->settings_.get<EPlatformAdhesion>("adhesion_type")),
-        mesh->settings_.get<int>("raft_surface_layers"),
-        mesh->settings_.get<coord_t>("raft_surface_thickness"),
-        mesh->settings_.get<int>("raft_interface_layers"),
-        mesh->settings_.get<coord_t>("raft_interface_thickness"),
-        mesh->settings_.get<coord_t>("raft_base_thickness"),
-        mesh->settings_.get<coord_t>("raft_airgap"),
-        mesh->settings_.get<coord_t>("layer_0_z_overlap"),
-        Raft::getFillerLayerCount());
+std::vector<Slicer*> Slicer::sliceMeshes(
+    MeshGroup& mesh_group,
+    const coord_t thickness,
+    const size_t slice_layer_count,
+    bool use_variable_layer_heights,
+    std::vector<AdaptiveLayer>* adaptive_layers,
+    const coord_t initial_layer_thickness)
+{
+    const std::vector<std::optional<MeshGroup::MeshCopy>> copies = mesh_group.findTranslatedCopies();
 
-    std::vector<std::pair<int32_t, int32_t>> zbbox = buildZHeightsForFaces(*mesh);
+    std::vector<Slicer*> slicers;
+    std::vector<Slicer*> original_slicers;
+    slicers.reserve(mesh_group.meshes.size());
+    for (const auto& [mesh, copy] : ranges::views::zip(mesh_group.meshes, copies))
+    {
+        slicers.push_back(new Slicer(&mesh, mesh.settings_.get<SlicingTolerance>("slicing_tolerance")));
+        if (! copy.has_value())
+        {
+            original_slicers.push_back(slicers.back());
+        }
+    }
 
-    buildSegments(*mesh, zbbox, slicing_tolerance, layers);
+    slice(original_slicers, thickness, slice_layer_count, use_variable_layer_heights, adaptive_layers, initial_layer_thickness);
 
-    spdlog::info("Slice of mesh took {:03.3f} seconds", slice_timer.restart());
+    if (original_slicers.size() < slicers.size())
+    {
+        spdlog::info("Reusing the slices of {} mesh(es) for {} translated copies", original_slicers.size(), slicers.size() - original_slicers.size());
+    }
+    for (const auto& [slicer, copy] : ranges::views::zip(slicers, copies))
+    {
+        if (copy.has_value())
+        {
+            slicer->copyTranslatedLayers(*slicers[copy->original_idx], copy->offset);
+        }
+    }
 
-    makePolygons(*i_mesh, slicing_tolerance, layers);
-    scripta::log("sliced_polygons", layers, SectionType::NA);
-    spdlog::info("Make polygons took {:03.3f} seconds", slice_timer.restart());
+    for (Mesh& mesh : mesh_group.meshes)
+    {
+        mesh.expandXY(mesh.settings_.get<coord_t>("xy_offset"));
+    }
+    return slicers;
 }
 
-void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers)
+void Slicer::copyTranslatedLayers(const Slicer& original, const Point2LL& offset)
 {
-    cura::parallel_for(
-        layers,
-        [&](auto layer_it)
+    layers.resize(original.layers.size());
+    cura::parallel_for<size_t>(
+        0,
+        layers.size(),
+        [this, &original, &offset](const size_t layer_nr)
         {
-            SlicerLayer& layer = *layer_it;
-            const int32_t& z = layer.z_;
-            layer.segments_.reserve(100);
+            const SlicerLayer& original_layer = original.layers[layer_nr];
+            SlicerLayer& layer = layers[layer_nr];
+            layer.z_ = original_layer.z_;
+            layer.polygons_ = original_layer.polygons_;
+            layer.polygons_.translate(offset);
+            layer.open_polylines_ = original_layer.open_polylines_;
+            layer.open_polylines_.translate(offset);
+        });
+}
 
-            // loop over all mesh faces
-            for (unsigned int face_idx = 0; face_idx < mesh.faces_.size(); face_idx++)
-            {
-                if ((z < zbbox[face_idx].first) || (z > zbbox[face_idx].second))
-                {
-                    continue;
-                }
+void Slicer::slice(
+    const std::vector<Slicer*>& slicers,
+    const coord_t thickness,
+    const size_t slice_layer_count,
+    bool use_variable_layer_heights,
+    const std::vector<AdaptiveLayer>* adaptive_layers,
+    const coord_t initial_layer_thickness)
+{
+    assert(slice_layer_count > 0);
 
-                // get all vertices per face
-                const MeshFace& face = mesh.faces_[face_idx];
-                const MeshVertex& v0 = mesh.vertices_[face.vertex_index_[0]];
-                const MeshVertex& v1 = mesh.vertices_[face.vertex_index_[1]];
-                const MeshVertex& v2 = mesh.vertices_[face.vertex_index_[2]];
-                const std::optional<Point2F> uv0 = face.uv_coordinates_[0];
-                const std::optional<Point2F> uv1 = face.uv_coordinates_[1];
-                const std::optional<Point2F> uv2 = face.uv_coordinates_[2];
-
-                // get all vertices represented as 3D point
-                Point3LL p0 = v0.p_;
-                Point3LL p1 = v1.p_;
-                Point3LL p2 = v2.p_;
-
-                // Compensate for points exactly on the slice-boundary, except for 'inclusive', which already handles this correctly.
-                if (slicing_tolerance != SlicingTolerance::INCLUSIVE)
-                {
-                    p0.z_ += static_cast<int>(p0.z_ == z) * -static_cast<int>(p0.z_ < 1);
-                    p1.z_ += static_cast<int>(p1.z_ == z) * -static_cast<int>(p1.z_ < 1);
-                    p2.z_ += static_cast<int>(p2.z_ == z) * -static_cast<int>(p2.z_ < 1);
-                }
+    TimeKeeper slice_timer;
 
-                SlicerSegment s;
-                s.endVertex = nullptr;
-                int end_edge_idx = -1;
-
-                /*
-                Now see if the triangle intersects the layer, and if so, where.
-
-                Edge cases are important here:
-                - If all three vertices of the triangle are exactly on the layer,
-                  don't count the triangle at all, because if the model is
-                  watertight, there will be adjacent triangles on all 3 sides that
-                  are not flat on the layer.
-                - If two of the vertices are exactly on the layer, only count the
-                  triangle if the last vertex is going up. We can't count both
-                  upwards and downwards triangles here, because if the model is
-                  manifold there will always be an adjacent triangle that is going
-                  the other way and you'd get double edges. You would also get one
-                  layer too many if the total model height is an exact multiple of
-                  the layer thickness. Between going up and going down, we need to
-                  choose the triangles going up, because otherwise the first layer
-                  of where the model starts will be empty and the model will float
-                  in mid-air. We'd much rather let the last layer be empty in that
-                  case.
-                - If only one of the vertices is exactly on the layer, the
-                  intersection between the triangle and the plane would be a point.
-                  We can't print points and with a manifold model there would be
-                  line segments adjacent to the point on both sides anyway, so we
-                  need to discard this 0-length line segment then.
-                - Vertices in ccw order if look from outside.
-                */
-
-                if (p0.z_ < z && p1.z_ > z && p2.z_ > z) //  1_______2
-                { //   \     /
-                    s = project2D(p0, p2, p1, uv0, uv2, uv1, z); //------------- z
-                    end_edge_idx = 0; //     \ /
-                } //      0
-
-                else if (p0.z_ > z && p1.z_ <= z && p2.z_ <= z) //      0
-                { //     / \      .
-                    s = project2D(p0, p1, p2, uv0, uv1, uv2, z); //------------- z
-                    end_edge_idx = 2; //   /     \    .
-                    if (p2.z_ == z) //  1_______2
-                    {
-                        s.endVertex = &v2;
-                    }
-                }
+    const size_t mesh_count = slicers.size();
+    for (Slicer* slicer : slicers)
+    {
+        const Mesh& mesh = *slicer->mesh;
+        slicer->layers
+            = buildLayersWithHeight(slice_layer_count, slicer->slicing_tolerance_, initial_layer_thickness, thickness, use_variable_layer_heights, adaptive_layers);
+        scripta::setAll(
+            slicer->layers,
+            static_cast<int>(mesh.settings_.get<EPlatformAdhesion>("adhesion_type")),
+            mesh.settings_.get<int>("raft_surface_layers"),
+            mesh.settings_.get<coord_t>("raft_surface_thickness"),
+            mesh.settings_.get<int>("raft_interface_layers"),
+            mesh.settings_.get<coord_t>("raft_interface_thickness"),
+            mesh.settings_.get<coord_t>("raft_base_thickness"),
+            mesh.settings_.get<coord_t>("raft_airgap"),
+            mesh.settings_.get<coord_t>("layer_0_z_overlap"),
+            Raft::getFillerLayerCount());
+    }
 
-                else if (p1.z_ < z && p0.z_ > z && p2.z_ > z) //  0_______2
-                { //   \     /
-                    s = project2D(p1, p0, p2, uv1, uv0, uv2, z); //------------- z
-                    end_edge_idx = 1; //     \ /
-                } //      1
-
-                else if (p1.z_ > z && p0.z_ <= z && p2.z_ <= z) //      1
-                { //     / \      .
-                    s = project2D(p1, p2, p0, uv1, uv2, uv0, z); //------------- z
-                    end_edge_idx = 0; //   /     \    .
-                    if (p0.z_ == z) //  0_______2
-                    {
-                        s.endVertex = &v0;
-                    }
-                }
+    std::vector<std::vector<std::pair<int32_t, int32_t>>> zbboxes(mesh_count);
+    std::vector<std::pair<int32_t, int32_t>> mesh_z_ranges(mesh_count, { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::lowest() });
+    cura::parallel_for<size_t>(
+        0,
+        mesh_count,
+        [&](const size_t mesh_idx)
+        {
+            zbboxes[mesh_idx] = buildZHeightsForFaces(*slicers[mesh_idx]->mesh);
+            for (const auto& [min_z, max_z] : zbboxes[mesh_idx])
+            {
+                mesh_z_ranges[mesh_idx].first = std::min(mesh_z_ranges[mesh_idx].first, min_z);
+                mesh_z_ranges[mesh_idx].second = std::max(mesh_z_ranges[mesh_idx].second, max_z);
+            }
+        });
 
-                else if (p2.z_ < z && p1.z_ > z && p0.z_ > z) //  0_______1
-                { //   \     /
-                    s = project2D(p2, p1, p0, uv2, uv1, uv0, z); //------------- z
-                    end_edge_idx = 2; //     \ /
-                } //      2
-
-                else if (p2.z_ > z && p1.z_ <= z && p0.z_ <= z) //      2
-                { //     / \      .
-                    s = project2D(p2, p0, p1, uv2, uv0, uv1, z); //------------- z
-                    end_edge_idx = 1; //   /     \    .
-                    if (p1.z_ == z) //  0_______1
-                    {
-                        s.endVertex = &v1;
-                    }
-                }
-                else
+    // The segments and their topology are only needed while making the polygons of a layer, so a layer takes the buffers that an earlier
+    // layer gave back, instead of allocating and growing its own. There are only ever as many buffers as layers being sliced at once.
+    struct SegmentBuffers
+    {
+        std::vector<SlicerSegment> segments;
+        std::vector<std::pair<int, int>> topology;
+    };
+    std::mutex buffer_pool_mutex;
+    std::vector<SegmentBuffers> buffer_pool;
+
+    // Slice and stitch all the meshes in a single sweep. The items are ordered by layer first, so that the chunks of the parallel loop
+    // mix the meshes and a mesh with many layers doesn't end up on a single thread. Layers outside the height range of a mesh can't
+    // have any segments, so the faces of the mesh don't have to be visited for those.
+    cura::parallel_for<size_t>(
+        0,
+        slice_layer_count * mesh_count,
+        [&](const size_t item_idx)
+        {
+            const size_t layer_nr = item_idx / mesh_count;
+            const size_t mesh_idx = item_idx % mesh_count;
+            TraceSpan span("slicing", "sliceLayer", layer_nr, mesh_idx);
+            Slicer& slicer = *slicers[mesh_idx];
+            SlicerLayer& layer = slicer.layers[layer_nr];
+
+            SegmentBuffers buffers;
+            {
+                std::lock_guard lock(buffer_pool_mutex);
+                if (! buffer_pool.empty())
                 {
-                    // Not all cases create a segment, because a point of a face could create just a dot, and two touching faces
-                    //   on the slice would create two segments
-                    continue;
+                    buffers = std::move(buffer_pool.back());
+                    buffer_pool.pop_back();
                 }
+            }
+            layer.segments_.swap(buffers.segments);
+            layer.face_idx_to_segment_idx_.swap(buffers.topology);
 
-                // store the segments per layer
-                layer.face_idx_to_segment_idx_.insert(std::make_pair(face_idx, layer.segments_.size()));
-                s.faceIndex = face_idx;
-                s.endOtherFaceIdx = face.connected_face_index_[end_edge_idx];
-                s.addedToPolygon = false;
-                layer.segments_.push_back(s);
+            if (layer.z_ >= mesh_z_ranges[mesh_idx].first && layer.z_ <= mesh_z_ranges[mesh_idx].second)
+            {
+                buildSegments(*slicer.mesh, zbboxes[mesh_idx], slicer.slicing_tolerance_, layer);
             }
+            layer.makePolygons(slicer.mesh);
+
+            buffers.segments.swap(layer.segments_);
+            buffers.topology.swap(layer.face_idx_to_segment_idx_);
+            std::lock_guard lock(buffer_pool_mutex);
+            buffer_pool.push_back(std::move(buffers));
+        });
+    buffer_pool.clear();
+    zbboxes.clear();
+
+    spdlog::info("Slice of {} mesh(es) took {:03.3f} seconds", mesh_count, slice_timer.restart());
+
+    std::vector<XYOffsets> xy_offsets(mesh_count);
+    cura::parallel_for<size_t>(
+        0,
+        mesh_count,
+        [&](const size_t mesh_idx)
+        {
+            Slicer& slicer = *slicers[mesh_idx];
+            applySlicingTolerance(slicer.slicing_tolerance_, slicer.layers);
+            xy_offsets[mesh_idx] = getXYOffsets(*slicer.mesh, slicer.layers);
         });
+
+    std::vector<size_t> offset_mesh_indices;
+    for (size_t mesh_idx = 0; mesh_idx < mesh_count; mesh_idx++)
+    {
+        if (! xy_offsets[mesh_idx].isNone())
+        {
+            offset_mesh_indices.push_back(mesh_idx);
+        }
+    }
+    cura::parallel_for<size_t>(
+        0,
+        slice_layer_count * offset_mesh_indices.size(),
+        [&](const size_t item_idx)
+        {
+            const size_t layer_nr = item_idx / offset_mesh_indices.size();
+            const size_t mesh_idx = offset_mesh_indices[item_idx % offset_mesh_indices.size()];
+            applyXYOffsets(xy_offsets[mesh_idx], layer_nr, slicers[mesh_idx]->layers[layer_nr]);
+        });
+
+    for (const Slicer* slicer : slicers)
+    {
+        scripta::log("sliced_polygons", slicer->layers, SectionType::NA);
+    }
+    spdlog::info("Make polygons took {:03.3f} seconds", slice_timer.restart());
+
+    if (Tracer::getInstance().isEnabled())
+    {
+        for (const Slicer* slicer : slicers)
+        {
+            size_t vertex_count = 0;
+            for (const SlicerLayer& layer : slicer->layers)
+            {
+                vertex_count += layer.polygons_.pointCount() + layer.open_polylines_.pointCount();
+            }
+            Tracer::getInstance().addCounter("sliced_vertex_count", static_cast<double>(vertex_count));
+        }
+    }
+}
+
+void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, SlicerLayer& layer)
+{
+    const int32_t& z = layer.z_;
+    layer.segments_.reserve(100);
+
+    // loop over all mesh faces
+    for (unsigned int face_idx = 0; face_idx < mesh.faces_.size(); face_idx++)
+    {
+        if ((z < zbbox[face_idx].first) || (z > zbbox[face_idx].second))
+        {
+            continue;
+        }
+
+        // get all vertices per face
+        const MeshFace& face = mesh.faces_[face_idx];
+        const MeshVertex& v0 = mesh.vertices_[face.vertex_index_[0]];
+        const MeshVertex& v1 = mesh.vertices_[face.vertex_index_[1]];
+        const MeshVertex& v2 = mesh.vertices_[face.vertex_index_[2]];
+        const std::optional<Point2F> uv0 = face.uv_coordinates_[0];
+        const std::optional<Point2F> uv1 = face.uv_coordinates_[1];
+        const std::optional<Point2F> uv2 = face.uv_coordinates_[2];
+
+        // get all vertices represented as 3D point
+        Point3LL p0 = v0.p_;
+        Point3LL p1 = v1.p_;
+        Point3LL p2 = v2.p_;
+
+        // Compensate for points exactly on the slice-boundary, except for 'inclusive', which already handles this correctly.
+        if (slicing_tolerance != SlicingTolerance::INCLUSIVE)
+        {
+            p0.z_ += static_cast<int>(p0.z_ == z) * -static_cast<int>(p0.z_ < 1);
+            p1.z_ += static_cast<int>(p1.z_ == z) * -static_cast<int>(p1.z_ < 1);
+            p2.z_ += static_cast<int>(p2.z_ == z) * -static_cast<int>(p2.z_ < 1);
+        }
+
+        SlicerSegment s;
+        s.endVertex = nullptr;
+        int end_edge_idx = -1;
+
+        /*
+        Now see if the triangle intersects the layer, and if so, where.
+
+        Edge cases are important here:
+        - If all three vertices of the triangle are exactly on the layer,
+          don't count the triangle at all, because if the model is
+          watertight, there will be adjacent triangles on all 3 sides that
+          are not flat on the layer.
+        - If two of the vertices are exactly on the layer, only count the
+          triangle if the last vertex is going up. We can't count both
+          upwards and downwards triangles here, because if the model is
+          manifold there will always be an adjacent triangle that is going
+          the other way and you'd get double edges. You would also get one
+          layer too many if the total model height is an exact multiple of
+          the layer thickness. Between going up and going down, we need to
+          choose the triangles going up, because otherwise the first layer
+          of where the model starts will be empty and the model will float
+          in mid-air. We'd much rather let the last layer be empty in that
+          case.
+        - If only one of the vertices is exactly on the layer, the
+          intersection between the triangle and the plane would be a point.
+          We can't print points and with a manifold model there would be
+          line segments adjacent to the point on both sides anyway, so we
+          need to discard this 0-length line segment then.
+        - Vertices in ccw order if look from outside.
+        */
+
+        if (p0.z_ < z && p1.z_ > z && p2.z_ > z) //  1_______2
+        { //   \     /
+            s = project2D(p0, p2, p1, uv0, uv2, uv1, z); //------------- z
+            end_edge_idx = 0; //     \ /
+        } //      0
+
+        else if (p0.z_ > z && p1.z_ <= z && p2.z_ <= z) //      0
+        { //     / \      .
+            s = project2D(p0, p1, p2, uv0, uv1, uv2, z); //------------- z
+            end_edge_idx = 2; //   /     \    .
+            if (p2.z_ == z) //  1_______2
+            {
+                s.endVertex = &v2;
+            }
+        }
+
+        else if (p1.z_ < z && p0.z_ > z && p2.z_ > z) //  0_______2
+        { //   \     /
+            s = project2D(p1, p0, p2, uv1, uv0, uv2, z); //------------- z
+            end_edge_idx = 1; //     \ /
+        } //      1
+
+        else if (p1.z_ > z && p0.z_ <= z && p2.z_ <= z) //      1
+        { //     / \      .
+            s = project2D(p1, p2, p0, uv1, uv2, uv0, z); //------------- z
+            end_edge_idx = 0; //   /     \    .
+            if (p0.z_ == z) //  0_______2
+            {
+                s.endVertex = &v0;
+            }
+        }
+
+        else if (p2.z_ < z && p1.z_ > z && p0.z_ > z) //  0_______1
+        { //   \     /
+            s = project2D(p2, p1, p0, uv2, uv1, uv0, z); //------------- z
+            end_edge_idx = 2; //     \ /
+        } //      2
+
+        else if (p2.z_ > z && p1.z_ <= z && p0.z_ <= z) //      2
+        { //     / \      .
+            s = project2D(p2, p0, p1, uv2, uv0, uv1, z); //------------- z
+            end_edge_idx = 1; //   /     \    .
+            if (p1.z_ == z) //  0_______1
+            {
+                s.endVertex = &v1;
+            }
+        }
+        else
+        {
+            // Not all cases create a segment, because a point of a face could create just a dot, and two touching faces
+            //   on the slice would create two segments
+            continue;
+        }
+
+        // store the segments per layer
+        layer.face_idx_to_segment_idx_.emplace_back(face_idx, layer.segments_.size());
+        s.faceIndex = face_idx;
+        s.endOtherFaceIdx = face.connected_face_index_[end_edge_idx];
+        s.addedToPolygon = false;
+        layer.segments_.push_back(s);
+    }
 }
 
 std::vector<SlicerLayer> Slicer::buildLayersWithHeight(
@@ -1018,15 +1224,8 @@ std::vector<SlicerLayer> Slicer::buildLayersWithHeight(
     return layers_res;
 }
 
-void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers)
+void Slicer::applySlicingTolerance(SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers)
 {
-    cura::parallel_for(
-        layers,
-        [&mesh](auto layer_it)
-        {
-            layer_it->makePolygons(&mesh);
-        });
-
     switch (slicing_tolerance)
     {
     case SlicingTolerance::INCLUSIVE:
@@ -1047,7 +1246,10 @@ void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::v
         // do nothing
         ;
     }
+}
 
+Slicer::XYOffsets Slicer::getXYOffsets(const Mesh& mesh, const std::vector<SlicerLayer>& layers)
+{
     size_t layer_apply_initial_xy_offset = 0;
     if (layers.size() > 0 && layers[0].polygons_.size() == 0 && ! mesh.settings_.get<bool>("support_mesh") && ! mesh.settings_.get<bool>("anti_overhang_mesh")
         && ! mesh.settings_.get<bool>("cutting_mesh") && ! mesh.settings_.get<bool>("infill_mesh"))
@@ -1055,66 +1257,61 @@ void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::v
         layer_apply_initial_xy_offset = 1;
     }
 
-
-    const coord_t xy_offset = mesh.settings_.get<coord_t>("xy_offset");
-    const coord_t xy_offset_0 = mesh.settings_.get<coord_t>("xy_offset_layer_0");
-    const coord_t xy_offset_hole = mesh.settings_.get<coord_t>("hole_xy_offset");
     const coord_t hole_offset_max_diameter = mesh.settings_.get<coord_t>("hole_xy_offset_max_diameter");
+    return XYOffsets{ .xy_offset = mesh.settings_.get<coord_t>("xy_offset"),
+                      .xy_offset_0 = mesh.settings_.get<coord_t>("xy_offset_layer_0"),
+                      .layer_apply_initial_xy_offset = layer_apply_initial_xy_offset,
+                      .hole_xy_offset = mesh.settings_.get<coord_t>("hole_xy_offset"),
+                      .hole_offset_max_diameter = hole_offset_max_diameter,
+                      .max_hole_area = std::numbers::pi / 4 * static_cast<double>(hole_offset_max_diameter * hole_offset_max_diameter) };
+}
 
-    const auto max_hole_area = std::numbers::pi / 4 * static_cast<double>(hole_offset_max_diameter * hole_offset_max_diameter);
+void Slicer::applyXYOffsets(const XYOffsets& offsets, const size_t layer_nr, SlicerLayer& layer)
+{
+    const auto xy_offset_local = (layer_nr <= offsets.layer_apply_initial_xy_offset) ? offsets.xy_offset_0 : offsets.xy_offset;
+    if (xy_offset_local != 0)
+    {
+        layer.polygons_ = layer.polygons_.offset(xy_offset_local, ClipperLib::JoinType::jtRound);
+    }
+    if (offsets.hole_xy_offset != 0)
+    {
+        const auto parts = layer.polygons_.splitIntoParts();
+        layer.polygons_.clear();
 
-    cura::parallel_for<size_t>(
-        0,
-        layers.size(),
-        [&layers, layer_apply_initial_xy_offset, xy_offset, xy_offset_0, xy_offset_hole, hole_offset_max_diameter, max_hole_area](size_t layer_nr)
+        for (const auto& part : parts)
         {
-            const auto xy_offset_local = (layer_nr <= layer_apply_initial_xy_offset) ? xy_offset_0 : xy_offset;
-            if (xy_offset_local != 0)
-            {
-                layers[layer_nr].polygons_ = layers[layer_nr].polygons_.offset(xy_offset_local, ClipperLib::JoinType::jtRound);
-            }
-            if (xy_offset_hole != 0)
+            Shape holes;
+            Shape outline;
+            for (const Polygon& poly : part)
             {
-                const auto parts = layers[layer_nr].polygons_.splitIntoParts();
-                layers[layer_nr].polygons_.clear();
-
-                for (const auto& part : parts)
+                const auto area = poly.area();
+                const auto abs_area = std::abs(area);
+                const auto is_hole = area < 0;
+                if (is_hole)
                 {
-                    Shape holes;
-                    Shape outline;
-                    for (const Polygon& poly : part)
+                    if (offsets.hole_offset_max_diameter == 0)
                     {
-                        const auto area = poly.area();
-                        const auto abs_area = std::abs(area);
-                        const auto is_hole = area < 0;
-                        if (is_hole)
-                        {
-                            if (hole_offset_max_diameter == 0)
-                            {
-                                holes.push_back(poly.offset(xy_offset_hole));
-                            }
-                            else if (abs_area < max_hole_area)
-                            {
-                                const auto distance = static_cast<int>(std::lerp(xy_offset_hole, 0, abs_area / max_hole_area));
-                                holes.push_back(poly.offset(distance));
-                            }
-                            else
-                            {
-                                holes.push_back(poly);
-                            }
-                        }
-                        else
-                        {
-                            outline.push_back(poly);
-                        }
+                        holes.push_back(poly.offset(offsets.hole_xy_offset));
                     }
-
-                    layers[layer_nr].polygons_.push_back(outline.difference(holes.unionPolygons()));
+                    else if (abs_area < offsets.max_hole_area)
+                    {
+                        const auto distance = static_cast<int>(std::lerp(offsets.hole_xy_offset, 0, abs_area / offsets.max_hole_area));
+                        holes.push_back(poly.offset(distance));
+                    }
+                    else
+                    {
+                        holes.push_back(poly);
+                    }
+                }
+                else
+                {
+                    outline.push_back(poly);
                 }
             }
-        });
 
-    mesh.expandXY(xy_offset);
+            layer.polygons_.push_back(outline.difference(holes.unionPolygons()));
+        }
+    }
 }
 
 
@@ -1691,6 +1691,78 @@ void AreaSupport::handleWallStruts(const Settings& settings, Shape& supportLayer
     }
 }
 
+std::vector<Shape> AreaSupport::stackMeshOutlines(const SliceMeshStorage& mesh, const size_t window_size, const std::vector<std::pair<LayerIndex, LayerIndex>>& windows)
+{
+    std::vector<Shape> stacked_outlines(windows.size());
+    const size_t layer_count = mesh.layers.size();
+    if (layer_count == 0 || window_size == 0)
+    {
+        return stacked_outlines;
+    }
+
+    // Unions of the outlines from the start of the block up to a layer, and from a layer up to the end of the block
+    std::vector<Shape> block_prefix(layer_count);
+    std::vector<Shape> block_suffix(layer_count);
+    const size_t block_count = round_up_divide(layer_count, window_size);
+    cura::parallel_for<size_t>(
+        0,
+        block_count,
+        [&](const size_t block_idx)
+        {
+            const size_t block_start = block_idx * window_size;
+            const size_t block_end = std::min(block_start + window_size, layer_count);
+
+            Shape accumulated;
+            for (size_t layer_idx = block_start; layer_idx < block_end; ++layer_idx)
+            {
+                accumulated = accumulated.unionPolygons(mesh.layers[layer_idx].getOutlines());
+                block_prefix[layer_idx] = accumulated;
+            }
+            accumulated.clear();
+            for (size_t layer_idx = block_end; layer_idx > block_start; --layer_idx)
+            {
+                accumulated = accumulated.unionPolygons(mesh.layers[layer_idx - 1].getOutlines());
+                block_suffix[layer_idx - 1] = accumulated;
+            }
+        });
+
+    cura::parallel_for<size_t>(
+        0,
+        windows.size(),
+        [&](const size_t window_idx)
+        {
+            const size_t first = windows[window_idx].first;
+            const size_t last = windows[window_idx].second;
+            assert(first <= last && last < layer_count && last - first < window_size);
+
+            const size_t first_block = first / window_size;
+            const size_t last_block = last / window_size;
+            if (first_block != last_block)
+            { // The window spans the end of a block and the start of the next one
+                stacked_outlines[window_idx] = block_suffix[first].unionPolygons(block_prefix[last]);
+            }
+            else if (first == first_block * window_size)
+            {
+                stacked_outlines[window_idx] = block_prefix[last];
+            }
+            else if (last + 1 == std::min((last_block + 1) * window_size, layer_count))
+            {
+                stacked_outlines[window_idx] = block_suffix[first];
+            }
+            else
+            { // Truncated window in the middle of a block, which only happens at the bottom or top of the model
+                Shape outlines;
+                for (size_t layer_idx = first; layer_idx <= last; ++layer_idx)
+                {
+                    outlines.push_back(mesh.layers[layer_idx].getOutlines());
+                }
+                stacked_outlines[window_idx] = outlines.unionPolygons();
+            }
+        });
+
+    return stacked_outlines;
+}
+
 void AreaSupport::generateSupportBottom(SliceDataStorage& storage, const SliceMeshStorage& mesh, std::vector<Shape>& global_support_areas_per_layer)
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
@@ -1707,19 +1779,40 @@ void AreaSupport::generateSupportBottom(SliceDataStorage& storage, const SliceMe
     const double minimum_bottom_area = mesh.settings.get<double>("minimum_bottom_area");
 
     std::vector<SupportLayer>& support_layers = storage.support.supportLayers;
-    for (LayerIndex layer_idx = support_layers.size() - 1; layer_idx >= static_cast<int>(z_distance_bottom); --layer_idx)
+    const LayerIndex first_layer_idx = z_distance_bottom;
+    const LayerIndex last_layer_idx = LayerIndex(support_layers.size()) - 1;
+    if (last_layer_idx < first_layer_idx)
     {
-        const unsigned int bottom_layer_idx_below = std::max(0, int(layer_idx) - int(bottom_layer_count) - int(z_distance_bottom));
-        Shape mesh_outlines;
-        for (auto layer_idx_below = bottom_layer_idx_below; layer_idx_below < layer_idx - z_distance_bottom + 1; layer_idx_below += 1)
-        {
-            mesh_outlines.push_back(mesh.layers[layer_idx_below].getOutlines());
-        }
-        Shape bottoms;
-        generateSupportInterfaceLayer(global_support_areas_per_layer[layer_idx], mesh_outlines, bottom_line_width, bottom_outline_offset, minimum_bottom_area, bottoms);
-        support_layers[layer_idx].support_bottom.push_back(bottoms);
-        scripta::log("support_interface_bottoms", bottoms, SectionType::SUPPORT, layer_idx);
+        return;
     }
+
+    // For each layer, the range of model layers below it that generate support bottom
+    std::vector<std::pair<LayerIndex, LayerIndex>> windows;
+    windows.reserve(last_layer_idx - first_layer_idx + 1);
+    for (LayerIndex layer_idx = first_layer_idx; layer_idx <= last_layer_idx; ++layer_idx)
+    {
+        const LayerIndex bottom_layer_idx_below = std::max(LayerIndex(0), layer_idx - bottom_layer_count - z_distance_bottom);
+        windows.emplace_back(bottom_layer_idx_below, layer_idx - z_distance_bottom);
+    }
+    const std::vector<Shape> mesh_outlines_per_layer = stackMeshOutlines(mesh, bottom_layer_count + 1, windows);
+
+    cura::parallel_for<size_t>(
+        0,
+        windows.size(),
+        [&](const size_t window_idx)
+        {
+            const LayerIndex layer_idx = first_layer_idx + window_idx;
+            Shape bottoms;
+            generateSupportInterfaceLayer(
+                global_support_areas_per_layer[layer_idx],
+                mesh_outlines_per_layer[window_idx],
+                bottom_line_width,
+                bottom_outline_offset,
+                minimum_bottom_area,
+                bottoms);
+            scripta::log("support_interface_bottoms", bottoms, SectionType::SUPPORT, layer_idx);
+            support_layers[layer_idx].support_bottom.push_back(std::move(bottoms));
+        });
 }
 
 void AreaSupport::generateSupportRoof(SliceDataStorage& storage, const SliceMeshStorage& mesh, std::vector<Shape>& global_support_areas_per_layer)
@@ -1739,53 +1832,86 @@ void AreaSupport::generateSupportRoof(SliceDataStorage& storage, const SliceMesh
     const double minimum_roof_area = mesh.settings.get<double>("minimum_roof_area");
 
     std::vector<SupportLayer>& support_layers = storage.support.supportLayers;
-    for (LayerIndex layer_idx = static_cast<int>(support_layers.size() - z_distance_top) - 1; layer_idx >= 0; --layer_idx)
+    const int roof_layers_end = static_cast<int>(support_layers.size()) - static_cast<int>(z_distance_top);
+    if (roof_layers_end <= 0)
+    {
+        return;
+    }
+
+    // For each layer, the range of model layers above it that generate support roof
+    std::vector<std::pair<LayerIndex, LayerIndex>> windows;
+    windows.reserve(roof_layers_end);
+    for (LayerIndex layer_idx = 0; layer_idx < roof_layers_end; ++layer_idx)
     {
         const LayerIndex top_layer_idx_above{
             std::min(LayerIndex{ support_layers.size() - 1 }, LayerIndex{ layer_idx + roof_layer_count + z_distance_top })
         }; // Maximum layer of the model that generates support roof.
-        Shape mesh_outlines;
-        for (auto layer_idx_above = top_layer_idx_above; layer_idx_above > layer_idx + z_distance_top - 1; layer_idx_above -= 1)
-        {
-            mesh_outlines.push_back(mesh.layers[layer_idx_above].getOutlines());
-        }
-        Shape roofs;
-        generateSupportInterfaceLayer(global_support_areas_per_layer[layer_idx], mesh_outlines, roof_line_width, roof_outline_offset, minimum_roof_area, roofs);
-        support_layers[layer_idx].support_roof.push_back(roofs);
-        if (layer_idx > 0 && layer_idx < support_layers.size() - 1 && support_top_distance % layer_height != 0)
-        {
-            support_layers[layer_idx].support_fractional_roof.push_back(roofs.difference(support_layers[layer_idx + 1].support_roof));
-        }
-        scripta::log("support_interface_roofs", roofs, SectionType::SUPPORT, layer_idx);
+        windows.emplace_back(layer_idx + z_distance_top, top_layer_idx_above);
     }
+    const std::vector<Shape> mesh_outlines_per_layer = stackMeshOutlines(mesh, roof_layer_count + 1, windows);
 
-    // Remove support in between the support roof and the model. Subtracts the roof polygons from the support polygons on the layers above it.
-    for (auto [layer_idx, support_layer] : support_layers | ranges::views::enumerate | ranges::views::drop(1) | ranges::views::drop_last(z_distance_top))
-    {
-        if (support_layer.support_roof.empty())
+    // Each layer only depends on its own support areas, so all roofs can be generated at once
+    std::vector<Shape> roofs_per_layer(roof_layers_end);
+    cura::parallel_for<size_t>(
+        0,
+        roofs_per_layer.size(),
+        [&](const size_t layer_idx)
         {
-            continue;
-        }
+            Shape& roofs = roofs_per_layer[layer_idx];
+            generateSupportInterfaceLayer(
+                global_support_areas_per_layer[layer_idx],
+                mesh_outlines_per_layer[layer_idx],
+                roof_line_width,
+                roof_outline_offset,
+                minimum_roof_area,
+                roofs);
+            support_layers[layer_idx].support_roof.push_back(roofs);
+            scripta::log("support_interface_roofs", roofs, SectionType::SUPPORT, LayerIndex(layer_idx));
+        });
 
-        int lower = static_cast<int>(layer_idx);
-        int upper = std::min(static_cast<int>(layer_idx + roof_layer_count + z_distance_top + 5), static_cast<int>(global_support_areas_per_layer.size()) - 1);
-        for (Shape& global_support : global_support_areas_per_layer | ranges::views::slice(lower, upper))
-        {
-            global_support = global_support.difference(support_layer.support_roof);
-        }
+    // The fractional roof is the part of the roof that is not covered by the roof of the layer above, which is now complete for every layer
+    if (support_top_distance % layer_height != 0)
+    {
+        cura::parallel_for<size_t>(
+            1,
+            std::min(roofs_per_layer.size(), support_layers.size() - 1),
+            [&](const size_t layer_idx)
+            {
+                support_layers[layer_idx].support_fractional_roof.push_back(roofs_per_layer[layer_idx].difference(support_layers[layer_idx + 1].support_roof));
+            });
     }
+
+    // Remove support in between the support roof and the model. Subtracts the roof polygons from the support polygons on the layers above it.
+    // Every layer gathers the roofs below it, in the same order as if each roof was subtracted from the layers above it, so that the layers can be processed in parallel.
+    const size_t removal_height = roof_layer_count + z_distance_top + 5;
+    cura::parallel_for<size_t>(
+        1,
+        std::max(global_support_areas_per_layer.size(), size_t(1)) - 1,
+        [&](const size_t layer_idx)
+        {
+            Shape& global_support = global_support_areas_per_layer[layer_idx];
+            const size_t first_roof_layer_idx = std::max(size_t(1), layer_idx + 1 > removal_height ? layer_idx + 1 - removal_height : size_t(0));
+            const size_t last_roof_layer_idx = std::min(layer_idx, static_cast<size_t>(roof_layers_end) - 1);
+            for (size_t roof_layer_idx = first_roof_layer_idx; roof_layer_idx <= last_roof_layer_idx; ++roof_layer_idx)
+            {
+                const SupportLayer& support_layer = support_layers[roof_layer_idx];
+                if (! support_layer.support_roof.empty())
+                {
+                    global_support = global_support.difference(support_layer.support_roof);
+                }
+            }
+        });
 }
 
 void AreaSupport::generateSupportInterfaceLayer(
     Shape& support_areas,
-    const Shape colliding_mesh_outlines,
+    const Shape& colliding_mesh_outlines,
     const coord_t safety_offset,
     const coord_t outline_offset,
     const double minimum_interface_area,
     Shape& interface_polygons)
 {
-    Shape model = colliding_mesh_outlines.unionPolygons();
-    interface_polygons = support_areas.offset(safety_offset / 2).intersection(model);
+    interface_polygons = support_areas.offset(safety_offset / 2).intersection(colliding_mesh_outlines);
     interface_polygons = interface_polygons.offset(safety_offset).intersection(support_areas); // Make sure we don't generate any models that are not printable.
     if (outline_offset != 0)
     {
@@ -7,6 +7,7 @@
 #include <limits>
 
 #include "geometry/OpenPolyline.h"
+#include "geometry/PointsKernels.h"
 #include "geometry/Polygon.h"
 #include "geometry/Shape.h"
 #include "utils/linearAlg2D.h"
@@ -84,10 +85,7 @@ void AABB::calculate(const Shape& shape)
     max_ = Point2LL(POINT_MIN, POINT_MIN);
     for (const Polygon& poly : shape)
     {
-        for (const Point2LL& point : poly)
-        {
-            include(point);
-        }
+        kernels::bounds(poly.getPoints(), min_, max_);
     }
 }
 
@@ -97,10 +95,7 @@ void AABB::calculate(const OpenLinesSet& lines)
     max_ = Point2LL(POINT_MIN, POINT_MIN);
     for (const OpenPolyline& line : lines)
     {
-        for (const Point2LL& point : line)
-        {
-            include(point);
-        }
+        kernels::bounds(line.getPoints(), min_, max_);
     }
 }
 
@@ -108,10 +103,7 @@ void AABB::calculate(const PointsSet& poly)
 {
     min_ = Point2LL(POINT_MAX, POINT_MAX);
     max_ = Point2LL(POINT_MIN, POINT_MIN);
-    for (const Point2LL& p : poly)
-    {
-        include(p);
-    }
+    kernels::bounds(poly.getPoints(), min_, max_);
 }
 
 bool AABB::contains(const Point2LL& point) const
@@ -164,10 +156,7 @@ void AABB::include(const Point2LL& point)
 
 void AABB::include(const PointsSet& polygon)
 {
-    for (const Point2LL& point : polygon)
-    {
-        include(point);
-    }
+    kernels::bounds(polygon.getPoints(), min_, max_);
 }
 
 void AABB::include(const AABB& other)
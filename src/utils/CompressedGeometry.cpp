@@ -0,0 +1,225 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/CompressedGeometry.h"
+
+#include <algorithm>
+
+#include "geometry/Polygon.h"
+
+namespace cura
+{
+
+namespace
+{
+
+/*!
+ * Appends integers to a byte buffer, seven bits per byte, with the high bit set on all but the last byte of each integer.
+ */
+class Writer
+{
+public:
+    explicit Writer(std::vector<uint8_t>& data)
+        : data_(data)
+    {
+    }
+
+    void writeUnsigned(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            data_.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        data_.push_back(static_cast<uint8_t>(value));
+    }
+
+    /*!
+     * Signed integers are zigzag-encoded first, so that small negative numbers take as few bytes as small positive numbers.
+     */
+    void writeSigned(const int64_t value)
+    {
+        writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+private:
+    std::vector<uint8_t>& data_;
+};
+
+/*!
+ * Reads back the integers that a \ref Writer wrote.
+ */
+class Reader
+{
+public:
+    explicit Reader(const std::vector<uint8_t>& data)
+        : data_(data)
+    {
+    }
+
+    uint64_t readUnsigned()
+    {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            const uint8_t byte = data_[position_++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+    }
+
+    int64_t readSigned()
+    {
+        const uint64_t value = readUnsigned();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t position_{ 0 };
+};
+
+} // namespace
+
+CompressedShape::CompressedShape(const Shape& shape)
+{
+    if (shape.empty())
+    {
+        return; // Many of the areas of a layer part are empty, so those take no memory at all.
+    }
+    Writer writer(data_);
+    writer.writeUnsigned(shape.size());
+    Point2LL previous(0, 0);
+    for (const Polygon& polygon : shape)
+    {
+        writer.writeUnsigned((polygon.size() << 1) | (polygon.isExplicitelyClosed() ? 1 : 0));
+        for (const Point2LL& point : polygon)
+        {
+            writer.writeSigned(point.X - previous.X);
+            writer.writeSigned(point.Y - previous.Y);
+            previous = point;
+        }
+    }
+    data_.shrink_to_fit();
+}
+
+Shape CompressedShape::decompress() const
+{
+    Shape shape;
+    if (data_.empty())
+    {
+        return shape;
+    }
+    Reader reader(data_);
+    const size_t polygon_count = reader.readUnsigned();
+    shape.reserve(polygon_count);
+    Point2LL previous(0, 0);
+    for (size_t polygon_idx = 0; polygon_idx < polygon_count; polygon_idx++)
+    {
+        const uint64_t header = reader.readUnsigned();
+        Polygon polygon((header & 1) != 0);
+        const size_t point_count = header >> 1;
+        polygon.getPoints().reserve(point_count);
+        for (size_t point_idx = 0; point_idx < point_count; point_idx++)
+        {
+            previous.X += reader.readSigned();
+            previous.Y += reader.readSigned();
+            polygon.push_back(previous);
+        }
+        shape.push_back(std::move(polygon));
+    }
+    return shape;
+}
+
+bool CompressedShape::empty() const
+{
+    return data_.empty();
+}
+
+size_t CompressedShape::byteSize() const
+{
+    return data_.capacity();
+}
+
+CompressedToolPaths::CompressedToolPaths(const std::vector<VariableWidthLines>& toolpaths)
+{
+    Writer writer(data_);
+    writer.writeUnsigned(toolpaths.size());
+    Point2LL previous(0, 0);
+    coord_t previous_width = 0;
+    for (const VariableWidthLines& lines : toolpaths)
+    {
+        writer.writeUnsigned(lines.size());
+        for (const ExtrusionLine& line : lines)
+        {
+            writer.writeUnsigned(line.inset_idx_);
+            writer.writeUnsigned((line.is_odd_ ? 1 : 0) | (line.is_closed_ ? 2 : 0));
+            writer.writeUnsigned(line.junctions_.size());
+            for (const ExtrusionJunction& junction : line.junctions_)
+            {
+                writer.writeSigned(junction.p_.X - previous.X);
+                writer.writeSigned(junction.p_.Y - previous.Y);
+                writer.writeSigned(junction.w_ - previous_width);
+                writer.writeSigned(static_cast<int64_t>(junction.perimeter_index_ - line.inset_idx_));
+                previous = junction.p_;
+                previous_width = junction.w_;
+            }
+            if (! std::ranges::binary_search(inset_indices_, line.inset_idx_))
+            {
+                inset_indices_.insert(std::ranges::lower_bound(inset_indices_, line.inset_idx_), line.inset_idx_);
+            }
+        }
+    }
+    data_.shrink_to_fit();
+    inset_indices_.shrink_to_fit();
+}
+
+std::vector<VariableWidthLines> CompressedToolPaths::decompress() const
+{
+    std::vector<VariableWidthLines> toolpaths;
+    if (data_.empty())
+    {
+        return toolpaths;
+    }
+    Reader reader(data_);
+    toolpaths.resize(reader.readUnsigned());
+    Point2LL previous(0, 0);
+    coord_t previous_width = 0;
+    for (VariableWidthLines& lines : toolpaths)
+    {
+        const size_t line_count = reader.readUnsigned();
+        lines.reserve(line_count);
+        for (size_t line_idx = 0; line_idx < line_count; line_idx++)
+        {
+            const size_t inset_idx = reader.readUnsigned();
+            const uint64_t flags = reader.readUnsigned();
+            ExtrusionLine& line = lines.emplace_back(inset_idx, (flags & 1) != 0, (flags & 2) != 0);
+            const size_t junction_count = reader.readUnsigned();
+            line.junctions_.reserve(junction_count);
+            for (size_t junction_idx = 0; junction_idx < junction_count; junction_idx++)
+            {
+                previous.X += reader.readSigned();
+                previous.Y += reader.readSigned();
+                previous_width += reader.readSigned();
+                const size_t perimeter_index = inset_idx + static_cast<size_t>(reader.readSigned());
+                line.junctions_.emplace_back(previous, previous_width, perimeter_index);
+            }
+        }
+    }
+    return toolpaths;
+}
+
+bool CompressedToolPaths::hasInsetIndex(const size_t inset_idx) const
+{
+    return std::ranges::binary_search(inset_indices_, inset_idx);
+}
+
+size_t CompressedToolPaths::byteSize() const
+{
+    return data_.capacity() + inset_indices_.capacity() * sizeof(size_t);
+}
+
+} // namespace cura
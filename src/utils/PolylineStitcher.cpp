@@ -3,6 +3,12 @@
 
 #include "utils/PolylineStitcher.h"
 
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "geometry/ClosedLinesSet.h"
 #include "geometry/OpenLinesSet.h"
 #include "geometry/OpenPolyline.h"
@@ -92,6 +98,178 @@ void PolylineStitcher<OpenLinesSet, ClosedLinesSet, OpenPolyline, Point2LL>::pus
     result_polygons.emplace_back(polyline.getPoints(), true);
 }
 
+namespace
+{
+
+/*!
+ * Spatial lookup of the end points of the polylines that are being stitched.
+ *
+ * The end points are sorted by the grid cell they are in, so that the end points of each cell are stored contiguously and the cells can
+ * be found with a binary search. Once a polyline has been used in a chain, its end points are removed by moving them behind the live
+ * range of their cell. This way the end points of polylines that have been stitched already don't have to be checked again and again,
+ * which made stitching layers with many fragments in a small area quadratic. The removed end points are kept behind the live range, since
+ * they can still close a chain when they are close to its front.
+ */
+class EndpointGrid
+{
+public:
+    struct Endpoint
+    {
+        Point2LL p_;
+        size_t line_idx_;
+        bool is_end_; //!< Whether this is the last point of the polyline, rather than the first.
+    };
+
+    template<typename InputPaths>
+    EndpointGrid(const InputPaths& lines, const coord_t cell_size)
+        : grid_(cell_size)
+    {
+        std::vector<std::pair<SquareGrid::GridPoint, Endpoint>> sorted;
+        sorted.reserve(lines.size() * 2);
+        for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
+        {
+            const auto& line = lines[line_idx];
+            if (line.empty())
+            {
+                continue;
+            }
+            for (const bool is_end : { false, true })
+            {
+                const Point2LL p = make_point(is_end ? line.back() : line.front());
+                sorted.emplace_back(grid_.toGridPoint(p), Endpoint{ p, line_idx, is_end });
+            }
+        }
+        std::stable_sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const auto& a, const auto& b)
+            {
+                return std::tie(a.first.X, a.first.Y) < std::tie(b.first.X, b.first.Y);
+            });
+
+        endpoints_.reserve(sorted.size());
+        positions_.resize(lines.size() * 2);
+        cell_of_endpoint_.resize(sorted.size());
+        for (const auto& [cell, endpoint] : sorted)
+        {
+            if (cells_.empty() || cells_.back().location_ != cell)
+            {
+                cells_.push_back(Cell{ cell, endpoints_.size(), endpoints_.size(), endpoints_.size() });
+            }
+            positions_[endpoint.line_idx_ * 2 + endpoint.is_end_] = endpoints_.size();
+            cell_of_endpoint_[endpoints_.size()] = cells_.size() - 1;
+            endpoints_.push_back(endpoint);
+            cells_.back().live_end_++;
+            cells_.back().end_++;
+        }
+    }
+
+    /*!
+     * Remove both end points of a polyline, so that they are no longer found by \ref processNearby.
+     */
+    void remove(const size_t line_idx)
+    {
+        for (const size_t endpoint_idx : { line_idx * 2, line_idx * 2 + 1 })
+        {
+            const size_t pos = positions_[endpoint_idx];
+            Cell& cell = cells_[cell_of_endpoint_[pos]];
+            assert(pos >= cell.begin_ && pos < cell.live_end_);
+            const size_t last = --cell.live_end_;
+            std::swap(endpoints_[pos], endpoints_[last]);
+            positions_[endpoints_[pos].line_idx_ * 2 + endpoints_[pos].is_end_] = pos;
+            positions_[endpoint_idx] = last;
+        }
+    }
+
+    /*!
+     * Process the remaining end points in the grid cells within \p radius of \p query, until \p process_func returns false.
+     * \return Whether all of them were processed, i.e. \p process_func never returned false.
+     */
+    template<typename F>
+    bool processNearby(const Point2LL& query, const coord_t radius, F&& process_func) const
+    {
+        return processCellsNearby(
+            query,
+            radius,
+            [&](const Cell& cell)
+            {
+                return processRange(cell.begin_, cell.live_end_, process_func);
+            });
+    }
+
+    /*!
+     * Process the end points that have been removed from the grid cells within \p radius of \p query, until \p process_func returns false.
+     * \return Whether all of them were processed, i.e. \p process_func never returned false.
+     */
+    template<typename F>
+    bool processRemovedNearby(const Point2LL& query, const coord_t radius, F&& process_func) const
+    {
+        return processCellsNearby(
+            query,
+            radius,
+            [&](const Cell& cell)
+            {
+                return processRange(cell.live_end_, cell.end_, process_func);
+            });
+    }
+
+private:
+    struct Cell
+    {
+        SquareGrid::GridPoint location_;
+        size_t begin_;
+        size_t live_end_; //!< The end points from here to \ref end_ have been removed.
+        size_t end_;
+    };
+
+    template<typename F>
+    bool processCellsNearby(const Point2LL& query, const coord_t radius, F&& process_cell) const
+    {
+        const SquareGrid::GridPoint min_cell = grid_.toGridPoint(query - Point2LL(radius, radius));
+        const SquareGrid::GridPoint max_cell = grid_.toGridPoint(query + Point2LL(radius, radius));
+        for (coord_t x = min_cell.X; x <= max_cell.X; x++)
+        {
+            auto cell = std::lower_bound(
+                cells_.begin(),
+                cells_.end(),
+                SquareGrid::GridPoint(x, min_cell.Y),
+                [](const Cell& lhs, const SquareGrid::GridPoint& location)
+                {
+                    return std::tie(lhs.location_.X, lhs.location_.Y) < std::tie(location.X, location.Y);
+                });
+            for (; cell != cells_.end() && cell->location_.X == x && cell->location_.Y <= max_cell.Y; ++cell)
+            {
+                if (! process_cell(*cell))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename F>
+    bool processRange(const size_t begin, const size_t end, F& process_func) const
+    {
+        for (size_t pos = begin; pos < end; pos++)
+        {
+            if (! process_func(endpoints_[pos]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    SquareGrid grid_;
+    std::vector<Endpoint> endpoints_;
+    std::vector<Cell> cells_; //!< Sorted by location, only containing cells with end points.
+    std::vector<size_t> positions_; //!< For the start and end point of each line, where it is in \ref endpoints_.
+    std::vector<size_t> cell_of_endpoint_; //!< For each position in \ref endpoints_, the index of the cell it belongs to.
+};
+
+} // namespace
+
 template<typename InputPaths, typename OutputPaths, typename Path, typename Junction>
 void PolylineStitcher<InputPaths, OutputPaths, Path, Junction>::stitch(
     const InputPaths& lines,
@@ -105,15 +283,7 @@ void PolylineStitcher<InputPaths, OutputPaths, Path, Junction>::stitch(
         return;
     }
 
-    SparsePointGrid<PathsPointIndex<InputPaths>, PathsPointIndexLocator<InputPaths>> grid(max_stitch_distance, lines.size() * 2);
-
-    // populate grid
-    for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
-    {
-        const auto line = lines[line_idx];
-        grid.insert(PathsPointIndex<InputPaths>(&lines, line_idx, 0));
-        grid.insert(PathsPointIndex<InputPaths>(&lines, line_idx, line.size() - 1));
-    }
+    EndpointGrid grid(lines, max_stitch_distance);
 
     std::vector<bool> processed(lines.size(), false);
 
@@ -124,93 +294,114 @@ void PolylineStitcher<InputPaths, OutputPaths, Path, Junction>::stitch(
             continue;
         }
         processed[line_idx] = true;
-        const auto line = lines[line_idx];
+        const Path& line = lines[line_idx];
+        if (line.empty())
+        {
+            result_lines.emplace_back(line);
+            continue;
+        }
+        grid.remove(line_idx);
         bool should_close = isOdd(line);
 
+        // The chain is first extended at its end, and then at its start. Rather than reversing the chain to extend it at the start, the
+        // points added there are gathered separately, in the order in which they are added, and the chain is put together once at the end.
+        // The resulting direction is the same as if the chain was reversed.
         Path chain = line;
+        std::vector<Junction> chain_start;
+        coord_t chain_length = chain.length();
+        size_t chain_size = chain.size();
         bool closest_is_closing_polygon = false;
-        for (bool go_in_reverse_direction : { false, true }) // first go in the unreversed direction, to try to prevent the chain.reverse() operation.
-        { // NOTE: Implementation only works for this order; we currently only re-reverse the chain when it's closed.
+        bool went_in_reverse_direction = false;
+
+        // The end point of a line which is at the front of the chain, as seen in the current direction. An end point close to it closes the chain.
+        PathsPointIndex<InputPaths> chain_front(&lines, line_idx, 0);
+        // The end point of a line which is at the back of the chain, as seen in the forward direction.
+        PathsPointIndex<InputPaths> chain_back(&lines, line_idx, line.size() - 1);
+        for (bool go_in_reverse_direction : { false, true }) // first go in the unreversed direction, to try to prevent reversing the chain.
+        {
             if (go_in_reverse_direction)
             { // try extending chain in the other direction
-                chain.reverse();
+                went_in_reverse_direction = true;
+                chain_front = chain_back;
             }
-            coord_t chain_length = chain.length();
+            const Point2LL front = chain_front.p();
 
             while (true)
             {
-                Point2LL from = make_point(chain.back());
+                const Point2LL from = make_point(go_in_reverse_direction ? (chain_start.empty() ? chain.front() : chain_start.back()) : chain.back());
 
                 PathsPointIndex<InputPaths> closest;
                 coord_t closest_distance = std::numeric_limits<coord_t>::max();
-                grid.processNearby(
-                    from,
-                    max_stitch_distance,
-                    std::function<bool(const PathsPointIndex<InputPaths>&)>(
-                        [from,
-                         &chain,
-                         &closest,
-                         &closest_is_closing_polygon,
-                         &closest_distance,
-                         &processed,
-                         &chain_length,
-                         go_in_reverse_direction,
-                         max_stitch_distance,
-                         snap_distance,
-                         should_close](const PathsPointIndex<InputPaths>& nearby) -> bool
+                const auto process_nearby = [&](const Point2LL& nearby_p, const PathsPointIndex<InputPaths>& nearby) -> bool
+                {
+                    bool is_closing_segment = false;
+                    coord_t dist = vSize(nearby_p - from);
+                    if (dist > max_stitch_distance)
+                    {
+                        return true; // keep looking
+                    }
+                    if (vSize2(nearby_p - front) < snap_distance * snap_distance)
+                    {
+                        if (chain_length + dist < 3 * max_stitch_distance // prevent closing of small poly, cause it might be able to continue making a larger polyline
+                            || chain_size <= 2) // don't make 2 vert polygons
+                        {
+                            return true; // look for a better next line
+                        }
+                        is_closing_segment = true;
+                        if (! should_close)
                         {
-                            bool is_closing_segment = false;
-                            coord_t dist = vSize(nearby.p() - from);
-                            if (dist > max_stitch_distance)
-                            {
-                                return true; // keep looking
-                            }
-                            if (vSize2(nearby.p() - make_point(chain.front())) < snap_distance * snap_distance)
-                            {
-                                if (chain_length + dist < 3 * max_stitch_distance // prevent closing of small poly, cause it might be able to continue making a larger polyline
-                                    || chain.size() <= 2) // don't make 2 vert polygons
-                                {
-                                    return true; // look for a better next line
-                                }
-                                is_closing_segment = true;
-                                if (! should_close)
-                                {
-                                    dist += 10; // prefer continuing polyline over closing a polygon; avoids closed zigzags from being printed separately
-                                    // continue to see if closing segment is also the closest
-                                    // there might be a segment smaller than [max_stitch_distance] which closes the polygon better
-                                }
-                                else
-                                {
-                                    dist -= 10; // Prefer closing the polygon if it's 100% even lines. Used to create closed contours.
-                                    // Continue to see if closing segment is also the closest.
-                                }
-                            }
-                            else if (processed[nearby.poly_idx_])
-                            { // it was already moved to output
-                                return true; // keep looking for a connection
-                            }
-                            bool nearby_would_be_reversed = nearby.point_idx_ != 0;
-                            nearby_would_be_reversed = nearby_would_be_reversed != go_in_reverse_direction; // flip nearby_would_be_reversed when searching in the reverse direction
-                            if (! canReverse(nearby) && nearby_would_be_reversed)
-                            { // connecting the segment would reverse the polygon direction
-                                return true; // keep looking for a connection
-                            }
-                            if (! canConnect(chain, (*nearby.polygons_)[nearby.poly_idx_]))
-                            {
-                                return true; // keep looking for a connection
-                            }
-                            if (dist < closest_distance)
-                            {
-                                closest_distance = dist;
-                                closest = nearby;
-                                closest_is_closing_polygon = is_closing_segment;
-                            }
-                            if (dist < snap_distance)
-                            { // we have found a good enough next line
-                                return false; // stop looking for alternatives
-                            }
-                            return true; // keep processing elements
-                        }));
+                            dist += 10; // prefer continuing polyline over closing a polygon; avoids closed zigzags from being printed separately
+                            // continue to see if closing segment is also the closest
+                            // there might be a segment smaller than [max_stitch_distance] which closes the polygon better
+                        }
+                        else
+                        {
+                            dist -= 10; // Prefer closing the polygon if it's 100% even lines. Used to create closed contours.
+                            // Continue to see if closing segment is also the closest.
+                        }
+                    }
+                    else if (processed[nearby.poly_idx_])
+                    { // it was already moved to output
+                        return true; // keep looking for a connection
+                    }
+                    bool nearby_would_be_reversed = nearby.point_idx_ != 0;
+                    nearby_would_be_reversed = nearby_would_be_reversed != go_in_reverse_direction; // flip nearby_would_be_reversed when searching in the reverse direction
+                    if (! canReverse(nearby) && nearby_would_be_reversed)
+                    { // connecting the segment would reverse the polygon direction
+                        return true; // keep looking for a connection
+                    }
+                    if (! canConnect(chain, lines[nearby.poly_idx_]))
+                    {
+                        return true; // keep looking for a connection
+                    }
+                    if (dist < closest_distance)
+                    {
+                        closest_distance = dist;
+                        closest = nearby;
+                        closest_is_closing_polygon = is_closing_segment;
+                    }
+                    if (dist < snap_distance)
+                    { // we have found a good enough next line
+                        return false; // stop looking for alternatives
+                    }
+                    return true; // keep processing elements
+                };
+
+                const auto process_endpoint = [&](const EndpointGrid::Endpoint& nearby)
+                {
+                    return process_nearby(nearby.p_, PathsPointIndex<InputPaths>(&lines, nearby.line_idx_, nearby.is_end_ ? lines[nearby.line_idx_].size() - 1 : 0));
+                };
+                // The end points of lines that have been processed already, like the front of the chain itself, are no longer in the live grid.
+                // Those close to the front can still close the chain, but they can only be in reach if the front is nearly in reach.
+                bool keep_looking = true;
+                if (vSize2(front - from) <= (max_stitch_distance + snap_distance) * (max_stitch_distance + snap_distance))
+                {
+                    keep_looking = grid.processRemovedNearby(front, snap_distance, process_endpoint);
+                }
+                if (keep_looking)
+                {
+                    grid.processNearby(from, max_stitch_distance, process_endpoint);
+                }
 
                 if (! closest.initialized() // we couldn't find any next line
                     || closest_is_closing_polygon // we closed the polygon
@@ -219,60 +410,75 @@ void PolylineStitcher<InputPaths, OutputPaths, Path, Junction>::stitch(
                     break;
                 }
 
-
-                coord_t segment_dist = vSize(make_point(chain.back()) - closest.p());
+                const Path& next_line = lines[closest.poly_idx_];
+                coord_t segment_dist = vSize(from - closest.p());
                 assert(segment_dist <= max_stitch_distance + 10);
-                const size_t old_size = chain.size();
-                if (closest.point_idx_ == 0)
+                const auto append = [&](auto& points, auto start_pos, const auto end_pos)
                 {
-                    auto start_pos = (*closest.polygons_)[closest.poly_idx_].begin();
                     if (segment_dist < snap_distance)
                     {
                         ++start_pos;
                     }
-                    chain.insert(chain.end(), start_pos, (*closest.polygons_)[closest.poly_idx_].end());
-                }
-                else
+                    Point2LL previous = from;
+                    for (auto it = start_pos; it != end_pos; ++it) // Update chain length.
+                    {
+                        chain_length += vSize(make_point(*it) - previous);
+                        previous = make_point(*it);
+                        chain_size++;
+                    }
+                    points.insert(points.end(), start_pos, end_pos);
+                };
+                const auto append_line = [&](auto& points)
                 {
-                    auto start_pos = (*closest.polygons_)[closest.poly_idx_].rbegin();
-                    if (segment_dist < snap_distance)
+                    if (closest.point_idx_ == 0)
                     {
-                        ++start_pos;
+                        append(points, next_line.begin(), next_line.end());
+                    }
+                    else
+                    {
+                        append(points, next_line.rbegin(), next_line.rend());
                     }
-                    chain.insert(chain.end(), start_pos, (*closest.polygons_)[closest.poly_idx_].rend());
+                };
+                if (go_in_reverse_direction)
+                {
+                    append_line(chain_start);
                 }
-                for (size_t i = old_size; i < chain.size(); ++i) // Update chain length.
+                else
                 {
-                    chain_length += vSize(chain[i] - chain[i - 1]);
+                    append_line(chain);
+                    chain_back = PathsPointIndex<InputPaths>(&lines, closest.poly_idx_, closest.point_idx_ == 0 ? next_line.size() - 1 : 0);
                 }
-                should_close = should_close & ! isOdd((*closest.polygons_)[closest.poly_idx_]); // If we connect an even to an odd line, we should no longer try to close it.
+                should_close = should_close & ! isOdd(next_line); // If we connect an even to an odd line, we should no longer try to close it.
                 assert(! processed[closest.poly_idx_]);
                 processed[closest.poly_idx_] = true;
+                grid.remove(closest.poly_idx_);
             }
 
             if (closest_is_closing_polygon)
             {
-                if (go_in_reverse_direction)
-                { // re-reverse chain to retain original direction
-                    // NOTE: not sure if this code could ever be reached, since if a polygon can be closed that should be already possible in the forward direction
-                    chain.reverse();
-                }
-
                 break; // don't consider reverse direction
             }
         }
+
+        // Put the chain together in the direction that it would have if it was reversed to go in the reverse direction, and re-reversed to
+        // retain the original direction if it was closed or if the polyline isn't allowed to be reversed.
+        const bool keep_reversed = went_in_reverse_direction && ! closest_is_closing_polygon && canReverse(PathsPointIndex<InputPaths>(&lines, line_idx, 0));
+        if (keep_reversed)
+        {
+            chain.reverse();
+            chain.insert(chain.end(), chain_start.begin(), chain_start.end());
+        }
+        else if (! chain_start.empty())
+        {
+            chain.insert(chain.begin(), chain_start.rbegin(), chain_start.rend());
+        }
+
         if (closest_is_closing_polygon)
         {
             pushToClosedResult(result_polygons, chain);
         }
         else
         {
-            PathsPointIndex<InputPaths> ppi_here(&lines, line_idx, 0);
-            if (! canReverse(ppi_here))
-            { // Since closest_is_closing_polygon is false we went through the second iterations of the for-loop, where go_in_reverse_direction is true
-                // the polyline isn't allowed to be reversed, so we re-reverse it.
-                chain.reverse();
-            }
             result_lines.emplace_back(chain);
         }
     }
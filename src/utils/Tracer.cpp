@@ -0,0 +1,234 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "utils/Tracer.h"
+
+#include <cstdio>
+#include <fstream>
+
+#if defined(__linux__)
+#include <unistd.h> // sysconf
+#endif
+
+#include <fmt/format.h>
+#include <spdlog/details/os.h>
+#include <spdlog/spdlog.h>
+
+#include "utils/format/filesystem_path.h"
+
+namespace cura
+{
+
+namespace
+{
+
+/*!
+ * Write the given string in the output as a JSON string literal
+ */
+void writeJsonString(std::string& output, std::string_view value)
+{
+    output.push_back('"');
+    for (const char character : value)
+    {
+        switch (character)
+        {
+        case '"':
+            output += "\\\"";
+            break;
+        case '\\':
+            output += "\\\\";
+            break;
+        case '\n':
+            output += "\\n";
+            break;
+        default:
+            output.push_back(character);
+        }
+    }
+    output.push_back('"');
+}
+
+} // namespace
+
+Tracer& Tracer::getInstance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::enable(const std::filesystem::path& output_file)
+{
+    std::lock_guard lock(buffers_mutex_);
+    output_file_ = output_file;
+    origin_ = std::chrono::steady_clock::now();
+    main_thread_id_ = std::this_thread::get_id();
+    enabled_.store(true, std::memory_order_relaxed);
+    spdlog::info("Recording trace to {}", output_file_);
+}
+
+void Tracer::enableFromEnvironment()
+{
+    if (const auto trace_file = spdlog::details::os::getenv("CURAENGINE_TRACE_FILE"); ! trace_file.empty())
+    {
+        enable(trace_file);
+    }
+}
+
+int64_t Tracer::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin_).count();
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer()
+{
+    // The buffers are owned by the tracer, so that events recorded by threads that have been stopped since are still written
+    thread_local ThreadBuffer* thread_buffer = nullptr;
+    if (thread_buffer == nullptr)
+    {
+        std::lock_guard lock(buffers_mutex_);
+        const bool is_main_thread = std::this_thread::get_id() == main_thread_id_;
+        buffers_.push_back(std::make_unique<ThreadBuffer>(ThreadBuffer{ buffers_.size(), is_main_thread, {} }));
+        thread_buffer = buffers_.back().get();
+    }
+    return *thread_buffer;
+}
+
+void Tracer::addSpan(std::string_view category, std::string name, int64_t start_us, int64_t duration_us, std::optional<int64_t> layer_nr, std::optional<size_t> mesh_idx)
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    getThreadBuffer().events.push_back(Event{ 'X', category, std::move(name), start_us, duration_us, layer_nr, mesh_idx, 0.0 });
+}
+
+void Tracer::addCounter(std::string_view name, double value, std::optional<int64_t> layer_nr)
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    getThreadBuffer().events.push_back(Event{ 'C', "counter", std::string(name), now(), 0, layer_nr, std::nullopt, value });
+}
+
+void Tracer::addMemoryCounter()
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    if (const std::optional<size_t> rss = currentResidentSetSize(); rss.has_value())
+    {
+        addCounter("rss_mb", static_cast<double>(*rss) / (1024.0 * 1024.0));
+    }
+}
+
+void Tracer::flush()
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard lock(buffers_mutex_);
+
+    std::string output;
+    output += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first_event = true;
+    auto begin_event = [&output, &first_event]()
+    {
+        if (! first_event)
+        {
+            output += ",\n";
+        }
+        first_event = false;
+    };
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_)
+    {
+        begin_event();
+        output += fmt::format(R"({{"ph":"M","name":"thread_name","pid":1,"tid":{},"args":{{"name":)", buffer->thread_index);
+        writeJsonString(output, buffer->is_main_thread ? std::string("main") : fmt::format("worker {}", buffer->thread_index));
+        output += "}}";
+
+        for (const Event& event : buffer->events)
+        {
+            begin_event();
+            output += fmt::format(R"({{"ph":"{}","pid":1,"tid":{},"ts":{},"cat":)", event.phase, buffer->thread_index, event.timestamp_us);
+            writeJsonString(output, event.category);
+            output += ",\"name\":";
+            writeJsonString(output, event.name);
+            if (event.phase == 'X')
+            {
+                output += fmt::format(",\"dur\":{}", event.duration_us);
+            }
+            output += ",\"args\":{";
+            bool first_arg = true;
+            auto write_arg = [&output, &first_arg](std::string_view key, const auto& value)
+            {
+                output += fmt::format("{}\"{}\":{}", first_arg ? "" : ",", key, value);
+                first_arg = false;
+            };
+            if (event.phase == 'C')
+            {
+                write_arg("value", event.value);
+            }
+            if (event.layer_nr.has_value())
+            {
+                write_arg("layer", *event.layer_nr);
+            }
+            if (event.mesh_idx.has_value())
+            {
+                write_arg("mesh", *event.mesh_idx);
+            }
+            output += "}}";
+        }
+        buffer->events.clear();
+    }
+    output += "\n]}\n";
+
+    std::ofstream file(output_file_, std::ios::binary | std::ios::trunc);
+    if (! file.is_open())
+    {
+        spdlog::error("Unable to write trace file {}", output_file_);
+        return;
+    }
+    file.write(output.data(), static_cast<std::streamsize>(output.size()));
+    spdlog::info("Trace written to {}", output_file_);
+}
+
+std::vector<Tracer::ThreadEvents> Tracer::getEvents()
+{
+    std::lock_guard lock(buffers_mutex_);
+    std::vector<ThreadEvents> events;
+    events.reserve(buffers_.size());
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_)
+    {
+        events.push_back(ThreadEvents{ buffer->thread_index, buffer->is_main_thread, buffer->events });
+    }
+    return events;
+}
+
+std::optional<size_t> Tracer::currentResidentSetSize()
+{
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+    {
+        return std::nullopt;
+    }
+    unsigned long total_pages = 0;
+    unsigned long resident_pages = 0;
+    const int read_values = std::fscanf(statm, "%lu %lu", &total_pages, &resident_pages);
+    std::fclose(statm);
+    if (read_values != 2)
+    {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(resident_pages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return std::nullopt;
+#endif
+}
+
+} // namespace cura
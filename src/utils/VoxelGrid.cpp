@@ -3,11 +3,15 @@
 
 #include "utils/VoxelGrid.h"
 
+#include <cassert>
+#include <memory>
+
 #include <range/v3/algorithm/max.hpp>
 #include <range/v3/algorithm/min.hpp>
 
 #include "utils/AABB3D.h"
 #include "utils/ParameterizedSegment.h"
+#include "utils/math.h"
 
 
 namespace cura
@@ -26,85 +30,139 @@ VoxelGrid::VoxelGrid(const AABB3D& bounding_box, const coord_t max_resolution)
     set_resolution(slices_count_.x_, resolution_.x_, bounding_box.spanX());
     set_resolution(slices_count_.y_, resolution_.y_, bounding_box.spanY());
     set_resolution(slices_count_.z_, resolution_.z_, bounding_box.spanZ());
+
+    bricks_count_ = Point3LL(
+        round_up_divide(slices_count_.x_, brick_side),
+        round_up_divide(slices_count_.y_, brick_side),
+        round_up_divide(slices_count_.z_, brick_side));
+    bricks_ = std::vector<std::atomic<Brick*>>(bricks_count_.x_ * bricks_count_.y_ * bricks_count_.z_);
 }
 
-Point3D VoxelGrid::toGlobalCoordinates(const LocalCoordinates& position, const bool at_center) const
+VoxelGrid::~VoxelGrid()
 {
-    return Point3D(toGlobalX(position.position.x, at_center), toGlobalY(position.position.y, at_center), toGlobalZ(position.position.z, at_center));
+    for (std::atomic<Brick*>& brick : bricks_)
+    {
+        delete brick.load();
+    }
 }
 
-void VoxelGrid::setOccupation(const LocalCoordinates& position, const uint8_t extruder_nr)
+Point3D VoxelGrid::toGlobalCoordinates(const LocalCoordinates& position, const bool at_center) const
 {
-    occupied_voxels_.insert_or_assign(position, extruder_nr);
+    return Point3D(toGlobalX(position.position.x, at_center), toGlobalY(position.position.y, at_center), toGlobalZ(position.position.z, at_center));
 }
 
-void VoxelGrid::setOrUpdateOccupation(const LocalCoordinates& position, const uint8_t extruder_nr)
+const std::atomic<uint8_t>* VoxelGrid::findVoxel(const LocalCoordinates& position) const
 {
-    occupied_voxels_.insert_or_visit(
-        { position, extruder_nr },
-        [extruder_nr](auto& voxel)
-        {
-            voxel.second = std::min(voxel.second, extruder_nr);
-        });
+    if (! isInGrid(position.position))
+    {
+        return nullptr;
+    }
+
+    const Brick* brick = bricks_[getBrickIndex(position.position)].load(std::memory_order_acquire);
+    return brick == nullptr ? nullptr : &brick->voxels[getIndexInBrick(position.position)];
 }
 
-std::optional<uint8_t> VoxelGrid::getOccupation(const LocalCoordinates& local_position) const
+std::atomic<uint8_t>& VoxelGrid::getOrCreateVoxel(const LocalCoordinates& position)
 {
-    std::optional<uint8_t> result = std::nullopt;
-    occupied_voxels_.cvisit(
-        local_position,
-        [&result](const auto& occupation)
+    assert(isInGrid(position.position));
+    std::atomic<Brick*>& brick_slot = bricks_[getBrickIndex(position.position)];
+    Brick* brick = brick_slot.load(std::memory_order_acquire);
+    if (brick == nullptr)
+    {
+        // Several threads may allocate the same brick at once, only the first one to register it wins
+        auto new_brick = std::make_unique<Brick>();
+        if (brick_slot.compare_exchange_strong(brick, new_brick.get(), std::memory_order_acq_rel, std::memory_order_acquire))
         {
-            result = occupation.second;
-        });
-    return result;
+            brick = new_brick.release();
+        }
+    }
+    return brick->voxels[getIndexInBrick(position.position)];
 }
 
-size_t VoxelGrid::occupiedCount() const
+void VoxelGrid::setOccupation(const LocalCoordinates& position, const uint8_t extruder_nr)
 {
-    return occupied_voxels_.size();
+    if (! isInGrid(position.position))
+    {
+        return;
+    }
+
+    if (getOrCreateVoxel(position).exchange(static_cast<uint8_t>(extruder_nr + 1), std::memory_order_relaxed) == empty_voxel)
+    {
+        occupied_count_.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-std::vector<VoxelGrid::LocalCoordinates> VoxelGrid::getVoxelsAround(const LocalCoordinates& point) const
+void VoxelGrid::setOrUpdateOccupation(const LocalCoordinates& position, const uint8_t extruder_nr)
 {
-    const Point3U16& position = point.position;
-    std::vector<LocalCoordinates> voxels_around;
-    static constexpr uint8_t nb_voxels_around = 3 * 3 * 3 - 1;
-    voxels_around.reserve(nb_voxels_around);
+    if (! isInGrid(position.position))
+    {
+        return;
+    }
 
-    for (int8_t delta_x = -1; delta_x < 2; ++delta_x)
+    std::atomic<uint8_t>& voxel = getOrCreateVoxel(position);
+    uint8_t value = voxel.load(std::memory_order_relaxed);
+    while (true)
     {
-        const int64_t pos_x = position.x + delta_x;
-        if (pos_x < 0 || pos_x >= slices_count_.x_)
+        const auto stored_value = static_cast<uint8_t>(extruder_nr + 1);
+        const bool is_occupied = value != empty_voxel && value != reserved_voxel;
+        const uint8_t new_value = is_occupied ? std::min(value, stored_value) : stored_value;
+        if (new_value == value)
         {
-            continue;
+            return;
         }
-
-        for (int8_t delta_y = -1; delta_y < 2; ++delta_y)
+        if (voxel.compare_exchange_weak(value, new_value, std::memory_order_relaxed))
         {
-            const int64_t pos_y = position.y + delta_y;
-            if (pos_y < 0 || pos_y >= slices_count_.y_)
+            if (value == empty_voxel)
             {
-                continue;
+                occupied_count_.fetch_add(1, std::memory_order_relaxed);
             }
+            return;
+        }
+    }
+}
 
-            for (int8_t delta_z = -1; delta_z < 2; ++delta_z)
-            {
-                const int64_t pos_z = position.z + delta_z;
-                if (pos_z < 0 || pos_z >= slices_count_.z_)
-                {
-                    continue;
-                }
+bool VoxelGrid::reserve(const LocalCoordinates& position)
+{
+    if (! isInGrid(position.position))
+    {
+        return false;
+    }
 
-                if (delta_x || delta_y || delta_z)
-                {
-                    voxels_around.push_back(LocalCoordinates(pos_x, pos_y, pos_z));
-                }
-            }
-        }
+    const std::atomic<uint8_t>* existing_voxel = findVoxel(position);
+    if (existing_voxel != nullptr && existing_voxel->load(std::memory_order_relaxed) != empty_voxel)
+    {
+        // Cheap early-out, without writing anything
+        return false;
     }
 
-    return voxels_around;
+    uint8_t expected = empty_voxel;
+    if (getOrCreateVoxel(position).compare_exchange_strong(expected, reserved_voxel, std::memory_order_relaxed))
+    {
+        occupied_count_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+std::optional<uint8_t> VoxelGrid::getOccupation(const LocalCoordinates& local_position) const
+{
+    const std::atomic<uint8_t>* voxel = findVoxel(local_position);
+    if (voxel == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    const uint8_t value = voxel->load(std::memory_order_relaxed);
+    if (value == empty_voxel || value == reserved_voxel)
+    {
+        return std::nullopt;
+    }
+    return static_cast<uint8_t>(value - 1);
+}
+
+size_t VoxelGrid::occupiedCount() const
+{
+    return occupied_count_.load(std::memory_order_relaxed);
 }
 
 VoxelGrid::LocalCoordinates VoxelGrid::toLocalCoordinates(const Point3D& position) const
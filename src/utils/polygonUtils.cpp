@@ -13,6 +13,7 @@
 
 #include "geometry/OpenPolyline.h"
 #include "geometry/PointMatrix.h"
+#include "geometry/PointsKernels.h"
 #include "geometry/SingleShape.h"
 #include "infill.h"
 #include "utils/SparsePointGridInclusive.h"
@@ -789,6 +790,12 @@ ClosestPointPolygon PolygonUtils::findClosest(Point2LL from, const Polygon& poly
     {
         return ClosestPointPolygon(&polygon);
     }
+    if (&penalty_function == &no_penalty_function)
+    {
+        // Without a penalty, only the distance counts, which the kernel can compute for several segments at once.
+        const auto [location, segment_idx] = kernels::closestOnPolygon(from, polygon.getPoints());
+        return ClosestPointPolygon(location, segment_idx, &polygon);
+    }
     Point2LL aPoint = polygon[0];
     Point2LL best = aPoint;
 
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "BeadingStrategy/FlattenedBeadingStrategy.h" //Unit under test.
+
+#include <numbers>
+
+#include <gtest/gtest.h>
+
+#include "BeadingStrategy/BeadingStrategyFactory.h" //To make the stack of strategies to compare with.
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Settings that make the stack of beading strategies take all its different paths.
+ */
+struct BeadingStrategyParameters
+{
+    coord_t preferred_bead_width_outer;
+    coord_t preferred_bead_width_inner;
+    bool print_thin_walls;
+    Ratio wall_split_middle_threshold;
+    Ratio wall_add_middle_threshold;
+    coord_t max_bead_count;
+    coord_t outer_wall_offset;
+    int inward_distributed_center_wall_count;
+};
+
+class FlattenedBeadingStrategyTest : public testing::TestWithParam<BeadingStrategyParameters>
+{
+public:
+    BeadingStrategyPtr make(const bool flattened) const
+    {
+        const BeadingStrategyParameters& parameters = GetParam();
+        const auto factory = flattened ? &BeadingStrategyFactory::makeStrategy : &BeadingStrategyFactory::makeStrategyStack;
+        return factory(
+            parameters.preferred_bead_width_outer,
+            parameters.preferred_bead_width_inner,
+            MM2INT(0.4),
+            std::numbers::pi / 6.0,
+            parameters.print_thin_walls,
+            MM2INT(0.2),
+            MM2INT(0.1),
+            parameters.wall_split_middle_threshold,
+            parameters.wall_add_middle_threshold,
+            parameters.max_bead_count,
+            parameters.outer_wall_offset,
+            parameters.inward_distributed_center_wall_count,
+            0.5_r);
+    }
+};
+
+TEST_P(FlattenedBeadingStrategyTest, SameAsStack)
+{
+    const BeadingStrategyPtr stack = make(false);
+    const BeadingStrategyPtr flattened = make(true);
+    const coord_t max_bead_count = GetParam().max_bead_count;
+
+    for (coord_t bead_count = 0; bead_count <= max_bead_count + 1; bead_count++)
+    {
+        EXPECT_EQ(flattened->getOptimalThickness(bead_count), stack->getOptimalThickness(bead_count)) << bead_count;
+        EXPECT_EQ(flattened->getTransitionThickness(bead_count), stack->getTransitionThickness(bead_count)) << bead_count;
+        EXPECT_EQ(flattened->getTransitioningLength(bead_count), stack->getTransitioningLength(bead_count)) << bead_count;
+        EXPECT_EQ(flattened->getTransitionAnchorPos(bead_count), stack->getTransitionAnchorPos(bead_count)) << bead_count;
+        EXPECT_EQ(flattened->getNonlinearThicknesses(bead_count), stack->getNonlinearThicknesses(bead_count)) << bead_count;
+    }
+
+    // Twice, to compare the memoized beadings too.
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        for (coord_t thickness = 0; thickness < MM2INT(8); thickness += 7)
+        {
+            const coord_t bead_count = stack->getOptimalBeadCount(thickness);
+            ASSERT_EQ(flattened->getOptimalBeadCount(thickness), bead_count) << thickness;
+
+            // The skeletal trapezoidation also computes the beadings of the neighbouring bead counts, to interpolate between them.
+            for (const coord_t computed_bead_count : { bead_count - 1, bead_count, bead_count + 1 })
+            {
+                if (computed_bead_count < 0 || computed_bead_count > max_bead_count + 1)
+                {
+                    continue;
+                }
+                const BeadingStrategy::Beading expected = stack->compute(thickness, computed_bead_count);
+                const BeadingStrategy::Beading beading = flattened->compute(thickness, computed_bead_count);
+                EXPECT_EQ(beading.total_thickness, expected.total_thickness) << thickness << " " << computed_bead_count;
+                EXPECT_EQ(beading.bead_widths, expected.bead_widths) << thickness << " " << computed_bead_count;
+                EXPECT_EQ(beading.toolpath_locations, expected.toolpath_locations) << thickness << " " << computed_bead_count;
+                if (! expected.bead_widths.empty() && thickness >= GetParam().preferred_bead_width_inner)
+                {
+                    // The widening strategy doesn't set how much is left over for its single wall in thin parts.
+                    EXPECT_EQ(beading.left_over, expected.left_over) << thickness << " " << computed_bead_count;
+                }
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FlattenedBeadingStrategyTestInstantiation,
+    FlattenedBeadingStrategyTest,
+    testing::Values(
+        BeadingStrategyParameters{ MM2INT(0.4), MM2INT(0.4), false, 0.5_r, 0.5_r, 2, 0, 2 },
+        BeadingStrategyParameters{ MM2INT(0.4), MM2INT(0.4), true, 0.5_r, 0.5_r, 2, 0, 2 },
+        BeadingStrategyParameters{ MM2INT(0.35), MM2INT(0.45), true, 0.3_r, 0.75_r, 4, MM2INT(0.05), 2 },
+        BeadingStrategyParameters{ MM2INT(0.35), MM2INT(0.45), false, 0.3_r, 0.75_r, 6, MM2INT(0.05), 1 },
+        BeadingStrategyParameters{ MM2INT(0.5), MM2INT(0.4), true, 0.9_r, 0.1_r, 10, 0, 4 },
+        BeadingStrategyParameters{ MM2INT(0.4), MM2INT(0.6), true, 0.5_r, 0.5_r, 20, MM2INT(0.3), 0 },
+        BeadingStrategyParameters{ MM2INT(0.4), MM2INT(0.4), false, 0.5_r, 0.5_r, 3, MM2INT(0.1), 2 }));
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
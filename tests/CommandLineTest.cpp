@@ -0,0 +1,95 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "communication/CommandLine.h" // The class under test.
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*
+ * Tests reading the job manifest of a batch of command line slices.
+ */
+class CommandLineTest : public testing::Test
+{
+public:
+    std::filesystem::path manifest_filename_;
+
+    void SetUp() override
+    {
+        manifest_filename_ = std::filesystem::temp_directory_path() / "CommandLineTest_manifest.txt";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(manifest_filename_);
+    }
+
+    void writeManifest(const std::string& contents) const
+    {
+        std::ofstream file(manifest_filename_);
+        file << contents;
+    }
+};
+
+TEST_F(CommandLineTest, ReadJobManifest)
+{
+    writeManifest(
+        "# Two jobs.\n"
+        "-j printer.def.json -l model.stl -o model.gcode\n"
+        "\n"
+        "   \t\n"
+        "  -s \"machine_start_gcode=G28 X Y\" -l \"my model.stl\" -s machine_end_gcode=\"\" -o out.gcode\n");
+
+    const auto jobs = CommandLine::readJobManifest(manifest_filename_, "CuraEngine");
+    ASSERT_TRUE(jobs.has_value()) << "The manifest is valid.";
+    ASSERT_EQ(jobs->size(), 2) << "Empty lines and comments are no jobs.";
+
+    const std::vector<std::string> first{ "CuraEngine", "slice", "-j", "printer.def.json", "-l", "model.stl", "-o", "model.gcode" };
+    EXPECT_EQ((*jobs)[0], first) << "Every job gets the executable and the slice command in front of its arguments.";
+
+    const std::vector<std::string> second{ "CuraEngine", "slice", "-s", "machine_start_gcode=G28 X Y", "-l", "my model.stl", "-s", "machine_end_gcode=", "-o", "out.gcode" };
+    EXPECT_EQ((*jobs)[1], second) << "Quotes group whitespace into one argument and are left out of the argument itself.";
+}
+
+TEST_F(CommandLineTest, ReadJobManifestEmptyArgument)
+{
+    writeManifest("-s \"\" -o out.gcode\n");
+
+    const auto jobs = CommandLine::readJobManifest(manifest_filename_, "CuraEngine");
+    ASSERT_TRUE(jobs.has_value());
+    ASSERT_EQ(jobs->size(), 1);
+    const std::vector<std::string> expected{ "CuraEngine", "slice", "-s", "", "-o", "out.gcode" };
+    EXPECT_EQ(jobs->front(), expected) << "A pair of quotes without anything in between is an empty argument.";
+}
+
+TEST_F(CommandLineTest, ReadJobManifestNoJobs)
+{
+    writeManifest("# Only a comment.\n\n");
+
+    const auto jobs = CommandLine::readJobManifest(manifest_filename_, "CuraEngine");
+    ASSERT_TRUE(jobs.has_value()) << "A manifest without jobs can still be read.";
+    EXPECT_TRUE(jobs->empty());
+}
+
+TEST_F(CommandLineTest, ReadJobManifestMissingClosingQuote)
+{
+    writeManifest(
+        "-l model.stl -o model.gcode\n"
+        "-l \"my model.stl -o out.gcode\n");
+
+    EXPECT_FALSE(CommandLine::readJobManifest(manifest_filename_, "CuraEngine").has_value()) << "Don't slice anything from a manifest that is cut off halfway.";
+}
+
+TEST_F(CommandLineTest, ReadJobManifestMissingFile)
+{
+    EXPECT_FALSE(CommandLine::readJobManifest(manifest_filename_, "CuraEngine").has_value()) << "The manifest was never written.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
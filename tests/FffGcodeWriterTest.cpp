@@ -147,7 +147,7 @@ TEST_F(FffGcodeWriterTest, SurfaceGetsExtraInfillLinesUnderIt)
     GCodeExport gcode_export;
     std::ofstream output_file;
     output_file.open("test_result.gcode");
-    gcode_export.output_stream_ = &output_file;
+    gcode_export.setOutputStream(&output_file);
     gcode_layer.writeGCode(gcode_export);
     */
 
@@ -43,7 +43,7 @@ public:
     void SetUp() override
     {
         output << std::fixed;
-        gcode.output_stream_ = &output;
+        gcode.setOutputStream(&output);
 
         // Since GCodeExport doesn't support copying, we have to reset everything in-place.
         gcode.current_position_ = Point3LL(0, 0, MM2INT(20));
@@ -204,7 +204,7 @@ public:
     void SetUp() override
     {
         output << std::fixed;
-        gcode.output_stream_ = &output;
+        gcode.setOutputStream(&output);
 
         // Since GCodeExport doesn't support copying, we have to reset everything in-place.
         gcode.current_position_ = Point3LL(0, 0, MM2INT(20));
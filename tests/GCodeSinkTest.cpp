@@ -0,0 +1,72 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "GCodeSink.h" // The unit under test.
+
+#include <limits>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(GCodeSinkTest, SameAsFixedStream)
+{
+    BufferGCodeSink sink;
+    std::ostringstream stream;
+    stream << std::fixed;
+
+    const auto write_both = [&sink, &stream](const auto value)
+    {
+        sink << value;
+        stream << value;
+    };
+    write_both("G1 X");
+    write_both('a');
+    write_both(std::string(" string "));
+    write_both(0);
+    write_both(-1234567);
+    write_both(std::numeric_limits<int64_t>::min());
+    write_both(std::numeric_limits<size_t>::max());
+    write_both(0.0);
+    write_both(-0.0);
+    write_both(0.1234565);
+    write_both(-987654.3210987);
+    write_both(1e20);
+    write_both(LayerIndex(-5));
+    write_both(Duration(12.3456789));
+    write_both(MMtoStream{ -500 });
+    write_both(MMtoStream{ 1234567 });
+    write_both(PrecisionedDouble{ 5, 1.0 / 3.0 });
+    write_both(PrecisionedDouble{ 1, 200.0 });
+    write_both(PrecisionedDouble{ 0, 2.5 });
+
+    EXPECT_EQ(sink.take(), stream.str());
+}
+
+TEST(GCodeSinkTest, BufferTakesAll)
+{
+    BufferGCodeSink sink;
+    EXPECT_TRUE(sink.take().empty()) << "Nothing was written yet.";
+
+    sink << "G0 X" << MMtoStream{ 1500 } << "\n";
+    EXPECT_EQ(sink.take(), "G0 X1.5\n");
+    EXPECT_TRUE(sink.take().empty()) << "All g-code was taken already.";
+
+    sink << "G1 Z" << MMtoStream{ 200 } << "\n";
+    EXPECT_EQ(sink.take(), "G1 Z0.2\n") << "Taking the g-code must leave the sink usable.";
+}
+
+TEST(GCodeSinkTest, StreamWritesThrough)
+{
+    std::ostringstream stream;
+    StreamGCodeSink sink(&stream);
+
+    sink << "M104 S" << PrecisionedDouble{ 1, 210.0 };
+    EXPECT_EQ(stream.str(), "M104 S210") << "A stream sink must not hold back any g-code.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "SkirtBrim.h" // The class under test.
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To set up a slice with settings.
+#include "Slice.h" // To set up a scene with settings.
+#include "geometry/OpenPolyline.h"
+#include "geometry/Polygon.h" // To create the parts to generate a brim around.
+#include "sliceDataStorage.h" // To store the parts and the brim.
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Tests generating the brim around parts on the first layer.
+ */
+class SkirtBrimTest : public testing::Test
+{
+public:
+    Settings* settings;
+
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().current_slice_ = std::make_shared<Slice>(1);
+        settings = &Application::getInstance().current_slice_->scene.settings;
+
+        const auto path = std::filesystem::path(__FILE__).parent_path().append("test_default_settings.txt").string();
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const size_t pos = line.find('=');
+            settings->add(line.substr(0, pos), line.substr(pos + 1));
+        }
+        settings->add("adhesion_type", "brim");
+        settings->add("skirt_brim_extruder_nr", "0");
+        settings->add("brim_line_count", "5");
+        settings->add("brim_gap", "0");
+        settings->add("brim_location", "outside");
+        Application::getInstance().current_slice_->scene.extruders.emplace_back(0, settings);
+    }
+
+    /*!
+     * Create a square part on the first layer of the mesh.
+     */
+    static void addSquare(SliceMeshStorage& mesh, const coord_t x, const coord_t y, const coord_t size)
+    {
+        Shape square;
+        square.push_back(Polygon({ { x, y }, { x + size, y }, { x + size, y + size }, { x, y + size } }, false));
+        SliceLayerPart& part = mesh.layers[0].parts.emplace_back();
+        part.outline = SingleShape(Shape(square));
+        part.print_outline = square;
+        part.boundaryBox = AABB(square);
+    }
+
+    /*!
+     * Generate the brim around parts that are far apart, except for the first two, which are so close that their brims merge.
+     * \param generate_per_cluster Whether to generate the brim per cluster of parts, or for all parts at once.
+     * \return The brim lines, per inset.
+     */
+    std::vector<MixedLinesSet> generateBrim(const bool generate_per_cluster) const
+    {
+        SliceDataStorage storage;
+        storage.print_layer_count = 1;
+        storage.support.supportLayers.resize(1);
+
+        Mesh mesh(*settings);
+        auto mesh_storage = std::make_shared<SliceMeshStorage>(&mesh, 1);
+        addSquare(*mesh_storage, MM2INT(20), MM2INT(20), MM2INT(10));
+        addSquare(*mesh_storage, MM2INT(31), MM2INT(20), MM2INT(10));
+        addSquare(*mesh_storage, MM2INT(80), MM2INT(20), MM2INT(10));
+        addSquare(*mesh_storage, MM2INT(20), MM2INT(80), MM2INT(15));
+        addSquare(*mesh_storage, MM2INT(80), MM2INT(80), MM2INT(5));
+        storage.meshes.push_back(mesh_storage);
+
+        SkirtBrim skirt_brim(storage);
+        skirt_brim.generate_per_cluster_ = generate_per_cluster;
+        skirt_brim.generate();
+        return storage.skirt_brim[0];
+    }
+
+    /*!
+     * Get the points of each line, in an order that doesn't depend on where the lines start or on the order of the lines.
+     */
+    static std::vector<std::vector<Point2LL>> sortedLinePoints(const MixedLinesSet& lines)
+    {
+        std::vector<std::vector<Point2LL>> result;
+        for (const PolylinePtr& line : lines)
+        {
+            std::vector<Point2LL> points(line->begin(), line->end());
+            std::sort(points.begin(), points.end());
+            result.push_back(std::move(points));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(SkirtBrimTest, ClusteredSameAsGlobal)
+{
+    const std::vector<MixedLinesSet> clustered = generateBrim(true);
+    const std::vector<MixedLinesSet> global = generateBrim(false);
+
+    ASSERT_EQ(clustered.size(), global.size()) << "Both must generate the same number of brim lines around the parts.";
+    ASSERT_GE(clustered.size(), 5) << "Five brim lines were requested.";
+    for (size_t inset_idx = 0; inset_idx < global.size(); inset_idx++)
+    {
+        EXPECT_EQ(clustered[inset_idx].size(), global[inset_idx].size()) << "Inset " << inset_idx << " must have the same number of lines.";
+        EXPECT_NEAR(clustered[inset_idx].length(), global[inset_idx].length(), 10) << "Inset " << inset_idx << " must have the same length.";
+        // The lines of each cluster come after those of the clusters before it, so only their order may differ.
+        EXPECT_EQ(sortedLinePoints(clustered[inset_idx]), sortedLinePoints(global[inset_idx])) << "Inset " << inset_idx << " must have the same lines.";
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
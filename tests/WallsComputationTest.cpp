@@ -3,6 +3,10 @@
 
 #include "WallsComputation.h" //Unit under test.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
 #include <unordered_set>
 
 #include <range/v3/view/join.hpp>
@@ -11,11 +15,13 @@
 #include <gtest/gtest.h>
 
 #include "InsetOrderOptimizer.h" //Unit also under test.
+#include "WallToolPaths.h" //Unit also under test.
 #include "geometry/OpenPolyline.h"
 #include "geometry/Polygon.h" //To create example polygons.
 #include "settings/Settings.h" //Settings to generate walls with.
 #include "sliceDataStorage.h" //Sl
 #include "slicer.h"
+#include "utils/linearAlg2D.h" //To compare walls.
 
 #ifdef WALLS_COMPUTATION_TEST_SVG_OUTPUT
 #include <cstdlib>
@@ -97,6 +103,86 @@ public:
         settings.add("wall_x_extruder_nr", "0");
         settings.add("wall_distribution_count", "2");
     }
+
+    /*!
+     * Generate three walls of 0.4mm for an outline, with or without the walls
+     * outside of the thin regions generated as offsets.
+     * \return The walls, binned by inset index, and their inner contour.
+     */
+    std::pair<std::vector<VariableWidthLines>, Shape> generateWallToolPaths(const Shape& outline, const bool offset_fast_path) const
+    {
+        WallToolPaths wall_tool_paths(outline, MM2INT(0.4), MM2INT(0.4), 3, 0, settings, 100, SectionType::WALL);
+        wall_tool_paths.offset_fast_path_ = offset_fast_path;
+        std::vector<VariableWidthLines> walls = wall_tool_paths.generate();
+        return { std::move(walls), wall_tool_paths.getInnerContour() };
+    }
+
+    static Shape findThinRegions(const Shape& outline, const coord_t radius)
+    {
+        return WallToolPaths::findThinRegions(outline, radius, AngleRadians(10.0 * std::numbers::pi / 180.0));
+    }
+
+    /*!
+     * Check that the walls are the same as the expected walls, within the
+     * deviation that simplifying them allows. Their order and the number of
+     * junctions may differ.
+     */
+    static void expectSameWalls(const std::vector<VariableWidthLines>& walls, const std::vector<VariableWidthLines>& expected_walls)
+    {
+        constexpr coord_t allowed_deviation = MM2INT(0.1);
+        // The largest distance from a junction of the walls to the other walls of the same inset.
+        const auto max_distance = [](const VariableWidthLines& lines, const VariableWidthLines& others)
+        {
+            coord_t max_distance2 = 0;
+            for (const ExtrusionLine& line : lines)
+            {
+                for (const ExtrusionJunction& junction : line)
+                {
+                    coord_t closest_distance2 = std::numeric_limits<coord_t>::max();
+                    for (const ExtrusionLine& other : others)
+                    {
+                        for (size_t junction_idx = 0; junction_idx + 1 < other.size(); junction_idx++)
+                        {
+                            closest_distance2 = std::min(closest_distance2, LinearAlg2D::getDist2FromLineSegment(other[junction_idx].p_, junction.p_, other[junction_idx + 1].p_));
+                        }
+                    }
+                    max_distance2 = std::max(max_distance2, closest_distance2);
+                }
+            }
+            return std::sqrt(static_cast<double>(max_distance2));
+        };
+        // The volume of the walls per mm of layer height.
+        const auto extruded_area = [](const VariableWidthLines& lines)
+        {
+            double area = 0;
+            for (const ExtrusionLine& line : lines)
+            {
+                for (size_t junction_idx = 0; junction_idx + 1 < line.size(); junction_idx++)
+                {
+                    const ExtrusionJunction& from = line[junction_idx];
+                    const ExtrusionJunction& to = line[junction_idx + 1];
+                    area += vSizef(to.p_ - from.p_) * static_cast<double>(from.w_ + to.w_) / 2;
+                }
+            }
+            return area;
+        };
+
+        ASSERT_EQ(walls.size(), expected_walls.size()) << "There must be as many walls.";
+        for (size_t inset_idx = 0; inset_idx < walls.size(); inset_idx++)
+        {
+            const VariableWidthLines& lines = walls[inset_idx];
+            const VariableWidthLines& expected_lines = expected_walls[inset_idx];
+            const auto is_closed = [](const ExtrusionLine& line)
+            {
+                return line.is_closed_;
+            };
+            EXPECT_EQ(std::count_if(lines.begin(), lines.end(), is_closed), std::count_if(expected_lines.begin(), expected_lines.end(), is_closed))
+                << "The walls must be stitched into as many closed loops.";
+            EXPECT_LE(max_distance(lines, expected_lines), allowed_deviation) << "Wall " << inset_idx << " must not be anywhere the expected wall isn't.";
+            EXPECT_LE(max_distance(expected_lines, lines), allowed_deviation) << "Wall " << inset_idx << " must be everywhere the expected wall is.";
+            EXPECT_NEAR(extruded_area(lines), extruded_area(expected_lines), extruded_area(expected_lines) * 0.01) << "Wall " << inset_idx << " must extrude as much material.";
+        }
+    }
 };
 
 /*!
@@ -227,5 +313,93 @@ TEST_F(WallsComputationTest, WallToolPathsGetWeakOrder)
     EXPECT_EQ(has_order_info.size(), n_paths) << "Every path should have order information.";
 }
 
+/*!
+ * Tests that the walls of a part that is thick enough everywhere are the same as offsets as from the skeletal trapezoidation.
+ */
+TEST_F(WallsComputationTest, UniformWallsSameAsSkeletalTrapezoidation)
+{
+    Shape part_shape = square_shape;
+    Polygon& hole = part_shape.newLine();
+    for (size_t point_idx = 0; point_idx < 64; point_idx++)
+    {
+        const double angle = -2.0 * std::numbers::pi * static_cast<double>(point_idx) / 64.0;
+        hole.emplace_back(MM2INT(10) + static_cast<coord_t>(MM2INT(4) * std::cos(angle)), MM2INT(10) + static_cast<coord_t>(MM2INT(4) * std::sin(angle)));
+    }
+    EXPECT_TRUE(findThinRegions(part_shape, MM2INT(1.4)).empty()) << "Only the convex corners are thinner than the walls, and those are no thin regions.";
+
+    const auto [expected_walls, expected_inner_contour] = generateWallToolPaths(part_shape, false);
+    const auto [walls, inner_contour] = generateWallToolPaths(part_shape, true);
+
+    expectSameWalls(walls, expected_walls);
+    for (const ExtrusionLine& line : walls | ranges::views::join)
+    {
+        EXPECT_TRUE(line.is_closed_) << "Each wall must go around the outline or around the hole.";
+        for (const ExtrusionJunction& junction : line)
+        {
+            EXPECT_EQ(junction.w_, MM2INT(0.4)) << "The walls must have their nominal width everywhere.";
+        }
+    }
+    EXPECT_NEAR(inner_contour.area(), expected_inner_contour.area(), part_shape.length() * MM2INT(0.01));
+}
+
+/*!
+ * Tests the walls of a part that is too thin for all walls in only one place, between an M3 hole and the edge. Only there do the walls
+ * come from the skeletal trapezoidation, but they must connect to the offset walls around it.
+ */
+TEST_F(WallsComputationTest, HoleNearEdgeSameAsSkeletalTrapezoidation)
+{
+    Shape part_shape = square_shape;
+    Polygon& hole = part_shape.newLine();
+    for (size_t point_idx = 0; point_idx < 64; point_idx++)
+    {
+        // Centered 2.6mm from the edge, leaving 1mm between the hole and the edge for 2.4mm of walls.
+        const double angle = -2.0 * std::numbers::pi * static_cast<double>(point_idx) / 64.0;
+        hole.emplace_back(MM2INT(10) + static_cast<coord_t>(MM2INT(1.6) * std::cos(angle)), MM2INT(2.6) + static_cast<coord_t>(MM2INT(1.6) * std::sin(angle)));
+    }
+    const Shape thin_regions = findThinRegions(part_shape, MM2INT(1.4));
+    ASSERT_FALSE(thin_regions.empty()) << "The 1mm between the hole and the edge is too thin for all walls.";
+    EXPECT_TRUE(thin_regions.inside(Point2LL(MM2INT(10), MM2INT(0.5)))) << "The thin region is between the hole and the edge.";
+    EXPECT_FALSE(thin_regions.inside(Point2LL(MM2INT(10), MM2INT(10)))) << "The rest of the part is thick enough.";
+
+    const auto [expected_walls, expected_inner_contour] = generateWallToolPaths(part_shape, false);
+    const auto [walls, inner_contour] = generateWallToolPaths(part_shape, true);
+
+    expectSameWalls(walls, expected_walls);
+    bool has_other_widths = false;
+    for (const ExtrusionLine& line : walls | ranges::views::join)
+    {
+        for (const ExtrusionJunction& junction : line)
+        {
+            has_other_widths |= junction.w_ != MM2INT(0.4);
+        }
+    }
+    EXPECT_TRUE(has_other_widths) << "Between the hole and the edge, the walls must deviate from their nominal width.";
+    EXPECT_NEAR(inner_contour.area(), expected_inner_contour.area(), part_shape.length() * MM2INT(0.01));
+}
+
+/*!
+ * Tests the walls of a part with a thin rib sticking out of it. The rib gets a single wall in the middle.
+ */
+TEST_F(WallsComputationTest, ThinRibSameAsSkeletalTrapezoidation)
+{
+    Shape part_shape;
+    Polygon& outline = part_shape.newLine();
+    outline.emplace_back(0, 0);
+    outline.emplace_back(MM2INT(30), 0);
+    outline.emplace_back(MM2INT(30), MM2INT(20));
+    outline.emplace_back(MM2INT(15.3), MM2INT(20));
+    outline.emplace_back(MM2INT(15.3), MM2INT(30));
+    outline.emplace_back(MM2INT(14.7), MM2INT(30));
+    outline.emplace_back(MM2INT(14.7), MM2INT(20));
+    outline.emplace_back(0, MM2INT(20));
+    EXPECT_FALSE(findThinRegions(part_shape, MM2INT(1.4)).empty()) << "The rib is thinner than the walls.";
+
+    const auto [expected_walls, expected_inner_contour] = generateWallToolPaths(part_shape, false);
+    const auto [walls, inner_contour] = generateWallToolPaths(part_shape, true);
+
+    expectSameWalls(walls, expected_walls);
+    EXPECT_NEAR(inner_contour.area(), expected_inner_contour.area(), part_shape.length() * MM2INT(0.01));
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
@@ -1,6 +1,7 @@
 // Copyright (c) 2024 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher.
 
+#include <algorithm>
 #include <google/protobuf/message.h>
 #include <memory>
 #include <numbers>
@@ -9,10 +10,12 @@
 
 #include "FffProcessor.h"
 #include "MockSocket.h" //To mock out the communication with the front-end.
+#include "PrintFeature.h"
 #include "communication/ArcusCommunicationPrivate.h" //To access the private fields of this communication class.
 #include "geometry/Polygon.h" //Create test shapes to send over the socket.
 #include "geometry/Shape.h"
 #include "settings/types/LayerIndex.h"
+#include "settings/types/Velocity.h"
 #include "utils/Coord_t.h"
 #include "utils/string.h"
 
@@ -100,7 +103,7 @@ TEST_F(ArcusCommunicationTest, FlushGCodeTest)
     // Multi-line to see flushing behaviour.
     const std::string test_gcode = "This Fibonacci joke is as bad as the last two you heard combined.\n"
                                    "It's pretty cool how the Chinese made a language entirely out of tattoos.";
-    ac->private_data->gcode_output_stream.write(test_gcode.c_str(), test_gcode.size());
+    *ac->private_data->gcode_output << test_gcode;
 
     // Call the function we're testing. This time it should give us a message.
     ac->flushGCode();
@@ -160,6 +163,54 @@ TEST_F(ArcusCommunicationTest, SendLayerComplete)
     EXPECT_EQ(static_cast<float>(layer_thickness), message->thickness());
 }
 
+TEST_F(ArcusCommunicationTest, StreamOptimizedLayers)
+{
+    constexpr LayerIndex::value_type layer_count = 5;
+    constexpr coord_t layer_thickness = 100;
+    const auto count_sent_layers = [this]()
+    {
+        return std::count_if(
+            socket->sent_messages.begin(),
+            socket->sent_messages.end(),
+            [](const Arcus::MessagePtr& message)
+            {
+                return dynamic_cast<proto::LayerOptimized*>(message.get()) != nullptr;
+            });
+    };
+
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        const coord_t z = (layer_nr + 1) * layer_thickness;
+        ac->setLayerForSend(layer_nr);
+        EXPECT_EQ(count_sent_layers(), layer_nr) << "Each layer must be sent as soon as the next layer starts.";
+        EXPECT_EQ(ac->private_data->optimized_layers.slice_data.size(), size_t(0)) << "Layers that were sent must not be buffered any more.";
+
+        ac->sendCurrentPosition(Point3LL(0, 0, z));
+        ac->sendLineTo(PrintFeatureType::OuterWall, Point3LL(1000, 0, z), 400, layer_thickness, Velocity(30));
+        ac->sendLineTo(PrintFeatureType::OuterWall, Point3LL(1000, 1000, z), 400, layer_thickness, Velocity(30));
+        ac->sendLayerComplete(layer_nr, z, layer_thickness);
+        EXPECT_EQ(ac->private_data->optimized_layers.slice_data.size(), size_t(1)) << "Only the layer that's being written should be buffered.";
+    }
+    EXPECT_EQ(count_sent_layers(), layer_count - 1) << "The last layer can still get more data until the end of the mesh group.";
+
+    ac->sendOptimizedLayerData();
+    ASSERT_EQ(count_sent_layers(), layer_count);
+    EXPECT_TRUE(ac->private_data->optimized_layers.slice_data.empty());
+
+    LayerIndex::value_type expected_layer_nr = 0;
+    for (const Arcus::MessagePtr& message : socket->sent_messages)
+    {
+        if (const auto* layer = dynamic_cast<proto::LayerOptimized*>(message.get()); layer != nullptr)
+        {
+            EXPECT_EQ(layer->id(), expected_layer_nr) << "The layers must be sent in order.";
+            EXPECT_EQ(layer->height(), static_cast<float>((expected_layer_nr + 1) * layer_thickness));
+            ASSERT_EQ(layer->path_segment_size(), 1);
+            EXPECT_EQ(layer->path_segment(0).points().size(), 3 * 3 * sizeof(float)) << "The start point and two lines.";
+            ++expected_layer_nr;
+        }
+    }
+}
+
 TEST_F(ArcusCommunicationTest, SendProgress)
 {
     ac->private_data->object_count = 2; // If there are two objects, all progress should get halved.
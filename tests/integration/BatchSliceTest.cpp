@@ -0,0 +1,104 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To run the jobs like the command line would.
+#include "FffProcessor.h" // To close the output file of the last job.
+#include "communication/CommandLine.h" // The batch of jobs to slice.
+
+namespace cura
+{
+
+/*
+ * Integration test on slicing a batch of jobs from the command line. Every job
+ * of a batch must produce the same g-code as it would when sliced on its own.
+ */
+class BatchSliceTest : public testing::Test
+{
+public:
+    std::filesystem::path output_directory_;
+
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+        output_directory_ = std::filesystem::temp_directory_path() / "BatchSliceTest";
+        std::filesystem::create_directories(output_directory_);
+    }
+
+    void TearDown() override
+    {
+        Application::getInstance().communication_.reset();
+        std::filesystem::remove_all(output_directory_);
+    }
+
+    /*!
+     * Create the arguments of a job that slices one model with the default
+     * test settings.
+     * \param model The model to slice, relative to the tests directory.
+     * \param output The file to write the g-code to.
+     * \return The arguments of the job, as given to the command line.
+     */
+    static std::vector<std::string> createJob(const std::string& model, const std::filesystem::path& output)
+    {
+        std::vector<std::string> job{ "CuraEngine", "slice" };
+
+        const std::filesystem::path tests_directory = std::filesystem::path(__FILE__).parent_path().parent_path();
+        std::ifstream settings_file(tests_directory / "test_default_settings.txt");
+        std::string line;
+        while (std::getline(settings_file, line))
+        {
+            if (line.find('=') != std::string::npos)
+            {
+                job.insert(job.end(), { "-s", line });
+            }
+        }
+
+        job.insert(job.end(), { "-l", (tests_directory / model).string(), "-o", output.string() });
+        return job;
+    }
+
+    /*!
+     * Slice all given jobs in one batch, like the command line does.
+     */
+    static void slice(std::vector<std::vector<std::string>> jobs)
+    {
+        auto communication = std::make_shared<CommandLine>(std::move(jobs));
+        Application::getInstance().communication_ = communication;
+        while (communication->hasSlice())
+        {
+            communication->sliceNext();
+        }
+        FffProcessor::getInstance()->reset(); // Closes the output file of the last job.
+    }
+
+    static std::string readFile(const std::filesystem::path& filename)
+    {
+        std::ifstream file(filename);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+};
+
+TEST_F(BatchSliceTest, SameAsSlicedAlone)
+{
+    const std::filesystem::path first_in_batch = output_directory_ / "first_in_batch.gcode";
+    const std::filesystem::path second_in_batch = output_directory_ / "second_in_batch.gcode";
+    const std::filesystem::path alone = output_directory_ / "alone.gcode";
+
+    // The first job prints a different model, so any state left behind by it would show up in the g-code of the second job.
+    slice({ createJob("testModel.stl", first_in_batch), createJob("integration/resources/cube.stl", second_in_batch) });
+    slice({ createJob("integration/resources/cube.stl", alone) });
+
+    const std::string gcode_in_batch = readFile(second_in_batch);
+    ASSERT_FALSE(readFile(first_in_batch).empty()) << "Every job of the batch must write its own g-code.";
+    ASSERT_FALSE(gcode_in_batch.empty()) << "Every job of the batch must write its own g-code.";
+    EXPECT_EQ(gcode_in_batch, readFile(alone)) << "A job sliced in a batch must give the same g-code as the job sliced alone.";
+}
+
+} // namespace cura
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include "Application.h" // To set up a slice with settings.
+#include "MeshGroup.h" // To find translated copies of meshes.
 #include "Slice.h" // To set up a scene to slice.
 #include "geometry/OpenPolyline.h"
 #include "geometry/Polygon.h" // Creating polygons to compare to sliced layers.
@@ -175,4 +176,112 @@ TEST_F(SlicePhaseTest, Cylinder1000)
     }
 }
 
+TEST_F(SlicePhaseTest, SliceMeshesSameAsSeparately)
+{
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    scene.settings.add("slicing_tolerance", "middle");
+    MeshGroup& mesh_group = scene.mesh_groups.back();
+
+    const Matrix4x3D transformation;
+    ASSERT_TRUE(loadMeshIntoMeshGroup(&mesh_group, std::filesystem::path(__FILE__).parent_path().append("resources/cube.stl").string().c_str(), transformation, scene.settings));
+    ASSERT_TRUE(
+        loadMeshIntoMeshGroup(&mesh_group, std::filesystem::path(__FILE__).parent_path().append("resources/cylinder1000.stl").string().c_str(), transformation, scene.settings));
+    ASSERT_EQ(mesh_group.meshes.size(), 2);
+    mesh_group.meshes[0].translate(Point3LL(30000, 0, 0)); // Next to the cylinder instead of inside it.
+    mesh_group.meshes[1].settings_.add("xy_offset", "0.1");
+
+    const auto layer_thickness = scene.settings.get<coord_t>("layer_height");
+    const auto initial_layer_thickness = scene.settings.get<coord_t>("layer_height_0");
+    constexpr bool variable_layer_height = false;
+    constexpr std::vector<AdaptiveLayer>* variable_layer_height_values = nullptr;
+    const coord_t max_z = std::max(mesh_group.meshes[0].max().z_, mesh_group.meshes[1].max().z_);
+    const size_t num_layers = (max_z - initial_layer_thickness) / layer_thickness + 1;
+
+    std::vector<Mesh> separate_meshes = mesh_group.meshes;
+    std::vector<Slicer*> slicers = Slicer::sliceMeshes(mesh_group, layer_thickness, num_layers, variable_layer_height, variable_layer_height_values, initial_layer_thickness);
+    ASSERT_EQ(slicers.size(), 2);
+
+    for (size_t mesh_idx = 0; mesh_idx < separate_meshes.size(); mesh_idx++)
+    {
+        Slicer separate_slicer(
+            &separate_meshes[mesh_idx],
+            layer_thickness,
+            num_layers,
+            variable_layer_height,
+            variable_layer_height_values,
+            SlicingTolerance::MIDDLE,
+            initial_layer_thickness);
+        ASSERT_EQ(slicers[mesh_idx]->layers.size(), num_layers);
+        EXPECT_EQ(slicers[mesh_idx]->mesh, &mesh_group.meshes[mesh_idx]);
+        for (size_t layer_nr = 0; layer_nr < num_layers; layer_nr++)
+        {
+            const SlicerLayer& layer = slicers[mesh_idx]->layers[layer_nr];
+            const SlicerLayer& separate_layer = separate_slicer.layers[layer_nr];
+            EXPECT_EQ(layer.z_, separate_layer.z_);
+            ASSERT_EQ(layer.polygons_.size(), separate_layer.polygons_.size());
+            for (size_t polygon_idx = 0; polygon_idx < layer.polygons_.size(); polygon_idx++)
+            {
+                EXPECT_EQ(layer.polygons_[polygon_idx].getPoints(), separate_layer.polygons_[polygon_idx].getPoints())
+                    << "Mesh " << mesh_idx << " must be sliced the same at layer " << layer_nr << ".";
+            }
+            EXPECT_EQ(layer.open_polylines_.size(), separate_layer.open_polylines_.size());
+        }
+        EXPECT_EQ(mesh_group.meshes[mesh_idx].getAABB().max_, separate_meshes[mesh_idx].getAABB().max_) << "The XY offset must be registered in the bounding box.";
+        delete slicers[mesh_idx];
+    }
+}
+
+TEST_F(SlicePhaseTest, SliceMeshesTranslatedCopies)
+{
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    scene.settings.add("slicing_tolerance", "middle");
+    MeshGroup& mesh_group = scene.mesh_groups.back();
+
+    const Matrix4x3D transformation;
+    const std::string cube_file = std::filesystem::path(__FILE__).parent_path().append("resources/cube.stl").string();
+    for (size_t copy_idx = 0; copy_idx < 3; copy_idx++)
+    {
+        ASSERT_TRUE(loadMeshIntoMeshGroup(&mesh_group, cube_file.c_str(), transformation, scene.settings));
+    }
+    ASSERT_EQ(mesh_group.meshes.size(), 3);
+    const Point2LL offset(25000, -12000);
+    mesh_group.meshes[1].translate(Point3LL(offset.X, offset.Y, 0));
+    mesh_group.meshes[2].translate(Point3LL(offset.X, offset.Y, 0));
+    mesh_group.meshes[2].settings_.add("xy_offset", "0.1"); // Different settings, so not a copy.
+
+    const std::vector<std::optional<MeshGroup::MeshCopy>> copies = mesh_group.findTranslatedCopies();
+    ASSERT_EQ(copies.size(), 3);
+    EXPECT_FALSE(copies[0].has_value()) << "The first mesh is the original.";
+    ASSERT_TRUE(copies[1].has_value()) << "The second mesh is a translated copy of the first one.";
+    EXPECT_EQ(copies[1]->original_idx, 0);
+    EXPECT_EQ(copies[1]->offset, offset);
+    EXPECT_FALSE(copies[2].has_value()) << "A mesh with other settings can't reuse the slices of another mesh.";
+
+    const auto layer_thickness = scene.settings.get<coord_t>("layer_height");
+    const auto initial_layer_thickness = scene.settings.get<coord_t>("layer_height_0");
+    const size_t num_layers = (mesh_group.meshes[0].max().z_ - initial_layer_thickness) / layer_thickness + 1;
+    Mesh separate_copy = mesh_group.meshes[1];
+    std::vector<Slicer*> slicers = Slicer::sliceMeshes(mesh_group, layer_thickness, num_layers, false, nullptr, initial_layer_thickness);
+    Slicer separate_slicer(&separate_copy, layer_thickness, num_layers, false, nullptr, SlicingTolerance::MIDDLE, initial_layer_thickness);
+
+    ASSERT_EQ(slicers[1]->layers.size(), num_layers);
+    EXPECT_EQ(slicers[1]->mesh, &mesh_group.meshes[1]);
+    for (size_t layer_nr = 0; layer_nr < num_layers; layer_nr++)
+    {
+        const SlicerLayer& layer = slicers[1]->layers[layer_nr];
+        const SlicerLayer& separate_layer = separate_slicer.layers[layer_nr];
+        EXPECT_EQ(layer.z_, separate_layer.z_);
+        ASSERT_EQ(layer.polygons_.size(), separate_layer.polygons_.size());
+        for (size_t polygon_idx = 0; polygon_idx < layer.polygons_.size(); polygon_idx++)
+        {
+            EXPECT_EQ(layer.polygons_[polygon_idx].getPoints(), separate_layer.polygons_[polygon_idx].getPoints())
+                << "The copy must get the same slices as when it is sliced itself, at layer " << layer_nr << ".";
+        }
+    }
+    for (Slicer* slicer : slicers)
+    {
+        delete slicer;
+    }
+}
+
 } // namespace cura
@@ -220,6 +220,34 @@ TEST_F(SettingsTest, OverwriteSetting)
     ASSERT_EQ(settings.get<std::string>("test_setting"), std::string("NP"));
 }
 
+TEST_F(SettingsTest, HasSameEntries)
+{
+    Settings other;
+    EXPECT_TRUE(settings.hasSameEntries(other)) << "Two empty containers are the same.";
+
+    settings.add("infill_sparse_density", "20");
+    settings.add("mesh_position_x", "10");
+    EXPECT_FALSE(settings.hasSameEntries(other));
+    EXPECT_FALSE(other.hasSameEntries(settings)) << "The comparison must be symmetric.";
+
+    other.add("infill_sparse_density", "20");
+    EXPECT_FALSE(settings.hasSameEntries(other));
+    EXPECT_TRUE(settings.hasSameEntries(other, { "mesh_position_x" })) << "The ignored settings may differ.";
+    EXPECT_TRUE(other.hasSameEntries(settings, { "mesh_position_x" }));
+
+    other.add("mesh_position_x", "-10");
+    EXPECT_FALSE(settings.hasSameEntries(other));
+    EXPECT_TRUE(settings.hasSameEntries(other, { "mesh_position_x" }));
+
+    other.add("infill_sparse_density", "25");
+    EXPECT_FALSE(settings.hasSameEntries(other, { "mesh_position_x" }));
+
+    other.add("infill_sparse_density", "20");
+    Settings parent;
+    other.setParent(&parent);
+    EXPECT_FALSE(settings.hasSameEntries(other, { "mesh_position_x" })) << "Settings with different parents may evaluate differently.";
+}
+
 TEST_F(SettingsTest, Inheritance)
 {
     std::shared_ptr<Slice> current_slice = std::make_shared<Slice>(0);
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/CompressedGeometry.h" // The classes under test.
+
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "geometry/Polygon.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+// NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+class CompressedGeometryTest : public testing::Test
+{
+public:
+    Shape shape;
+    std::vector<VariableWidthLines> toolpaths;
+
+    void SetUp() override
+    {
+        std::mt19937_64 random{ 42 };
+        std::uniform_int_distribution<coord_t> step(-MM2INT(2), MM2INT(2));
+        std::uniform_int_distribution<coord_t> width(MM2INT(0.3), MM2INT(0.5));
+
+        // Small steps, far away from the origin, with the largest coordinates in between and an empty polygon.
+        Point2LL point(-MM2INT(300), MM2INT(150));
+        for (size_t polygon_idx = 0; polygon_idx < 5; polygon_idx++)
+        {
+            Polygon polygon(polygon_idx == 1);
+            for (size_t point_idx = 0; point_idx < 100; point_idx++)
+            {
+                point += Point2LL(step(random), step(random));
+                polygon.push_back(point);
+            }
+            shape.push_back(polygon);
+        }
+        shape.push_back(Polygon({ { std::numeric_limits<coord_t>::min() / 4, std::numeric_limits<coord_t>::max() / 4 }, { 0, 0 } }, false));
+        shape.push_back(Polygon());
+
+        toolpaths.resize(3);
+        for (size_t inset_idx = 0; inset_idx < 3; inset_idx++)
+        {
+            for (size_t line_idx = 0; line_idx < 4; line_idx++)
+            {
+                ExtrusionLine& line = toolpaths[inset_idx].emplace_back(inset_idx == 2 ? 4 : inset_idx, line_idx == 1, line_idx != 1);
+                for (size_t junction_idx = 0; junction_idx < 50; junction_idx++)
+                {
+                    point += Point2LL(step(random), step(random));
+                    line.junctions_.emplace_back(point, width(random), junction_idx == 10 ? inset_idx + 1 : line.inset_idx_);
+                }
+            }
+        }
+        toolpaths[1].emplace_back(); // An empty line with the default, unset inset index.
+    }
+};
+// NOLINTEND(misc-non-private-member-variables-in-classes)
+
+TEST_F(CompressedGeometryTest, ShapeRoundTrip)
+{
+    const CompressedShape compressed(shape);
+    EXPECT_FALSE(compressed.empty());
+    const Shape result = compressed.decompress();
+
+    ASSERT_EQ(result.size(), shape.size());
+    for (size_t polygon_idx = 0; polygon_idx < shape.size(); polygon_idx++)
+    {
+        EXPECT_EQ(result[polygon_idx].getPoints(), shape[polygon_idx].getPoints()) << polygon_idx;
+        EXPECT_EQ(result[polygon_idx].isExplicitelyClosed(), shape[polygon_idx].isExplicitelyClosed()) << polygon_idx;
+    }
+}
+
+TEST_F(CompressedGeometryTest, EmptyRoundTrip)
+{
+    EXPECT_TRUE(CompressedShape(Shape()).decompress().empty());
+    EXPECT_TRUE(CompressedShape().decompress().empty());
+    EXPECT_TRUE(CompressedShape(Shape()).empty());
+    EXPECT_EQ(CompressedShape(Shape()).byteSize(), 0) << "An empty shape takes no memory.";
+    EXPECT_TRUE(CompressedToolPaths(std::vector<VariableWidthLines>()).decompress().empty());
+    EXPECT_TRUE(CompressedToolPaths().decompress().empty());
+    EXPECT_FALSE(CompressedToolPaths().hasInsetIndex(0));
+}
+
+TEST_F(CompressedGeometryTest, ToolPathsRoundTrip)
+{
+    const CompressedToolPaths compressed(toolpaths);
+    const std::vector<VariableWidthLines> result = compressed.decompress();
+
+    ASSERT_EQ(result.size(), toolpaths.size());
+    for (size_t bin_idx = 0; bin_idx < toolpaths.size(); bin_idx++)
+    {
+        ASSERT_EQ(result[bin_idx].size(), toolpaths[bin_idx].size()) << bin_idx;
+        for (size_t line_idx = 0; line_idx < toolpaths[bin_idx].size(); line_idx++)
+        {
+            const ExtrusionLine& expected = toolpaths[bin_idx][line_idx];
+            const ExtrusionLine& line = result[bin_idx][line_idx];
+            EXPECT_EQ(line.inset_idx_, expected.inset_idx_) << bin_idx << " " << line_idx;
+            EXPECT_EQ(line.is_odd_, expected.is_odd_) << bin_idx << " " << line_idx;
+            EXPECT_EQ(line.is_closed_, expected.is_closed_) << bin_idx << " " << line_idx;
+            EXPECT_EQ(line.junctions_, expected.junctions_) << bin_idx << " " << line_idx;
+        }
+    }
+}
+
+TEST_F(CompressedGeometryTest, HasInsetIndex)
+{
+    const CompressedToolPaths compressed(toolpaths);
+
+    EXPECT_TRUE(compressed.hasInsetIndex(0));
+    EXPECT_TRUE(compressed.hasInsetIndex(1));
+    EXPECT_FALSE(compressed.hasInsetIndex(2));
+    EXPECT_FALSE(compressed.hasInsetIndex(3));
+    EXPECT_TRUE(compressed.hasInsetIndex(4));
+    EXPECT_TRUE(compressed.hasInsetIndex(std::numeric_limits<size_t>::max()));
+}
+
+TEST_F(CompressedGeometryTest, Compact)
+{
+    // Steps of up to 2mm take at most 3 bytes per coordinate, instead of 8.
+    size_t point_count = 0;
+    for (const Polygon& polygon : shape)
+    {
+        point_count += polygon.size();
+    }
+    EXPECT_LT(CompressedShape(shape).byteSize(), point_count * sizeof(Point2LL) / 2);
+
+    size_t junction_count = 0;
+    for (const VariableWidthLines& lines : toolpaths)
+    {
+        for (const ExtrusionLine& line : lines)
+        {
+            junction_count += line.size();
+        }
+    }
+    EXPECT_LT(CompressedToolPaths(toolpaths).byteSize(), junction_count * sizeof(ExtrusionJunction) / 2);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
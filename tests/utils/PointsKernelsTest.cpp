@@ -0,0 +1,181 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "geometry/PointsKernels.h" // The unit under test.
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/linearAlg2D.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura::kernels
+{
+
+class PointsKernelsTest : public testing::Test
+{
+public:
+    std::mt19937_64 random{ 42 };
+
+    void SetUp() override
+    {
+        if (! isSupported(InstructionSet::AVX2))
+        {
+            GTEST_SKIP() << "The CPU doesn't support AVX2, so there is nothing to compare the scalar kernels with.";
+        }
+    }
+
+    /*!
+     * Random polygons of all small sizes, with coordinates from a small range (lots of coincident and collinear points), a range of
+     * a typical build plate and a range too large for the vectorized kernels.
+     */
+    std::vector<std::vector<Point2LL>> randomPolygons(const coord_t range)
+    {
+        std::uniform_int_distribution<coord_t> coordinate(-range, range);
+        std::vector<std::vector<Point2LL>> polygons;
+        for (size_t size = 0; size < 40; size++)
+        {
+            for (size_t repeat = 0; repeat < 50; repeat++)
+            {
+                std::vector<Point2LL>& polygon = polygons.emplace_back();
+                for (size_t point_idx = 0; point_idx < size; point_idx++)
+                {
+                    polygon.emplace_back(coordinate(random), coordinate(random));
+                }
+            }
+        }
+        return polygons;
+    }
+
+    std::vector<Point2LL> queryPoints(const std::vector<Point2LL>& polygon, const coord_t range)
+    {
+        std::uniform_int_distribution<coord_t> coordinate(-range, range);
+        std::vector<Point2LL> points{ Point2LL(coordinate(random), coordinate(random)), Point2LL(coordinate(random), coordinate(random)) };
+        if (polygon.size() >= 2)
+        {
+            points.push_back(polygon[1]); // On a vertex.
+            points.push_back((polygon[0] + polygon[1]) / 2); // Possibly on an edge.
+            points.emplace_back(coordinate(random), polygon[1].Y); // On the same height as a vertex.
+        }
+        return points;
+    }
+};
+
+TEST_F(PointsKernelsTest, AreaAgrees)
+{
+    for (const coord_t range : { coord_t(20), MM2INT(300), coord_t(1) << 40 })
+    {
+        for (const std::vector<Point2LL>& polygon : randomPolygons(range))
+        {
+            const double scalar = area(polygon, InstructionSet::SCALAR);
+            EXPECT_EQ(scalar, area(polygon, InstructionSet::AVX2));
+            if (range <= MM2INT(300))
+            {
+                EXPECT_NEAR(scalar, ClipperLib::Area(polygon), 1.0) << "Only the rounding may differ from Clipper.";
+            }
+        }
+    }
+}
+
+TEST_F(PointsKernelsTest, LengthAgrees)
+{
+    for (const coord_t range : { coord_t(20), MM2INT(300), coord_t(3) << 28 }) // Larger ranges would overflow vSize2.
+    {
+        for (const std::vector<Point2LL>& polyline : randomPolygons(range))
+        {
+            for (const bool closed : { false, true })
+            {
+                coord_t expected = 0;
+                for (size_t point_idx = 1; point_idx < polyline.size(); point_idx++)
+                {
+                    expected += vSize(polyline[point_idx] - polyline[point_idx - 1]);
+                }
+                if (closed && ! polyline.empty())
+                {
+                    expected += vSize(polyline.front() - polyline.back());
+                }
+                EXPECT_EQ(length(polyline, closed, InstructionSet::SCALAR), expected);
+                EXPECT_EQ(length(polyline, closed, InstructionSet::AVX2), expected);
+            }
+        }
+    }
+}
+
+TEST_F(PointsKernelsTest, BoundsAgree)
+{
+    for (const coord_t range : { coord_t(20), coord_t(1) << 40 })
+    {
+        for (const std::vector<Point2LL>& polygon : randomPolygons(range))
+        {
+            Point2LL scalar_min(range, range + 5);
+            Point2LL scalar_max(-range, -range - 5);
+            Point2LL avx2_min = scalar_min;
+            Point2LL avx2_max = scalar_max;
+            bounds(polygon, scalar_min, scalar_max, InstructionSet::SCALAR);
+            bounds(polygon, avx2_min, avx2_max, InstructionSet::AVX2);
+            EXPECT_EQ(scalar_min, avx2_min);
+            EXPECT_EQ(scalar_max, avx2_max);
+        }
+    }
+}
+
+TEST_F(PointsKernelsTest, PointInPolygonAgrees)
+{
+    for (const coord_t range : { coord_t(20), MM2INT(300), coord_t(1) << 40 })
+    {
+        for (const std::vector<Point2LL>& polygon : randomPolygons(range))
+        {
+            const PointsSoAView view(polygon);
+            for (const Point2LL& point : queryPoints(polygon, range))
+            {
+                const int expected = ClipperLib::PointInPolygon(point, polygon);
+                EXPECT_EQ(pointInPolygon(point, polygon, InstructionSet::SCALAR), expected);
+                EXPECT_EQ(pointInPolygon(point, polygon, InstructionSet::AVX2), expected);
+                EXPECT_EQ(pointInPolygon(point, view.xs(), view.ys(), InstructionSet::SCALAR), expected);
+                EXPECT_EQ(pointInPolygon(point, view.xs(), view.ys(), InstructionSet::AVX2), expected);
+            }
+        }
+    }
+}
+
+TEST_F(PointsKernelsTest, ClosestOnPolygonAgrees)
+{
+    for (const coord_t range : { coord_t(20), MM2INT(300) })
+    {
+        for (const std::vector<Point2LL>& polygon : randomPolygons(range))
+        {
+            if (polygon.empty())
+            {
+                continue;
+            }
+            for (const Point2LL& from : queryPoints(polygon, range))
+            {
+                // The same loop as PolygonUtils::findClosest.
+                Point2LL expected_location = polygon[0];
+                coord_t best_score = vSize2(from - expected_location);
+                size_t expected_idx = 0;
+                for (size_t point_idx = 0; point_idx < polygon.size(); point_idx++)
+                {
+                    const Point2LL closest_here = LinearAlg2D::getClosestOnLineSegment(from, polygon[point_idx], polygon[(point_idx + 1) % polygon.size()]);
+                    if (vSize2(from - closest_here) < best_score)
+                    {
+                        expected_location = closest_here;
+                        best_score = vSize2(from - closest_here);
+                        expected_idx = point_idx;
+                    }
+                }
+                for (const InstructionSet instruction_set : { InstructionSet::SCALAR, InstructionSet::AVX2 })
+                {
+                    const auto [location, segment_idx] = closestOnPolygon(from, polygon, instruction_set);
+                    EXPECT_EQ(location, expected_location);
+                    EXPECT_EQ(segment_idx, expected_idx);
+                }
+            }
+        }
+    }
+}
+
+} // namespace cura::kernels
+// NOLINTEND(*-magic-numbers)
@@ -145,6 +145,30 @@ TEST_F(PolygonTest, polygonOffsetBugTest)
     }
 }
 
+TEST_F(PolygonTest, offsetNestedTest)
+{
+    Shape shape = clockwise_donut;
+    shape.push_back(pointy_square);
+    shape.push_back(triangle);
+    const std::vector<coord_t> distances{ 25, -10, 0, 300, 25, -60 };
+    const std::vector<Shape> nested = shape.offsetNested(distances);
+
+    ASSERT_EQ(nested.size(), distances.size());
+    for (size_t distance_idx = 0; distance_idx < distances.size(); distance_idx++)
+    {
+        const Shape expected = shape.offset(distances[distance_idx]);
+        ASSERT_EQ(nested[distance_idx].size(), expected.size()) << "Offset by " << distances[distance_idx] << " should give the same polygons as a single offset.";
+        for (size_t poly_idx = 0; poly_idx < expected.size(); poly_idx++)
+        {
+            EXPECT_EQ(nested[distance_idx][poly_idx].getPoints(), expected[poly_idx].getPoints())
+                << "Offset by " << distances[distance_idx] << " should give the same polygons as a single offset.";
+        }
+    }
+
+    EXPECT_TRUE(Shape().offsetNested(distances)[0].empty());
+    EXPECT_TRUE(shape.offsetNested({}).empty());
+}
+
 TEST_F(PolygonTest, isOutsideTest)
 {
     Shape test_triangle;
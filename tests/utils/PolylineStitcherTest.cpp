@@ -0,0 +1,151 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/PolylineStitcher.h" // The unit under test.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "geometry/ClosedLinesSet.h"
+#include "geometry/ClosedPolyline.h"
+#include "geometry/LinesSet.h"
+#include "geometry/OpenLinesSet.h"
+#include "geometry/OpenPolyline.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+using Stitcher = PolylineStitcher<OpenLinesSet, ClosedLinesSet, OpenPolyline, Point2LL>;
+
+/*!
+ * Cut a closed contour into fragments of a few segments each, reversing some of them.
+ */
+void addFragments(const std::vector<Point2LL>& contour, OpenLinesSet& fragments, std::mt19937& rng)
+{
+    size_t point_idx = 0;
+    while (point_idx < contour.size())
+    {
+        const size_t segment_count = 1 + rng() % 3;
+        OpenPolyline fragment;
+        for (size_t i = 0; i <= segment_count && point_idx + i <= contour.size(); i++)
+        {
+            fragment.push_back(contour[(point_idx + i) % contour.size()]);
+        }
+        point_idx += segment_count;
+        if (rng() % 2 == 0)
+        {
+            fragment.reverse();
+        }
+        fragments.emplace_back(fragment);
+    }
+}
+
+std::vector<Point2LL> makeSquare(const Point2LL& corner, const coord_t size, const size_t points_per_side)
+{
+    std::vector<Point2LL> square;
+    const Point2LL directions[] = { Point2LL(1, 0), Point2LL(0, 1), Point2LL(-1, 0), Point2LL(0, -1) };
+    Point2LL position = corner;
+    for (const Point2LL& direction : directions)
+    {
+        for (size_t i = 0; i < points_per_side; i++)
+        {
+            square.push_back(position);
+            position += direction * (size / static_cast<coord_t>(points_per_side));
+        }
+    }
+    return square;
+}
+
+TEST(PolylineStitcherTest, StitchShuffledFragmentsIntoPolygon)
+{
+    std::mt19937 rng(42);
+    const std::vector<Point2LL> square = makeSquare(Point2LL(0, 0), 10000, 5);
+    OpenLinesSet fragments;
+    addFragments(square, fragments, rng);
+    std::shuffle(fragments.begin(), fragments.end(), rng);
+
+    OpenLinesSet result_lines;
+    ClosedLinesSet result_polygons;
+    Stitcher::stitch(fragments, result_lines, result_polygons, 100, 10);
+
+    EXPECT_TRUE(result_lines.empty());
+    ASSERT_EQ(result_polygons.size(), 1);
+    // The shared end points of the fragments are merged, only the last point of the chain coincides with the first one.
+    EXPECT_EQ(result_polygons[0].size(), square.size() + 1);
+    EXPECT_EQ(result_polygons[0].front(), result_polygons[0].back());
+    EXPECT_EQ(result_polygons[0].length(), 4 * 10000);
+}
+
+TEST(PolylineStitcherTest, KeepGapsOpen)
+{
+    OpenLinesSet fragments;
+    fragments.emplace_back(OpenPolyline({ Point2LL(3000, 0), Point2LL(2000, 0) }));
+    fragments.emplace_back(OpenPolyline({ Point2LL(0, 0), Point2LL(1000, 0) }));
+    fragments.emplace_back(OpenPolyline({ Point2LL(2050, 0), Point2LL(1000, 0) }));
+    fragments.emplace_back(OpenPolyline({ Point2LL(5000, 0), Point2LL(6000, 0) })); // Too far away to be stitched.
+
+    OpenLinesSet result_lines;
+    ClosedLinesSet result_polygons;
+    Stitcher::stitch(fragments, result_lines, result_polygons, 100, 10);
+
+    EXPECT_TRUE(result_polygons.empty());
+    ASSERT_EQ(result_lines.size(), 2);
+    const OpenPolyline& stitched = result_lines[0];
+    ASSERT_EQ(stitched.size(), 5) << "The stitch of 50 microns should be bridged by a new segment.";
+    EXPECT_EQ(stitched.length(), 3000 + 100);
+    EXPECT_TRUE((stitched.front() == Point2LL(0, 0) && stitched.back() == Point2LL(3000, 0)) || (stitched.front() == Point2LL(3000, 0) && stitched.back() == Point2LL(0, 0)));
+    EXPECT_EQ(result_lines[1].size(), 2);
+}
+
+TEST(PolylineStitcherTest, CloseAtEndPointOfStitchedLine)
+{
+    OpenLinesSet fragments;
+    fragments.emplace_back(OpenPolyline({ Point2LL(0, 0), Point2LL(8, 0) }));
+    fragments.emplace_back(OpenPolyline({ Point2LL(8, 0), Point2LL(1000, 0), Point2LL(1000, 1000), Point2LL(30, 97) }));
+
+    OpenLinesSet result_lines;
+    ClosedLinesSet result_polygons;
+    Stitcher::stitch(fragments, result_lines, result_polygons, 100, 10);
+
+    // The last point is just out of reach of the front of the chain, but within reach of the end points where the first two lines meet.
+    // Those are within the snap distance of the front, so they close the polygon too.
+    EXPECT_TRUE(result_lines.empty());
+    ASSERT_EQ(result_polygons.size(), 1);
+    EXPECT_EQ(result_polygons[0].front(), Point2LL(0, 0));
+    EXPECT_EQ(result_polygons[0].back(), Point2LL(30, 97));
+}
+
+TEST(PolylineStitcherTest, StitchManyFragmentsIntoSeparatePolygons)
+{
+    std::mt19937 rng(1234);
+    constexpr size_t squares_per_side = 20;
+    OpenLinesSet fragments;
+    for (size_t x = 0; x < squares_per_side; x++)
+    {
+        for (size_t y = 0; y < squares_per_side; y++)
+        {
+            // Squares that are 200 microns apart, so they are close enough to be stitched to each other but the closing stitch is preferred.
+            addFragments(makeSquare(Point2LL(x * 1200, y * 1200), 1000, 4), fragments, rng);
+        }
+    }
+    std::shuffle(fragments.begin(), fragments.end(), rng);
+
+    OpenLinesSet result_lines;
+    ClosedLinesSet result_polygons;
+    Stitcher::stitch(fragments, result_lines, result_polygons, 300, 10);
+
+    EXPECT_TRUE(result_lines.empty());
+    ASSERT_EQ(result_polygons.size(), squares_per_side * squares_per_side);
+    for (const ClosedPolyline& polygon : result_polygons)
+    {
+        EXPECT_EQ(polygon.size(), 16 + 1);
+        EXPECT_EQ(polygon.length(), 4 * 1000);
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
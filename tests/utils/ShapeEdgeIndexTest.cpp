@@ -0,0 +1,142 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "geometry/ShapeEdgeIndex.h" // The unit under test.
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "geometry/Shape.h"
+#include "utils/polygonUtils.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class ShapeEdgeIndexTest : public testing::Test
+{
+public:
+    std::mt19937_64 random{ 42 };
+
+    /*!
+     * A shape with a few round holes in a round outline, like the masks of a layer part, plus some random polygons of all small
+     * sizes, with many coincident and collinear points.
+     */
+    Shape randomShape(const coord_t range)
+    {
+        Shape shape;
+        const auto add_circle = [&shape](const Point2LL& center, const coord_t radius, const size_t point_count)
+        {
+            Polygon& circle = shape.newLine();
+            for (size_t point_idx = 0; point_idx < point_count; point_idx++)
+            {
+                const double angle = 2.0 * std::numbers::pi * static_cast<double>(point_idx) / static_cast<double>(point_count);
+                circle.emplace_back(center.X + static_cast<coord_t>(radius * std::cos(angle)), center.Y + static_cast<coord_t>(radius * std::sin(angle)));
+            }
+        };
+        add_circle(Point2LL(0, 0), range, 500);
+        add_circle(Point2LL(range / 2, 0), range / 4, 100);
+        add_circle(Point2LL(-range / 2, range / 3), range / 5, 3);
+
+        std::uniform_int_distribution<coord_t> coordinate(-range, range);
+        std::uniform_int_distribution<coord_t> small_coordinate(-20, 20);
+        for (size_t size = 0; size < 8; size++)
+        {
+            Polygon& polygon = shape.newLine();
+            const Point2LL offset(coordinate(random), coordinate(random));
+            for (size_t point_idx = 0; point_idx < size; point_idx++)
+            {
+                polygon.emplace_back(offset + Point2LL(small_coordinate(random), small_coordinate(random)));
+            }
+        }
+        return shape;
+    }
+
+    /*!
+     * Random points, vertices of the shape, points on its edges and points on the same height as its vertices.
+     */
+    std::vector<Point2LL> queryPoints(const Shape& shape, const coord_t range)
+    {
+        std::uniform_int_distribution<coord_t> coordinate(-range - 100, range + 100);
+        std::vector<Point2LL> points;
+        for (const Polygon& polygon : shape)
+        {
+            for (size_t point_idx = 0; point_idx < polygon.size(); point_idx++)
+            {
+                const Point2LL& point = polygon[point_idx];
+                points.push_back(point);
+                points.push_back((point + polygon[(point_idx + 1) % polygon.size()]) / 2);
+                points.emplace_back(coordinate(random), point.Y);
+                points.emplace_back(point.X + 1, point.Y - 1);
+            }
+        }
+        for (size_t point_idx = 0; point_idx < 1000; point_idx++)
+        {
+            points.emplace_back(coordinate(random), coordinate(random));
+        }
+        return points;
+    }
+};
+
+TEST_F(ShapeEdgeIndexTest, EmptyShape)
+{
+    const ShapeEdgeIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_FALSE(index.inside(Point2LL(0, 0), true));
+    EXPECT_FALSE(index.collidesWithLineSegment(Point2LL(0, 0), Point2LL(100, 100)));
+    EXPECT_TRUE(index.intersectionsWithSegment(Point2LL(0, 0), Point2LL(100, 100)).empty());
+
+    EXPECT_TRUE(ShapeEdgeIndex(Shape()).empty());
+}
+
+TEST_F(ShapeEdgeIndexTest, InsideAgrees)
+{
+    for (const coord_t range : { coord_t(50), MM2INT(100) })
+    {
+        const Shape shape = randomShape(range);
+        const ShapeEdgeIndex index(shape);
+        for (const Point2LL& point : queryPoints(shape, range))
+        {
+            EXPECT_EQ(index.inside(point, false), shape.inside(point, false)) << point;
+            EXPECT_EQ(index.inside(point, true), shape.inside(point, true)) << point;
+        }
+    }
+}
+
+TEST_F(ShapeEdgeIndexTest, SegmentQueriesAgree)
+{
+    for (const coord_t range : { coord_t(50), MM2INT(100) })
+    {
+        const Shape shape = randomShape(range);
+        const ShapeEdgeIndex index(shape);
+        const std::vector<Point2LL> points = queryPoints(shape, range);
+        std::uniform_int_distribution<size_t> point_idx(0, points.size() - 1);
+        std::uniform_int_distribution<coord_t> step(-MM2INT(2), MM2INT(2));
+        for (size_t segment_idx = 0; segment_idx < 5000; segment_idx++)
+        {
+            // Both long segments through the whole shape and short ones, like the lines of walls.
+            const Point2LL start = points[point_idx(random)];
+            const Point2LL end = segment_idx % 2 == 0 ? points[point_idx(random)] : start + Point2LL(step(random), step(random));
+            if (start == end)
+            {
+                continue;
+            }
+
+            EXPECT_EQ(index.collidesWithLineSegment(start, end), PolygonUtils::polygonCollidesWithLineSegment(shape, start, end)) << start << " " << end;
+
+            std::vector<float> intersections = index.intersectionsWithSegment(start, end);
+            std::vector<float> expected = shape.intersectionsWithSegment(start, end);
+            std::sort(intersections.begin(), intersections.end());
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(intersections, expected) << start << " " << end;
+        }
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -86,5 +86,46 @@ INSTANTIATE_TEST_SUITE_P(WriteDoubleToStreamTestInstantiation,
                                          std::numeric_limits<double>::lowest(),
                                          -std::numeric_limits<double>::lowest()));
 
+/*
+ * The buffer versions of writeInt2mm and writeDoubleToStream must write exactly the same characters as the stream versions, to keep
+ * the g-code output identical.
+ */
+TEST(StringTest, WriteInt2mmBufferSameAsStream)
+{
+    for (int32_t in = -200000; in <= 200000; in += 7)
+    {
+        std::ostringstream ss;
+        writeInt2mm(in, ss);
+        char buffer[24];
+        char* end = writeInt2mm(int64_t(in), buffer);
+        ASSERT_EQ(ss.str(), std::string(buffer, end)) << "The integer " << in << " was written differently.";
+    }
+    for (const int32_t in : { -1000, -999, -500, -100, -99, -1, 0, 1, 99, 100, 999, 1000, 1001, std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min() })
+    {
+        std::ostringstream ss;
+        writeInt2mm(in, ss);
+        char buffer[24];
+        char* end = writeInt2mm(int64_t(in), buffer);
+        EXPECT_EQ(ss.str(), std::string(buffer, end)) << "The integer " << in << " was written differently.";
+    }
+}
+
+TEST(StringTest, WriteDoubleToBufferSameAsStream)
+{
+    for (const double in : { 0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.05, 0.15, 1e-9, -1e-9, 123456.789, 1e14, -10.000, 0.00000001, std::numeric_limits<double>::min(),
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::quiet_NaN() })
+    {
+        for (const uint8_t precision : { 0, 1, 2, 5 })
+        {
+            std::ostringstream ss;
+            writeDoubleToStream(precision, in, ss);
+            char buffer[400];
+            char* end = writeDoubleToBuffer(precision, in, buffer);
+            EXPECT_EQ(ss.str(), std::string(buffer, end)) << "The double " << in << " was written differently with precision " << int(precision) << ".";
+        }
+    }
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
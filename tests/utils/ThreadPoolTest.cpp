@@ -0,0 +1,97 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ThreadPool.h" // The unit under test.
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class ThreadPoolTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+    }
+};
+
+TEST_F(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> visits(1000);
+    cura::parallel_for<size_t>(
+        0,
+        visits.size(),
+        [&visits](const size_t idx)
+        {
+            visits[idx]++;
+        });
+
+    for (size_t idx = 0; idx < visits.size(); idx++)
+    {
+        EXPECT_EQ(visits[idx], 1) << "Index " << idx << " should be visited exactly once.";
+    }
+}
+
+TEST_F(ThreadPoolTest, NestedParallelFor)
+{
+    constexpr size_t outer_count = 7;
+    constexpr size_t inner_count = 300;
+    std::vector<std::atomic<int>> visits(outer_count * inner_count);
+    std::vector<std::atomic<int>> completed_inner_loops(outer_count);
+
+    cura::parallel_for<size_t>(
+        0,
+        outer_count,
+        [&](const size_t outer_idx)
+        {
+            cura::parallel_for<size_t>(
+                0,
+                inner_count,
+                [&](const size_t inner_idx)
+                {
+                    // A third level, to make sure that waiting loops don't depend on each other.
+                    cura::parallel_for<size_t>(
+                        0,
+                        3,
+                        [&](const size_t)
+                        {
+                        });
+                    visits[outer_idx * inner_count + inner_idx]++;
+                });
+            // The inner loop has to be completely done when it returns.
+            for (size_t inner_idx = 0; inner_idx < inner_count; inner_idx++)
+            {
+                EXPECT_EQ(visits[outer_idx * inner_count + inner_idx], 1);
+            }
+            completed_inner_loops[outer_idx]++;
+        });
+
+    for (size_t outer_idx = 0; outer_idx < outer_count; outer_idx++)
+    {
+        EXPECT_EQ(completed_inner_loops[outer_idx], 1);
+    }
+}
+
+TEST_F(ThreadPoolTest, EmptyRange)
+{
+    bool visited = false;
+    cura::parallel_for<int>(
+        5,
+        5,
+        [&visited](const int)
+        {
+            visited = true;
+        });
+    EXPECT_FALSE(visited);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
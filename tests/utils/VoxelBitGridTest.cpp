@@ -0,0 +1,106 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/VoxelBitGrid.h" // The unit under test.
+
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(VoxelBitGridTest, SetAndTest)
+{
+    VoxelBitGrid grid(GridPoint3(-3, -2, -1), GridPoint3(9, 4, 5));
+    EXPECT_EQ(grid.count(), 0);
+
+    const std::vector<GridPoint3> cells{ GridPoint3(-3, -2, -1), GridPoint3(9, 4, 5), GridPoint3(0, 0, 0), GridPoint3(4, -1, 2), GridPoint3(4, -1, 3) };
+    for (const GridPoint3& cell : cells)
+    {
+        grid.set(cell);
+    }
+    grid.set(GridPoint3(0, 0, 0)); // Setting a cell twice doesn't add it twice.
+
+    EXPECT_EQ(grid.count(), cells.size());
+    for (const GridPoint3& cell : cells)
+    {
+        EXPECT_TRUE(grid.test(cell)) << "The cell " << cell << " was set.";
+    }
+    EXPECT_FALSE(grid.test(GridPoint3(1, 0, 0)));
+    EXPECT_FALSE(grid.test(GridPoint3(4, -1, 4)));
+    EXPECT_FALSE(grid.test(GridPoint3(100, 0, 0))) << "Cells outside of the grid are never in it.";
+}
+
+TEST(VoxelBitGridTest, ForEachVisitsAllCells)
+{
+    VoxelBitGrid grid(GridPoint3(0, 0, 0), GridPoint3(20, 20, 3)); // Planes don't fill whole words.
+    std::unordered_set<GridPoint3> expected;
+    for (coord_t i = 0; i < 21; i++)
+    {
+        const GridPoint3 cell(i, (i * 7) % 21, i % 4);
+        grid.set(cell);
+        expected.emplace(cell);
+    }
+
+    std::unordered_set<GridPoint3> visited;
+    GridPoint3 last(-1, -1, -1);
+    grid.forEach(
+        [&](const GridPoint3& cell)
+        {
+            EXPECT_TRUE(visited.emplace(cell).second) << "Each cell should be visited once.";
+            EXPECT_TRUE(cell.z_ > last.z_ || (cell.z_ == last.z_ && (cell.y_ > last.y_ || (cell.y_ == last.y_ && cell.x_ > last.x_)))) << "Cells are visited in order.";
+            last = cell;
+        });
+    EXPECT_EQ(visited, expected);
+}
+
+TEST(VoxelBitGridTest, MergeSlab)
+{
+    VoxelBitGrid grid(GridPoint3(-5, -5, -5), GridPoint3(5, 5, 5));
+    grid.set(GridPoint3(1, 1, -5));
+
+    VoxelBitGrid slab = grid.emptySlab(-1, 100);
+    slab.set(GridPoint3(-5, 5, -1));
+    slab.set(GridPoint3(2, 3, 5));
+    VoxelBitGrid other_slab = grid.emptySlab(-1, 1);
+    other_slab.set(GridPoint3(-5, 5, -1));
+    other_slab.set(GridPoint3(0, 0, 1));
+
+    grid |= slab;
+    grid |= other_slab;
+
+    EXPECT_EQ(grid.count(), 4);
+    EXPECT_TRUE(grid.test(GridPoint3(1, 1, -5)));
+    EXPECT_TRUE(grid.test(GridPoint3(-5, 5, -1)));
+    EXPECT_TRUE(grid.test(GridPoint3(2, 3, 5)));
+    EXPECT_TRUE(grid.test(GridPoint3(0, 0, 1)));
+}
+
+TEST(VoxelBitGridTest, IntersectAndSubtract)
+{
+    VoxelBitGrid a(GridPoint3(0, 0, 0), GridPoint3(9, 9, 9));
+    VoxelBitGrid b = a;
+    VoxelBitGrid c = a;
+    a.set(GridPoint3(1, 2, 3));
+    a.set(GridPoint3(4, 5, 6));
+    a.set(GridPoint3(7, 8, 9));
+    b.set(GridPoint3(4, 5, 6));
+    b.set(GridPoint3(7, 8, 9));
+    b.set(GridPoint3(0, 0, 0));
+    c.set(GridPoint3(7, 8, 9));
+
+    a &= b;
+    EXPECT_EQ(a.count(), 2);
+    EXPECT_TRUE(a.test(GridPoint3(4, 5, 6)));
+    EXPECT_TRUE(a.test(GridPoint3(7, 8, 9)));
+
+    a.subtract(c);
+    EXPECT_EQ(a.count(), 1);
+    EXPECT_TRUE(a.test(GridPoint3(4, 5, 6)));
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
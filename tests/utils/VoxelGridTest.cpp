@@ -0,0 +1,113 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/VoxelGrid.h" // The unit under test.
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+#include "utils/AABB3D.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class VoxelGridTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+    }
+};
+
+TEST_F(VoxelGridTest, SetAndGetOccupation)
+{
+    // 100 voxels on each side, which doesn't fill whole bricks
+    VoxelGrid grid(AABB3D(Point3LL(0, 0, 0), Point3LL(9999, 9999, 9999)), 100);
+    ASSERT_EQ(grid.getSlicesCount(), Point3LL(100, 100, 100));
+
+    const VoxelGrid::LocalCoordinates voxel(17, 99, 40);
+    EXPECT_FALSE(grid.getOccupation(voxel).has_value());
+
+    grid.setOccupation(voxel, 0);
+    EXPECT_EQ(grid.getOccupation(voxel), 0) << "Extruder 0 is an occupation, not an empty voxel.";
+
+    grid.setOrUpdateOccupation(voxel, 3);
+    EXPECT_EQ(grid.getOccupation(voxel), 0) << "Updating should keep the lowest extruder.";
+
+    grid.setOrUpdateOccupation(VoxelGrid::LocalCoordinates(99, 0, 0), 3);
+    grid.setOrUpdateOccupation(VoxelGrid::LocalCoordinates(99, 0, 0), 2);
+    EXPECT_EQ(grid.getOccupation(VoxelGrid::LocalCoordinates(99, 0, 0)), 2);
+
+    grid.setOccupation(VoxelGrid::LocalCoordinates(99, 0, 0), 5);
+    EXPECT_EQ(grid.getOccupation(VoxelGrid::LocalCoordinates(99, 0, 0)), 5) << "Setting should overwrite the occupation.";
+
+    EXPECT_FALSE(grid.getOccupation(VoxelGrid::LocalCoordinates(16, 99, 40)).has_value()) << "Neighbouring voxels in the same brick stay empty.";
+    EXPECT_EQ(grid.occupiedCount(), 2);
+}
+
+TEST_F(VoxelGridTest, ReserveOnce)
+{
+    VoxelGrid grid(AABB3D(Point3LL(0, 0, 0), Point3LL(1000, 1000, 1000)), 100);
+
+    const VoxelGrid::LocalCoordinates voxel(3, 4, 5);
+    EXPECT_TRUE(grid.reserve(voxel));
+    EXPECT_FALSE(grid.reserve(voxel)) << "A voxel can only be reserved once.";
+    EXPECT_FALSE(grid.getOccupation(voxel).has_value()) << "A reserved voxel is not occupied yet.";
+
+    grid.setOccupation(voxel, 1);
+    EXPECT_EQ(grid.getOccupation(voxel), 1);
+    EXPECT_EQ(grid.occupiedCount(), 1);
+
+    grid.setOccupation(VoxelGrid::LocalCoordinates(0, 0, 0), 0);
+    EXPECT_FALSE(grid.reserve(VoxelGrid::LocalCoordinates(0, 0, 0))) << "An occupied voxel can't be reserved.";
+}
+
+TEST_F(VoxelGridTest, FindOccupiedVoxels)
+{
+    VoxelGrid grid(AABB3D(Point3LL(0, 0, 0), Point3LL(5000, 5000, 5000)), 100);
+    grid.setOccupation(VoxelGrid::LocalCoordinates(0, 0, 0), 1);
+    grid.setOccupation(VoxelGrid::LocalCoordinates(20, 30, 40), 0);
+    grid.setOccupation(VoxelGrid::LocalCoordinates(49, 49, 49), 2);
+    grid.reserve(VoxelGrid::LocalCoordinates(1, 1, 1));
+
+    std::vector<VoxelGrid::LocalCoordinates> found = grid.findOccupiedVoxels(
+        [](const auto& voxel)
+        {
+            return voxel.second > 0;
+        });
+    std::sort(found.begin(), found.end());
+
+    std::vector<VoxelGrid::LocalCoordinates> expected{ VoxelGrid::LocalCoordinates(0, 0, 0), VoxelGrid::LocalCoordinates(49, 49, 49) };
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(found, expected);
+}
+
+TEST_F(VoxelGridTest, VisitVoxelsAround)
+{
+    VoxelGrid grid(AABB3D(Point3LL(0, 0, 0), Point3LL(1000, 1000, 1000)), 100);
+
+    size_t count = 0;
+    grid.visitVoxelsAround(
+        VoxelGrid::LocalCoordinates(5, 5, 5),
+        [&count](const VoxelGrid::LocalCoordinates&)
+        {
+            ++count;
+        });
+    EXPECT_EQ(count, 26);
+
+    count = 0;
+    grid.visitVoxelsAround(
+        VoxelGrid::LocalCoordinates(0, 0, 0),
+        [&count](const VoxelGrid::LocalCoordinates&)
+        {
+            ++count;
+        });
+    EXPECT_EQ(count, 7) << "Only the voxels inside the grid are visited.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)